@@ -34,6 +34,7 @@ PYBIND11_MODULE(python_griddly, m) {
   gdy.def("get_action_input_mappings", &Py_GDYWrapper::getActionInputMappings);
   gdy.def("get_avatar_object", &Py_GDYWrapper::getAvatarObject);
   gdy.def("create_game", &Py_GDYWrapper::createGame);
+  gdy.def("create_vector_game", &Py_GDYWrapper::createVectorGame, py::arg("num_envs"), py::arg("observer_name"), py::arg("num_threads") = 1, py::arg("pin_threads") = false);
   gdy.def("get_level_count", &Py_GDYWrapper::getLevelCount);
   gdy.def("get_observer_type", &Py_GDYWrapper::getObserverType);
   
@@ -45,11 +46,14 @@ PYBIND11_MODULE(python_griddly, m) {
   
   // Initialize the game or reset the game state
   game_process.def("init", &Py_GameWrapper::init);
-  game_process.def("reset", &Py_GameWrapper::reset);
+  game_process.def("reset", &Py_GameWrapper::reset, py::call_guard<py::gil_scoped_release>());
 
   // Generic step function for multiple players and multiple actions per step
   game_process.def("step_parallel", &Py_GameWrapper::stepParallel);
 
+  // Copy of the rewards accumulated since the last step
+  game_process.def("get_accumulated_rewards", &Py_GameWrapper::getAccumulatedRewards);
+
   // Set the current map of the game (should be followed by reset or init)
   game_process.def("load_level", &Py_GameWrapper::loadLevel);
   game_process.def("load_level_string", &Py_GameWrapper::loadLevelString);
@@ -59,6 +63,11 @@ PYBIND11_MODULE(python_griddly, m) {
   game_process.def("get_available_action_ids", &Py_GameWrapper::getAvailableActionIds);
   game_process.def("build_valid_action_trees", &Py_GameWrapper::buildValidActionTrees);
 
+  // Dense [units, action types, action ids] masks, written into a caller provided array
+  game_process.def("get_action_mask_shape", &Py_GameWrapper::getActionMaskShape);
+  game_process.def("write_action_mask", &Py_GameWrapper::writeActionMask);
+  game_process.def("update_action_masks", &Py_GameWrapper::updateActionMasks);
+
   // Width and height of the game grid 
   game_process.def("get_width", &Py_GameWrapper::getWidth);
   game_process.def("get_height", &Py_GameWrapper::getHeight);
@@ -75,12 +84,20 @@ PYBIND11_MODULE(python_griddly, m) {
   // Enable the history collection mode 
   game_process.def("enable_history", &Py_GameWrapper::enableHistory);
 
-  // Create a copy of the game in its current state
-  game_process.def("clone", &Py_GameWrapper::clone);
+  // Record changes to the game so they can be rolled back to a checkpoint
+  game_process.def("enable_journal", &Py_GameWrapper::enableJournal);
+  game_process.def("checkpoint", &Py_GameWrapper::checkpoint);
+  game_process.def("rollback", &Py_GameWrapper::rollback);
+
+  // Create a copy of the game in its current state, a copy-on-write clone only copies the parts of the game it uses
+  game_process.def("clone", &Py_GameWrapper::clone, py::arg("copy_on_write") = false);
 
   // Get a dictionary containing the objects in the environment and their variable values
   game_process.def("get_state", &Py_GameWrapper::getState);
 
+  // Get a hash of the current state without building it
+  game_process.def("get_state_hash", &Py_GameWrapper::getStateHash);
+
   // Get a specific variable value
   game_process.def("get_global_variable", &Py_GameWrapper::getGlobalVariables);
 
@@ -105,6 +122,24 @@ PYBIND11_MODULE(python_griddly, m) {
   game_process.def("seed", &Py_GameWrapper::seedRandomGenerator);
 
 
+  py::class_<Py_VectorGameWrapper, std::shared_ptr<Py_VectorGameWrapper>> vector_game_process(m, "VectorGameProcess");
+  vector_game_process.def("get_num_envs", &Py_VectorGameWrapper::getNumEnvs);
+  vector_game_process.def("get_player_count", &Py_VectorGameWrapper::getPlayerCount);
+  vector_game_process.def("get_num_threads", &Py_VectorGameWrapper::getNumThreads);
+  vector_game_process.def("load_level", &Py_VectorGameWrapper::loadLevel);
+  vector_game_process.def("init", &Py_VectorGameWrapper::init);
+  vector_game_process.def("reset", &Py_VectorGameWrapper::reset);
+
+  // Steps every environment from an int32 array of shape (envs, players, action_dims)
+  vector_game_process.def("step", &Py_VectorGameWrapper::step);
+
+  // Asynchronous stepping, recv returns the envs that finish first
+  vector_game_process.def("send", &Py_VectorGameWrapper::send);
+  vector_game_process.def("recv", &Py_VectorGameWrapper::recv);
+  vector_game_process.def("observe", &Py_VectorGameWrapper::observe);
+  vector_game_process.def("seed", &Py_VectorGameWrapper::seed);
+  vector_game_process.def("release", &Py_VectorGameWrapper::release);
+
   py::class_<Py_StepPlayerWrapper, std::shared_ptr<Py_StepPlayerWrapper>> player(m, "Player");
   player.def("step", &Py_StepPlayerWrapper::stepSingle);
   player.def("step_multi", &Py_StepPlayerWrapper::stepMulti);
@@ -133,5 +168,18 @@ PYBIND11_MODULE(python_griddly, m) {
       })
       .def("shape", &NumpyWrapper<uint8_t>::getShape)
       .def("strides", &NumpyWrapper<uint8_t>::getStrides);
+
+  py::class_<NumpyWrapper<int32_t>, std::shared_ptr<NumpyWrapper<int32_t>>>(m, "Int32Array", py::buffer_protocol())
+      .def_buffer([](NumpyWrapper<int32_t> &m) -> py::buffer_info {
+        return py::buffer_info(
+            &m.getData(),
+            m.getScalarSize(),
+            py::format_descriptor<int32_t>::format(),
+            m.getShape().size(),
+            m.getShape(),
+            m.getStrides());
+      })
+      .def("shape", &NumpyWrapper<int32_t>::getShape)
+      .def("strides", &NumpyWrapper<int32_t>::getStrides);
 }
 }  // namespace griddly
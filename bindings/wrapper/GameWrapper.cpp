@@ -1,3 +1,4 @@
+#include <pybind11/numpy.h>
 #include <spdlog/spdlog.h>
 
 #include "../../src/Griddly/Core/TurnBasedGameProcess.hpp"
@@ -129,6 +130,54 @@ class Py_GameWrapper {
     return valid_action_trees;
   }
 
+  std::vector<uint32_t> getActionMaskShape() const {
+    return gameProcess_->getActionMaskShape();
+  }
+
+  // Writes the valid actions of the player into a contiguous uint8 or bool array of get_action_mask_shape()
+  void writeActionMask(uint32_t playerId, py::buffer mask) const {
+    auto maskInfo = mask.request(true);
+    if (maskInfo.itemsize != 1) {
+      auto error = fmt::format("Invalid data type {0}, must be uint8 or bool.", maskInfo.format);
+      spdlog::error(error);
+      throw std::invalid_argument(error);
+    }
+
+    auto maskShape = gameProcess_->getActionMaskShape();
+    bool validShape = maskInfo.ndim == static_cast<py::ssize_t>(maskShape.size());
+    py::ssize_t expectedStride = 1;
+    for (int32_t d = static_cast<int32_t>(maskShape.size()) - 1; validShape && d >= 0; d--) {
+      validShape = maskInfo.shape[d] == maskShape[d] && maskInfo.strides[d] == expectedStride;
+      expectedStride *= maskShape[d];
+    }
+
+    if (!validShape) {
+      auto error = fmt::format("Invalid action mask, must be a contiguous array with shape ({0}, {1}, {2}).", maskShape[0], maskShape[1], maskShape[2]);
+      spdlog::error(error);
+      throw std::invalid_argument(error);
+    }
+
+    py::gil_scoped_release release;
+    gameProcess_->writeActionMask(playerId, static_cast<uint8_t*>(maskInfo.ptr));
+  }
+
+  // Updates the action masks of every player incrementally and returns a view of them, the view is only valid until the next update
+  py::object updateActionMasks() {
+    const std::vector<uint8_t>* masks;
+    {
+      py::gil_scoped_release release;
+      masks = &gameProcess_->updateActionMasks();
+    }
+    auto shape = gameProcess_->getActionMasksShape();
+
+    std::vector<uint32_t> strides(shape.size(), 1);
+    for (int32_t d = static_cast<int32_t>(shape.size()) - 2; d >= 0; d--) {
+      strides[d] = strides[d + 1] * shape[d + 1];
+    }
+
+    return py::cast(std::make_shared<NumpyWrapper<uint8_t>>(NumpyWrapper<uint8_t>(shape, strides, const_cast<uint8_t&>(*masks->data()))));
+  }
+
   py::dict getAvailableActionNames(int playerId) const {
     auto availableActionNames = gameProcess_->getAvailableActionNames(playerId);
 
@@ -273,6 +322,17 @@ class Py_GameWrapper {
     return py::make_tuple(playerRewards, terminated, info);
   }
 
+  // A copy of the rewards for player ids 1 to N that have not been collected by a step yet, the next step changes them
+  py::array getAccumulatedRewards() {
+    const auto& accumulatedRewards = gameProcess_->getAccumulatedRewards();
+    py::array_t<int32_t> rewards(playerCount_);
+    auto* rewardsData = rewards.mutable_data();
+    for (uint32_t p = 0; p < playerCount_; p++) {
+      rewardsData[p] = accumulatedRewards.get(p + 1);
+    }
+    return std::move(rewards);
+  }
+
   std::array<uint32_t, 2> getTileSize() const {
     auto vulkanObserver = std::dynamic_pointer_cast<VulkanObserver>(gameProcess_->getObserver());
     if (vulkanObserver == nullptr) {
@@ -287,6 +347,22 @@ class Py_GameWrapper {
     gameProcess_->getGrid()->enableHistory(enable);
   }
 
+  uint64_t getStateHash() const {
+    return gameProcess_->getGrid()->getStateHash();
+  }
+
+  void enableJournal(bool enable) {
+    gameProcess_->getGrid()->enableJournal(enable);
+  }
+
+  uint32_t checkpoint() {
+    return gameProcess_->getGrid()->checkpoint();
+  }
+
+  void rollback(uint32_t checkpointId) {
+    gameProcess_->rollback(checkpointId);
+  }
+
   uint32_t getWidth() const {
     return gameProcess_->getGrid()->getWidth();
   }
@@ -300,8 +376,8 @@ class Py_GameWrapper {
     gameProcess_->release();
   }
 
-  std::shared_ptr<Py_GameWrapper> clone() {
-    auto clonedGameProcess = gameProcess_->clone();
+  std::shared_ptr<Py_GameWrapper> clone(bool copyOnWrite) {
+    auto clonedGameProcess = gameProcess_->clone(copyOnWrite);
     auto clonedPyGameProcessWrapper = std::make_shared<Py_GameWrapper>(Py_GameWrapper(gdyFactory_, clonedGameProcess));
 
     return clonedPyGameProcessWrapper;
@@ -309,7 +385,11 @@ class Py_GameWrapper {
 
   py::dict getState() const {
     py::dict py_state;
-    auto state = gameProcess_->getState();
+    StateInfo state;
+    {
+      py::gil_scoped_release release;
+      state = gameProcess_->getState();
+    }
 
     py_state["GameTicks"] = state.gameTicks;
     py_state["Hash"] = state.hash;
@@ -386,7 +466,7 @@ class Py_GameWrapper {
         py::dict py_event;
 
         py::dict rewards;
-        for (auto& reward : historyEvent.rewards) {
+        for (const auto& reward : historyEvent.rewards) {
           rewards[py::cast(reward.first)] = reward.second;
         }
 
@@ -5,6 +5,7 @@
 #include <memory>
 
 #include "../../src/Griddly/Core/GDY/Objects/Object.hpp"
+#include "../../src/Griddly/Core/GDY/SymbolTable.hpp"
 #include "../../src/Griddly/Core/Observers/TensorObservationInterface.hpp"
 #include "../../src/Griddly/Core/Players/Player.hpp"
 #include "WrapperCommon.cpp"
@@ -16,6 +17,9 @@ class Py_StepPlayerWrapper {
  public:
   Py_StepPlayerWrapper(int playerId, std::string playerName, std::shared_ptr<Observer> observer, std::shared_ptr<GDYFactory> gdyFactory, std::shared_ptr<GameProcess> gameProcess)
       : player_(std::make_shared<Player>(Player(playerId, playerName, observer, gameProcess))), gdyFactory_(gdyFactory), gameProcess_(gameProcess) {
+    for (const auto& actionName : gdyFactory_->getExternalActionNames()) {
+      externalActionNameIds_.push_back(SymbolTable::actionNames().intern(actionName));
+    }
   }
 
   ~Py_StepPlayerWrapper() {
@@ -62,29 +66,27 @@ class Py_StepPlayerWrapper {
 
     std::vector<std::shared_ptr<Action>> actions;
     for (int a = 0; a < actionCount; a++) {
-      std::string actionName;
+      uint32_t actionNameIdx = 0;
       std::vector<int32_t> actionArray;
       auto pStr = (int32_t*)stepArrayInfo.ptr + a * actionStride;
 
       switch (actionSize) {
         case 1:
-          actionName = externalActionNames.at(0);
           actionArray.push_back(*(pStr + 0 * actionArrayStride));
           break;
         case 2:
-          actionName = externalActionNames.at(*(pStr + 0 * actionArrayStride));
+          actionNameIdx = *(pStr + 0 * actionArrayStride);
           actionArray.push_back(*(pStr + 1 * actionArrayStride));
           break;
         case 3:
           actionArray.push_back(*(pStr + 0 * actionArrayStride));
           actionArray.push_back(*(pStr + 1 * actionArrayStride));
-          actionName = externalActionNames.at(0);
           actionArray.push_back(*(pStr + 2 * actionArrayStride));
           break;
         case 4:
           actionArray.push_back(*(pStr + 0 * actionArrayStride));
           actionArray.push_back(*(pStr + 1 * actionArrayStride));
-          actionName = externalActionNames.at(*(pStr + 2 * actionArrayStride));
+          actionNameIdx = *(pStr + 2 * actionArrayStride);
           actionArray.push_back(*(pStr + 3 * actionArrayStride));
           break;
         default: {
@@ -94,13 +96,18 @@ class Py_StepPlayerWrapper {
         }
       }
 
-      auto action = buildAction(actionName, actionArray);
+      auto action = buildAction(externalActionNames.at(actionNameIdx), externalActionNameIds_.at(actionNameIdx), actionArray);
       if (action != nullptr) {
         actions.push_back(action);
       }
     }
 
-    auto actionResult = player_->performActions(actions, updateTicks);
+    ActionResult actionResult;
+    {
+      // Games only touch their own grid, so other python threads can step other games meanwhile
+      py::gil_scoped_release release;
+      actionResult = player_->performActions(actions, updateTicks);
+    }
     auto info = buildInfo(actionResult);
     auto rewards = gameProcess_->getAccumulatedRewards(player_->getId());
     return py::make_tuple(rewards, actionResult.terminated, info);
@@ -111,13 +118,16 @@ class Py_StepPlayerWrapper {
       throw std::invalid_argument("Cannot send player commands when game has not been initialized.");
     }
 
-    auto action = buildAction(actionName, actionArray);
+    auto action = buildAction(actionName, SymbolTable::actionNames().intern(actionName), actionArray);
 
     ActionResult actionResult;
-    if (action != nullptr) {
-      actionResult = player_->performActions({action}, updateTicks);
-    } else {
-      actionResult = player_->performActions({}, updateTicks);
+    {
+      py::gil_scoped_release release;
+      if (action != nullptr) {
+        actionResult = player_->performActions({action}, updateTicks);
+      } else {
+        actionResult = player_->performActions({}, updateTicks);
+      }
     }
 
     auto info = buildInfo(actionResult);
@@ -130,6 +140,9 @@ class Py_StepPlayerWrapper {
   const std::shared_ptr<GDYFactory> gdyFactory_;
   const std::shared_ptr<GameProcess> gameProcess_;
 
+  // Interned once so building an action each step does not look the name up again
+  std::vector<uint32_t> externalActionNameIds_;
+
   py::dict buildInfo(ActionResult actionResult) {
     py::dict py_info;
 
@@ -160,7 +173,7 @@ class Py_StepPlayerWrapper {
     return py_info;
   }
 
-  std::shared_ptr<Action> buildAction(std::string actionName, std::vector<int32_t> actionArray) {
+  std::shared_ptr<Action> buildAction(const std::string& actionName, uint32_t actionNameId, std::vector<int32_t> actionArray) {
     const auto& actionInputsDefinition = gdyFactory_->findActionInputsDefinition(actionName);
     auto playerAvatar = player_->getAvatar();
     auto playerId = player_->getId();
@@ -178,7 +191,7 @@ class Py_StepPlayerWrapper {
       const auto& vectorToDest = mapping.vectorToDest;
       const auto& orientationVector = mapping.orientationVector;
       const auto& metaData = mapping.metaData;
-      const auto& action = std::make_shared<Action>(Action(gameProcess_->getGrid(), actionName, playerId, 0, metaData));
+      const auto& action = gameProcess_->getGrid()->newAction(actionNameId, playerId, 0, metaData);
       action->init(playerAvatar, vectorToDest, orientationVector, actionInputsDefinition.relative);
 
       return action;
@@ -197,7 +210,7 @@ class Py_StepPlayerWrapper {
       const auto& metaData = mapping.metaData;
       glm::ivec2 destinationLocation = sourceLocation + vector;
 
-      auto action = std::make_shared<Action>(Action(gameProcess_->getGrid(), actionName, playerId, 0, metaData));
+      auto action = gameProcess_->getGrid()->newAction(actionNameId, playerId, 0, metaData);
       action->init(sourceLocation, destinationLocation);
 
       return action;
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <spdlog/spdlog.h>
+
+#include "../../src/Griddly/Core/VectorGameProcess.hpp"
+#include "NumpyWrapper.cpp"
+
+namespace py = pybind11;
+
+namespace griddly {
+
+class Py_VectorGameWrapper {
+ public:
+  Py_VectorGameWrapper(uint32_t numEnvs, std::string playerObserverName, uint32_t numThreads, bool pinThreads, std::shared_ptr<GDYFactory> gdyFactory)
+      : vectorGameProcess_(std::make_shared<VectorGameProcess>(numEnvs, gdyFactory, playerObserverName, numThreads, pinThreads)) {
+    spdlog::debug("Created vector game process wrapper with {0} environments on {1} threads", numEnvs, vectorGameProcess_->getNumThreads());
+  }
+
+  std::shared_ptr<VectorGameProcess> unwrapped() {
+    return vectorGameProcess_;
+  }
+
+  uint32_t getNumEnvs() const {
+    return vectorGameProcess_->getNumEnvs();
+  }
+
+  uint32_t getPlayerCount() const {
+    return vectorGameProcess_->getPlayerCount();
+  }
+
+  uint32_t getNumThreads() const {
+    return vectorGameProcess_->getNumThreads();
+  }
+
+  void loadLevel(uint32_t levelId) {
+    vectorGameProcess_->setLevel(levelId);
+  }
+
+  void init() {
+    py::gil_scoped_release release;
+    vectorGameProcess_->init();
+  }
+
+  py::object reset() {
+    {
+      py::gil_scoped_release release;
+      vectorGameProcess_->reset();
+    }
+    return wrapObservations();
+  }
+
+  py::tuple step(py::buffer stepArray) {
+    auto numEnvs = vectorGameProcess_->getNumEnvs();
+    auto stepArrayInfo = requestActionArray(stepArray, numEnvs);
+    auto actionSize = static_cast<uint32_t>(stepArrayInfo.shape[2]);
+
+    {
+      py::gil_scoped_release release;
+      vectorGameProcess_->step(static_cast<const int32_t*>(stepArrayInfo.ptr), actionSize);
+    }
+
+    return py::make_tuple(wrapObservations(), wrapRewards(), wrapDones());
+  }
+
+  void send(std::vector<uint32_t> envIds, py::buffer stepArray) {
+    auto stepArrayInfo = requestActionArray(stepArray, static_cast<uint32_t>(envIds.size()));
+    auto actionSize = static_cast<uint32_t>(stepArrayInfo.shape[2]);
+
+    py::gil_scoped_release release;
+    vectorGameProcess_->send(envIds.data(), static_cast<uint32_t>(envIds.size()), static_cast<const int32_t*>(stepArrayInfo.ptr), actionSize);
+  }
+
+  // Returns the ids of the finished envs, the buffers are shared by all envs so index them with the ids
+  py::tuple recv(uint32_t batchSize) {
+    std::vector<uint32_t> envIds;
+    {
+      py::gil_scoped_release release;
+      envIds = vectorGameProcess_->recv(batchSize);
+    }
+
+    return py::make_tuple(py::cast(envIds), wrapObservations(), wrapRewards(), wrapDones());
+  }
+
+  py::object observe() {
+    return wrapObservations();
+  }
+
+  void seed(uint32_t seed) {
+    for (uint32_t e = 0; e < vectorGameProcess_->getNumEnvs(); e++) {
+      vectorGameProcess_->getGameProcess(e)->seedRandomGenerator(seed + e);
+    }
+  }
+
+  void release() {
+    vectorGameProcess_->release();
+  }
+
+ private:
+  py::buffer_info requestActionArray(py::buffer stepArray, uint32_t envCount) {
+    auto stepArrayInfo = stepArray.request();
+    if (stepArrayInfo.format != py::format_descriptor<int32_t>::format()) {
+      auto error = fmt::format("Invalid data type {0}, must be int32.", stepArrayInfo.format);
+      spdlog::error(error);
+      throw std::invalid_argument(error);
+    }
+
+    auto playerCount = vectorGameProcess_->getPlayerCount();
+    if (stepArrayInfo.ndim != 3 || stepArrayInfo.shape[0] != envCount || stepArrayInfo.shape[1] != playerCount) {
+      auto error = fmt::format("Invalid action array, must have shape ({0}, {1}, action_dims).", envCount, playerCount);
+      spdlog::error(error);
+      throw std::invalid_argument(error);
+    }
+
+    auto actionSize = static_cast<uint32_t>(stepArrayInfo.shape[2]);
+    auto itemSize = static_cast<py::ssize_t>(sizeof(int32_t));
+    auto contiguousStrides = std::vector<py::ssize_t>{playerCount * actionSize * itemSize, actionSize * itemSize, itemSize};
+    if (stepArrayInfo.strides != contiguousStrides) {
+      auto error = "Action array must be C-contiguous.";
+      spdlog::error(error);
+      throw std::invalid_argument(error);
+    }
+
+    return stepArrayInfo;
+  }
+
+  // The returned arrays are views over the batch buffers and are overwritten by the next step or reset
+  py::object wrapObservations() {
+    auto numEnvs = vectorGameProcess_->getNumEnvs();
+    auto playerCount = vectorGameProcess_->getPlayerCount();
+    const auto& observationShape = vectorGameProcess_->getObservationShape();
+    const auto& observationStrides = vectorGameProcess_->getObservationStrides();
+
+    uint32_t observationSize = 1;
+    for (auto dim : observationShape) {
+      observationSize *= dim;
+    }
+
+    std::vector<uint32_t> shape{numEnvs, playerCount};
+    std::vector<uint32_t> strides{playerCount * observationSize, observationSize};
+    shape.insert(shape.end(), observationShape.begin(), observationShape.end());
+    strides.insert(strides.end(), observationStrides.begin(), observationStrides.end());
+
+    auto& observations = vectorGameProcess_->getObservations();
+    return py::cast(std::make_shared<NumpyWrapper<uint8_t>>(NumpyWrapper<uint8_t>(shape, strides, *observations.data())));
+  }
+
+  py::object wrapRewards() {
+    auto numEnvs = vectorGameProcess_->getNumEnvs();
+    auto playerCount = vectorGameProcess_->getPlayerCount();
+    auto& rewards = vectorGameProcess_->getRewards();
+    return py::cast(std::make_shared<NumpyWrapper<int32_t>>(NumpyWrapper<int32_t>({numEnvs, playerCount}, {playerCount * static_cast<uint32_t>(sizeof(int32_t)), sizeof(int32_t)}, *rewards.data())));
+  }
+
+  py::object wrapDones() {
+    auto& dones = vectorGameProcess_->getDones();
+    return py::cast(std::make_shared<NumpyWrapper<uint8_t>>(NumpyWrapper<uint8_t>({vectorGameProcess_->getNumEnvs()}, {1}, *dones.data())));
+  }
+
+  const std::shared_ptr<VectorGameProcess> vectorGameProcess_;
+};
+
+}  // namespace griddly
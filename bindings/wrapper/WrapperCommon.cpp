@@ -38,15 +38,24 @@ inline py::dict wrapEntityObservation(EntityObservations& entityObservations) {
   return entityObservation;
 }
 
+// Rendering the observation does not touch python objects, so the GIL is only held while wrapping it
 inline py::object wrapObservation(std::shared_ptr<Observer> observer) {
   if (observer->getObserverType() == ObserverType::ENTITY) {
     auto entityObserver = std::dynamic_pointer_cast<EntityObserver>(observer);
-    auto& observationData = entityObserver->update();
-    return wrapEntityObservation(observationData);
+    EntityObservations* observationData;
+    {
+      py::gil_scoped_release release;
+      observationData = &entityObserver->update();
+    }
+    return wrapEntityObservation(*observationData);
   } else {
     auto tensorObserver = std::dynamic_pointer_cast<TensorObservationInterface>(observer);
-    auto& observationData = tensorObserver->update();
-    return py::cast(std::make_shared<NumpyWrapper<uint8_t>>(NumpyWrapper<uint8_t>(tensorObserver->getShape(), tensorObserver->getStrides(), observationData)));
+    uint8_t* observationData;
+    {
+      py::gil_scoped_release release;
+      observationData = &tensorObserver->update();
+    }
+    return py::cast(std::make_shared<NumpyWrapper<uint8_t>>(NumpyWrapper<uint8_t>(tensorObserver->getShape(), tensorObserver->getStrides(), *observationData)));
   }
 }
 
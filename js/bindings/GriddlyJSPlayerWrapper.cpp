@@ -88,7 +88,7 @@ std::shared_ptr<griddly::Action> GriddlyJSPlayerWrapper::buildAction(std::string
     const auto& vectorToDest = mapping.vectorToDest;
     const auto& orientationVector = mapping.orientationVector;
     const auto& metaData = mapping.metaData;
-    const auto& action = std::make_shared<griddly::Action>(griddly::Action(gameProcess_->getGrid(), actionName, playerId, 0, metaData));
+    const auto& action = gameProcess_->getGrid()->newAction(actionName, playerId, 0, metaData);
     action->init(playerAvatar, vectorToDest, orientationVector, actionInputsDefinition.relative);
 
     return action;
@@ -107,7 +107,7 @@ std::shared_ptr<griddly::Action> GriddlyJSPlayerWrapper::buildAction(std::string
     const auto& metaData = mapping.metaData;
     glm::ivec2 destinationLocation = sourceLocation + vector;
 
-    auto action = std::make_shared<griddly::Action>(griddly::Action(gameProcess_->getGrid(), actionName, playerId, 0, metaData));
+    auto action = gameProcess_->getGrid()->newAction(actionName, playerId, 0, metaData);
     action->init(sourceLocation, destinationLocation);
 
     return action;
@@ -527,15 +527,16 @@ class GymWrapper(gym.Env):
 
         self._cache.action_space_parts.append(self.max_action_ids)
 
-    def clone(self):
+    def clone(self, copy_on_write=False):
         """
         Return an environment that is an executable copy of the current environment
+        :param copy_on_write: only copy the objects the clone reads or changes, observing the clone copies all of them
         :return:
         """
         return GymWrapper(
             level=self.level_id,
             gdy=self.gdy,
-            game=self.game.clone(),
+            game=self.game.clone(copy_on_write),
             global_observer_type=self._global_observer_type,
             player_observer_type=self._player_observer_type,
             player_last_observation=self._player_last_observation,
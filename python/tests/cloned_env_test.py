@@ -125,3 +125,36 @@ def test_clone_multi_agent_done(test_name):
     assert np.all(np.array(obs_2) == np.array(c_obs))
     assert np.all(reward_2 == c_reward)
     assert np.all(done_2 == c_done)
+
+
+def test_copy_on_write_random_trajectory_states(test_name):
+
+    env = gym.make(
+        "GDY-Sokoban-v0",
+        global_observer_type=gd.ObserverType.NONE,
+        player_observer_type=gd.ObserverType.NONE,
+    )
+    env.reset()
+    clone_env = env.clone(copy_on_write=True)
+
+    # The clone is stepped first so it still shares the objects of env
+    actions = [env.action_space.sample() for _ in range(1000)]
+
+    for action in actions:
+        c_obs, c_reward, c_done, c_info = clone_env.step(action)
+        obs, reward, done, info = env.step(action)
+
+        assert reward == c_reward
+        assert done == c_done
+        assert info == c_info
+
+        env_state = env.get_state()
+        cloned_state = clone_env.get_state()
+
+        assert (
+            env_state["Hash"] == cloned_state["Hash"]
+        ), f"state: {env_state}, cloned: {cloned_state}"
+
+        if done and c_done:
+            env.reset()
+            clone_env.reset()
@@ -1,7 +1,7 @@
 #include <spdlog/spdlog.h>
 
-#include <memory>
-#include <unordered_map>
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "AStarPathFinder.hpp"
@@ -12,54 +12,130 @@
 namespace griddly {
 
 AStarPathFinder::AStarPathFinder(std::shared_ptr<Grid> grid, std::set<std::string> impassableObjects, ActionInputsDefinition actionInputs, PathFinderMode mode)
-    : PathFinder(std::move(grid), std::move(impassableObjects), std::move(mode)), actionInputs_(std::move(std::move(actionInputs))) {
+    : PathFinder(std::move(grid), std::move(impassableObjects), mode), actionInputs_(std::move(actionInputs)) {
+  moves_.reserve(actionInputs_.inputMappings.size());
+  for (const auto& inputMapping : actionInputs_.inputMappings) {
+    const auto& mapping = inputMapping.second;
+    moves_.push_back({inputMapping.first, mapping.vectorToDest, mapping.orientationVector, glm::length(static_cast<glm::vec2>(mapping.vectorToDest))});
+  }
+}
+
+AStarPathFinder::SearchBuffers& AStarPathFinder::getSearchBuffers() {
+  thread_local SearchBuffers buffers;
+  return buffers;
+}
+
+uint32_t AStarPathFinder::getOrientationSlot(SearchBuffers& buffers, glm::ivec2 orientationVector) {
+  for (uint32_t slot = 0; slot < buffers.slotOrientations.size(); slot++) {
+    if (buffers.slotOrientations[slot] == orientationVector) {
+      return slot;
+    }
+  }
+
+  // Nodes of a new orientation are appended, so the indexes of existing nodes do not change
+  buffers.slotOrientations.push_back(orientationVector);
+  buffers.slotRotations.push_back(DiscreteOrientation(orientationVector).getRotationMatrix());
+  buffers.nodes.resize(std::max<size_t>(buffers.nodes.size(), 1 + buffers.slotOrientations.size() * buffers.cellCount));
+  return static_cast<uint32_t>(buffers.slotOrientations.size() - 1);
+}
+
+AStarPathFinder::Node& AStarPathFinder::getNode(SearchBuffers& buffers, uint32_t nodeIdx) {
+  auto& node = buffers.nodes[nodeIdx];
+  if (node.generation != buffers.generation) {
+    node = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), 0, NO_NODE, buffers.generation};
+  }
+  return node;
 }
 
-SearchOutput AStarPathFinder::reconstructPath(const std::shared_ptr<AStarPathNode>& currentBestNode) {
-  if (currentBestNode->parent == nullptr || currentBestNode->parent->parent == nullptr) {
-    return {currentBestNode->actionId};
+glm::ivec2 AStarPathFinder::getNodeLocation(const SearchBuffers& buffers, uint32_t nodeIdx) {
+  if (nodeIdx == 0) {
+    return buffers.startLocation;
   }
-  spdlog::debug("Reconstructing path: [{0},{1}]->[{2},{3}] actionId: {4}", currentBestNode->parent->location.x, currentBestNode->parent->location.y, currentBestNode->location.x, currentBestNode->location.y, currentBestNode->parent->actionId);
-  return reconstructPath(currentBestNode->parent);
+  auto cell = (nodeIdx - 1) % buffers.cellCount;
+  return {cell % buffers.width, cell / buffers.width};
+}
+
+uint32_t AStarPathFinder::getNodeSlot(const SearchBuffers& buffers, uint32_t nodeIdx) {
+  return nodeIdx == 0 ? buffers.startSlot : (nodeIdx - 1) / buffers.cellCount;
+}
 
-  return {0};
+void AStarPathFinder::pushOpenNode(SearchBuffers& buffers, uint32_t nodeIdx) {
+  const auto& nodes = buffers.nodes;
+  buffers.openNodes.push_back(nodeIdx);
+  std::push_heap(buffers.openNodes.begin(), buffers.openNodes.end(), [&nodes](uint32_t a, uint32_t b) {
+    return nodes[a].scoreFromStart > nodes[b].scoreFromStart;
+  });
+}
+
+void AStarPathFinder::popOpenNode(SearchBuffers& buffers) {
+  const auto& nodes = buffers.nodes;
+  std::pop_heap(buffers.openNodes.begin(), buffers.openNodes.end(), [&nodes](uint32_t a, uint32_t b) {
+    return nodes[a].scoreFromStart > nodes[b].scoreFromStart;
+  });
+  buffers.openNodes.pop_back();
+}
+
+SearchOutput AStarPathFinder::reconstructPath(const SearchBuffers& buffers, uint32_t nodeIdx) {
+  // The action to take is the one that leads from the start node to the first node on the path
+  while (buffers.nodes[nodeIdx].parent != NO_NODE && buffers.nodes[buffers.nodes[nodeIdx].parent].parent != NO_NODE) {
+    nodeIdx = buffers.nodes[nodeIdx].parent;
+  }
+  return {buffers.nodes[nodeIdx].actionId};
 }
 
 SearchOutput AStarPathFinder::search(glm::ivec2 startLocation, glm::ivec2 endLocation, glm::ivec2 startOrientationVector, uint32_t maxDepth) {
-  std::priority_queue<std::shared_ptr<AStarPathNode>, std::vector<std::shared_ptr<AStarPathNode>>, SortAStarPathNodes> orderedBestNodes;
-  std::unordered_map<glm::ivec4, std::shared_ptr<AStarPathNode>> nodes;
+  auto& buffers = getSearchBuffers();
+
+  const auto width = grid_->getWidth();
+  const auto height = grid_->getHeight();
+  if (buffers.width != width || buffers.cellCount != width * height) {
+    buffers.width = width;
+    buffers.cellCount = width * height;
+    buffers.nodes.resize(std::max<size_t>(buffers.nodes.size(), 1 + buffers.slotOrientations.size() * buffers.cellCount));
+  }
+
+  if (++buffers.generation == 0) {
+    for (auto& node : buffers.nodes) {
+      node.generation = 0;
+    }
+    buffers.generation = 1;
+  }
+
+  buffers.openNodes.clear();
+  buffers.startLocation = startLocation;
+  buffers.startSlot = getOrientationSlot(buffers, startOrientationVector);
 
   const float behaviourCoeff = mode_ == PathFinderMode::FLEE ? -1. : 1.;
 
-  auto startNode = std::make_shared<AStarPathNode>(AStarPathNode(startLocation, startOrientationVector));
-  startNode->scoreFromStart = behaviourCoeff * glm::distance(static_cast<glm::vec2>(endLocation), static_cast<glm::vec2>(startLocation));
-  startNode->scoreToGoal = 0;
-  orderedBestNodes.push(startNode);
+  auto& startNode = getNode(buffers, 0);
+  startNode.scoreFromStart = behaviourCoeff * glm::distance(static_cast<glm::vec2>(endLocation), static_cast<glm::vec2>(startLocation));
+  startNode.scoreToGoal = 0;
+  pushOpenNode(buffers, 0);
 
   uint32_t steps = 0;
 
-  auto currentBestNode = orderedBestNodes.top();
+  auto currentBestNodeIdx = buffers.openNodes.front();
 
-  while (!orderedBestNodes.empty()) {
-    orderedBestNodes.pop();
+  while (!buffers.openNodes.empty()) {
+    popOpenNode(buffers);
 
-    spdlog::trace("Current best node at location: [{0},{1}]. score: {2}, action: {3}", currentBestNode->location.x, currentBestNode->location.y, currentBestNode->scoreFromStart, currentBestNode->actionId);
+    const auto currentLocation = getNodeLocation(buffers, currentBestNodeIdx);
+    const auto currentScoreToGoal = buffers.nodes[currentBestNodeIdx].scoreToGoal;
 
-    if (currentBestNode->location == endLocation || steps >= maxDepth) {
-      return reconstructPath(currentBestNode);
-    }
+    spdlog::trace("Current best node at location: [{0},{1}]. score: {2}, action: {3}", currentLocation.x, currentLocation.y, buffers.nodes[currentBestNodeIdx].scoreFromStart, buffers.nodes[currentBestNodeIdx].actionId);
 
-    auto rotationMatrix = DiscreteOrientation(currentBestNode->orientationVector).getRotationMatrix();
+    if (currentLocation == endLocation || steps >= maxDepth) {
+      return reconstructPath(buffers, currentBestNodeIdx);
+    }
 
-    for (const auto& inputMapping : actionInputs_.inputMappings) {
-      const auto& actionId = inputMapping.first;
-      const auto& mapping = inputMapping.second;
+    const auto rotationMatrix = buffers.slotRotations[getNodeSlot(buffers, currentBestNodeIdx)];
 
-      const auto& vectorToDest = actionInputs_.relative ? mapping.vectorToDest * rotationMatrix : mapping.vectorToDest;
-      const auto& nextLocation = currentBestNode->location + vectorToDest;
-      const auto& nextOrientation = actionInputs_.relative ? mapping.orientationVector * rotationMatrix : mapping.orientationVector;
+    for (const auto& move : moves_) {
+      const auto vectorToDest = actionInputs_.relative ? move.vectorToDest * rotationMatrix : move.vectorToDest;
+      const auto nextLocation = currentLocation + vectorToDest;
+      const auto nextOrientation = actionInputs_.relative ? move.orientationVector * rotationMatrix : move.orientationVector;
 
-      if (nextLocation.y < 0 || nextLocation.y >= grid_->getHeight() || nextLocation.x < 0 || nextLocation.x >= grid_->getWidth()) {
+      if (nextLocation.y < 0 || nextLocation.y >= height || nextLocation.x < 0 || nextLocation.x >= width) {
         continue;
       }
 
@@ -67,50 +143,44 @@ SearchOutput AStarPathFinder::search(glm::ivec2 startLocation, glm::ivec2 endLoc
       const auto& objectsAtNextLocation = grid_->getObjectsAt(nextLocation);
       bool passable = true;
       for (const auto& object : objectsAtNextLocation) {
-        const auto& objectName = object.second->getObjectName();
-        if (impassableObjects_.find(objectName) != impassableObjects_.end()) {
+        if (isImpassable(object.second->getObjectNameId())) {
           passable = false;
           break;
         }
       }
 
-      if (passable) {
-        std::shared_ptr<AStarPathNode> neighbourNode;
-
-        const auto nodeKey = glm::ivec4(nextLocation, nextOrientation);
-
-        if (nodes.find(nodeKey) != nodes.end()) {
-          neighbourNode = nodes.at(nodeKey);
-        } else {
-          neighbourNode = std::make_shared<AStarPathNode>(AStarPathNode(nextLocation, nextOrientation));
-          nodes[nodeKey] = neighbourNode;
-        }
-
-        auto nextScoreToGoal = currentBestNode->scoreToGoal + glm::length(static_cast<glm::vec2>(mapping.vectorToDest));
+      if (!passable) {
+        continue;
+      }
 
-        if (nextScoreToGoal < neighbourNode->scoreToGoal) {
-          // We have found a better path
+      // Looking up the slot can grow the node buffer, so node references are only taken afterwards
+      auto slot = getOrientationSlot(buffers, nextOrientation);
+      auto neighbourNodeIdx = 1 + slot * buffers.cellCount + nextLocation.y * width + nextLocation.x;
+      auto& neighbourNode = getNode(buffers, neighbourNodeIdx);
 
-          // Set the action from the current best node to this node
-          neighbourNode->actionId = actionId;
-          neighbourNode->parent = currentBestNode;
-          currentBestNode->child = neighbourNode;
+      auto nextScoreToGoal = currentScoreToGoal + move.cost;
 
-          // Calculate the scores
-          neighbourNode->scoreToGoal = nextScoreToGoal;
-          neighbourNode->scoreFromStart = nextScoreToGoal + behaviourCoeff * glm::distance(static_cast<glm::vec2>(endLocation), static_cast<glm::vec2>(nextLocation));
+      if (nextScoreToGoal < neighbourNode.scoreToGoal) {
+        // We have found a better path
+        neighbourNode.actionId = move.actionId;
+        neighbourNode.parent = currentBestNodeIdx;
+        neighbourNode.scoreToGoal = nextScoreToGoal;
+        neighbourNode.scoreFromStart = nextScoreToGoal + behaviourCoeff * glm::distance(static_cast<glm::vec2>(endLocation), static_cast<glm::vec2>(nextLocation));
 
-          steps++;
-          spdlog::trace("New scores for location: [{0},{1}], scoreToGoal: {2}, scoreFromStart: {3}, action: {4}. Steps: {5}", nextLocation.x, nextLocation.y, neighbourNode->scoreToGoal, neighbourNode->scoreFromStart, actionId, steps);
-          orderedBestNodes.push(neighbourNode);
-        }
+        steps++;
+        spdlog::trace("New scores for location: [{0},{1}], scoreToGoal: {2}, scoreFromStart: {3}, action: {4}. Steps: {5}", nextLocation.x, nextLocation.y, neighbourNode.scoreToGoal, neighbourNode.scoreFromStart, move.actionId, steps);
+        pushOpenNode(buffers, neighbourNodeIdx);
       }
     }
 
-    currentBestNode = orderedBestNodes.top();
+    if (buffers.openNodes.empty()) {
+      break;
+    }
+
+    currentBestNodeIdx = buffers.openNodes.front();
   }
 
-  return reconstructPath(currentBestNode);
+  return reconstructPath(buffers, currentBestNodeIdx);
 }
 
-}  // namespace griddly
\ No newline at end of file
+}  // namespace griddly
@@ -1,6 +1,7 @@
 #pragma once
 
-#include "AStarPathNode.hpp"
+#include <vector>
+
 #include "GDY/Actions/Action.hpp"
 #include "Grid.hpp"
 #include "PathFinder.hpp"
@@ -8,24 +9,66 @@
 
 namespace griddly {
 
-struct SortAStarPathNodes {
-  bool operator()(const std::shared_ptr<AStarPathNode>& a, const std::shared_ptr<AStarPathNode>& b) {
-    return a->scoreFromStart > b->scoreFromStart;
-  };
-};
-
-
+/**
+ * A* over (location, orientation) states.
+ *
+ * Nodes are stored in flat arrays indexed by orientation, y and x, and the open set is a binary heap of node indices.
+ * The arrays are shared by every path finder on the same thread and are never cleared, each search bumps a generation
+ * counter and nodes from older generations are treated as unvisited.
+ */
 class AStarPathFinder : public PathFinder {
  public:
   AStarPathFinder(std::shared_ptr<Grid> grid, std::set<std::string> impassableObjects, ActionInputsDefinition actionInputs, PathFinderMode mode);
 
-  SearchOutput reconstructPath(const std::shared_ptr<AStarPathNode>& currentBestNode);
-
   SearchOutput search(glm::ivec2 startLocation, glm::ivec2 endLocation, glm::ivec2 startOrientationVector, uint32_t maxDepth) override;
 
  private:
-  const std::string targetAction_;
+  static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+  struct Move {
+    uint32_t actionId;
+    glm::ivec2 vectorToDest;
+    glm::ivec2 orientationVector;
+    float cost;
+  };
+
+  struct Node {
+    float scoreFromStart;
+    float scoreToGoal;
+    uint32_t actionId;
+    uint32_t parent;
+    uint32_t generation = 0;
+  };
+
+  // The start node is at index 0, every other node at 1 + orientationSlot * cellCount + y * width + x
+  struct SearchBuffers {
+    std::vector<Node> nodes;
+    std::vector<glm::ivec2> slotOrientations;
+    std::vector<glm::imat2x2> slotRotations;
+    std::vector<uint32_t> openNodes;
+    uint32_t generation = 0;
+    uint32_t width = 0;
+    uint32_t cellCount = 0;
+    glm::ivec2 startLocation{};
+    uint32_t startSlot = 0;
+  };
+
+  static SearchBuffers& getSearchBuffers();
+
+  static uint32_t getOrientationSlot(SearchBuffers& buffers, glm::ivec2 orientationVector);
+  static Node& getNode(SearchBuffers& buffers, uint32_t nodeIdx);
+  static glm::ivec2 getNodeLocation(const SearchBuffers& buffers, uint32_t nodeIdx);
+  static uint32_t getNodeSlot(const SearchBuffers& buffers, uint32_t nodeIdx);
+
+  static void pushOpenNode(SearchBuffers& buffers, uint32_t nodeIdx);
+  static void popOpenNode(SearchBuffers& buffers);
+
+  static SearchOutput reconstructPath(const SearchBuffers& buffers, uint32_t nodeIdx);
+
   const ActionInputsDefinition actionInputs_;
+
+  // The input mappings of the action, flattened so searching does not walk the hash map
+  std::vector<Move> moves_;
 };
 
 }  // namespace griddly
@@ -0,0 +1,288 @@
+#include "ActionMask.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "GDY/Actions/Action.hpp"
+
+namespace griddly {
+
+ActionMaskLayout::ActionMaskLayout(const std::shared_ptr<GDYFactory>& gdyFactory, const std::shared_ptr<Grid>& grid)
+    : externalActionNames_(gdyFactory->getExternalActionNames()),
+      hasAvatar_(!gdyFactory->getAvatarObject().empty()),
+      height_(grid->getHeight()),
+      unitCount_(hasAvatar_ ? 1 : grid->getWidth() * grid->getHeight()) {
+  const auto actionInputsDefinitions = gdyFactory->getActionInputsDefinitions();
+
+  actionTypeDefinitions_.reserve(externalActionNames_.size());
+  externalActionNameIds_.reserve(externalActionNames_.size());
+  for (const auto& actionName : externalActionNames_) {
+    externalActionNameIds_.push_back(SymbolTable::actionNames().intern(actionName));
+
+    auto actionInputsDefinitionIt = actionInputsDefinitions.find(actionName);
+    if (actionInputsDefinitionIt == actionInputsDefinitions.end()) {
+      actionTypeDefinitions_.emplace_back();
+      continue;
+    }
+
+    actionTypeDefinitions_.push_back(actionInputsDefinitionIt->second);
+    for (const auto& inputMapping : actionInputsDefinitionIt->second.inputMappings) {
+      actionIdCount_ = std::max(actionIdCount_, inputMapping.first + 1);
+    }
+  }
+}
+
+std::vector<uint32_t> ActionMaskLayout::getShape() const {
+  return {unitCount_, static_cast<uint32_t>(externalActionNames_.size()), actionIdCount_};
+}
+
+uint32_t ActionMaskLayout::getUnitCount() const {
+  return unitCount_;
+}
+
+uint32_t ActionMaskLayout::getUnitStride() const {
+  return static_cast<uint32_t>(externalActionNames_.size()) * actionIdCount_;
+}
+
+uint32_t ActionMaskLayout::getUnit(glm::ivec2 location) const {
+  return hasAvatar_ ? 0 : location.x * height_ + location.y;
+}
+
+glm::ivec2 ActionMaskLayout::getUnitLocation(uint32_t unit) const {
+  return {unit / height_, unit % height_};
+}
+
+bool ActionMaskLayout::hasAvatar() const {
+  return hasAvatar_;
+}
+
+void ActionMaskLayout::writeObjectMask(Grid& grid, const std::shared_ptr<Object>& object, uint8_t* unitMask, PreconditionCache& preconditionCache, std::vector<glm::ivec2>* destinationLocations) const {
+  preconditionCache.clear();
+  for (uint32_t actionType = 0; actionType < externalActionNames_.size(); actionType++) {
+    const auto& actionInputsDefinition = actionTypeDefinitions_[actionType];
+    auto* actionTypeMask = unitMask + actionType * actionIdCount_;
+
+    for (const auto& inputMapping : actionInputsDefinition.inputMappings) {
+      const auto& mapping = inputMapping.second;
+
+      auto potentialAction = grid.newAction(externalActionNameIds_[actionType], 0, 0, mapping.metaData);
+      potentialAction->init(object, mapping.vectorToDest, mapping.orientationVector, actionInputsDefinition.relative);
+
+      if (destinationLocations != nullptr) {
+        destinationLocations->push_back(potentialAction->getDestinationLocation());
+      }
+
+      if (object->isValidAction(potentialAction, preconditionCache)) {
+        actionTypeMask[inputMapping.first] = 1;
+        actionTypeMask[0] = 1;
+      }
+    }
+  }
+}
+
+ActionMaskTracker::ActionMaskTracker(std::shared_ptr<GDYFactory> gdyFactory, std::shared_ptr<Grid> grid)
+    : gdyFactory_(std::move(gdyFactory)), grid_(std::move(grid)) {
+  grid_->enableActionMaskTracking(true);
+}
+
+ActionMaskTracker::~ActionMaskTracker() {
+  grid_->enableActionMaskTracking(false);
+}
+
+void ActionMaskTracker::update() {
+  // Taken before recomputing, resolving objects on a copy-on-write clone can copy tiles, which records them as changed
+  const auto changes = grid_->getActionMaskChanges();
+  grid_->purgeActionMaskChanges();
+
+  if (changes.invalidated || layout_ == nullptr) {
+    recomputeAll();
+    return;
+  }
+
+  for (const auto& location : changes.locations) {
+    auto locationReadersIt = locationReaders_.find(location);
+    if (locationReadersIt != locationReaders_.end()) {
+      markReaders(locationReadersIt->second);
+    }
+
+    // Objects that have moved or been added here
+    for (const auto& objectIt : grid_->getObjectsAt(location)) {
+      markObjectUnit(objectIt.second);
+    }
+  }
+
+  for (const auto* variable : changes.variables) {
+    auto variableReadersIt = variableReaders_.find(variable);
+    if (variableReadersIt != variableReaders_.end()) {
+      markReaders(variableReadersIt->second);
+    }
+  }
+
+  recomputeMarkedUnits();
+}
+
+const std::vector<uint8_t>& ActionMaskTracker::getMasks() const {
+  return masks_;
+}
+
+std::vector<uint32_t> ActionMaskTracker::getShape() const {
+  auto shape = layout_->getShape();
+  shape.insert(shape.begin(), playerCount_);
+  return shape;
+}
+
+uint32_t ActionMaskTracker::getRecomputedUnitCount() const {
+  return recomputedUnitCount_;
+}
+
+void ActionMaskTracker::recomputeAll() {
+  layout_ = std::make_unique<ActionMaskLayout>(gdyFactory_, grid_);
+  playerCount_ = grid_->getPlayerCount();
+
+  auto unitKeyCount = playerCount_ * layout_->getUnitCount();
+  spdlog::debug("Recomputing all action masks for {0} players and {1} units", playerCount_, layout_->getUnitCount());
+
+  masks_.assign(unitKeyCount * layout_->getUnitStride(), 0);
+  unitReads_.assign(unitKeyCount, {});
+  locationReaders_.clear();
+  variableReaders_.clear();
+
+  markedUnits_.clear();
+  isMarked_.assign(unitKeyCount, false);
+
+  for (const auto& object : grid_->getObjects()) {
+    markObjectUnit(object);
+  }
+
+  recomputeMarkedUnits();
+}
+
+void ActionMaskTracker::markUnit(uint32_t unitKey) {
+  if (!isMarked_[unitKey]) {
+    isMarked_[unitKey] = true;
+    markedUnits_.push_back(unitKey);
+  }
+}
+
+void ActionMaskTracker::markObjectUnit(const std::shared_ptr<Object>& object) {
+  auto playerId = object->getPlayerId();
+  if (playerId == 0 || playerId > playerCount_) {
+    return;
+  }
+
+  markUnit((playerId - 1) * layout_->getUnitCount() + layout_->getUnit(object->getLocation()));
+}
+
+void ActionMaskTracker::markReaders(const std::vector<uint32_t>& unitKeys) {
+  for (auto unitKey : unitKeys) {
+    markUnit(unitKey);
+
+    // If an object changed owner, the unit of its new player has to be recomputed as well
+    if (!layout_->hasAvatar()) {
+      auto location = layout_->getUnitLocation(unitKey % layout_->getUnitCount());
+      for (const auto& objectIt : grid_->getObjectsAt(location)) {
+        markObjectUnit(objectIt.second);
+      }
+    }
+  }
+}
+
+void ActionMaskTracker::recomputeMarkedUnits() {
+  recomputedUnitCount_ = static_cast<uint32_t>(markedUnits_.size());
+
+  // Recomputing a unit changes the reader lists, so the marked units are copied out first
+  auto markedUnits = std::move(markedUnits_);
+  markedUnits_.clear();
+  for (auto unitKey : markedUnits) {
+    isMarked_[unitKey] = false;
+    recomputeUnit(unitKey);
+  }
+}
+
+void ActionMaskTracker::recomputeUnit(uint32_t unitKey) {
+  auto unitCount = layout_->getUnitCount();
+  auto unitStride = layout_->getUnitStride();
+  auto playerId = unitKey / unitCount + 1;
+
+  unregisterReads(unitKey);
+
+  auto* unitMask = masks_.data() + unitKey * unitStride;
+  std::fill(unitMask, unitMask + unitStride, 0);
+
+  auto& reads = unitReads_[unitKey];
+  reads.locations.clear();
+  reads.variables.clear();
+  preconditionCache_.variableReads = &reads.variables;
+
+  auto writeObjectMask = [&](const std::shared_ptr<Object>& object) {
+    if (object->getPlayerId() != playerId) {
+      return;
+    }
+
+    reads.locations.push_back(object->getLocation());
+    reads.variables.push_back(object->getVariableValue("_playerId").get());
+    layout_->writeObjectMask(*grid_, object, unitMask, preconditionCache_, &reads.locations);
+  };
+
+  if (layout_->hasAvatar()) {
+    for (const auto& object : grid_->getObjects()) {
+      writeObjectMask(object);
+    }
+  } else {
+    auto location = layout_->getUnitLocation(unitKey % unitCount);
+    reads.locations.push_back(location);
+    for (const auto& objectIt : grid_->getObjectsAt(location)) {
+      writeObjectMask(objectIt.second);
+    }
+  }
+
+  preconditionCache_.variableReads = nullptr;
+
+  registerReads(unitKey);
+}
+
+void ActionMaskTracker::registerReads(uint32_t unitKey) {
+  auto& reads = unitReads_[unitKey];
+
+  std::sort(reads.locations.begin(), reads.locations.end(), [](const glm::ivec2& a, const glm::ivec2& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+  });
+  reads.locations.erase(std::unique(reads.locations.begin(), reads.locations.end()), reads.locations.end());
+
+  std::sort(reads.variables.begin(), reads.variables.end());
+  reads.variables.erase(std::unique(reads.variables.begin(), reads.variables.end()), reads.variables.end());
+
+  for (const auto& location : reads.locations) {
+    locationReaders_[location].push_back(unitKey);
+  }
+
+  for (const auto* variable : reads.variables) {
+    variableReaders_[variable].push_back(unitKey);
+  }
+}
+
+void ActionMaskTracker::unregisterReads(uint32_t unitKey) {
+  const auto& reads = unitReads_[unitKey];
+
+  auto removeReader = [unitKey](std::vector<uint32_t>& readers) {
+    readers.erase(std::remove(readers.begin(), readers.end(), unitKey), readers.end());
+  };
+
+  for (const auto& location : reads.locations) {
+    auto locationReadersIt = locationReaders_.find(location);
+    if (locationReadersIt != locationReaders_.end()) {
+      removeReader(locationReadersIt->second);
+    }
+  }
+
+  for (const auto* variable : reads.variables) {
+    auto variableReadersIt = variableReaders_.find(variable);
+    if (variableReadersIt != variableReaders_.end()) {
+      removeReader(variableReadersIt->second);
+    }
+  }
+}
+
+}  // namespace griddly
@@ -0,0 +1,112 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "GDY/GDYFactory.hpp"
+#include "Grid.hpp"
+
+namespace griddly {
+
+/**
+ * The layout of a player's action mask: [units, action types, action ids].
+ * If players control an avatar there is a single unit, otherwise there is a unit for every location at index x * height + y.
+ */
+class ActionMaskLayout {
+ public:
+  ActionMaskLayout(const std::shared_ptr<GDYFactory>& gdyFactory, const std::shared_ptr<Grid>& grid);
+
+  std::vector<uint32_t> getShape() const;
+
+  uint32_t getUnitCount() const;
+
+  // The number of mask entries of a single unit
+  uint32_t getUnitStride() const;
+
+  uint32_t getUnit(glm::ivec2 location) const;
+
+  glm::ivec2 getUnitLocation(uint32_t unit) const;
+
+  bool hasAvatar() const;
+
+  // Marks every valid action of the object in the mask of its unit, action id 0 is marked whenever any other id of that type is valid.
+  // If destinationLocations is set, the destination of every action that was tested is appended to it
+  void writeObjectMask(Grid& grid, const std::shared_ptr<Object>& object, uint8_t* unitMask, PreconditionCache& preconditionCache, std::vector<glm::ivec2>* destinationLocations = nullptr) const;
+
+ private:
+  std::vector<std::string> externalActionNames_;
+  std::vector<uint32_t> externalActionNameIds_;
+
+  // The input definition of each action type, looked up once rather than for every object
+  std::vector<ActionInputsDefinition> actionTypeDefinitions_;
+
+  bool hasAvatar_;
+  uint32_t height_;
+  uint32_t unitCount_;
+  uint32_t actionIdCount_ = 1;
+};
+
+/**
+ * Keeps the action masks of every player up to date as the grid changes.
+ * While a unit is computed the tiles and variables its preconditions read are recorded. Each update only recomputes
+ * the units whose tiles or variables the grid has changed since the last update, so the cost scales with the number
+ * of changes rather than the number of objects.
+ */
+class ActionMaskTracker {
+ public:
+  ActionMaskTracker(std::shared_ptr<GDYFactory> gdyFactory, std::shared_ptr<Grid> grid);
+
+  virtual ~ActionMaskTracker();
+
+  virtual void update();
+
+  // The masks of every player: [players, units, action types, action ids], the player with id p is at index p - 1.
+  // The buffer is only reallocated if the shape changes when the grid is reset
+  const std::vector<uint8_t>& getMasks() const;
+
+  std::vector<uint32_t> getShape() const;
+
+  // The number of units recomputed by the last update
+  uint32_t getRecomputedUnitCount() const;
+
+ private:
+  struct UnitReads {
+    std::vector<glm::ivec2> locations;
+    std::vector<const int32_t*> variables;
+  };
+
+  void recomputeAll();
+
+  void markUnit(uint32_t unitKey);
+  void markObjectUnit(const std::shared_ptr<Object>& object);
+  void markReaders(const std::vector<uint32_t>& unitKeys);
+
+  void recomputeMarkedUnits();
+  void recomputeUnit(uint32_t unitKey);
+
+  void registerReads(uint32_t unitKey);
+  void unregisterReads(uint32_t unitKey);
+
+  const std::shared_ptr<GDYFactory> gdyFactory_;
+  const std::shared_ptr<Grid> grid_;
+
+  // Rebuilt whenever the grid is reset, as the size of the grid can change
+  std::unique_ptr<ActionMaskLayout> layout_;
+  uint32_t playerCount_ = 0;
+
+  std::vector<uint8_t> masks_;
+
+  // Indexed by unit key, (playerId - 1) * unitCount + unit
+  std::vector<UnitReads> unitReads_;
+  std::unordered_map<glm::ivec2, std::vector<uint32_t>> locationReaders_;
+  std::unordered_map<const int32_t*, std::vector<uint32_t>> variableReaders_;
+
+  std::vector<uint32_t> markedUnits_;
+  std::vector<bool> isMarked_;
+
+  PreconditionCache preconditionCache_;
+  uint32_t recomputedUnitCount_ = 0;
+};
+
+}  // namespace griddly
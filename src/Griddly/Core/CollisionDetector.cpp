@@ -1,9 +1,54 @@
 #include "CollisionDetector.hpp"
 
+#include <glm/gtx/quaternion.hpp>  // need this for length2 function
+#include <limits>
+
+#include "GDY/Objects/Object.hpp"
+
 namespace griddly {
 
 CollisionDetector::CollisionDetector(uint32_t gridWidth, uint32_t gridHeight, uint32_t range)
     : range_(range), gridWidth_(gridWidth), gridHeight_(gridHeight) {
 }
 
+bool CollisionDetector::upsert(std::shared_ptr<Object> object) {
+  auto location = object->getLocation();
+  return upsert(std::move(object), location);
+}
+
+uint32_t CollisionDetector::getRange() const {
+  return range_;
+}
+
+void CollisionDetector::searchObjects(glm::ivec2 location, std::vector<std::shared_ptr<Object>>& objects) {
+  forEachObject(location, [&objects](const std::shared_ptr<Object>& object) {
+    objects.push_back(object);
+  });
+}
+
+std::shared_ptr<Object> CollisionDetector::searchClosest(glm::ivec2 location) {
+  std::shared_ptr<Object> closestObject = nullptr;
+  auto closestDistance = std::numeric_limits<float>::max();
+
+  forEachObject(location, [&](const std::shared_ptr<Object>& object) {
+    auto distance = glm::length2(static_cast<glm::vec2>(object->getLocation() - location));
+    if (distance < closestDistance) {
+      closestDistance = distance;
+      closestObject = object;
+    }
+  });
+
+  return closestObject;
+}
+
+SearchResult CollisionDetector::search(glm::ivec2 location) {
+  SearchResult searchResult;
+  forEachObject(location, [&](const std::shared_ptr<Object>& object) {
+    auto distance = glm::length2(static_cast<glm::vec2>(object->getLocation() - location));
+    searchResult.objectSet.insert(object);
+    searchResult.closestObjects.push({distance, object});
+  });
+  return searchResult;
+}
+
 }  // namespace griddly
\ No newline at end of file
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <functional>
 #include <glm/glm.hpp>
 #include <memory>
-#include <unordered_set>
 #include <queue>
+#include <unordered_set>
+#include <vector>
 
 namespace griddly {
 
@@ -26,16 +28,34 @@ struct SearchResult {
   std::priority_queue<CollisionTarget, std::vector<CollisionTarget>, SortCollisionTargets> closestObjects;
 };
 
+using CollisionVisitor = std::function<void(const std::shared_ptr<Object>&)>;
+
 class CollisionDetector {
  public:
   CollisionDetector(uint32_t gridWidth, uint32_t gridHeight, uint32_t range);
   virtual ~CollisionDetector() = default;
 
-  virtual bool upsert(std::shared_ptr<Object> object) = 0;
+  bool upsert(std::shared_ptr<Object> object);
+
+  // For objects that are being moved to location but have not updated their own location yet
+  virtual bool upsert(std::shared_ptr<Object> object, glm::ivec2 location) = 0;
 
   virtual bool remove(std::shared_ptr<Object> object) = 0;
 
-  virtual SearchResult search(glm::ivec2 location) = 0;
+  // Calls the visitor with every object in range of the location, without copying any of the stored objects
+  virtual void forEachObject(glm::ivec2 location, const CollisionVisitor& visitor) = 0;
+
+  // Appends the objects in range of the location
+  virtual void searchObjects(glm::ivec2 location, std::vector<std::shared_ptr<Object>>& objects);
+
+  // The object in range that is closest to the location, or nullptr if there are none
+  virtual std::shared_ptr<Object> searchClosest(glm::ivec2 location);
+
+  // Collects the objects in range and orders them by distance
+  SearchResult search(glm::ivec2 location);
+
+  // Objects further than this from a location on either axis are never found by searching it
+  uint32_t getRange() const;
 
  protected:
   const uint32_t range_;
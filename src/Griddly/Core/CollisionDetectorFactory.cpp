@@ -1,10 +1,16 @@
 #include "CollisionDetectorFactory.hpp"
 
+#include "OccupancyGridCollisionDetector.hpp"
 #include "SpatialHashCollisionDetector.hpp"
 
 namespace griddly {
 
 std::shared_ptr<CollisionDetector> CollisionDetectorFactory::newCollisionDetector(uint32_t gridWidth, uint32_t gridHeight, ActionTriggerDefinition actionTriggerDefinition) {
+  // Small ranges only read a handful of cells, so indexing the grid directly beats hashing unless the grid is huge
+  if (actionTriggerDefinition.range <= MAX_OCCUPANCY_GRID_RANGE && gridWidth * gridHeight <= MAX_OCCUPANCY_GRID_CELLS) {
+    return std::make_shared<OccupancyGridCollisionDetector>(gridWidth, gridHeight, actionTriggerDefinition.range, actionTriggerDefinition.triggerType);
+  }
+
   // Calculate bucket size
   auto minDim = gridWidth > gridHeight ? gridWidth : gridHeight;
   uint32_t cellSize = 10;
@@ -10,6 +10,9 @@ struct ActionTriggerDefinition;
 
 class CollisionDetectorFactory {
  public:
+  static constexpr uint32_t MAX_OCCUPANCY_GRID_RANGE = 2;
+  static constexpr uint32_t MAX_OCCUPANCY_GRID_CELLS = 1 << 16;
+
   virtual ~CollisionDetectorFactory() = default;
   virtual std::shared_ptr<CollisionDetector> newCollisionDetector(uint32_t gridWidth, uint32_t gridHeight, ActionTriggerDefinition actionTriggerDefinition);
 };
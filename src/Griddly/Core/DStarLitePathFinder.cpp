@@ -0,0 +1,317 @@
+#include "DStarLitePathFinder.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "Grid.hpp"
+
+namespace griddly {
+
+namespace {
+constexpr float INF = std::numeric_limits<float>::infinity();
+}  // namespace
+
+DStarLitePathFinder::DStarLitePathFinder(std::shared_ptr<Grid> grid, std::set<std::string> impassableObjects, const ActionInputsDefinition& actionInputs, PathFinderMode mode)
+    : PathFinder(grid, impassableObjects, mode),
+      movingGoalPathFinder_(std::move(grid), std::move(impassableObjects), actionInputs, mode) {
+  for (const auto& inputMapping : actionInputs.inputMappings) {
+    const auto& vectorToDest = inputMapping.second.vectorToDest;
+    moves_.push_back({inputMapping.first, vectorToDest, glm::length(static_cast<glm::vec2>(vectorToDest))});
+  }
+
+  std::sort(moves_.begin(), moves_.end(), [](const Move& a, const Move& b) {
+    return a.actionId < b.actionId;
+  });
+
+  grid_->enableLocationChangeLog();
+}
+
+uint32_t DStarLitePathFinder::getExpandedCount() const {
+  return expandedCount_;
+}
+
+SearchOutput DStarLitePathFinder::search(glm::ivec2 startLocation, glm::ivec2 endLocation, glm::ivec2 startOrientationVector, uint32_t maxDepth) {
+  expandedCount_ = 0;
+
+  consecutiveGoalMoves_ = searched_ && endLocation != goal_ ? consecutiveGoalMoves_ + 1 : 0;
+  searched_ = true;
+
+  if (consecutiveGoalMoves_ >= MAX_CONSECUTIVE_GOAL_MOVES) {
+    goal_ = endLocation;
+    release();
+    return movingGoalPathFinder_.search(startLocation, endLocation, startOrientationVector, maxDepth);
+  }
+
+  changedLocations_.clear();
+  bool canRepair = initialized_ && width_ == grid_->getWidth() && height_ == grid_->getHeight() && grid_->getLocationChanges(changeIdx_, changedLocations_);
+  changeIdx_ = grid_->getLocationChangeCount();
+
+  if (!canRepair) {
+    initialize(startLocation, endLocation);
+  } else {
+    // Keys are relative to the start, so moving it lowers every key in the heap by at most the heuristic between the two starts
+    km_ += glm::distance(static_cast<glm::vec2>(start_), static_cast<glm::vec2>(startLocation));
+    start_ = startLocation;
+
+    if (endLocation != goal_) {
+      moveGoal(endLocation);
+    }
+
+    for (const auto& location : changedLocations_) {
+      updatePassability(location);
+    }
+  }
+
+  if (!isInBounds(start_) || !isInBounds(goal_) || start_ == goal_) {
+    return {0};
+  }
+
+  computeShortestPath();
+
+  // Follow the cheapest move from the start
+  uint32_t bestActionId = 0;
+  float bestCost = INF;
+  for (const auto& move : moves_) {
+    auto nextLocation = start_ + move.vectorToDest;
+    if (!canMoveTo(nextLocation)) {
+      continue;
+    }
+
+    auto cost = move.cost + g_[getCellIdx(nextLocation)];
+    if (cost < bestCost) {
+      bestCost = cost;
+      bestActionId = move.actionId;
+    }
+  }
+
+  spdlog::debug("D* Lite action from [{0},{1}] to [{2},{3}]: {4}, expanded {5} locations", start_.x, start_.y, goal_.x, goal_.y, bestActionId, expandedCount_);
+
+  return {bestActionId};
+}
+
+void DStarLitePathFinder::initialize(glm::ivec2 startLocation, glm::ivec2 endLocation) {
+  width_ = grid_->getWidth();
+  height_ = grid_->getHeight();
+  initialized_ = true;
+
+  start_ = startLocation;
+  goal_ = endLocation;
+  km_ = 0;
+
+  auto cellCount = width_ * height_;
+  g_.assign(cellCount, INF);
+  rhs_.assign(cellCount, INF);
+  passable_.assign(cellCount, 1);
+  isOpen_.assign(cellCount, 0);
+  openKeys_.resize(cellCount);
+  open_.clear();
+  openCount_ = 0;
+
+  for (uint32_t y = 0; y < height_; y++) {
+    for (uint32_t x = 0; x < width_; x++) {
+      passable_[y * width_ + x] = isImpassableAt(glm::ivec2(x, y)) ? 0 : 1;
+    }
+  }
+
+  if (isInBounds(goal_)) {
+    auto goalIdx = getCellIdx(goal_);
+    rhs_[goalIdx] = 0;
+    pushOpen(goalIdx);
+  }
+}
+
+void DStarLitePathFinder::release() {
+  if (!initialized_) {
+    return;
+  }
+
+  initialized_ = false;
+  std::vector<float>().swap(g_);
+  std::vector<float>().swap(rhs_);
+  std::vector<uint8_t>().swap(passable_);
+  std::vector<OpenEntry>().swap(open_);
+  std::vector<uint8_t>().swap(isOpen_);
+  std::vector<Key>().swap(openKeys_);
+  openCount_ = 0;
+}
+
+void DStarLitePathFinder::moveGoal(glm::ivec2 endLocation) {
+  auto previousGoal = goal_;
+  goal_ = endLocation;
+
+  // The goal can always be moved onto, so the moves into the previous and new goals change as well
+  if (isInBounds(previousGoal)) {
+    updateVertex(getCellIdx(previousGoal));
+    updatePredecessors(previousGoal);
+  }
+
+  if (isInBounds(goal_)) {
+    updateVertex(getCellIdx(goal_));
+    updatePredecessors(goal_);
+  }
+}
+
+void DStarLitePathFinder::updatePassability(glm::ivec2 location) {
+  if (!isInBounds(location)) {
+    return;
+  }
+
+  uint8_t passable = isImpassableAt(location) ? 0 : 1;
+  auto cellIdx = getCellIdx(location);
+  if (passable_[cellIdx] != passable) {
+    passable_[cellIdx] = passable;
+    updatePredecessors(location);
+  }
+}
+
+bool DStarLitePathFinder::isImpassableAt(glm::ivec2 location) const {
+  for (const auto& objectIt : grid_->getObjectsAt(location)) {
+    if (isImpassable(objectIt.second->getObjectNameId())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void DStarLitePathFinder::updatePredecessors(glm::ivec2 location) {
+  for (const auto& move : moves_) {
+    auto previousLocation = location - move.vectorToDest;
+    if (isInBounds(previousLocation)) {
+      updateVertex(getCellIdx(previousLocation));
+    }
+  }
+}
+
+void DStarLitePathFinder::updateVertex(uint32_t cellIdx) {
+  auto location = getCellLocation(cellIdx);
+
+  if (location == goal_) {
+    rhs_[cellIdx] = 0;
+  } else {
+    float rhs = INF;
+    for (const auto& move : moves_) {
+      auto nextLocation = location + move.vectorToDest;
+      if (canMoveTo(nextLocation)) {
+        rhs = std::min(rhs, move.cost + g_[getCellIdx(nextLocation)]);
+      }
+    }
+    rhs_[cellIdx] = rhs;
+  }
+
+  if (g_[cellIdx] != rhs_[cellIdx]) {
+    pushOpen(cellIdx);
+  } else if (isOpen_[cellIdx] != 0) {
+    isOpen_[cellIdx] = 0;
+    openCount_--;
+  }
+}
+
+DStarLitePathFinder::Key DStarLitePathFinder::calculateKey(uint32_t cellIdx) const {
+  auto minCost = std::min(g_[cellIdx], rhs_[cellIdx]);
+  return {minCost + heuristic(cellIdx) + km_, minCost};
+}
+
+float DStarLitePathFinder::heuristic(uint32_t cellIdx) const {
+  return glm::distance(static_cast<glm::vec2>(start_), static_cast<glm::vec2>(getCellLocation(cellIdx)));
+}
+
+void DStarLitePathFinder::computeShortestPath() {
+  auto startIdx = getCellIdx(start_);
+
+  while (peekOpen() && (open_.front().key < calculateKey(startIdx) || rhs_[startIdx] != g_[startIdx])) {
+    auto top = popOpen();
+    auto cellIdx = top.cellIdx;
+    auto newKey = calculateKey(cellIdx);
+    expandedCount_++;
+
+    if (top.key < newKey) {
+      pushOpen(cellIdx);
+    } else if (g_[cellIdx] > rhs_[cellIdx]) {
+      g_[cellIdx] = rhs_[cellIdx];
+      updatePredecessors(getCellLocation(cellIdx));
+    } else {
+      g_[cellIdx] = INF;
+      updateVertex(cellIdx);
+      updatePredecessors(getCellLocation(cellIdx));
+    }
+  }
+}
+
+bool DStarLitePathFinder::canMoveTo(glm::ivec2 location) const {
+  return isInBounds(location) && (passable_[getCellIdx(location)] != 0 || location == goal_);
+}
+
+bool DStarLitePathFinder::isInBounds(glm::ivec2 location) const {
+  return location.x >= 0 && location.y >= 0 && location.x < static_cast<int32_t>(width_) && location.y < static_cast<int32_t>(height_);
+}
+
+uint32_t DStarLitePathFinder::getCellIdx(glm::ivec2 location) const {
+  return location.y * width_ + location.x;
+}
+
+glm::ivec2 DStarLitePathFinder::getCellLocation(uint32_t cellIdx) const {
+  return {cellIdx % width_, cellIdx / width_};
+}
+
+bool DStarLitePathFinder::isLowerPriority(const OpenEntry& a, const OpenEntry& b) {
+  return b.key < a.key;
+}
+
+bool DStarLitePathFinder::isStale(const OpenEntry& entry) const {
+  return isOpen_[entry.cellIdx] == 0 || !(openKeys_[entry.cellIdx] == entry.key);
+}
+
+void DStarLitePathFinder::pushOpen(uint32_t cellIdx) {
+  auto key = calculateKey(cellIdx);
+  if (isOpen_[cellIdx] != 0) {
+    if (openKeys_[cellIdx] == key) {
+      return;
+    }
+  } else {
+    isOpen_[cellIdx] = 1;
+    openCount_++;
+  }
+
+  openKeys_[cellIdx] = key;
+  open_.push_back({key, cellIdx});
+  std::push_heap(open_.begin(), open_.end(), isLowerPriority);
+
+  if (open_.size() > MIN_COMPACT_OPEN_SIZE && open_.size() > 2 * openCount_) {
+    compactOpen();
+  }
+}
+
+void DStarLitePathFinder::compactOpen() {
+  open_.erase(std::remove_if(open_.begin(), open_.end(), [this](const OpenEntry& entry) { return isStale(entry); }), open_.end());
+  std::make_heap(open_.begin(), open_.end(), isLowerPriority);
+}
+
+size_t DStarLitePathFinder::getOpenSize() const {
+  return open_.size();
+}
+
+bool DStarLitePathFinder::peekOpen() {
+  while (!open_.empty()) {
+    if (!isStale(open_.front())) {
+      return true;
+    }
+
+    std::pop_heap(open_.begin(), open_.end(), isLowerPriority);
+    open_.pop_back();
+  }
+  return false;
+}
+
+DStarLitePathFinder::OpenEntry DStarLitePathFinder::popOpen() {
+  std::pop_heap(open_.begin(), open_.end(), isLowerPriority);
+  auto entry = open_.back();
+  open_.pop_back();
+  isOpen_[entry.cellIdx] = 0;
+  openCount_--;
+  return entry;
+}
+
+}  // namespace griddly
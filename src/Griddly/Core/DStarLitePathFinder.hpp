@@ -0,0 +1,123 @@
+#pragma once
+
+#include <vector>
+
+#include "AStarPathFinder.hpp"
+#include "GDY/Actions/Action.hpp"
+#include "PathFinder.hpp"
+
+namespace griddly {
+
+/**
+ * An incremental planner based on D* Lite, searching backwards from the target so the searching object can move freely.
+ *
+ * The search is kept between calls and repaired from the locations the grid reports as changed, so replanning after a
+ * few tiles have changed, or the searching object or its target have moved, only revisits the affected part of the search.
+ * A target that moves on consecutive searches invalidates most of the search every time, so it is searched with A* and the
+ * search is released until the target stops again. Only supports SEEK with actions that are not relative to the orientation of the object.
+ */
+class DStarLitePathFinder : public PathFinder {
+ public:
+  DStarLitePathFinder(std::shared_ptr<Grid> grid, std::set<std::string> impassableObjects, const ActionInputsDefinition& actionInputs, PathFinderMode mode);
+
+  // The search depth is only used by A*, a search that is repaired rather than restarted is not bounded by it
+  SearchOutput search(glm::ivec2 startLocation, glm::ivec2 endLocation, glm::ivec2 startOrientationVector, uint32_t maxDepth) override;
+
+  // The number of locations expanded by the last search, zero if it was searched with A*
+  uint32_t getExpandedCount() const;
+
+  // The number of entries in the heap, including the stale ones that have not been dropped yet
+  size_t getOpenSize() const;
+
+ private:
+  struct Move {
+    uint32_t actionId;
+    glm::ivec2 vectorToDest;
+    float cost;
+  };
+
+  struct Key {
+    float primary;
+    float secondary;
+
+    bool operator<(const Key& other) const {
+      return primary < other.primary || (primary == other.primary && secondary < other.secondary);
+    }
+
+    bool operator==(const Key& other) const {
+      return primary == other.primary && secondary == other.secondary;
+    }
+  };
+
+  struct OpenEntry {
+    Key key;
+    uint32_t cellIdx;
+  };
+
+  // Searching with A* after this many consecutive moves of the target
+  static constexpr uint32_t MAX_CONSECUTIVE_GOAL_MOVES = 2;
+
+  // The heap is not rebuilt until it holds at least this many entries
+  static constexpr size_t MIN_COMPACT_OPEN_SIZE = 64;
+
+  void initialize(glm::ivec2 startLocation, glm::ivec2 endLocation);
+  void release();
+  void moveGoal(glm::ivec2 endLocation);
+  void updatePassability(glm::ivec2 location);
+  bool isImpassableAt(glm::ivec2 location) const;
+
+  void updatePredecessors(glm::ivec2 location);
+  void updateVertex(uint32_t cellIdx);
+  Key calculateKey(uint32_t cellIdx) const;
+  float heuristic(uint32_t cellIdx) const;
+  void computeShortestPath();
+
+  bool canMoveTo(glm::ivec2 location) const;
+  bool isInBounds(glm::ivec2 location) const;
+  uint32_t getCellIdx(glm::ivec2 location) const;
+  glm::ivec2 getCellLocation(uint32_t cellIdx) const;
+
+  static bool isLowerPriority(const OpenEntry& a, const OpenEntry& b);
+  bool isStale(const OpenEntry& entry) const;
+  void pushOpen(uint32_t cellIdx);
+
+  // Drops every stale entry and rebuilds the heap
+  void compactOpen();
+
+  // Discards stale entries from the top of the heap, returns false if there are no open cells left
+  bool peekOpen();
+  OpenEntry popOpen();
+
+  // Sorted by action id, so ties between equally good moves are broken the same way every time
+  std::vector<Move> moves_;
+
+  AStarPathFinder movingGoalPathFinder_;
+  bool searched_ = false;
+  uint32_t consecutiveGoalMoves_ = 0;
+
+  bool initialized_ = false;
+  uint32_t width_ = 0;
+  uint32_t height_ = 0;
+  uint64_t changeIdx_ = 0;
+  std::vector<glm::ivec2> changedLocations_;
+
+  glm::ivec2 start_{};
+  glm::ivec2 goal_{};
+  float km_ = 0;
+
+  // Indexed by y * width + x
+  std::vector<float> g_;
+  std::vector<float> rhs_;
+  std::vector<uint8_t> passable_;
+
+  // Entries are not removed from the heap, entries whose key no longer matches the open key of their cell are skipped
+  // and the heap is compacted once they outnumber the open cells
+  std::vector<OpenEntry> open_;
+  std::vector<uint8_t> isOpen_;
+  std::vector<Key> openKeys_;
+  size_t openCount_ = 0;
+
+  uint32_t expandedCount_ = 0;
+};
+
+}  // namespace griddly
@@ -0,0 +1,118 @@
+#include "DelayedActionQueue.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace griddly {
+
+DelayedActionQueue::DelayedActionQueue(uint32_t slots) {
+  uint32_t slotCount = 1;
+  while (slotCount < slots) {
+    slotCount <<= 1;
+  }
+
+  slots_.resize(slotCount);
+  slotMask_ = slotCount - 1;
+}
+
+DelayedActionQueue::Slot& DelayedActionQueue::getSlot(uint32_t tick) {
+  return slots_[tick & slotMask_];
+}
+
+void DelayedActionQueue::push(DelayedActionQueueItem item) {
+  // Ticks can go backwards when grids are rolled back or have their tick count set
+  nextTick_ = std::min(nextTick_, item.priority);
+  getSlot(item.priority).push_back(std::move(item));
+  size_++;
+}
+
+void DelayedActionQueue::popDue(uint32_t tick, std::vector<DelayedActionQueueItem>& dueItems) {
+  if (size_ == 0 || tick < nextTick_) {
+    nextTick_ = std::max(nextTick_, tick + 1);
+    return;
+  }
+
+  if (tick - nextTick_ < slots_.size()) {
+    // Each slot holds a single tick of the window, so popping slot by slot keeps the actions in tick order
+    for (auto t = nextTick_; t <= tick && size_ > 0; t++) {
+      popDueFromSlot(getSlot(t), tick, dueItems);
+    }
+  } else {
+    auto firstDueItem = dueItems.size();
+    for (auto& slot : slots_) {
+      popDueFromSlot(slot, tick, dueItems);
+    }
+    std::stable_sort(dueItems.begin() + firstDueItem, dueItems.end(), [](const DelayedActionQueueItem& a, const DelayedActionQueueItem& b) {
+      return a.priority < b.priority;
+    });
+  }
+
+  nextTick_ = tick + 1;
+}
+
+void DelayedActionQueue::popDueFromSlot(Slot& slot, uint32_t tick, std::vector<DelayedActionQueueItem>& dueItems) {
+  auto keepIt = slot.begin();
+  for (auto& item : slot) {
+    if (item.priority <= tick) {
+      dueItems.push_back(std::move(item));
+      size_--;
+    } else {
+      if (&*keepIt != &item) {
+        *keepIt = std::move(item);
+      }
+      ++keepIt;
+    }
+  }
+  slot.erase(keepIt, slot.end());
+}
+
+bool DelayedActionQueue::remove(uint32_t priority, const Action* action, DelayedActionQueueItem* removedItem) {
+  auto& slot = getSlot(priority);
+  auto itemIt = std::find_if(slot.begin(), slot.end(), [priority, action](const DelayedActionQueueItem& queuedItem) {
+    return queuedItem.action.get() == action && queuedItem.priority == priority;
+  });
+
+  if (itemIt == slot.end()) {
+    return false;
+  }
+
+  if (removedItem != nullptr) {
+    *removedItem = std::move(*itemIt);
+  }
+  slot.erase(itemIt);
+  size_--;
+  return true;
+}
+
+void DelayedActionQueue::restore(DelayedActionQueueItem item) {
+  nextTick_ = std::min(nextTick_, item.priority);
+  auto& slot = getSlot(item.priority);
+  slot.insert(slot.begin(), std::move(item));
+  size_++;
+}
+
+void DelayedActionQueue::clear() {
+  for (auto& slot : slots_) {
+    slot.clear();
+  }
+  nextTick_ = 0;
+  size_ = 0;
+}
+
+size_t DelayedActionQueue::size() const {
+  return size_;
+}
+
+bool DelayedActionQueue::empty() const {
+  return size_ == 0;
+}
+
+DelayedActionQueue::const_iterator DelayedActionQueue::begin() const {
+  return {slots_, 0};
+}
+
+DelayedActionQueue::const_iterator DelayedActionQueue::end() const {
+  return {slots_, slots_.size()};
+}
+
+}  // namespace griddly
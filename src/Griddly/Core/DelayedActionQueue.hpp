@@ -0,0 +1,112 @@
+#pragma once
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "DelayedActionQueueItem.hpp"
+
+namespace griddly {
+
+/**
+ * A timing wheel of delayed actions keyed by the tick they are executed at.
+ * Each tick maps to one of a fixed number of slots, so pushing an action and popping the actions of a tick do not
+ * depend on how many actions are queued. Actions further away than the size of the wheel share a slot with nearer
+ * ones and are skipped until their tick comes round. Slots keep their capacity, so a game that keeps scheduling
+ * actions stops allocating once the wheel has warmed up.
+ *
+ * Actions due on the same tick are popped in the order they were pushed.
+ */
+class DelayedActionQueue {
+ public:
+  using value_type = DelayedActionQueueItem;
+  using Slot = std::vector<DelayedActionQueueItem>;
+
+  static constexpr uint32_t DEFAULT_SLOTS = 256;
+
+  // Iterates every queued action without copying, in no particular order
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = DelayedActionQueueItem;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const DelayedActionQueueItem*;
+    using reference = const DelayedActionQueueItem&;
+
+    const_iterator(const std::vector<Slot>& slots, size_t slotIdx) : slots_(&slots), slotIdx_(slotIdx) {
+      skipEmptySlots();
+    }
+
+    const DelayedActionQueueItem& operator*() const {
+      return (*slots_)[slotIdx_][itemIdx_];
+    }
+
+    const DelayedActionQueueItem* operator->() const {
+      return &(*slots_)[slotIdx_][itemIdx_];
+    }
+
+    const_iterator& operator++() {
+      itemIdx_++;
+      skipEmptySlots();
+      return *this;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return slotIdx_ == other.slotIdx_ && itemIdx_ == other.itemIdx_;
+    }
+
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    void skipEmptySlots() {
+      while (slotIdx_ < slots_->size() && itemIdx_ >= (*slots_)[slotIdx_].size()) {
+        slotIdx_++;
+        itemIdx_ = 0;
+      }
+    }
+
+    const std::vector<Slot>* slots_;
+    size_t slotIdx_;
+    size_t itemIdx_ = 0;
+  };
+
+  // The number of slots is rounded up to a power of two
+  explicit DelayedActionQueue(uint32_t slots = DEFAULT_SLOTS);
+
+  void push(DelayedActionQueueItem item);
+
+  // Appends every action due at or before the tick to dueItems and removes them from the queue
+  void popDue(uint32_t tick, std::vector<DelayedActionQueueItem>& dueItems);
+
+  // Removes a queued action, returns false if it is not in the queue. If removedItem is set the removed item is moved into it
+  bool remove(uint32_t priority, const Action* action, DelayedActionQueueItem* removedItem = nullptr);
+
+  // Puts a popped action back in front of the actions due on the same tick, so undoing pops restores their order
+  void restore(DelayedActionQueueItem item);
+
+  void clear();
+
+  size_t size() const;
+
+  bool empty() const;
+
+  const_iterator begin() const;
+
+  const_iterator end() const;
+
+ private:
+  Slot& getSlot(uint32_t tick);
+
+  // Moves the due actions of a slot to dueItems, keeping the order of the rest
+  void popDueFromSlot(Slot& slot, uint32_t tick, std::vector<DelayedActionQueueItem>& dueItems);
+
+  std::vector<Slot> slots_;
+  uint32_t slotMask_;
+
+  // Every queued action is due at or after this tick
+  uint32_t nextTick_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace griddly
@@ -1,27 +1,23 @@
 #pragma once
+#include <cstdint>
 #include <memory>
-#include <queue>
-#include "Util/util.hpp"
 
 namespace griddly {
 
 class Action;
+class Object;
 
 class DelayedActionQueueItem {
  public:
-  DelayedActionQueueItem(uint32_t _playerId, uint32_t _priority, std::shared_ptr<Action> _action);
+  DelayedActionQueueItem() = default;
+  DelayedActionQueueItem(uint32_t _playerId, uint32_t _priority, std::shared_ptr<Action> _action, std::shared_ptr<Object> _sourceObject = nullptr);
 
-  uint32_t playerId;
-  uint32_t priority;
-  std::shared_ptr<Action> action;
+  uint32_t playerId = 0;
+  // The game tick the action is executed at
+  uint32_t priority = 0;
+  std::shared_ptr<Action> action = nullptr;
+  // The grid object whose pending delayed actions index this action, if any
+  std::shared_ptr<Object> sourceObject = nullptr;
 };
 
-struct SortDelayedActionQueue {
-  bool operator()(const std::shared_ptr<DelayedActionQueueItem>& a, const std::shared_ptr<DelayedActionQueueItem>& b) {
-    return a->priority > b->priority;
-  };
-};
-
-using DelayedActionQueue = VectorPriorityQueue<std::shared_ptr<DelayedActionQueueItem>, std::vector<std::shared_ptr<DelayedActionQueueItem> >, SortDelayedActionQueue>;
-
-}  // namespace griddly
\ No newline at end of file
+}  // namespace griddly
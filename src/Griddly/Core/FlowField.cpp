@@ -0,0 +1,131 @@
+#include "FlowField.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "GDY/SymbolTable.hpp"
+#include "Grid.hpp"
+
+namespace griddly {
+
+FlowField::FlowField(const std::string& targetObjectName, const std::set<std::string>& impassableObjects, std::vector<glm::ivec2> moveVectors)
+    : targetObjectNameId_(SymbolTable::objectNames().intern(targetObjectName)), moveVectors_(std::move(moveVectors)) {
+  for (const auto& impassableObject : impassableObjects) {
+    impassableObjectNameIds_.push_back(SymbolTable::objectNames().intern(impassableObject));
+  }
+  objectNameVersions_.resize(1 + impassableObjectNameIds_.size());
+}
+
+std::string FlowField::getKey(const std::string& actionName, const std::string& targetObjectName, const std::set<std::string>& impassableObjects) {
+  auto key = actionName + ":" + targetObjectName;
+  for (const auto& impassableObject : impassableObjects) {
+    key += ":" + impassableObject;
+  }
+  return key;
+}
+
+void FlowField::update(const Grid& grid) {
+  if (isOutdated(grid)) {
+    compute(grid);
+  }
+}
+
+uint32_t FlowField::getDistance(glm::ivec2 location) const {
+  if (location.x < 0 || location.y < 0 || location.x >= static_cast<int32_t>(width_) || location.y >= static_cast<int32_t>(height_)) {
+    return UNREACHABLE;
+  }
+  return distances_[location.y * width_ + location.x];
+}
+
+bool FlowField::isPassable(glm::ivec2 location) const {
+  if (location.x < 0 || location.y < 0 || location.x >= static_cast<int32_t>(width_) || location.y >= static_cast<int32_t>(height_)) {
+    return false;
+  }
+  return passable_[location.y * width_ + location.x] != 0;
+}
+
+uint32_t FlowField::getComputeCount() const {
+  return computeCount_;
+}
+
+bool FlowField::isOutdated(const Grid& grid) const {
+  if (!computed_ || width_ != grid.getWidth() || height_ != grid.getHeight()) {
+    return true;
+  }
+
+  if (computedTick_ == *grid.getTickCount()) {
+    return false;
+  }
+
+  if (objectNameVersions_[0] != grid.getObjectNameVersion(targetObjectNameId_)) {
+    return true;
+  }
+
+  for (size_t i = 0; i < impassableObjectNameIds_.size(); i++) {
+    if (objectNameVersions_[i + 1] != grid.getObjectNameVersion(impassableObjectNameIds_[i])) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void FlowField::compute(const Grid& grid) {
+  width_ = grid.getWidth();
+  height_ = grid.getHeight();
+  computedTick_ = *grid.getTickCount();
+  computed_ = true;
+  computeCount_++;
+
+  objectNameVersions_[0] = grid.getObjectNameVersion(targetObjectNameId_);
+  for (size_t i = 0; i < impassableObjectNameIds_.size(); i++) {
+    objectNameVersions_[i + 1] = grid.getObjectNameVersion(impassableObjectNameIds_[i]);
+  }
+
+  spdlog::debug("Computing flow field for object {0}", SymbolTable::objectNames().getName(targetObjectNameId_));
+
+  auto cellCount = width_ * height_;
+  distances_.assign(cellCount, UNREACHABLE);
+  passable_.assign(cellCount, 1);
+  frontier_.clear();
+
+  for (uint32_t y = 0; y < height_; y++) {
+    for (uint32_t x = 0; x < width_; x++) {
+      auto cellIdx = y * width_ + x;
+      for (const auto& objectIt : grid.getObjectsAt(glm::ivec2(x, y))) {
+        auto objectNameId = objectIt.second->getObjectNameId();
+        if (std::find(impassableObjectNameIds_.begin(), impassableObjectNameIds_.end(), objectNameId) != impassableObjectNameIds_.end()) {
+          passable_[cellIdx] = 0;
+        }
+        if (objectNameId == targetObjectNameId_ && distances_[cellIdx] != 0) {
+          distances_[cellIdx] = 0;
+          frontier_.push_back(cellIdx);
+        }
+      }
+    }
+  }
+
+  // Breadth first from every target at once, walking each move backwards to find the locations it can be made from
+  for (size_t frontierIdx = 0; frontierIdx < frontier_.size(); frontierIdx++) {
+    auto cellIdx = frontier_[frontierIdx];
+    auto location = glm::ivec2(cellIdx % width_, cellIdx / width_);
+    auto nextDistance = distances_[cellIdx] + 1;
+
+    for (const auto& moveVector : moveVectors_) {
+      auto previousLocation = location - moveVector;
+      if (previousLocation.x < 0 || previousLocation.y < 0 || previousLocation.x >= static_cast<int32_t>(width_) || previousLocation.y >= static_cast<int32_t>(height_)) {
+        continue;
+      }
+
+      auto previousCellIdx = previousLocation.y * width_ + previousLocation.x;
+      if (passable_[previousCellIdx] != 0 && distances_[previousCellIdx] == UNREACHABLE) {
+        distances_[previousCellIdx] = nextDistance;
+        frontier_.push_back(previousCellIdx);
+      }
+    }
+  }
+}
+
+}  // namespace griddly
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace griddly {
+
+class Grid;
+
+/**
+ * The number of moves from every location in the grid to the closest object of a target type, avoiding impassable objects.
+ *
+ * A single field is shared by every object that searches for the same target with the same actions, so hundreds of units
+ * cost a single breadth first search. The field is recomputed at most once per tick, and only if an object of the target
+ * type or an impassable type has been added, removed or moved since it was last computed.
+ */
+class FlowField {
+ public:
+  static constexpr uint32_t UNREACHABLE = std::numeric_limits<uint32_t>::max();
+
+  FlowField(const std::string& targetObjectName, const std::set<std::string>& impassableObjects, std::vector<glm::ivec2> moveVectors);
+
+  virtual ~FlowField() = default;
+
+  // Recomputes the field if it is out of date
+  virtual void update(const Grid& grid);
+
+  virtual uint32_t getDistance(glm::ivec2 location) const;
+
+  virtual bool isPassable(glm::ivec2 location) const;
+
+  // The number of times the field has been computed
+  uint32_t getComputeCount() const;
+
+  static std::string getKey(const std::string& actionName, const std::string& targetObjectName, const std::set<std::string>& impassableObjects);
+
+ private:
+  bool isOutdated(const Grid& grid) const;
+  void compute(const Grid& grid);
+
+  const uint32_t targetObjectNameId_;
+  std::vector<uint32_t> impassableObjectNameIds_;
+  const std::vector<glm::ivec2> moveVectors_;
+
+  // The version of each object name the field was computed from, the target first, see Grid::getObjectNameVersion
+  std::vector<uint64_t> objectNameVersions_;
+  int32_t computedTick_ = -1;
+  bool computed_ = false;
+  uint32_t computeCount_ = 0;
+
+  uint32_t width_ = 0;
+  uint32_t height_ = 0;
+
+  // Indexed by y * width + x
+  std::vector<uint32_t> distances_;
+  std::vector<uint8_t> passable_;
+  std::vector<uint32_t> frontier_;
+};
+
+}  // namespace griddly
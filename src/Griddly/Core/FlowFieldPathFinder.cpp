@@ -0,0 +1,68 @@
+#include "FlowFieldPathFinder.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "Grid.hpp"
+
+namespace griddly {
+
+FlowFieldPathFinder::FlowFieldPathFinder(std::shared_ptr<Grid> grid, std::set<std::string> impassableObjects, const ActionInputsDefinition& actionInputs, PathFinderMode mode, std::shared_ptr<FlowField> flowField)
+    : PathFinder(std::move(grid), std::move(impassableObjects), mode), flowField_(std::move(flowField)) {
+  for (const auto& inputMapping : actionInputs.inputMappings) {
+    moves_.push_back({inputMapping.first, inputMapping.second.vectorToDest});
+  }
+
+  std::sort(moves_.begin(), moves_.end(), [](const Move& a, const Move& b) {
+    return a.actionId < b.actionId;
+  });
+}
+
+std::vector<glm::ivec2> FlowFieldPathFinder::getMoveVectors(const ActionInputsDefinition& actionInputs) {
+  std::vector<glm::ivec2> moveVectors;
+  for (const auto& inputMapping : actionInputs.inputMappings) {
+    moveVectors.push_back(inputMapping.second.vectorToDest);
+  }
+  return moveVectors;
+}
+
+SearchOutput FlowFieldPathFinder::search(glm::ivec2 startLocation, glm::ivec2 endLocation, glm::ivec2 startOrientationVector, uint32_t maxDepth) {
+  flowField_->update(*grid_);
+
+  auto bestDistance = flowField_->getDistance(startLocation);
+  uint32_t bestActionId = 0;
+
+  // The field does not reach a start on an impassable object, so when fleeing every reachable location is further away
+  if (mode_ == PathFinderMode::FLEE && bestDistance == FlowField::UNREACHABLE) {
+    bestDistance = 0;
+  }
+
+  for (const auto& move : moves_) {
+    auto nextLocation = startLocation + move.vectorToDest;
+    auto distance = flowField_->getDistance(nextLocation);
+
+    // Targets can be moved onto even if they are impassable, so they can be reached
+    if (!flowField_->isPassable(nextLocation) && distance != 0) {
+      continue;
+    }
+
+    // Walled off locations are not far from the target, the field just cannot tell how far they are
+    if (mode_ == PathFinderMode::FLEE && distance == FlowField::UNREACHABLE) {
+      continue;
+    }
+
+    bool better = mode_ == PathFinderMode::FLEE ? distance > bestDistance : distance < bestDistance;
+    if (better) {
+      bestDistance = distance;
+      bestActionId = move.actionId;
+    }
+  }
+
+  spdlog::debug("Flow field action from [{0},{1}]: {2}, distance to target: {3}", startLocation.x, startLocation.y, bestActionId, bestDistance);
+
+  return {bestActionId};
+}
+
+}  // namespace griddly
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "FlowField.hpp"
+#include "GDY/Actions/Action.hpp"
+#include "PathFinder.hpp"
+
+namespace griddly {
+
+/**
+ * Picks the action that moves down (SEEK) or up (FLEE) a flow field shared with every other object chasing the same target.
+ * Only supports actions that are not relative to the orientation of the object.
+ */
+class FlowFieldPathFinder : public PathFinder {
+ public:
+  FlowFieldPathFinder(std::shared_ptr<Grid> grid, std::set<std::string> impassableObjects, const ActionInputsDefinition& actionInputs, PathFinderMode mode, std::shared_ptr<FlowField> flowField);
+
+  // The end location and search depth are not used, the field already covers every target in the grid
+  SearchOutput search(glm::ivec2 startLocation, glm::ivec2 endLocation, glm::ivec2 startOrientationVector, uint32_t maxDepth) override;
+
+  // The move vectors of the actions, which a flow field for them has to be computed with
+  static std::vector<glm::ivec2> getMoveVectors(const ActionInputsDefinition& actionInputs);
+
+ private:
+  struct Move {
+    uint32_t actionId;
+    glm::ivec2 vectorToDest;
+  };
+
+  const std::shared_ptr<FlowField> flowField_;
+
+  // Sorted by action id, so ties between equally good moves are broken the same way every time
+  std::vector<Move> moves_;
+};
+
+}  // namespace griddly
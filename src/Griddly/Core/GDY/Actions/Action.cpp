@@ -5,10 +5,17 @@
 
 #include <utility>
 
+#include "../SymbolTable.hpp"
+
 namespace griddly {
 
-Action::Action(std::shared_ptr<Grid> grid, std::string actionName, uint32_t playerId, uint32_t delay, std::unordered_map<std::string, int32_t> metaData)
-    : actionName_(std::move(actionName)),
+Action::Action(std::shared_ptr<Grid> grid, std::string actionName, uint32_t playerId, uint32_t delay, ActionMetaData metaData)
+    : Action(std::move(grid), SymbolTable::actionNames().intern(actionName), playerId, delay, std::move(metaData)) {
+}
+
+Action::Action(std::shared_ptr<Grid> grid, uint32_t actionNameId, uint32_t playerId, uint32_t delay, ActionMetaData metaData)
+    : actionName_(SymbolTable::actionNames().getName(actionNameId)),
+      actionNameId_(actionNameId),
       delay_(delay),
       playerId_(playerId),
       grid_(grid),
@@ -72,6 +79,10 @@ std::shared_ptr<Object> Action::getSourceObject() const {
   }
 }
 
+bool Action::hasSourceObject() const {
+  return sourceObject_ != nullptr;
+}
+
 std::shared_ptr<Object> Action::getDestinationObject() const {
   switch (actionMode_) {
     case ActionMode::SRC_LOC_DST_LOC:
@@ -142,6 +153,8 @@ glm::ivec2 Action::getOrientationVector() const {
 
 const std::string& Action::getActionName() const { return actionName_; }
 
+uint32_t Action::getActionNameId() const { return actionNameId_; }
+
 uint32_t Action::getOriginatingPlayerId() const {
   return playerId_;
 }
@@ -150,16 +163,17 @@ uint32_t Action::getDelay() const {
   return delay_;
 }
 
-int32_t Action::getMetaData(std::string variableName) const {
-  if (metaData_.find(variableName) != metaData_.end()) {
-    return metaData_.at(variableName);
+int32_t Action::getMetaData(const std::string& variableName) const {
+  const auto* metaDataIt = metaData_.find(variableName);
+  if (metaDataIt != metaData_.end()) {
+    return metaDataIt->second;
   } else {
     spdlog::warn("cannot resolve action metadata variable meta.{0}, will return 0", variableName);
     return 0;
   }
 }
 
-const std::unordered_map<std::string, int32_t>& Action::getMetaData() const {
+const ActionMetaData& Action::getMetaData() const {
   return metaData_;
 }
 
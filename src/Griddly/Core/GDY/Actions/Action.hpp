@@ -5,6 +5,7 @@
 
 #include "../../Grid.hpp"
 #include "../Objects/Object.hpp"
+#include "ActionMetaData.hpp"
 #include "Direction.hpp"
 
 namespace griddly {
@@ -23,7 +24,7 @@ struct InputMapping {
   glm::ivec2 vectorToDest{};
   glm::ivec2 orientationVector{};
   std::string description = "";
-  std::unordered_map<std::string, int32_t> metaData{};
+  ActionMetaData metaData{};
 };
 
 struct ActionInputsDefinition {
@@ -35,7 +36,11 @@ struct ActionInputsDefinition {
 
 class Action {
  public:
-  Action(std::shared_ptr<Grid> grid, std::string actionName, uint32_t playerId, uint32_t delay = 0, std::unordered_map<std::string, int32_t> metaData = {});
+  // Prefer ActionPool::newAction, which reuses the memory of released actions
+  Action(std::shared_ptr<Grid> grid, std::string actionName, uint32_t playerId, uint32_t delay = 0, ActionMetaData metaData = {});
+
+  // For callers that interned the action name once up front
+  Action(std::shared_ptr<Grid> grid, uint32_t actionNameId, uint32_t playerId, uint32_t delay = 0, ActionMetaData metaData = {});
 
   // An action that is tied to specific objects, used in triggered actions
   virtual void init(std::shared_ptr<Object> sourceObject, std::shared_ptr<Object> destinationObject);
@@ -49,6 +54,9 @@ class Action {
   // resolve the source object in the current grid
   virtual std::shared_ptr<Object> getSourceObject() const;
 
+  // True if the action was initialised with a source object rather than a source location
+  virtual bool hasSourceObject() const;
+
   // resolve the destination object in the current grid
   virtual std::shared_ptr<Object> getDestinationObject() const;
 
@@ -60,6 +68,9 @@ class Action {
 
   virtual const std::string& getActionName() const;
 
+  // Id of the action's name in SymbolTable::actionNames()
+  virtual uint32_t getActionNameId() const;
+
   virtual std::string getDescription() const;
 
   virtual glm::ivec2 getOrientationVector() const;
@@ -69,9 +80,9 @@ class Action {
   // Delay an action
   virtual uint32_t getDelay() const;
 
-  virtual const std::unordered_map<std::string, int32_t>& getMetaData() const;
+  virtual const ActionMetaData& getMetaData() const;
 
-  virtual int32_t getMetaData(std::string variableName) const;
+  virtual int32_t getMetaData(const std::string& variableName) const;
 
   virtual ~Action() = default;
 
@@ -84,13 +95,15 @@ class Action {
 
   glm::ivec2 orientationVector_ = {0, 0};
 
-  const std::string actionName_;
+  // Owned by the action name symbol table
+  const std::string& actionName_;
+  const uint32_t actionNameId_;
   const uint32_t delay_;
   const std::weak_ptr<Grid> grid_;
   const uint32_t playerId_ = 0;
 
   // Some variables that we can set in the input mapping
-  const std::unordered_map<std::string, int32_t> metaData_;
+  const ActionMetaData metaData_;
 
  private:
   ActionMode actionMode_;
@@ -0,0 +1,95 @@
+#pragma once
+#include <array>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace griddly {
+
+/**
+ * The metadata attached to an action, most actions have none or only a few entries.
+ * Entries are kept in insertion order in a fixed inline array, and only move to the heap if there are more than INLINE_CAPACITY of them.
+ * Lookups are linear, which is faster than hashing for so few entries.
+ */
+class ActionMetaData {
+ public:
+  using Entry = std::pair<std::string, int32_t>;
+  static constexpr size_t INLINE_CAPACITY = 4;
+
+  ActionMetaData() = default;
+
+  ActionMetaData(std::initializer_list<Entry> entries) {
+    for (const auto& entry : entries) {
+      (*this)[entry.first] = entry.second;
+    }
+  }
+
+  explicit ActionMetaData(const std::unordered_map<std::string, int32_t>& metaData) {
+    for (const auto& metaDataIt : metaData) {
+      (*this)[metaDataIt.first] = metaDataIt.second;
+    }
+  }
+
+  const Entry* begin() const {
+    return size_ <= INLINE_CAPACITY ? inlineEntries_.data() : overflowEntries_.data();
+  }
+
+  const Entry* end() const {
+    return begin() + size_;
+  }
+
+  const Entry* find(const std::string& key) const {
+    for (const auto* entry = begin(); entry != end(); entry++) {
+      if (entry->first == key) {
+        return entry;
+      }
+    }
+    return end();
+  }
+
+  const int32_t& at(const std::string& key) const {
+    const auto* entry = find(key);
+    if (entry == end()) {
+      throw std::out_of_range("No action metadata with key " + key);
+    }
+    return entry->second;
+  }
+
+  int32_t& operator[](const std::string& key) {
+    auto* entry = const_cast<Entry*>(find(key));
+    if (entry != end()) {
+      return entry->second;
+    }
+
+    if (size_ < INLINE_CAPACITY) {
+      inlineEntries_[size_] = {key, 0};
+      return inlineEntries_[size_++].second;
+    }
+
+    if (size_ == INLINE_CAPACITY) {
+      overflowEntries_.assign(inlineEntries_.begin(), inlineEntries_.end());
+    }
+
+    overflowEntries_.emplace_back(key, 0);
+    size_++;
+    return overflowEntries_.back().second;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+ private:
+  std::array<Entry, INLINE_CAPACITY> inlineEntries_{};
+  std::vector<Entry> overflowEntries_;
+  size_t size_ = 0;
+};
+
+}  // namespace griddly
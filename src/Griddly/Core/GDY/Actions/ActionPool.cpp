@@ -0,0 +1,18 @@
+#include "ActionPool.hpp"
+
+#include "Action.hpp"
+
+namespace griddly {
+
+ActionPool::ActionPool() : blocks_(std::make_shared<ActionPoolBlocks>()) {
+}
+
+std::shared_ptr<Action> ActionPool::newAction(std::shared_ptr<Grid> grid, uint32_t actionNameId, uint32_t playerId, uint32_t delay, ActionMetaData metaData) {
+  return std::allocate_shared<Action>(ActionPoolAllocator<Action>(blocks_), std::move(grid), actionNameId, playerId, delay, std::move(metaData));
+}
+
+size_t ActionPool::getFreeBlockCount() const {
+  return blocks_->freeBlocks.size();
+}
+
+}  // namespace griddly
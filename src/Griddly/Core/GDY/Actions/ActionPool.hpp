@@ -0,0 +1,95 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ActionMetaData.hpp"
+
+namespace griddly {
+
+class Action;
+class Grid;
+
+// Memory blocks that have been released by actions and can be reused by new ones
+struct ActionPoolBlocks {
+  size_t blockSize = 0;
+  std::vector<void*> freeBlocks;
+
+  ~ActionPoolBlocks() {
+    for (auto* block : freeBlocks) {
+      ::operator delete(block);
+    }
+  }
+};
+
+// Allocator for std::allocate_shared, the action and its control block share one block
+template <class T>
+class ActionPoolAllocator {
+ public:
+  using value_type = T;
+
+  explicit ActionPoolAllocator(std::shared_ptr<ActionPoolBlocks> blocks) : blocks_(std::move(blocks)) {}
+
+  template <class U>
+  ActionPoolAllocator(const ActionPoolAllocator<U>& other) : blocks_(other.blocks_) {}  // NOLINT
+
+  T* allocate(size_t n) {
+    auto size = n * sizeof(T);
+    if (size == blocks_->blockSize && !blocks_->freeBlocks.empty()) {
+      auto* block = blocks_->freeBlocks.back();
+      blocks_->freeBlocks.pop_back();
+      return static_cast<T*>(block);
+    }
+
+    return static_cast<T*>(::operator new(size));
+  }
+
+  void deallocate(T* ptr, size_t n) {
+    auto size = n * sizeof(T);
+    if (blocks_->blockSize == 0) {
+      blocks_->blockSize = size;
+    }
+
+    if (size == blocks_->blockSize) {
+      blocks_->freeBlocks.push_back(ptr);
+    } else {
+      ::operator delete(ptr);
+    }
+  }
+
+  template <class U>
+  bool operator==(const ActionPoolAllocator<U>& other) const {
+    return blocks_ == other.blocks_;
+  }
+
+  template <class U>
+  bool operator!=(const ActionPoolAllocator<U>& other) const {
+    return blocks_ != other.blocks_;
+  }
+
+ private:
+  template <class U>
+  friend class ActionPoolAllocator;
+
+  std::shared_ptr<ActionPoolBlocks> blocks_;
+};
+
+/**
+ * Creates actions in recycled memory. Once the pool has warmed up, creating the actions for a tick does not allocate.
+ * Blocks go back to the pool when the last reference to an action is released, so a pool must only be used by the thread that is stepping its grid.
+ */
+class ActionPool {
+ public:
+  ActionPool();
+
+  // The action name id is interned by the caller, so creating an action does not look up or copy its name
+  std::shared_ptr<Action> newAction(std::shared_ptr<Grid> grid, uint32_t actionNameId, uint32_t playerId, uint32_t delay = 0, ActionMetaData metaData = {});
+
+  // The number of released blocks that are waiting to be reused
+  size_t getFreeBlockCount() const;
+
+ private:
+  std::shared_ptr<ActionPoolBlocks> blocks_;
+};
+
+}  // namespace griddly
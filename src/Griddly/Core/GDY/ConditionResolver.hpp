@@ -14,31 +14,68 @@ enum class LogicOp {
   OR,
 };
 
+enum class ConditionOp {
+  EQ,
+  GT,
+  GTE,
+  LT,
+  LTE,
+  NEQ,
+};
+
 template <class ConditionFunction>
 class ConditionResolver {
  public:
   ConditionFunction instantiateCondition(std::string &commandName, YAML::Node &conditionNode) const {
+    if (commandName == "and") {
+      return processConditions(conditionNode, false, LogicOp::AND);
+    } else if (commandName == "or") {
+      return processConditions(conditionNode, false, LogicOp::OR);
+    } else {
+      return resolveConditionArguments(getConditionOp(commandName), conditionNode);
+    }
+  }
+
+  static ConditionOp getConditionOp(const std::string &commandName) {
     if (commandName == "eq") {
-      return resolveConditionArguments([](int32_t a, int32_t b) { return a == b; }, conditionNode);
+      return ConditionOp::EQ;
     } else if (commandName == "gt") {
-      return resolveConditionArguments([](int32_t a, int32_t b) { return a > b; }, conditionNode);
+      return ConditionOp::GT;
     } else if (commandName == "gte") {
-      return resolveConditionArguments([](int32_t a, int32_t b) { return a >= b; }, conditionNode);
+      return ConditionOp::GTE;
     } else if (commandName == "lt") {
-      return resolveConditionArguments([](int32_t a, int32_t b) { return a < b; }, conditionNode);
+      return ConditionOp::LT;
     } else if (commandName == "lte") {
-      return resolveConditionArguments([](int32_t a, int32_t b) { return a <= b; }, conditionNode);
+      return ConditionOp::LTE;
     } else if (commandName == "neq") {
-      return resolveConditionArguments([](int32_t a, int32_t b) { return a != b; }, conditionNode);
-    } else if (commandName == "and") {
-      return processConditions(conditionNode, false, LogicOp::AND);
-    } else if (commandName == "or") {
-      return processConditions(conditionNode, false, LogicOp::OR);
+      return ConditionOp::NEQ;
     } else {
       throw std::invalid_argument(fmt::format("Unknown or badly defined condition command {0}.", commandName));
     }
   }
 
+  static bool compare(ConditionOp op, int32_t a, int32_t b) {
+    switch (op) {
+      case ConditionOp::EQ:
+        return a == b;
+      case ConditionOp::GT:
+        return a > b;
+      case ConditionOp::GTE:
+        return a >= b;
+      case ConditionOp::LT:
+        return a < b;
+      case ConditionOp::LTE:
+        return a <= b;
+      case ConditionOp::NEQ:
+      default:
+        return a != b;
+    }
+  }
+
+  static std::function<bool(int32_t, int32_t)> getConditionFunction(ConditionOp op) {
+    return [op](int32_t a, int32_t b) { return compare(op, a, b); };
+  }
+
   ConditionFunction processConditions(YAML::Node &conditionNodeList, bool isTopLevel = false, LogicOp op = LogicOp::NONE) const {
     // We should have a single item and not a list
     if (!conditionNodeList.IsDefined()) {
@@ -86,7 +123,7 @@ class ConditionResolver {
     }
   }
 
-  virtual ConditionFunction resolveConditionArguments(const std::function<bool(int32_t, int32_t)> conditionFunction, YAML::Node &conditionArgumentsNode) const = 0;
+  virtual ConditionFunction resolveConditionArguments(ConditionOp conditionOp, YAML::Node &conditionArgumentsNode) const = 0;
   virtual ConditionFunction resolveAND(const std::vector<ConditionFunction> &conditionList) const = 0;
   virtual ConditionFunction resolveOR(const std::vector<ConditionFunction> &conditionList) const = 0;
 };
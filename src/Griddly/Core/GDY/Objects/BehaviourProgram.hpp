@@ -0,0 +1,148 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../ConditionResolver.hpp"
+#include "ObjectVariable.hpp"
+
+namespace griddly {
+
+enum class PathFinderMode;
+enum class PathFinderAlgorithm;
+
+enum class ActionExecutor {
+  ACTION_PLAYER_ID,
+  OBJECT_PLAYER_ID,
+};
+
+enum class BehaviourOpCode : uint8_t {
+  NOP,
+  PRINT,       // print operands [a, a + b)
+  REWARD,      // reward operand a
+  CHANGE_TO,   // change to object type string a
+  ADD,         // operand a += operand b
+  SUB,         // operand a -= operand b
+  SET,         // operand a = operand b
+  INCR,        // operand a += 1
+  DECR,        // operand a -= 1
+  ROT_DIR,     // rotate to the action's orientation
+  MOV_DEST,    // move to the action's destination
+  MOV_SRC,     // move to the action's source
+  MOV,         // move to [operand a, operand b]
+  CASCADE,     // cascade the action to the destination object
+  EXEC,        // execute exec definition a
+  REMOVE,      // remove this object
+  SET_TILE,    // set the render tile to operand a
+  SPAWN,       // spawn object type string a at the action's destination
+  ABORT,       // abort the action
+  COMPARE,     // condition flag = operand a <op> operand b
+  JUMP,        // skip the next `jump` instructions
+  JUMP_IF_FALSE,
+  JUMP_IF_TRUE,
+};
+
+struct BehaviourInstruction {
+  BehaviourOpCode opCode = BehaviourOpCode::NOP;
+  uint32_t a = 0;
+  uint32_t b = 0;
+  uint32_t jump = 0;
+  ConditionOp conditionOp = ConditionOp::EQ;
+};
+
+// Jumps are relative, so conditions and nested commands can be compiled separately and concatenated
+using BehaviourCode = std::vector<BehaviourInstruction>;
+
+struct ExecDefinition {
+  std::string actionName;
+  uint32_t actionNameId = 0;
+  uint32_t delay = 0;
+  uint32_t actionId = 0;
+  bool randomize = false;
+  ActionExecutor executor = ActionExecutor::ACTION_PLAYER_ID;
+  std::vector<std::pair<std::string, uint32_t>> metaData{};
+  int32_t pathFinderIdx = -1;
+};
+
+struct PathFinderDefinition {
+  std::string actionName;
+  std::string targetObjectName;
+  std::set<std::string> impassableObjects;
+  glm::ivec2 endLocation{0, 0};
+  PathFinderMode mode;
+  PathFinderAlgorithm algorithm{};  // A* unless set
+  uint32_t maxSearchDepth = 100;
+};
+
+using BehaviourCodeByIdx = std::unordered_map<uint32_t, BehaviourCode>;
+
+// Behaviour code indexed by interned action name id and object name id, see SymbolTable
+class BehaviourTable {
+ public:
+  // Returns nullptr if there are no behaviours for the action and object
+  const BehaviourCodeByIdx* find(uint32_t actionNameId, uint32_t objectNameId) const {
+    if (actionNameId >= table_.size()) {
+      return nullptr;
+    }
+
+    const auto& behavioursForAction = table_[actionNameId];
+    if (objectNameId >= behavioursForAction.size() || behavioursForAction[objectNameId].empty()) {
+      return nullptr;
+    }
+
+    return &behavioursForAction[objectNameId];
+  }
+
+  BehaviourCodeByIdx& at(uint32_t actionNameId, uint32_t objectNameId) {
+    if (actionNameId >= table_.size()) {
+      table_.resize(actionNameId + 1);
+    }
+
+    auto& behavioursForAction = table_[actionNameId];
+    if (objectNameId >= behavioursForAction.size()) {
+      behavioursForAction.resize(objectNameId + 1);
+    }
+
+    return behavioursForAction[objectNameId];
+  }
+
+ private:
+  std::vector<std::vector<BehaviourCodeByIdx>> table_;
+};
+
+// The behaviours of an object type, compiled once and shared by all instances of that type.
+// Unqualified variables are compiled to slots which each instance binds to its own variables.
+struct BehaviourProgram {
+  static constexpr uint32_t NO_VARIABLE_SLOT = UINT32_MAX;
+
+  std::vector<std::string> variableNames;
+  std::unordered_map<std::string, uint32_t> variableSlots;
+
+  // Slots indexed by interned variable name id, so src. and dst. variables of other objects are found without hashing
+  std::vector<uint32_t> variableNameSlots;
+
+  // Constant tables referenced by instructions
+  std::vector<ObjectVariable> operands;
+  std::vector<std::string> strings;
+  std::vector<ExecDefinition> execDefinitions;
+
+  // action -> destination -> behaviour idx -> code
+  BehaviourTable srcBehaviours;
+
+  // action -> source -> behaviour idx -> code
+  BehaviourTable dstBehaviours;
+
+  // action -> destination -> behaviour idx -> condition code
+  BehaviourTable actionPreconditions;
+
+  std::unordered_set<std::string> availableActionNames;
+
+  // Path finders are bound per instance as they reference the grid
+  std::vector<PathFinderDefinition> pathFinderDefinitions;
+};
+
+}  // namespace griddly
@@ -2,19 +2,28 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <utility>
 
 #include "../../Grid.hpp"
-#include "../../SpatialHashCollisionDetector.hpp"
+#include "../../NearestObjectIndex.hpp"
 #include "../../AStarPathFinder.hpp"
+#include "../../DStarLitePathFinder.hpp"
+#include "../../JumpPointPathFinder.hpp"
+#include "../../FlowFieldPathFinder.hpp"
 #include "../../Util/util.hpp"
 #include "../Actions/Action.hpp"
+#include "../SymbolTable.hpp"
 #include "ObjectGenerator.hpp"
 
 namespace griddly {
 
 Object::Object(std::string objectName, char mapCharacter, uint32_t playerId, uint32_t zIdx, std::unordered_map<std::string, std::shared_ptr<int32_t>> availableVariables, std::shared_ptr<ObjectGenerator> objectGenerator, std::weak_ptr<Grid> grid)
-    : objectName_(std::move(objectName)), mapCharacter_(mapCharacter), zIdx_(zIdx), objectGenerator_(std::move(objectGenerator)), grid_(std::move(grid)) {
+    : Object(objectName, SymbolTable::objectNames().intern(objectName), mapCharacter, playerId, zIdx, std::move(availableVariables), std::move(objectGenerator), std::move(grid)) {
+}
+
+Object::Object(std::string objectName, uint32_t objectNameId, char mapCharacter, uint32_t playerId, uint32_t zIdx, std::unordered_map<std::string, std::shared_ptr<int32_t>> availableVariables, std::shared_ptr<ObjectGenerator> objectGenerator, std::weak_ptr<Grid> grid)
+    : objectName_(std::move(objectName)), objectNameId_(objectNameId), mapCharacter_(mapCharacter), zIdx_(zIdx), objectGenerator_(std::move(objectGenerator)), grid_(std::move(grid)) {
   availableVariables.insert({"_x", x_});
   availableVariables.insert({"_y", y_});
   availableVariables.insert({"_dx", orientation_.getDx()});
@@ -24,8 +33,9 @@ Object::Object(std::string objectName, char mapCharacter, uint32_t playerId, uin
 
   *playerId_ = playerId;
 
-  availableVariables_ = availableVariables;
+  availableVariables_ = std::move(availableVariables);
   renderTileName_ = objectName_ + std::to_string(renderTileId_);
+  objectNameHash_ = std::hash<std::string>()(objectName_);
 }
 
 Object::~Object() {
@@ -52,206 +62,174 @@ std::string Object::getDescription() const {
   return fmt::format("{0}@[{1}, {2}]", objectName_, location_.x, location_.y);
 }
 
-BehaviourResult Object::onActionSrc(std::string destinationObjectName, std::shared_ptr<Action> action, std::vector<uint32_t> behaviourIdxs) {
-  const auto& actionName = action->getActionName();
-
-  auto behavioursForActionIt = srcBehaviours_.find(actionName);
-  if (behavioursForActionIt == srcBehaviours_.end()) {
+BehaviourResult Object::onActionSrc(uint32_t destinationObjectNameId, const std::shared_ptr<Action>& action, const std::vector<uint32_t>& behaviourIdxs) {
+  if (behaviourProgram_ == nullptr) {
     return {true};
   }
 
-  auto &behavioursForAction = behavioursForActionIt->second;
-
-  auto behavioursForActionAndDestinationObject = behavioursForAction.find(destinationObjectName);
-  if (behavioursForActionAndDestinationObject == behavioursForAction.end()) {
+  const auto* behaviours = behaviourProgram_->srcBehaviours.find(action->getActionNameId(), destinationObjectNameId);
+  if (behaviours == nullptr) {
     return {true};
   }
 
-  spdlog::debug("Executing behaviours for source [{0}] -> {1} -> {2}", getObjectName(), actionName, destinationObjectName);
-  auto &behaviours = behavioursForActionAndDestinationObject->second;
+  spdlog::debug("Executing behaviours for source [{0}] -> {1} -> {2}", getObjectName(), action->getActionName(), destinationObjectNameId);
 
-  std::unordered_map<uint32_t, int32_t> rewardAccumulator;
+  PlayerRewards rewardAccumulator;
   for (const auto &idx : behaviourIdxs) {
-    for (const auto &behaviour : behaviours.at(idx)) {
-      auto result = behaviour(action);
-
-      accumulateRewards(rewardAccumulator, result.rewards);
-      if (result.abortAction) {
-        return {true, rewardAccumulator};
-      }
+    if (executeBehaviourCode(behaviours->at(idx), action, rewardAccumulator)) {
+      return {true, rewardAccumulator};
     }
   }
 
   return {false, rewardAccumulator};
 }
 
-BehaviourResult Object::onActionDst(std::shared_ptr<Action> action, std::vector<uint32_t> behaviourIdxs) {
-  const auto& actionName = action->getActionName();
+BehaviourResult Object::onActionDst(const std::shared_ptr<Action>& action, const std::vector<uint32_t>& behaviourIdxs) {
   auto sourceObject = action->getSourceObject();
-  const auto sourceObjectName = sourceObject == nullptr ? "_empty" : sourceObject->getObjectName();
+  const auto sourceObjectNameId = sourceObject == nullptr ? EMPTY_OBJECT_ID : sourceObject->getObjectNameId();
 
-  auto behavioursForActionIt = dstBehaviours_.find(actionName);
-  if (behavioursForActionIt == dstBehaviours_.end()) {
+  if (behaviourProgram_ == nullptr) {
     spdlog::debug("Aborting dst behaviour, (no dst behaviours)", action->getDescription());
     return {true};
   }
 
-  auto &behavioursForAction = behavioursForActionIt->second;
-
-  auto behavioursForActionAndDestinationObject = behavioursForAction.find(sourceObjectName);
-
-  if (behavioursForActionAndDestinationObject == behavioursForAction.end()) {
+  const auto* behaviours = behaviourProgram_->dstBehaviours.find(action->getActionNameId(), sourceObjectNameId);
+  if (behaviours == nullptr) {
     spdlog::debug("Aborting dst behaviour, (no behaviours for action)", action->getDescription());
     return {true};
   }
 
-  spdlog::debug("Executing behaviours for destination {0} -> {1} -> [{2}]", sourceObjectName, actionName, getObjectName());
-  auto &behaviours = behavioursForActionAndDestinationObject->second;
+  spdlog::debug("Executing behaviours for destination {0} -> {1} -> [{2}]", sourceObjectNameId, action->getActionName(), getObjectName());
 
-  std::unordered_map<uint32_t, int32_t> rewardAccumulator;
+  PlayerRewards rewardAccumulator;
   for (const auto &idx : behaviourIdxs) {
-    for (const auto &behaviour : behaviours.at(idx)) {
-      auto result = behaviour(action);
-
-      accumulateRewards(rewardAccumulator, result.rewards);
-      if (result.abortAction) {
-        return {true, rewardAccumulator};
-      }
+    if (executeBehaviourCode(behaviours->at(idx), action, rewardAccumulator)) {
+      return {true, rewardAccumulator};
     }
   }
 
   return {false, rewardAccumulator};
 }
 
-std::unordered_map<std::string, std::shared_ptr<ObjectVariable>> Object::resolveVariables(CommandArguments &commandArguments, bool allowStrings) const {
-  std::unordered_map<std::string, std::shared_ptr<ObjectVariable>> resolvedVariables;
-  for (auto commandArgument : commandArguments) {
-    resolvedVariables[commandArgument.first] = std::make_shared<ObjectVariable>(ObjectVariable(commandArgument.second, availableVariables_, allowStrings));
+uint32_t Object::resolveOperand(const YAML::Node &operandNode, bool allowStrings) const {
+  auto &operands = behaviourProgram_->operands;
+  operands.emplace_back(operandNode, behaviourProgram_->variableSlots, allowStrings);
+  return static_cast<uint32_t>(operands.size() - 1);
+}
+
+uint32_t Object::resolveOperand(CommandArguments &commandArguments, const std::string &argumentKey, const std::string &commandName) const {
+  auto commandArgumentIt = commandArguments.find(argumentKey);
+  if (commandArgumentIt == commandArguments.end()) {
+    auto errorString = fmt::format("Command {0} is missing argument {1}.", commandName, argumentKey);
+    spdlog::error(errorString);
+    throw std::invalid_argument(errorString);
   }
 
-  return resolvedVariables;
+  return resolveOperand(commandArgumentIt->second);
 }
 
-BehaviourCondition Object::resolveConditionArguments(const std::function<bool(int32_t, int32_t)> condition, YAML::Node &conditionArgumentsNode) const {
+uint32_t Object::resolveString(const std::string &value) const {
+  auto &strings = behaviourProgram_->strings;
+  strings.push_back(value);
+  return static_cast<uint32_t>(strings.size() - 1);
+}
+
+BehaviourCode Object::resolveConditionArguments(ConditionOp conditionOp, YAML::Node &conditionArgumentsNode) const {
   auto conditionArguments = singleOrListNodeToCommandArguments(conditionArgumentsNode);
-  auto variablePointers = resolveVariables(conditionArguments);
 
-  auto a = variablePointers["0"];
-  auto b = variablePointers["1"];
+  auto a = resolveOperand(conditionArguments, "0", "condition");
+  auto b = resolveOperand(conditionArguments, "1", "condition");
 
-  return [this, condition, a, b](std::shared_ptr<Action> action) {
-    return condition(a->resolve(action), b->resolve(action));
-  };
+  return {{BehaviourOpCode::COMPARE, a, b, 0, conditionOp}};
 }
 
-BehaviourCondition Object::resolveAND(const std::vector<BehaviourCondition> &conditionList) const {
-  return [conditionList](const std::shared_ptr<Action> &action) -> bool {
-    for (const auto &condition : conditionList) {
-      if (!condition(action)) {
-        return false;
-      }
-    }
-    return true;
-  };
+/**
+ * @brief Concatenates conditions, jumping past the remaining conditions as soon as jumpOpCode decides the result
+ */
+static BehaviourCode shortCircuitConditions(const std::vector<BehaviourCode> &conditionList, BehaviourOpCode jumpOpCode) {
+  size_t codeLength = 0;
+  for (const auto &condition : conditionList) {
+    codeLength += condition.size() + 1;
+  }
+
+  BehaviourCode code;
+  code.reserve(codeLength);
+  for (const auto &condition : conditionList) {
+    code.insert(code.end(), condition.begin(), condition.end());
+    code.push_back({jumpOpCode});
+    code.back().jump = static_cast<uint32_t>(codeLength - code.size());
+  }
+
+  return code;
 }
 
-BehaviourCondition Object::resolveOR(const std::vector<BehaviourCondition> &conditionList) const {
-  return [conditionList](const std::shared_ptr<Action> &action) -> bool {
-    for (const auto &condition : conditionList) {
-      if (condition(action)) {
-        return true;
-      }
-    }
-    return false;
-  };
+BehaviourCode Object::resolveAND(const std::vector<BehaviourCode> &conditionList) const {
+  return shortCircuitConditions(conditionList, BehaviourOpCode::JUMP_IF_FALSE);
+}
+
+BehaviourCode Object::resolveOR(const std::vector<BehaviourCode> &conditionList) const {
+  return shortCircuitConditions(conditionList, BehaviourOpCode::JUMP_IF_TRUE);
 }
 
-BehaviourFunction Object::instantiateConditionalBehaviour(const std::string &commandName, CommandArguments &commandArguments, CommandList &subCommands) {
+BehaviourCode Object::compileConditionalBehaviour(const std::string &commandName, CommandArguments &commandArguments, CommandList &subCommands) {
   if (subCommands.size() == 0) {
-    return instantiateBehaviour(commandName, commandArguments);
-  }
-
-  std::function<bool(int32_t, int32_t)> condition;
-  if (commandName == "eq") {
-    condition = [](int32_t a, int32_t b) { return a == b; };
-  } else if (commandName == "gt") {
-    condition = [](int32_t a, int32_t b) { return a > b; };
-  } else if (commandName == "gte") {
-    condition = [](int32_t a, int32_t b) { return a >= b; };
-  } else if (commandName == "lt") {
-    condition = [](int32_t a, int32_t b) { return a < b; };
-  } else if (commandName == "lte") {
-    condition = [](int32_t a, int32_t b) { return a <= b; };
-  } else if (commandName == "neq") {
-    condition = [](int32_t a, int32_t b) { return a != b; };
-  } else {
-    throw std::invalid_argument(fmt::format("Unknown or badly defined condition command {0}.", commandName));
+    return compileBehaviour(commandName, commandArguments);
   }
 
-  std::vector<BehaviourFunction> conditionalBehaviours;
+  auto conditionOp = getConditionOp(commandName);
 
+  BehaviourCode conditionalCode;
   for (auto subCommand : subCommands) {
     auto subCommandName = subCommand.first;
     auto subCommandVariables = subCommand.second;
 
-    conditionalBehaviours.push_back(instantiateBehaviour(subCommandName, subCommandVariables));
+    auto subCommandCode = compileBehaviour(subCommandName, subCommandVariables);
+    conditionalCode.insert(conditionalCode.end(), subCommandCode.begin(), subCommandCode.end());
   }
 
-  auto variablePointers = resolveVariables(commandArguments);
-  auto a = variablePointers["0"];
-  auto b = variablePointers["1"];
+  auto a = resolveOperand(commandArguments, "0", commandName);
+  auto b = resolveOperand(commandArguments, "1", commandName);
 
-  return [this, condition, conditionalBehaviours, a, b](const std::shared_ptr<Action> action) -> BehaviourResult {
-    if (condition(a->resolve(action), b->resolve(action))) {
-      std::unordered_map<uint32_t, int32_t> rewardAccumulator;
-      return executeBehaviourFunctionList(rewardAccumulator, conditionalBehaviours, action);
-    }
-
-    return {};
-  };
+  BehaviourCode code{{BehaviourOpCode::COMPARE, a, b, 0, conditionOp}, {BehaviourOpCode::JUMP_IF_FALSE, 0, 0, static_cast<uint32_t>(conditionalCode.size())}};
+  code.insert(code.end(), conditionalCode.begin(), conditionalCode.end());
+  return code;
 }
 
-/**
- * @brief executes a list of behaviour functions and accumulates the rewards
- * 
- * @param rewardAccumulator 
- * @param behaviourList 
- * @param action 
- * @return BehaviourResult 
- */
-BehaviourResult Object::executeBehaviourFunctionList(std::unordered_map<uint32_t, int32_t> &rewardAccumulator, const std::vector<BehaviourFunction> &behaviourList, const std::shared_ptr<Action> &action) const {
-  for (auto &behaviour : behaviourList) {
-    auto result = behaviour(action);
+BehaviourCode Object::compileCommandList(YAML::Node &commandListNode) {
+  if (commandListNode.IsDefined() && !commandListNode.IsSequence()) {
+    auto line = commandListNode.Mark().line;
+    auto errorString = fmt::format("Parse Error line {0}. Commands must be a list.", line);
+    spdlog::error(errorString);
+    throw std::invalid_argument(errorString);
+  }
 
-    accumulateRewards(rewardAccumulator, result.rewards);
-    if (result.abortAction) {
-      return {true, rewardAccumulator};
-    }
+  BehaviourCode code;
+  for (auto &&subCommandNode : commandListNode) {
+    auto subCommandIt = validateCommandPairNode(subCommandNode);
+    auto subCommandName = subCommandIt->first.as<std::string>();
+    auto subCommandArguments = subCommandIt->second;
+
+    auto subCommandArgumentMap = singleOrListNodeToCommandArguments(subCommandArguments);
+
+    auto subCommandCode = compileBehaviour(subCommandName, subCommandArgumentMap);
+    code.insert(code.end(), subCommandCode.begin(), subCommandCode.end());
   }
 
-  return {false, rewardAccumulator};
+  return code;
 }
 
-BehaviourFunction Object::instantiateBehaviour(const std::string &commandName, CommandArguments &commandArguments) {
+BehaviourCode Object::compileBehaviour(const std::string &commandName, CommandArguments &commandArguments) {
   // Command just used in tests
   if (commandName == "nop") {
-    return [this](std::shared_ptr<Action> action) -> BehaviourResult {
-      return {};
-    };
+    return {{BehaviourOpCode::NOP}};
   }
 
   if (commandName == "print") {
-    auto resolvedVariables = resolveVariables(commandArguments, true);
-    return [this, resolvedVariables](std::shared_ptr<Action> action) -> BehaviourResult {
-      std::stringstream printline;
-
-      for (const auto &resolvedVariable : resolvedVariables) {
-        printline << " " << resolvedVariable.second->resolveString(action);
-      }
-      spdlog::info(printline.str());
-
-      return {};
-    };
+    auto firstOperand = static_cast<uint32_t>(behaviourProgram_->operands.size());
+    for (const auto &commandArgument : commandArguments) {
+      resolveOperand(commandArgument.second, true);
+    }
+    return {{BehaviourOpCode::PRINT, firstOperand, static_cast<uint32_t>(commandArguments.size())}};
   }
 
   if (commandName == "if") {
@@ -259,334 +237,375 @@ BehaviourFunction Object::instantiateBehaviour(const std::string &commandName, C
     auto onTrueCommands = getCommandArgument<YAML::Node>(commandArguments, "OnTrue", YAML::Node(YAML::NodeType::Undefined));
     auto onFalseCommands = getCommandArgument<YAML::Node>(commandArguments, "OnFalse", YAML::Node(YAML::NodeType::Undefined));
 
-    // For everthing in OnTrue:
-    std::vector<BehaviourFunction> onTrueCommandList;
+    auto onTrueCode = compileCommandList(onTrueCommands);
+    auto onFalseCode = compileCommandList(onFalseCommands);
 
-    if(onTrueCommands.IsDefined() && !onTrueCommands.IsSequence()) {
-      auto line = onTrueCommands.Mark().line;
-      auto errorString = fmt::format("Parse Error line {0}. Commands must be a list.", line);
-      spdlog::error(errorString);
-      throw std::invalid_argument(errorString);
-    }
-
-    if(onFalseCommands.IsDefined() && !onFalseCommands.IsSequence()) {
-      auto line = onFalseCommands.Mark().line;
-      auto errorString = fmt::format("Parse Error line {0}. Commands must be a list.", line);
-      spdlog::error(errorString);
-      throw std::invalid_argument(errorString);
-    }
-
-    for (auto &&conditionSubCommand : onTrueCommands) {
-
-      auto subCommandIt = validateCommandPairNode(conditionSubCommand);
-      auto subCommandName = subCommandIt->first.as<std::string>();
-      auto subCommandArguments = subCommandIt->second;
-
-      auto subCommandArgumentMap = singleOrListNodeToCommandArguments(subCommandArguments);
-
-      onTrueCommandList.emplace_back(instantiateBehaviour(subCommandName, subCommandArgumentMap));
-    }
-
-    // For everything in OnFalse
-    std::vector<BehaviourFunction> onFalseCommandList;
-    for (auto &&conditionSubCommand : onFalseCommands) {
-      auto subCommandIt = validateCommandPairNode(conditionSubCommand);
-      auto subCommandName = subCommandIt->first.as<std::string>();
-      auto subCommandArguments = subCommandIt->second;
-
-      auto subCommandArgumentMap = singleOrListNodeToCommandArguments(subCommandArguments);
-
-      onFalseCommandList.emplace_back(instantiateBehaviour(subCommandName, subCommandArgumentMap));
-    }
-
-    BehaviourCondition condition = processConditions(conditions, true, LogicOp::NONE);
-
-    return [this, onTrueCommandList, onFalseCommandList, condition](const std::shared_ptr<Action> &action) -> BehaviourResult {
-      std::unordered_map<uint32_t, int32_t> rewardAccumulator;
-      if (condition(action)) {
-        return executeBehaviourFunctionList(rewardAccumulator, onTrueCommandList, action);
-      } else {
-        return executeBehaviourFunctionList(rewardAccumulator, onFalseCommandList, action);
-      }
-    };
+    // condition, jump over OnTrue if false, OnTrue, jump over OnFalse, OnFalse
+    auto code = processConditions(conditions, true, LogicOp::NONE);
+    code.push_back({BehaviourOpCode::JUMP_IF_FALSE, 0, 0, static_cast<uint32_t>(onTrueCode.size() + 1)});
+    code.insert(code.end(), onTrueCode.begin(), onTrueCode.end());
+    code.push_back({BehaviourOpCode::JUMP, 0, 0, static_cast<uint32_t>(onFalseCode.size())});
+    code.insert(code.end(), onFalseCode.begin(), onFalseCode.end());
+    return code;
   }
 
-  // reward the player that owns this particular object, otherwise warn
   if (commandName == "reward") {
-    auto variablePointers = resolveVariables(commandArguments);
-    auto value = variablePointers["0"];
-    return [this, value](std::shared_ptr<Action> action) -> BehaviourResult {
-      // if the object has a player Id, the reward will be given to that object's player,
-      // otherwise the reward will be given to the player which has performed the action
-      auto rewardPlayer = getPlayerId() == 0 ? action->getOriginatingPlayerId() : getPlayerId();
-
-      if (rewardPlayer == 0) {
-        spdlog::warn("Misconfigured 'reward' for object '{0}' will not be assigned to a player.", action->getSourceObject()->getDescription());
-        return {};
-      }
-
-      // Find the player id of this object and give rewards to this player.
-      return {false, {{rewardPlayer, value->resolve(action)}}};
-    };
+    return {{BehaviourOpCode::REWARD, resolveOperand(commandArguments, "0", commandName)}};
   }
 
   if (commandName == "change_to") {
-    auto objectName = commandArguments["0"].as<std::string>();
-    return [this, objectName](std::shared_ptr<Action> action) -> BehaviourResult {
-      spdlog::debug("Changing object={0} to {1}", getObjectName(), objectName);
-      auto playerId = getPlayerId();
-      auto location = getLocation();
-      auto newObject = objectGenerator_->newInstance(objectName, playerId, grid());
-      removeObject();
-      grid()->addObject(location, newObject, true, action);
-      return {};
-    };
+    return {{BehaviourOpCode::CHANGE_TO, resolveString(commandArguments["0"].as<std::string>())}};
   }
 
   if (commandName == "add") {
-    auto variablePointers = resolveVariables(commandArguments);
-    auto a = variablePointers["0"];
-    auto b = variablePointers["1"];
-    return [this, a, b](std::shared_ptr<Action> action) -> BehaviourResult {
-      *a->resolve_ptr(action) += b->resolve(action);
-      grid()->invalidateLocation(getLocation());
-      return {};
-    };
+    return {{BehaviourOpCode::ADD, resolveOperand(commandArguments, "0", commandName), resolveOperand(commandArguments, "1", commandName)}};
   }
 
   if (commandName == "sub") {
-    auto variablePointers = resolveVariables(commandArguments);
-    auto a = variablePointers["0"];
-    auto b = variablePointers["1"];
-    return [this, a, b](std::shared_ptr<Action> action) -> BehaviourResult {
-      *a->resolve_ptr(action) -= b->resolve(action);
-      grid()->invalidateLocation(getLocation());
-      return {};
-    };
+    return {{BehaviourOpCode::SUB, resolveOperand(commandArguments, "0", commandName), resolveOperand(commandArguments, "1", commandName)}};
   }
 
   if (commandName == "set") {
-    auto variablePointers = resolveVariables(commandArguments);
-    auto a = variablePointers["0"];
-    auto b = variablePointers["1"];
-    return [this, a, b](std::shared_ptr<Action> action) -> BehaviourResult {
-      spdlog::debug("set");
-      *a->resolve_ptr(action) = b->resolve(action);
-      grid()->invalidateLocation(getLocation());
-      return {};
-    };
+    return {{BehaviourOpCode::SET, resolveOperand(commandArguments, "0", commandName), resolveOperand(commandArguments, "1", commandName)}};
   }
 
   if (commandName == "incr") {
-    auto variablePointers = resolveVariables(commandArguments);
-    auto a = variablePointers["0"];
-    return [this, a](std::shared_ptr<Action> action) -> BehaviourResult {
-      spdlog::debug("incr");
-      (*a->resolve_ptr(action)) += 1;
-      grid()->invalidateLocation(getLocation());
-      return {};
-    };
+    return {{BehaviourOpCode::INCR, resolveOperand(commandArguments, "0", commandName)}};
   }
 
   if (commandName == "decr") {
-    auto variablePointers = resolveVariables(commandArguments);
-    auto a = variablePointers["0"];
-    return [this, a](std::shared_ptr<Action> action) -> BehaviourResult {
-      spdlog::debug("decr");
-      (*a->resolve_ptr(action)) -= 1;
-      grid()->invalidateLocation(getLocation());
-      return {};
-    };
+    return {{BehaviourOpCode::DECR, resolveOperand(commandArguments, "0", commandName)}};
   }
 
   if (commandName == "rot") {
     if (commandArguments["0"].as<std::string>() == "_dir") {
-      return [this](std::shared_ptr<Action> action) -> BehaviourResult {
-        orientation_.setOrientation(action->getOrientationVector());
-
-        // redraw the current location
-        grid()->invalidateLocation(getLocation());
-        return {};
-      };
+      return {{BehaviourOpCode::ROT_DIR}};
     }
   }
 
   if (commandName == "mov") {
     if (commandArguments["0"].as<std::string>() == "_dest") {
-      return [this](std::shared_ptr<Action> action) -> BehaviourResult {
-        auto objectMoved = moveObject(action->getDestinationLocation());
-        return {!objectMoved};
-      };
+      return {{BehaviourOpCode::MOV_DEST}};
     }
 
     if (commandArguments["0"].as<std::string>() == "_src") {
-      return [this](std::shared_ptr<Action> action) -> BehaviourResult {
-        auto objectMoved = moveObject(action->getSourceLocation());
-        return {!objectMoved};
-      };
+      return {{BehaviourOpCode::MOV_SRC}};
     }
 
-    auto variablePointers = resolveVariables(commandArguments);
-
-    if (variablePointers.size() != 2) {
-      spdlog::error("Bad mov command detected! There should be two arguments but {0} were provided. This command will be ignored.", variablePointers.size());
-      return [this](std::shared_ptr<Action> action) -> BehaviourResult {
-        return {};
-      };
+    if (commandArguments.size() != 2) {
+      spdlog::error("Bad mov command detected! There should be two arguments but {0} were provided. This command will be ignored.", commandArguments.size());
+      return {{BehaviourOpCode::NOP}};
     }
 
-    auto x = variablePointers["0"];
-    auto y = variablePointers["1"];
-
-    return [this, x, y](std::shared_ptr<Action> action) -> BehaviourResult {
-      auto objectMoved = moveObject({x->resolve(action), y->resolve(action)});
-      return {!objectMoved};
-    };
+    return {{BehaviourOpCode::MOV, resolveOperand(commandArguments, "0", commandName), resolveOperand(commandArguments, "1", commandName)}};
   }
 
   if (commandName == "cascade") {
-    auto a = commandArguments["0"].as<std::string>();
-    return [this, a](std::shared_ptr<Action> action) -> BehaviourResult {
-      if (a == "_dest") {
-        std::shared_ptr<Action> cascadedAction = std::make_shared<Action>(Action(grid(), action->getActionName(), action->getOriginatingPlayerId(), action->getDelay(), action->getMetaData()));
+    if (commandArguments["0"].as<std::string>() == "_dest") {
+      return {{BehaviourOpCode::CASCADE}};
+    }
 
-        cascadedAction->init(action->getDestinationObject(), action->getVectorToDest(), action->getOrientationVector(), false);
+    spdlog::warn("The only supported variable for cascade is _dest.");
+    return {{BehaviourOpCode::ABORT}};
+  }
 
-        auto sourceLocation = cascadedAction->getSourceLocation();
-        auto destinationLocation = cascadedAction->getDestinationLocation();
-        auto vectorToDest = action->getVectorToDest();
-        spdlog::debug("Cascade vector [{0},{1}]", vectorToDest.x, vectorToDest.y);
-        spdlog::debug("Cascading action to [{0},{1}], dst: [{2}, {3}]", sourceLocation.x, sourceLocation.y, destinationLocation.x, destinationLocation.y);
+  if (commandName == "exec") {
+    ExecDefinition execDefinition;
+    execDefinition.actionName = getCommandArgument<std::string>(commandArguments, "Action", "");
+    execDefinition.actionNameId = SymbolTable::actionNames().intern(execDefinition.actionName);
+    execDefinition.randomize = getCommandArgument<bool>(commandArguments, "Randomize", false);
+    execDefinition.executor = getActionExecutorFromString(getCommandArgument<std::string>(commandArguments, "Executor", "action"));
+    execDefinition.delay = resolveOperand(getCommandArgument<YAML::Node>(commandArguments, "Delay", YAML::Node("0")));
+    execDefinition.actionId = resolveOperand(getCommandArgument<YAML::Node>(commandArguments, "ActionId", YAML::Node("0")));
+    execDefinition.metaData = resolveActionMetaData(commandArguments);
 
-        auto actionRewards = grid()->performActions(0, {cascadedAction});
+    auto searchNode = getCommandArgument<YAML::Node>(commandArguments, "Search", YAML::Node(YAML::NodeType::Undefined));
+    execDefinition.pathFinderIdx = definePathFinder(searchNode, execDefinition.actionName);
 
-        return {false, actionRewards};
-      }
+    auto &execDefinitions = behaviourProgram_->execDefinitions;
+    execDefinitions.push_back(std::move(execDefinition));
+    return {{BehaviourOpCode::EXEC, static_cast<uint32_t>(execDefinitions.size() - 1)}};
+  }
 
-      spdlog::warn("The only supported variable for cascade is _dest.");
+  if (commandName == "remove") {
+    return {{BehaviourOpCode::REMOVE}};
+  }
 
-      return {true};
-    };
+  if (commandName == "set_tile") {
+    return {{BehaviourOpCode::SET_TILE, resolveOperand(commandArguments, "0", commandName)}};
   }
 
-  if (commandName == "exec") {
-    auto actionName = getCommandArgument<std::string>(commandArguments, "Action", "");
-    auto delayNode = getCommandArgument<YAML::Node>(commandArguments, "Delay", YAML::Node("0"));
-    auto randomize = getCommandArgument<bool>(commandArguments, "Randomize", false);
-    auto actionIdNode = getCommandArgument<YAML::Node>(commandArguments, "ActionId", YAML::Node("0"));
-    auto executor = getCommandArgument<std::string>(commandArguments, "Executor", "action");
-    auto searchNode = getCommandArgument<YAML::Node>(commandArguments, "Search", YAML::Node(YAML::NodeType::Undefined));
-    auto resolvedExecMetaData = resolveActionMetaData(commandArguments);
+  if (commandName == "spawn") {
+    return {{BehaviourOpCode::SPAWN, resolveString(commandArguments["0"].as<std::string>())}};
+  }
 
-    PathFinderConfig pathFinderConfig = configurePathFinder(searchNode, actionName);
+  throw std::invalid_argument(fmt::format("Unknown or badly defined command {0}.", commandName));
+}
 
-    auto actionExecutor = getActionExecutorFromString(executor);
+bool Object::evaluateCondition(const BehaviourCode &code, const std::shared_ptr<Action> &action, std::vector<const int32_t *> *variableReads) const {
+  const auto &operands = behaviourProgram_->operands;
+  bool condition = false;
+
+  for (size_t pc = 0; pc < code.size(); pc++) {
+    const auto &instruction = code[pc];
+    switch (instruction.opCode) {
+      case BehaviourOpCode::COMPARE:
+        // Comparisons skipped by short circuiting cannot change the result until one that was evaluated changes
+        if (variableReads != nullptr) {
+          for (auto operandIdx : {instruction.a, instruction.b}) {
+            const auto *variable = operands[operandIdx].resolveVariable(*this, action);
+            if (variable != nullptr) {
+              variableReads->push_back(variable);
+            }
+          }
+        }
+        condition = compare(instruction.conditionOp, operands[instruction.a].resolve(*this, action), operands[instruction.b].resolve(*this, action));
+        break;
+      case BehaviourOpCode::JUMP_IF_FALSE:
+        if (!condition) {
+          pc += instruction.jump;
+        }
+        break;
+      case BehaviourOpCode::JUMP_IF_TRUE:
+        if (condition) {
+          pc += instruction.jump;
+        }
+        break;
+      default:
+        throw std::invalid_argument("Conditions can only contain comparisons.");
+    }
+  }
 
-    auto delay = std::make_shared<ObjectVariable>(delayNode, availableVariables_);
-    auto actionId = std::make_shared<ObjectVariable>(actionIdNode, availableVariables_);
+  return condition;
+}
 
-    // Resolve source object
-    return [this, actionName, delay, randomize, actionId, actionExecutor, resolvedExecMetaData, pathFinderConfig](std::shared_ptr<Action> action) -> BehaviourResult {
-      InputMapping fallbackInputMapping;
-      fallbackInputMapping.vectorToDest = action->getVectorToDest();
-      fallbackInputMapping.orientationVector = action->getOrientationVector();
+bool Object::executeBehaviourCode(const BehaviourCode &code, const std::shared_ptr<Action> &action, PlayerRewards &rewardAccumulator) {
+  const auto &behaviourProgram = *behaviourProgram_;
+  const auto &operands = behaviourProgram.operands;
+  bool condition = false;
+
+  for (size_t pc = 0; pc < code.size(); pc++) {
+    const auto &instruction = code[pc];
+    switch (instruction.opCode) {
+      case BehaviourOpCode::NOP:
+        break;
+
+      case BehaviourOpCode::PRINT: {
+        std::stringstream printline;
+        for (auto operandIdx = instruction.a; operandIdx < instruction.a + instruction.b; operandIdx++) {
+          printline << " " << operands[operandIdx].resolveString(*this, action);
+        }
+        spdlog::info(printline.str());
+      } break;
 
-      // Resolve metaData variables if they exist
-      for (const auto &resolvedExecMetaDataIt : resolvedExecMetaData) {
-        fallbackInputMapping.metaData[resolvedExecMetaDataIt.first] = resolvedExecMetaDataIt.second->resolve(action);
-      }
+      case BehaviourOpCode::REWARD: {
+        // if the object has a player Id, the reward will be given to that object's player,
+        // otherwise the reward will be given to the player which has performed the action
+        auto rewardPlayer = getPlayerId() == 0 ? action->getOriginatingPlayerId() : getPlayerId();
 
-      SingleInputMapping inputMapping;
-      if (pathFinderConfig.pathFinder != nullptr) {
-        spdlog::debug("Executing action based on PathFinder");
-        auto endLocation = pathFinderConfig.endLocation;
-        if (pathFinderConfig.collisionDetector != nullptr) {
-          auto searchResult = pathFinderConfig.collisionDetector->search(getLocation());
+        if (rewardPlayer == 0) {
+          spdlog::warn("Misconfigured 'reward' for object '{0}' will not be assigned to a player.", action->getSourceObject()->getDescription());
+          break;
+        }
 
-          if (searchResult.objectSet.empty()) {
-            spdlog::debug("Cannot find target object for pathfinding!");
-            return {};
-          }
+        rewardAccumulator[rewardPlayer] += operands[instruction.a].resolve(*this, action);
+      } break;
+
+      case BehaviourOpCode::CHANGE_TO: {
+        const auto &objectName = behaviourProgram.strings[instruction.a];
+        spdlog::debug("Changing object={0} to {1}", getObjectName(), objectName);
+        auto playerId = getPlayerId();
+        auto location = getLocation();
+        auto newObject = objectGenerator_->newInstance(objectName, playerId, grid());
+        removeObject();
+        grid()->addObject(location, newObject, true, action);
+      } break;
+
+      case BehaviourOpCode::ADD:
+        writeVariable(operands[instruction.a], action, operands[instruction.b].resolve(*this, action), true);
+        break;
+
+      case BehaviourOpCode::SUB:
+        writeVariable(operands[instruction.a], action, -operands[instruction.b].resolve(*this, action), true);
+        break;
+
+      case BehaviourOpCode::SET:
+        writeVariable(operands[instruction.a], action, operands[instruction.b].resolve(*this, action), false);
+        break;
+
+      case BehaviourOpCode::INCR:
+        writeVariable(operands[instruction.a], action, 1, true);
+        break;
+
+      case BehaviourOpCode::DECR:
+        writeVariable(operands[instruction.a], action, -1, true);
+        break;
+
+      case BehaviourOpCode::ROT_DIR:
+        grid()->recordObjectStateChange(shared_from_this());
+        orientation_.setOrientation(action->getOrientationVector());
+        grid()->updateStateHash(shared_from_this());
 
-          endLocation = searchResult.closestObjects.top().target->getLocation();
+        // redraw the current location
+        grid()->invalidateLocation(getLocation());
+        break;
+
+      case BehaviourOpCode::MOV_DEST:
+        if (!moveObject(action->getDestinationLocation())) {
+          return true;
         }
+        break;
 
-        spdlog::debug("Searching for path from [{0},{1}] to [{2},{3}] using action {4}", getLocation().x, getLocation().y, endLocation.x, endLocation.y, actionName);
+      case BehaviourOpCode::MOV_SRC:
+        if (!moveObject(action->getSourceLocation())) {
+          return true;
+        }
+        break;
 
-        auto searchResult = pathFinderConfig.pathFinder->search(getLocation(), endLocation, getObjectOrientation().getUnitVector(), pathFinderConfig.maxSearchDepth);
-        inputMapping = getInputMapping(actionName, searchResult.actionId, false, fallbackInputMapping);
-      } else {
-        inputMapping = getInputMapping(actionName, actionId->resolve(action), randomize, fallbackInputMapping);
-      }
+      case BehaviourOpCode::MOV:
+        if (!moveObject({operands[instruction.a].resolve(*this, action), operands[instruction.b].resolve(*this, action)})) {
+          return true;
+        }
+        break;
 
-      if (inputMapping.mappedToGrid) {
-        inputMapping.vectorToDest = inputMapping.destinationLocation - getLocation();
-      }
+      case BehaviourOpCode::CASCADE: {
+        auto cascadedAction = grid()->newAction(action->getActionNameId(), action->getOriginatingPlayerId(), action->getDelay(), action->getMetaData());
 
-      uint32_t execAsPlayerId = 0;
-      switch (actionExecutor) {
-        case ActionExecutor::ACTION_PLAYER_ID:
-          execAsPlayerId = action->getOriginatingPlayerId();
-          break;
-        case ActionExecutor::OBJECT_PLAYER_ID:
-          execAsPlayerId = getPlayerId();
-          break;
-        default:
-          break;
-      }
+        cascadedAction->init(action->getDestinationObject(), action->getVectorToDest(), action->getOrientationVector(), false);
 
-      std::shared_ptr<Action> newAction = std::make_shared<Action>(Action(grid(), actionName, execAsPlayerId, delay->resolve(action), inputMapping.metaData));
-      newAction->init(shared_from_this(), inputMapping.vectorToDest, inputMapping.orientationVector, inputMapping.relative);
+        auto sourceLocation = cascadedAction->getSourceLocation();
+        auto destinationLocation = cascadedAction->getDestinationLocation();
+        auto vectorToDest = action->getVectorToDest();
+        spdlog::debug("Cascade vector [{0},{1}]", vectorToDest.x, vectorToDest.y);
+        spdlog::debug("Cascading action to [{0},{1}], dst: [{2}, {3}]", sourceLocation.x, sourceLocation.y, destinationLocation.x, destinationLocation.y);
 
-      auto rewards = grid()->performActions(0, {newAction});
+        auto actionRewards = grid()->performActions(0, {cascadedAction});
+        accumulateRewards(rewardAccumulator, actionRewards);
+      } break;
+
+      case BehaviourOpCode::EXEC:
+        execute(behaviourProgram.execDefinitions[instruction.a], action, rewardAccumulator);
+        break;
+
+      case BehaviourOpCode::REMOVE:
+        spdlog::debug("remove");
+        removeObject();
+        break;
+
+      case BehaviourOpCode::SET_TILE: {
+        auto resolvedTileId = operands[instruction.a].resolve(*this, action);
+        spdlog::debug("Setting tile Id to: {0}", resolvedTileId);
+        grid()->recordObjectStateChange(shared_from_this());
+        setRenderTileId(resolvedTileId);
+        grid()->updateStateHash(shared_from_this());
+        grid()->invalidateLocation({*x_, *y_});
+        spdlog::debug("Tile id updated");
+      } break;
+
+      case BehaviourOpCode::SPAWN: {
+        const auto &objectName = behaviourProgram.strings[instruction.a];
+        auto destinationLocation = action->getDestinationLocation();
+        spdlog::debug("Spawning object={0} in location [{1},{2}]", objectName, destinationLocation.x, destinationLocation.y);
+        auto playerId = getPlayerId();
+
+        auto newObject = objectGenerator_->newInstance(objectName, playerId, grid());
+        grid()->addObject(destinationLocation, newObject, true, action);
+      } break;
+
+      case BehaviourOpCode::ABORT:
+        return true;
 
-      return {false, rewards};
-    };
+      case BehaviourOpCode::COMPARE:
+        condition = compare(instruction.conditionOp, operands[instruction.a].resolve(*this, action), operands[instruction.b].resolve(*this, action));
+        break;
+
+      case BehaviourOpCode::JUMP:
+        pc += instruction.jump;
+        break;
+
+      case BehaviourOpCode::JUMP_IF_FALSE:
+        if (!condition) {
+          pc += instruction.jump;
+        }
+        break;
+
+      case BehaviourOpCode::JUMP_IF_TRUE:
+        if (condition) {
+          pc += instruction.jump;
+        }
+        break;
+    }
   }
 
-  if (commandName == "remove") {
-    return [this](std::shared_ptr<Action> action) -> BehaviourResult {
-      spdlog::debug("remove");
-      removeObject();
-      return {};
-    };
+  return false;
+}
+
+void Object::execute(const ExecDefinition &execDefinition, const std::shared_ptr<Action> &action, PlayerRewards &rewardAccumulator) {
+  const auto &operands = behaviourProgram_->operands;
+  const auto &actionName = execDefinition.actionName;
+
+  InputMapping fallbackInputMapping;
+  fallbackInputMapping.vectorToDest = action->getVectorToDest();
+  fallbackInputMapping.orientationVector = action->getOrientationVector();
+
+  // Resolve metaData variables if they exist
+  for (const auto &metaDataIt : execDefinition.metaData) {
+    fallbackInputMapping.metaData[metaDataIt.first] = operands[metaDataIt.second].resolve(*this, action);
   }
 
-  if (commandName == "set_tile") {
-    auto variablePointers = resolveVariables(commandArguments);
+  SingleInputMapping inputMapping;
+  if (execDefinition.pathFinderIdx >= 0) {
+    spdlog::debug("Executing action based on PathFinder");
+    const auto &pathFinderConfig = pathFinderConfigs_.at(execDefinition.pathFinderIdx);
+    auto endLocation = pathFinderConfig.endLocation;
+    if (pathFinderConfig.targetObjectIndex != nullptr) {
+      auto closestObject = pathFinderConfig.targetObjectIndex->searchClosest(getLocation());
+
+      if (closestObject == nullptr) {
+        spdlog::debug("Cannot find target object for pathfinding!");
+        return;
+      }
+
+      endLocation = closestObject->getLocation();
+    }
 
-    auto tileId = variablePointers["0"];
+    spdlog::debug("Searching for path from [{0},{1}] to [{2},{3}] using action {4}", getLocation().x, getLocation().y, endLocation.x, endLocation.y, actionName);
 
-    return [this, tileId](std::shared_ptr<Action> action) -> BehaviourResult {
-      auto resolvedTileId = tileId->resolve(action);
-      spdlog::debug("Setting tile Id to: {0}", resolvedTileId);
-      setRenderTileId(resolvedTileId);
-      grid()->invalidateLocation({*x_, *y_});
-      spdlog::debug("Tile id updated");
-      return {};
-    };
+    auto searchResult = pathFinderConfig.pathFinder->search(getLocation(), endLocation, getObjectOrientation().getUnitVector(), pathFinderConfig.maxSearchDepth);
+    inputMapping = getInputMapping(actionName, searchResult.actionId, false, fallbackInputMapping);
+  } else {
+    inputMapping = getInputMapping(actionName, operands[execDefinition.actionId].resolve(*this, action), execDefinition.randomize, fallbackInputMapping);
   }
 
-  if (commandName == "spawn") {
-    auto objectName = commandArguments["0"].as<std::string>();
-    return [this, objectName](std::shared_ptr<Action> action) -> BehaviourResult {
-      auto destinationLocation = action->getDestinationLocation();
-      spdlog::debug("Spawning object={0} in location [{1},{2}]", objectName, destinationLocation.x, destinationLocation.y);
-      auto playerId = getPlayerId();
+  if (inputMapping.mappedToGrid) {
+    inputMapping.vectorToDest = inputMapping.destinationLocation - getLocation();
+  }
 
-      auto newObject = objectGenerator_->newInstance(objectName, playerId, grid());
-      grid()->addObject(destinationLocation, newObject, true, action);
-      return {};
-    };
+  uint32_t execAsPlayerId = 0;
+  switch (execDefinition.executor) {
+    case ActionExecutor::ACTION_PLAYER_ID:
+      execAsPlayerId = action->getOriginatingPlayerId();
+      break;
+    case ActionExecutor::OBJECT_PLAYER_ID:
+      execAsPlayerId = getPlayerId();
+      break;
+    default:
+      break;
   }
 
-  throw std::invalid_argument(fmt::format("Unknown or badly defined command {0}.", commandName));
+  auto newAction = grid()->newAction(execDefinition.actionNameId, execAsPlayerId, operands[execDefinition.delay].resolve(*this, action), inputMapping.metaData);
+  newAction->init(shared_from_this(), inputMapping.vectorToDest, inputMapping.orientationVector, inputMapping.relative);
+
+  auto rewards = grid()->performActions(0, {newAction});
+  accumulateRewards(rewardAccumulator, rewards);
 }
 
 void Object::addPrecondition(const std::string &actionName, uint32_t behaviourIdx, const std::string &destinationObjectName, YAML::Node &conditionsNode) {
   spdlog::debug("Adding action precondition when action={0} is performed on object={1} by object={2}", actionName, destinationObjectName, getObjectName());
-  auto preconditionFunction = processConditions(conditionsNode, true, LogicOp::AND);
-  actionPreconditions_[actionName][destinationObjectName][behaviourIdx] = preconditionFunction;
+  auto &behaviourProgram = getMutableBehaviourProgram();
+  auto actionNameId = SymbolTable::actionNames().intern(actionName);
+  auto destinationObjectNameId = SymbolTable::objectNames().intern(destinationObjectName);
+  behaviourProgram.actionPreconditions.at(actionNameId, destinationObjectNameId)[behaviourIdx] = processConditions(conditionsNode, true, LogicOp::AND);
 }
 
 void Object::addActionSrcBehaviour(
@@ -598,11 +617,17 @@ void Object::addActionSrcBehaviour(
     CommandList conditionalCommands) {
   spdlog::debug("Adding behaviour command={0} when action={1} is performed on object={2} by object={3}", commandName, actionName, destinationObjectName, getObjectName());
 
-  // This object can perform this action
-  availableActionNames_.insert(actionName);
+  auto &behaviourProgram = getMutableBehaviourProgram();
 
-  auto behaviourFunction = instantiateConditionalBehaviour(commandName, commandArguments, conditionalCommands);
-  srcBehaviours_[actionName][destinationObjectName][behaviourIdx].push_back(behaviourFunction);
+  // This object can perform this action
+  behaviourProgram.availableActionNames.insert(actionName);
+
+  auto behaviourCode = compileConditionalBehaviour(commandName, commandArguments, conditionalCommands);
+  auto actionNameId = SymbolTable::actionNames().intern(actionName);
+  auto destinationObjectNameId = SymbolTable::objectNames().intern(destinationObjectName);
+  auto &code = behaviourProgram.srcBehaviours.at(actionNameId, destinationObjectNameId)[behaviourIdx];
+  code.insert(code.end(), behaviourCode.begin(), behaviourCode.end());
+  bindPathFinders();
 }
 
 void Object::addActionDstBehaviour(
@@ -614,17 +639,21 @@ void Object::addActionDstBehaviour(
     CommandList conditionalCommands) {
   spdlog::debug("Adding behaviour command={0} when object={1} performs action={2} on object={3}", commandName, sourceObjectName, actionName, getObjectName());
 
-  auto behaviourFunction = instantiateConditionalBehaviour(commandName, commandArguments, conditionalCommands);
-  dstBehaviours_[actionName][sourceObjectName][behaviourIdx].push_back(behaviourFunction);
+  auto &behaviourProgram = getMutableBehaviourProgram();
+  auto behaviourCode = compileConditionalBehaviour(commandName, commandArguments, conditionalCommands);
+  auto actionNameId = SymbolTable::actionNames().intern(actionName);
+  auto sourceObjectNameId = SymbolTable::objectNames().intern(sourceObjectName);
+  auto &code = behaviourProgram.dstBehaviours.at(actionNameId, sourceObjectNameId)[behaviourIdx];
+  code.insert(code.end(), behaviourCode.begin(), behaviourCode.end());
+  bindPathFinders();
 }
 
-std::vector<uint32_t> Object::getValidBehaviourIdxs(std::shared_ptr<Action> action) const {
-  std::vector<uint32_t> validBehaviourIdxs{};
-  const auto& actionName = action->getActionName();
+bool Object::findActionBehaviours(const std::shared_ptr<Action>& action, const BehaviourCodeByIdx*& destBehaviours, const BehaviourCodeByIdx*& preconditions) const {
+  auto actionNameId = action->getActionNameId();
   auto destinationObject = action->getDestinationObject();
 
-  std::string destinationObjectName = destinationObject->getObjectName();
-  if (destinationObjectName == "_empty") {
+  auto destinationObjectNameId = destinationObject->getObjectNameId();
+  if (destinationObjectNameId == EMPTY_OBJECT_ID) {
     auto width = grid()->getWidth();
     auto height = grid()->getHeight();
 
@@ -633,56 +662,52 @@ std::vector<uint32_t> Object::getValidBehaviourIdxs(std::shared_ptr<Action> acti
     auto destinationLocation = action->getDestinationLocation();
     if (destinationLocation.x >= width || destinationLocation.x < 0 ||
         destinationLocation.y >= height || destinationLocation.y < 0) {
-      destinationObjectName = "_boundary";
+      destinationObjectNameId = BOUNDARY_OBJECT_ID;
     }
   }
 
-  spdlog::debug("Checking preconditions for action [{0}] -> {1} -> {2}", getObjectName(), actionName, destinationObjectName);
+  spdlog::debug("Checking preconditions for action [{0}] -> {1} -> {2}", getObjectName(), action->getActionName(), destinationObjectNameId);
 
   // There are no source behaviours for this action, so this action cannot happen
-  auto it = srcBehaviours_.find(actionName);
-  if (it == srcBehaviours_.end()) {
-    spdlog::debug("No source behaviours for action {0} on object {1}", actionName, objectName_);
-    return {};
+  if (behaviourProgram_ == nullptr) {
+    spdlog::debug("No source behaviours for action {0} on object {1}", action->getActionName(), objectName_);
+    return false;
   }
 
   // Check the source behaviours against the destination object
-  const auto &destBehavioursIt = it->second.find(destinationObjectName);
-  if (destBehavioursIt == it->second.end()) {
-    spdlog::debug("No destination behaviours for object {0} performing action {1} on object {2}", objectName_, actionName, destinationObjectName);
-    return {};
+  destBehaviours = behaviourProgram_->srcBehaviours.find(actionNameId, destinationObjectNameId);
+  if (destBehaviours == nullptr) {
+    spdlog::debug("No destination behaviours for object {0} performing action {1} on object {2}", objectName_, action->getActionName(), destinationObjectNameId);
+    return false;
   }
 
-  // Check for preconditions
-  auto preconditionsForActionIt = actionPreconditions_.find(actionName);
+  preconditions = behaviourProgram_->actionPreconditions.find(actionNameId, destinationObjectNameId);
+  return true;
+}
 
-  // If there are no preconditions then we just let the action happen
-  if (preconditionsForActionIt == actionPreconditions_.end()) {
-    spdlog::debug("No preconditions found, returning all {0} possible actions", destBehavioursIt->second.size());
-    for (const auto behaviourIdx : destBehavioursIt->second) {
-      validBehaviourIdxs.push_back(behaviourIdx.first);
-    }
+std::vector<uint32_t> Object::getValidBehaviourIdxs(const std::shared_ptr<Action>& action) const {
+  std::vector<uint32_t> validBehaviourIdxs{};
 
-    return validBehaviourIdxs;
+  const BehaviourCodeByIdx *destBehaviours = nullptr;
+  const BehaviourCodeByIdx *preconditions = nullptr;
+  if (!findActionBehaviours(action, destBehaviours, preconditions)) {
+    return {};
   }
 
-  auto &preconditionsForAction = preconditionsForActionIt->second;
-  spdlog::debug("{0} preconditions found.", preconditionsForAction.size());
-
-  auto preconditionsForActionAndDestinationObjectIt = preconditionsForAction.find(destinationObjectName);
-  if (preconditionsForActionAndDestinationObjectIt == preconditionsForAction.end()) {
-    spdlog::debug("Precondition found, but not with destination object {0}. Passing.", destinationObjectName);
-    for (const auto behaviourIdx : destBehavioursIt->second) {
+  // If there are no preconditions then we just let the action happen
+  if (preconditions == nullptr) {
+    spdlog::debug("No preconditions found, returning all {0} possible actions", destBehaviours->size());
+    for (const auto &behaviourIdx : *destBehaviours) {
       validBehaviourIdxs.push_back(behaviourIdx.first);
     }
 
     return validBehaviourIdxs;
   }
 
-  auto &preconditions = preconditionsForActionAndDestinationObjectIt->second;
+  spdlog::debug("{0} preconditions found.", preconditions->size());
 
-  for (const auto &behaviourPreconditionIt : preconditions) {
-    if (behaviourPreconditionIt.second(action)) {
+  for (const auto &behaviourPreconditionIt : *preconditions) {
+    if (evaluateCondition(behaviourPreconditionIt.second, action)) {
       validBehaviourIdxs.push_back(behaviourPreconditionIt.first);
     }
   }
@@ -690,13 +715,60 @@ std::vector<uint32_t> Object::getValidBehaviourIdxs(std::shared_ptr<Action> acti
   return validBehaviourIdxs;
 }
 
-bool Object::isValidAction(std::shared_ptr<Action> action) const {
+bool Object::isValidAction(const std::shared_ptr<Action>& action) const {
   if (getValidBehaviourIdxs(action).size() > 0) {
     return true;
   } 
   return false;
 }
 
+bool Object::isValidAction(const std::shared_ptr<Action>& action, PreconditionCache& preconditionCache) const {
+  const BehaviourCodeByIdx *destBehaviours = nullptr;
+  const BehaviourCodeByIdx *preconditions = nullptr;
+  if (!findActionBehaviours(action, destBehaviours, preconditions)) {
+    return false;
+  }
+
+  if (preconditions == nullptr) {
+    return true;
+  }
+
+  for (const auto &behaviourPreconditionIt : *preconditions) {
+    const auto *precondition = &behaviourPreconditionIt.second;
+    auto &entries = preconditionCache.entries;
+    auto cachedIt = std::find_if(entries.begin(), entries.end(), [precondition](const PreconditionCacheEntry &entry) {
+      return entry.precondition == precondition;
+    });
+
+    bool result;
+    if (cachedIt == entries.end()) {
+      result = evaluateCondition(*precondition, action, preconditionCache.variableReads);
+      entries.push_back({precondition, isSourceOnlyCondition(*precondition), result});
+    } else if (cachedIt->sourceOnly) {
+      result = cachedIt->result;
+    } else {
+      result = evaluateCondition(*precondition, action, preconditionCache.variableReads);
+    }
+
+    if (result) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool Object::isSourceOnlyCondition(const BehaviourCode &code) const {
+  const auto &operands = behaviourProgram_->operands;
+  for (const auto &instruction : code) {
+    if (instruction.opCode == BehaviourOpCode::COMPARE &&
+        (operands[instruction.a].dependsOnActionTarget() || operands[instruction.b].dependsOnActionTarget())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 std::unordered_map<std::string, std::shared_ptr<int32_t>> Object::getAvailableVariables() const {
   return availableVariables_;
 }
@@ -759,7 +831,7 @@ SingleInputMapping Object::getInputMapping(const std::string &actionName, uint32
 
   // Add metadata keys from fallback, only if they are not aleady present
   for (const auto &metaDataIt : fallback.metaData) {
-    auto key = metaDataIt.first;
+    const auto &key = metaDataIt.first;
     if (resolvedInputMapping.metaData.find(key) == resolvedInputMapping.metaData.end()) {
       resolvedInputMapping.metaData[key] = metaDataIt.second;
     }
@@ -772,6 +844,27 @@ void Object::setInitialActionDefinitions(std::vector<InitialActionDefinition> in
   initialActionDefinitions_ = initialActionDefinitions;
 }
 
+void Object::addPendingDelayedAction(uint32_t executionTick, const Action *action) {
+  pendingDelayedActions_.push_back({executionTick, action});
+}
+
+void Object::removePendingDelayedAction(const Action *action) {
+  auto pendingIt = std::find_if(pendingDelayedActions_.begin(), pendingDelayedActions_.end(), [action](const PendingDelayedAction &pending) {
+    return pending.action == action;
+  });
+
+  if (pendingIt != pendingDelayedActions_.end()) {
+    *pendingIt = pendingDelayedActions_.back();
+    pendingDelayedActions_.pop_back();
+  }
+}
+
+std::vector<PendingDelayedAction> Object::takePendingDelayedActions() {
+  std::vector<PendingDelayedAction> pendingDelayedActions;
+  pendingDelayedActions.swap(pendingDelayedActions_);
+  return pendingDelayedActions;
+}
+
 std::vector<std::shared_ptr<Action>> Object::getInitialActions(std::shared_ptr<Action> originatingAction = nullptr) {
   std::vector<std::shared_ptr<Action>> initialActions;
 
@@ -788,7 +881,7 @@ std::vector<std::shared_ptr<Action>> Object::getInitialActions(std::shared_ptr<A
 
     auto inputMapping = getInputMapping(actionDefinition.actionName, actionDefinition.actionId, actionDefinition.randomize, fallbackInputMapping);
 
-    auto action = std::make_shared<Action>(Action(grid(), actionDefinition.actionName, 0, actionDefinition.delay, inputMapping.metaData));
+    auto action = grid()->newAction(actionDefinition.actionNameId, 0, actionDefinition.delay, inputMapping.metaData);
     if (inputMapping.mappedToGrid) {
       inputMapping.vectorToDest = inputMapping.destinationLocation - getLocation();
     }
@@ -811,62 +904,117 @@ C Object::getCommandArgument(CommandArguments &commandArguments, std::string com
   return commandArgumentIt->second.as<C>(defaultValue);
 }
 
-std::unordered_map<std::string, std::shared_ptr<ObjectVariable>> Object::resolveActionMetaData(CommandArguments &commandArguments) {
+std::vector<std::pair<std::string, uint32_t>> Object::resolveActionMetaData(CommandArguments &commandArguments) const {
   auto commandArgumentIt = commandArguments.find("MetaData");
   if (commandArgumentIt == commandArguments.end()) {
     return {};
   }
 
-  std::unordered_map<std::string, std::shared_ptr<ObjectVariable>> resolvedMetaData{};
+  std::vector<std::pair<std::string, uint32_t>> resolvedMetaData{};
   auto metaDataNode = commandArguments.at("MetaData");
   if (metaDataNode.IsDefined()) {
     for (YAML::const_iterator it = metaDataNode.begin(); it != metaDataNode.end(); ++it) {
-      auto key = it->first.as<std::string>();
-      resolvedMetaData[key] = std::make_shared<ObjectVariable>(ObjectVariable(it->second, availableVariables_));
+      resolvedMetaData.emplace_back(it->first.as<std::string>(), resolveOperand(it->second));
     }
   }
 
   return resolvedMetaData;
 }
 
-PathFinderConfig Object::configurePathFinder(YAML::Node &searchNode, std::string actionName) {
-  PathFinderConfig config;
-  if (searchNode.IsDefined()) {
-    spdlog::debug("Configuring path finder for action {0}", actionName);
+int32_t Object::definePathFinder(YAML::Node &searchNode, std::string actionName) {
+  if (!searchNode.IsDefined()) {
+    return -1;
+  }
 
-    auto targetObjectNameNode = searchNode["TargetObjectName"];
+  spdlog::debug("Defining path finder for action {0}", actionName);
 
-    if (targetObjectNameNode.IsDefined()) {
-      auto targetObjectName = targetObjectNameNode.as<std::string>();
+  PathFinderDefinition definition;
+  definition.actionName = actionName;
 
-      spdlog::debug("Path finder target object: {0}", targetObjectName);
+  auto targetObjectNameNode = searchNode["TargetObjectName"];
+  if (targetObjectNameNode.IsDefined()) {
+    definition.targetObjectName = targetObjectNameNode.as<std::string>();
+    spdlog::debug("Path finder target object: {0}", definition.targetObjectName);
+  }
 
-      spdlog::debug("Grid height: {0}", grid()->getHeight());
+  auto impassableObjectsList = singleOrListNodeToList(searchNode["ImpassableObjects"]);
+  definition.impassableObjects = std::set<std::string>(impassableObjectsList.begin(), impassableObjectsList.end());
 
-      // Just make the range really large so we always look in all cells
-      auto range = std::max(grid()->getWidth(), grid()->getHeight());
+  definition.maxSearchDepth = searchNode["MaxDepth"].as<uint32_t>(100);
+  definition.mode = getPathFinderModeFromString(searchNode["Mode"].as<std::string>("SEEK"));
+  definition.algorithm = getPathFinderAlgorithmFromString(searchNode["Algorithm"].as<std::string>("ASTAR"));
 
-      config.collisionDetector = std::make_shared<SpatialHashCollisionDetector>(SpatialHashCollisionDetector(grid()->getWidth(), grid()->getHeight(), 10, range, TriggerType::RANGE_BOX_AREA));
+  if (searchNode["TargetLocation"].IsDefined()) {
+    auto targetEndLocation = singleOrListNodeToList<uint32_t>(searchNode["TargetLocation"]);
+    definition.endLocation = glm::ivec2(targetEndLocation[0], targetEndLocation[1]);
+  }
+
+  auto &pathFinderDefinitions = behaviourProgram_->pathFinderDefinitions;
+  pathFinderDefinitions.push_back(definition);
+  return static_cast<int32_t>(pathFinderDefinitions.size() - 1);
+}
+
+PathFinderConfig Object::configurePathFinder(const PathFinderDefinition &pathFinderDefinition) {
+  PathFinderConfig config;
+  const auto &actionName = pathFinderDefinition.actionName;
+  spdlog::debug("Configuring path finder for action {0}", actionName);
+
+  const auto &actionInputDefinitions = objectGenerator_->getActionInputDefinitions();
+  auto actionInputDefinitionIt = actionInputDefinitions.find(actionName);
+  if (actionInputDefinitionIt == actionInputDefinitions.end()) {
+    auto errorString = fmt::format("Path finder action {0} not found in input definitions.", actionName);
+    spdlog::error(errorString);
+    throw std::invalid_argument(errorString);
+  }
 
-      if (config.collisionDetector != nullptr) {
-        grid()->addCollisionDetector({targetObjectName}, actionName + generateRandomString(5), config.collisionDetector);
+  config.maxSearchDepth = pathFinderDefinition.maxSearchDepth;
+  config.mode = pathFinderDefinition.mode;
+  config.endLocation = pathFinderDefinition.endLocation;
+
+  if (pathFinderDefinition.algorithm == PathFinderAlgorithm::FLOW_FIELD) {
+    if (!pathFinderDefinition.targetObjectName.empty() && !actionInputDefinitionIt->second.relative) {
+      const auto &targetObjectName = pathFinderDefinition.targetObjectName;
+      const auto &impassableObjects = pathFinderDefinition.impassableObjects;
+
+      auto flowFieldKey = FlowField::getKey(actionName, targetObjectName, impassableObjects);
+      auto flowField = grid()->getFlowField(flowFieldKey);
+      if (flowField == nullptr) {
+        flowField = std::make_shared<FlowField>(targetObjectName, impassableObjects, FlowFieldPathFinder::getMoveVectors(actionInputDefinitionIt->second));
+        grid()->addFlowField(flowFieldKey, flowField);
       }
+
+      config.pathFinder = std::make_shared<FlowFieldPathFinder>(grid(), impassableObjects, actionInputDefinitionIt->second, config.mode, flowField);
+      return config;
     }
 
-    auto impassableObjectsList = singleOrListNodeToList(searchNode["ImpassableObjects"]);
+    spdlog::warn("Flow field path finding for action {0} needs a TargetObjectName and actions that are not relative, using A* instead.", actionName);
+  }
 
-    std::set<std::string> impassableObjectsSet(impassableObjectsList.begin(), impassableObjectsList.end());
-    const auto &actionInputDefinitions = objectGenerator_->getActionInputDefinitions();
-    auto actionInputDefinitionIt = actionInputDefinitions.find(actionName);
+  bool incremental = pathFinderDefinition.algorithm == PathFinderAlgorithm::INCREMENTAL;
+  if (incremental && (config.mode != PathFinderMode::SEEK || actionInputDefinitionIt->second.relative)) {
+    spdlog::warn("Incremental path finding for action {0} needs SEEK mode and actions that are not relative, using A* instead.", actionName);
+    incremental = false;
+  }
 
-    config.maxSearchDepth = searchNode["MaxDepth"].as<uint32_t>(100);
-    config.mode = getPathFinderModeFromString(searchNode["Mode"].as<std::string>("SEEK"));
-    config.pathFinder = std::make_shared<AStarPathFinder>(AStarPathFinder(grid(), impassableObjectsSet, actionInputDefinitionIt->second, config.mode));
+  if (!pathFinderDefinition.targetObjectName.empty()) {
+    config.targetObjectIndex = grid()->getNearestObjectIndex(pathFinderDefinition.targetObjectName);
+  }
 
-    if (searchNode["TargetLocation"].IsDefined()) {
-      auto targetEndLocation = singleOrListNodeToList<uint32_t>(searchNode["TargetLocation"]);
-      config.endLocation = glm::ivec2(targetEndLocation[0], targetEndLocation[1]);
+  if (incremental) {
+    config.pathFinder = std::make_shared<DStarLitePathFinder>(grid(), pathFinderDefinition.impassableObjects, actionInputDefinitionIt->second, config.mode);
+  } else if (config.mode == PathFinderMode::SEEK && JumpPointPathFinder::supports(actionInputDefinitionIt->second)) {
+    // Finds paths just as short as A* while expanding far fewer tiles
+    const auto &impassableObjects = pathFinderDefinition.impassableObjects;
+    auto passabilityMapKey = PassabilityMap::getKey(impassableObjects);
+    auto passabilityMap = grid()->getPassabilityMap(passabilityMapKey);
+    if (passabilityMap == nullptr) {
+      passabilityMap = std::make_shared<PassabilityMap>(impassableObjects);
+      grid()->addPassabilityMap(passabilityMapKey, passabilityMap);
     }
+
+    config.pathFinder = std::make_shared<JumpPointPathFinder>(grid(), impassableObjects, actionInputDefinitionIt->second, config.mode, passabilityMap);
+  } else {
+    config.pathFinder = std::make_shared<AStarPathFinder>(AStarPathFinder(grid(), pathFinderDefinition.impassableObjects, actionInputDefinitionIt->second, config.mode));
   }
 
   return config;
@@ -881,6 +1029,7 @@ bool Object::moveObject(glm::ivec2 newLocation) {
     *x_ = newLocation.x;
     *y_ = newLocation.y;
     location_ = glm::ivec2(*x_, *y_);
+    grid()->updateStateHash(shared_from_this());
     return true;
   }
 
@@ -896,6 +1045,76 @@ uint32_t Object::getRenderTileId() const {
   return renderTileId_;
 }
 
+ObjectState Object::getObjectState() const {
+  return {location_, orientation_.getUnitVector(), renderTileId_, removed_};
+}
+
+void Object::setObjectState(const ObjectState &objectState) {
+  *x_ = objectState.location.x;
+  *y_ = objectState.location.y;
+  location_ = objectState.location;
+  orientation_.setOrientation(objectState.orientationVector);
+  if (renderTileId_ != objectState.renderTileId) {
+    setRenderTileId(objectState.renderTileId);
+  }
+  removed_ = objectState.removed;
+}
+
+uint64_t Object::getStateHash() const {
+  auto stateHash = mixHash(objectNameHash_);
+  stateHash = mixHash(stateHash ^ *playerId_);
+  stateHash = mixHash(stateHash ^ (static_cast<uint64_t>(static_cast<uint32_t>(location_.x)) << 32 | static_cast<uint32_t>(location_.y)));
+  stateHash = mixHash(stateHash ^ static_cast<uint64_t>(orientation_.getDirection()));
+  stateHash = mixHash(stateHash ^ renderTileId_);
+
+  // Summed so the order of the variables does not matter
+  uint64_t variablesHash = 0;
+  for (const auto &stateVariable : stateVariables_) {
+    variablesHash += mixHash(stateVariable.first ^ mixHash(static_cast<uint32_t>(*stateVariable.second)));
+  }
+
+  return mixHash(stateHash ^ variablesHash);
+}
+
+void Object::setStateVariables(const std::unordered_map<std::string, uint32_t> &variableDefinitions) {
+  stateVariables_.clear();
+  stateVariables_.reserve(variableDefinitions.size());
+  for (const auto &variableDefinition : variableDefinitions) {
+    auto variableIt = availableVariables_.find(variableDefinition.first);
+    if (variableIt != availableVariables_.end()) {
+      stateVariables_.emplace_back(std::hash<std::string>()(variableDefinition.first), variableIt->second);
+    }
+  }
+}
+
+void Object::getOwnedVariables(std::vector<std::shared_ptr<int32_t>> &variables) const {
+  variables.push_back(playerId_);
+  for (const auto &stateVariable : stateVariables_) {
+    variables.push_back(stateVariable.second);
+  }
+}
+
+uint64_t Object::getCachedStateHash() const {
+  return cachedStateHash_;
+}
+
+void Object::setCachedStateHash(uint64_t stateHash) {
+  cachedStateHash_ = stateHash;
+}
+
+void Object::writeVariable(const ObjectVariable &operand, const std::shared_ptr<Action> &action, int32_t value, bool relative) {
+  std::shared_ptr<Object> variableObject;
+  auto *variable = operand.resolveWritableVariable(shared_from_this(), action, variableObject);
+  if (variable == nullptr) {
+    // Action meta data is read only
+    return;
+  }
+
+  auto grid = this->grid();
+  grid->writeVariable(variable, relative ? *variable + value : value, variableObject);
+  grid->invalidateLocation(getLocation());
+}
+
 void Object::removeObject() {
   removed_ = true;
   grid()->removeObject(shared_from_this());
@@ -913,6 +1132,10 @@ const std::string &Object::getObjectName() const {
   return objectName_;
 }
 
+uint32_t Object::getObjectNameId() const {
+  return objectNameId_;
+}
+
 char Object::getMapCharacter() const {
   return mapCharacter_;
 }
@@ -934,7 +1157,83 @@ void Object::markAsPlayerAvatar() {
 }
 
 std::unordered_set<std::string> Object::getAvailableActionNames() const {
-  return availableActionNames_;
+  if (behaviourProgram_ == nullptr) {
+    return {};
+  }
+  return behaviourProgram_->availableActionNames;
+}
+
+std::shared_ptr<BehaviourProgram> Object::getBehaviourProgram() const {
+  return behaviourProgram_;
+}
+
+bool Object::bindBehaviourProgram(std::shared_ptr<BehaviourProgram> behaviourProgram) {
+  if (behaviourProgram->variableNames.size() != availableVariables_.size()) {
+    return false;
+  }
+
+  std::vector<std::shared_ptr<int32_t>> variableSlots;
+  variableSlots.reserve(behaviourProgram->variableNames.size());
+  for (const auto &variableName : behaviourProgram->variableNames) {
+    auto variableIt = availableVariables_.find(variableName);
+    if (variableIt == availableVariables_.end()) {
+      return false;
+    }
+    variableSlots.push_back(variableIt->second);
+  }
+
+  behaviourProgram_ = std::move(behaviourProgram);
+  variableSlots_ = std::move(variableSlots);
+  pathFinderConfigs_.clear();
+  bindPathFinders();
+  return true;
+}
+
+const std::shared_ptr<int32_t> &Object::getVariableSlot(uint32_t slotIdx) const {
+  return variableSlots_[slotIdx];
+}
+
+int32_t *Object::getVariableValueById(uint32_t variableNameId, const std::string &variableName) {
+  if (behaviourProgram_ != nullptr) {
+    const auto &variableNameSlots = behaviourProgram_->variableNameSlots;
+    if (variableNameId < variableNameSlots.size() && variableNameSlots[variableNameId] != BehaviourProgram::NO_VARIABLE_SLOT) {
+      return variableSlots_[variableNameSlots[variableNameId]].get();
+    }
+  }
+
+  // Objects without behaviours have no program to look the slot up in
+  return getVariableValue(variableName).get();
+}
+
+BehaviourProgram &Object::getMutableBehaviourProgram() {
+  if (behaviourProgram_ == nullptr) {
+    behaviourProgram_ = std::make_shared<BehaviourProgram>();
+    for (const auto &variable : availableVariables_) {
+      auto slot = static_cast<uint32_t>(behaviourProgram_->variableNames.size());
+      behaviourProgram_->variableSlots.insert({variable.first, slot});
+      behaviourProgram_->variableNames.push_back(variable.first);
+      variableSlots_.push_back(variable.second);
+
+      auto variableNameId = SymbolTable::variableNames().intern(variable.first);
+      auto &variableNameSlots = behaviourProgram_->variableNameSlots;
+      if (variableNameId >= variableNameSlots.size()) {
+        variableNameSlots.resize(variableNameId + 1, BehaviourProgram::NO_VARIABLE_SLOT);
+      }
+      variableNameSlots[variableNameId] = slot;
+    }
+  } else if (behaviourProgram_.use_count() > 1) {
+    // The program is shared with other objects, so copy it before adding to it
+    behaviourProgram_ = std::make_shared<BehaviourProgram>(*behaviourProgram_);
+  }
+
+  return *behaviourProgram_;
+}
+
+void Object::bindPathFinders() {
+  const auto &pathFinderDefinitions = behaviourProgram_->pathFinderDefinitions;
+  for (auto i = pathFinderConfigs_.size(); i < pathFinderDefinitions.size(); i++) {
+    pathFinderConfigs_.push_back(configurePathFinder(pathFinderDefinitions[i]));
+  }
 }
 
 std::shared_ptr<Grid> Object::grid() const {
@@ -965,4 +1264,18 @@ PathFinderMode Object::getPathFinderModeFromString(const std::string& modeString
   }
 }
 
+PathFinderAlgorithm Object::getPathFinderAlgorithmFromString(const std::string& algorithmString) const {
+  if (algorithmString == "ASTAR") {
+    return PathFinderAlgorithm::ASTAR;
+  } else if (algorithmString == "FLOW_FIELD") {
+    return PathFinderAlgorithm::FLOW_FIELD;
+  } else if (algorithmString == "INCREMENTAL") {
+    return PathFinderAlgorithm::INCREMENTAL;
+  } else {
+    auto errorString = fmt::format("Invalid Path Finder Algorithm choice '{0}'.", algorithmString);
+    spdlog::error(errorString);
+    throw std::invalid_argument(errorString);
+  }
+}
+
 }  // namespace griddly
\ No newline at end of file
@@ -5,20 +5,22 @@
 #include <glm/glm.hpp>
 #include <memory>
 #include <random>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "../Actions/ActionMetaData.hpp"
+#include "../../PlayerRewards.hpp"
 #include "../Actions/Direction.hpp"
 #include "../ConditionResolver.hpp"
 // #include "../../AStarPathFinder.hpp"
 #include "../YAMLUtils.hpp"
+#include "BehaviourProgram.hpp"
 #include "ObjectVariable.hpp"
 
 #define CommandArguments std::map<std::string, YAML::Node>
-#define BehaviourFunction std::function<BehaviourResult(const std::shared_ptr<Action>&)>
-#define BehaviourCondition std::function<bool(const std::shared_ptr<Action>&)>
 #define CommandList std::vector<std::pair<std::string, CommandArguments>>
 
 namespace griddly {
@@ -29,7 +31,7 @@ class ObjectGenerator;
 class InputMapping;
 class PathFinder;
 enum class PathFinderMode;
-class CollisionDetector;
+class NearestObjectIndex;
 
 struct InitialActionDefinition {
   std::string actionName;
@@ -37,6 +39,7 @@ struct InitialActionDefinition {
   uint32_t delay = 0;
   bool randomize = false;
   float executionProbability = 1.0;
+  uint32_t actionNameId = 0;
 };
 
 struct SingleInputMapping {
@@ -53,28 +56,56 @@ struct SingleInputMapping {
   glm::ivec2 destinationLocation{};
 
   // Action metadata
-  std::unordered_map<std::string, int32_t> metaData{};
+  ActionMetaData metaData{};
+};
+
+// Precondition results that can be shared between actions from the same source object.
+// Preconditions that only read the source object give the same result for every action id, so they are evaluated once.
+struct PreconditionCacheEntry {
+  const BehaviourCode* precondition = nullptr;
+  bool sourceOnly = false;
+  bool result = false;
+};
+
+struct PreconditionCache {
+  std::vector<PreconditionCacheEntry> entries;
+
+  // If set, the variables read while evaluating preconditions are appended to it
+  std::vector<const int32_t*>* variableReads = nullptr;
+
+  void clear() {
+    entries.clear();
+  }
 };
 
 struct BehaviourResult {
   bool abortAction = false;
-  std::unordered_map<uint32_t, int32_t> rewards{};
+  PlayerRewards rewards{};
+};
+
+// The state of an object that is not held in its variables, used by the grid to undo changes
+struct ObjectState {
+  glm::ivec2 location{};
+  glm::ivec2 orientationVector{};
+  uint32_t renderTileId = 0;
+  bool removed = false;
 };
 
-enum class ActionExecutor {
-  ACTION_PLAYER_ID,
-  OBJECT_PLAYER_ID,
+// A delayed action the object is the source of
+struct PendingDelayedAction {
+  uint32_t executionTick;
+  const Action* action;
 };
 
 struct PathFinderConfig {
   std::shared_ptr<PathFinder> pathFinder = nullptr;
-  std::shared_ptr<CollisionDetector> collisionDetector = nullptr;
+  std::shared_ptr<NearestObjectIndex> targetObjectIndex = nullptr;
   glm::ivec2 endLocation{0, 0};
   PathFinderMode mode;
   uint32_t maxSearchDepth = 100;
 };
 
-class Object : public std::enable_shared_from_this<Object>, ConditionResolver<BehaviourCondition> {
+class Object : public std::enable_shared_from_this<Object>, ConditionResolver<BehaviourCode> {
  public:
   virtual const glm::ivec2& getLocation() const;
 
@@ -84,6 +115,9 @@ class Object : public std::enable_shared_from_this<Object>, ConditionResolver<Be
 
   virtual const std::string& getObjectName() const;
 
+  // Id of the object's name in SymbolTable::objectNames()
+  virtual uint32_t getObjectNameId() const;
+
   virtual char getMapCharacter() const;
 
   virtual const std::string& getObjectRenderTileName() const;
@@ -104,17 +138,37 @@ class Object : public std::enable_shared_from_this<Object>, ConditionResolver<Be
 
   virtual uint32_t getRenderTileId() const;
 
+  virtual ObjectState getObjectState() const;
+
+  virtual void setObjectState(const ObjectState& objectState);
+
+  // Hash of the object's type, owner, location, orientation, render tile and state variables
+  virtual uint64_t getStateHash() const;
+
+  // Variables defined by the object's type rather than globally, these are part of the object's state hash
+  virtual void setStateVariables(const std::unordered_map<std::string, uint32_t>& variableDefinitions);
+
+  // Appends the variables that belong to this object rather than being shared with other objects
+  virtual void getOwnedVariables(std::vector<std::shared_ptr<int32_t>>& variables) const;
+
+  // The state hash this object currently contributes to the grid's state hash
+  uint64_t getCachedStateHash() const;
+  void setCachedStateHash(uint64_t stateHash);
+
   virtual void markAsPlayerAvatar();  // Set this object as a player avatar
 
-  virtual bool isValidAction(std::shared_ptr<Action> action) const;
+  virtual bool isValidAction(const std::shared_ptr<Action>& action) const;
 
-  virtual std::vector<uint32_t> getValidBehaviourIdxs(std::shared_ptr<Action> action) const;
+  // The cache must be cleared before it is used with a different source object
+  virtual bool isValidAction(const std::shared_ptr<Action>& action, PreconditionCache& preconditionCache) const;
+
+  virtual std::vector<uint32_t> getValidBehaviourIdxs(const std::shared_ptr<Action>& action) const;
 
   virtual void addPrecondition(const std::string& actionName, uint32_t behaviourIdx, const std::string& destinationObjectName, YAML::Node& conditionsNode);
 
-  virtual BehaviourResult onActionSrc(std::string destinationObjectName, std::shared_ptr<Action> action, std::vector<uint32_t> behaviourIdxs);
+  virtual BehaviourResult onActionSrc(uint32_t destinationObjectNameId, const std::shared_ptr<Action>& action, const std::vector<uint32_t>& behaviourIdxs);
 
-  virtual BehaviourResult onActionDst(std::shared_ptr<Action> action, std::vector<uint32_t> behaviourIdxs);
+  virtual BehaviourResult onActionDst(const std::shared_ptr<Action>& action, const std::vector<uint32_t>& behaviourIdxs);
 
   virtual void addActionSrcBehaviour(const std::string& action, uint32_t behaviourIdx, const std::string& destinationObjectName, const std::string& commandName, CommandArguments commandArguments, CommandList nestedCommands);
 
@@ -126,15 +180,33 @@ class Object : public std::enable_shared_from_this<Object>, ConditionResolver<Be
 
   virtual std::unordered_set<std::string> getAvailableActionNames() const;
 
+  virtual std::shared_ptr<BehaviourProgram> getBehaviourProgram() const;
+
+  // Share a compiled behaviour program, returns false if the program was compiled for a different set of variables
+  virtual bool bindBehaviourProgram(std::shared_ptr<BehaviourProgram> behaviourProgram);
+
+  const std::shared_ptr<int32_t>& getVariableSlot(uint32_t slotIdx) const;
+
+  // Looks a variable up by its interned name id (see SymbolTable::variableNames), falling back to the name
+  int32_t* getVariableValueById(uint32_t variableNameId, const std::string& variableName);
+
   // Initial actions for objects
   virtual std::vector<std::shared_ptr<Action>> getInitialActions(std::shared_ptr<Action> originatingAction);
   virtual void setInitialActionDefinitions(std::vector<InitialActionDefinition> actionDefinitions);
 
-  // Conditional functions
-  BehaviourResult executeBehaviourFunctionList(std::unordered_map<uint32_t, int32_t>& rewardAccumulator, const std::vector<BehaviourFunction>& behaviourList, const std::shared_ptr<Action>& action) const;
+  // Indexes the delayed actions of the object, so the grid can cancel them when the object is removed
+  virtual void addPendingDelayedAction(uint32_t executionTick, const Action* action);
+  virtual void removePendingDelayedAction(const Action* action);
+  virtual std::vector<PendingDelayedAction> takePendingDelayedActions();
+
+  // Runs compiled behaviour code, returns true if the action should be aborted
+  bool executeBehaviourCode(const BehaviourCode& code, const std::shared_ptr<Action>& action, PlayerRewards& rewardAccumulator);
 
   Object(std::string objectName, char mapCharacter, uint32_t playerId, uint32_t zIdx, std::unordered_map<std::string, std::shared_ptr<int32_t>> availableVariables, std::shared_ptr<ObjectGenerator> objectGenerator, std::weak_ptr<Grid> grid);
 
+  // The object generator interns the name once per object type and passes the id in
+  Object(std::string objectName, uint32_t objectNameId, char mapCharacter, uint32_t playerId, uint32_t zIdx, std::unordered_map<std::string, std::shared_ptr<int32_t>> availableVariables, std::shared_ptr<ObjectGenerator> objectGenerator, std::weak_ptr<Grid> grid);
+
   virtual ~Object();
 
  private:
@@ -148,6 +220,8 @@ class Object : public std::enable_shared_from_this<Object>, ConditionResolver<Be
 
   std::shared_ptr<int32_t> playerId_ = std::make_shared<int32_t>(0);
   const std::string objectName_;
+  size_t objectNameHash_;
+  uint32_t objectNameId_;
   const char mapCharacter_;
   const int32_t zIdx_;
   uint32_t renderTileId_ = 0;
@@ -156,23 +230,28 @@ class Object : public std::enable_shared_from_this<Object>, ConditionResolver<Be
 
   std::vector<InitialActionDefinition> initialActionDefinitions_;
 
-  // action -> destination -> [behaviour functions]
-  std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_map<uint32_t, std::vector<BehaviourFunction>>>> srcBehaviours_;
+  // Not owned, the grid removes actions from the index when they are executed or cancelled
+  std::vector<PendingDelayedAction> pendingDelayedActions_;
 
-  // action -> source -> [behaviour functions]
-  std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_map<uint32_t, std::vector<BehaviourFunction>>>> dstBehaviours_;
-
-  // action -> destination -> [precondition list]
-  std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_map<uint32_t, BehaviourCondition>>> actionPreconditions_;
+  // Compiled behaviours, possibly shared with other objects of the same type
+  std::shared_ptr<BehaviourProgram> behaviourProgram_;
 
   // The variables that are available in the object for behaviour commands to interact with
   std::unordered_map<std::string, std::shared_ptr<int32_t>> availableVariables_;
 
+  // (name hash, variable) of the variables defined by the object's type
+  std::vector<std::pair<size_t, std::shared_ptr<int32_t>>> stateVariables_;
+  uint64_t cachedStateHash_ = 0;
+
+  // availableVariables_ in the slot order of the behaviour program
+  std::vector<std::shared_ptr<int32_t>> variableSlots_;
+
+  // One path finder for each path finder definition in the behaviour program
+  std::vector<PathFinderConfig> pathFinderConfigs_;
+
   std::shared_ptr<Grid> grid() const;
   const std::weak_ptr<Grid> grid_;
 
-  std::unordered_set<std::string> availableActionNames_;
-
   const std::shared_ptr<ObjectGenerator> objectGenerator_;
 
   virtual bool moveObject(glm::ivec2 newLocation);
@@ -180,26 +259,50 @@ class Object : public std::enable_shared_from_this<Object>, ConditionResolver<Be
   virtual void removeObject();
   bool removed_ = false;
 
+  // Writes value to the operand, or adds it if relative, through the grid so it is journaled and hashed.
+  // Also marks this object's location to be redrawn
+  void writeVariable(const ObjectVariable& operand, const std::shared_ptr<Action>& action, int32_t value, bool relative);
+
   SingleInputMapping getInputMapping(const std::string& actionName, uint32_t actionId, bool randomize, InputMapping fallback);
 
-  PathFinderConfig configurePathFinder(YAML::Node& searchNode, std::string actionName);
+  BehaviourProgram& getMutableBehaviourProgram();
+
+  void bindPathFinders();
+
+  int32_t definePathFinder(YAML::Node& searchNode, std::string actionName);
+
+  PathFinderConfig configurePathFinder(const PathFinderDefinition& pathFinderDefinition);
 
   template <typename C>
   static C getCommandArgument(CommandArguments& commandArguments, std::string commandArgumentKey, C defaultValue);
 
-  std::unordered_map<std::string, std::shared_ptr<ObjectVariable>> resolveActionMetaData(CommandArguments& commandArguments);
+  std::vector<std::pair<std::string, uint32_t>> resolveActionMetaData(CommandArguments& commandArguments) const;
+
+  uint32_t resolveOperand(const YAML::Node& operandNode, bool allowStrings = false) const;
+  uint32_t resolveOperand(CommandArguments& commandArguments, const std::string& argumentKey, const std::string& commandName) const;
+  uint32_t resolveString(const std::string& value) const;
+
+  BehaviourCode resolveConditionArguments(ConditionOp conditionOp, YAML::Node& conditionArgumentsNode) const override;
+  BehaviourCode resolveAND(const std::vector<BehaviourCode>& conditionList) const override;
+  BehaviourCode resolveOR(const std::vector<BehaviourCode>& conditionList) const override;
+
+  BehaviourCode compileBehaviour(const std::string& commandName, CommandArguments& commandArguments);
+  BehaviourCode compileConditionalBehaviour(const std::string& commandName, CommandArguments& commandArguments, CommandList& subCommands);
+  BehaviourCode compileCommandList(YAML::Node& commandListNode);
+
+  bool evaluateCondition(const BehaviourCode& code, const std::shared_ptr<Action>& action, std::vector<const int32_t*>* variableReads = nullptr) const;
 
-  std::unordered_map<std::string, std::shared_ptr<ObjectVariable>> resolveVariables(CommandArguments& variables, bool allowStrings = false) const;
+  // True if none of the operands of the condition depend on the action's destination or meta data
+  bool isSourceOnlyCondition(const BehaviourCode& code) const;
 
-  BehaviourCondition resolveConditionArguments(const std::function<bool(int32_t, int32_t)> conditionFunction, YAML::Node& conditionArgumentsNode) const override;
-  BehaviourCondition resolveAND(const std::vector<BehaviourCondition>& conditionList) const override;
-  BehaviourCondition resolveOR(const std::vector<BehaviourCondition>& conditionList) const override;
+  // Finds the source behaviours and preconditions for the action, returns false if the object has no behaviours for it
+  bool findActionBehaviours(const std::shared_ptr<Action>& action, const BehaviourCodeByIdx*& destBehaviours, const BehaviourCodeByIdx*& preconditions) const;
 
-  BehaviourFunction instantiateBehaviour(const std::string& commandName, CommandArguments& commandArguments);
-  BehaviourFunction instantiateConditionalBehaviour(const std::string& commandName, CommandArguments& commandArguments, CommandList& subCommands);
+  void execute(const ExecDefinition& execDefinition, const std::shared_ptr<Action>& action, PlayerRewards& rewardAccumulator);
 
   ActionExecutor getActionExecutorFromString(const std::string& executorString) const;
   PathFinderMode getPathFinderModeFromString(const std::string& modeString) const;
+  PathFinderAlgorithm getPathFinderAlgorithmFromString(const std::string& algorithmString) const;
 };
 
 }  // namespace griddly
\ No newline at end of file
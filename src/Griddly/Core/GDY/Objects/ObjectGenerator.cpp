@@ -6,6 +6,7 @@
 #include <spdlog/fmt/fmt.h>
 
 #include "../../Grid.hpp"
+#include "../SymbolTable.hpp"
 #include "Object.hpp"
 
 namespace griddly {
@@ -13,6 +14,7 @@ ObjectGenerator::ObjectGenerator() {
   // Define the default _empty object
   ObjectDefinition emptyObjectDefinition;
   emptyObjectDefinition.objectName = "_empty";
+  emptyObjectDefinition.objectNameId = EMPTY_OBJECT_ID;
   emptyObjectDefinition.zIdx = 0;
   emptyObjectDefinition.variableDefinitions = {};
 
@@ -21,6 +23,7 @@ ObjectGenerator::ObjectGenerator() {
   // Define the default _boundary object
   ObjectDefinition boundaryObjectDefinition;
   boundaryObjectDefinition.objectName = "_boundary";
+  boundaryObjectDefinition.objectNameId = BOUNDARY_OBJECT_ID;
   boundaryObjectDefinition.zIdx = 0;
   boundaryObjectDefinition.variableDefinitions = {};
   objectDefinitions_.insert({"_boundary", std::make_shared<ObjectDefinition>(boundaryObjectDefinition)});
@@ -31,6 +34,7 @@ void ObjectGenerator::defineNewObject(std::string objectName, char mapCharacter,
 
   ObjectDefinition objectDefinition;
   objectDefinition.objectName = objectName;
+  objectDefinition.objectNameId = SymbolTable::objectNames().intern(objectName);
   objectDefinition.mapCharacter = mapCharacter;
   objectDefinition.zIdx = zIdx;
   objectDefinition.variableDefinitions = variableDefinitions;
@@ -45,12 +49,20 @@ void ObjectGenerator::defineActionBehaviour(
   spdlog::debug("Defining object {0} behaviour {1}:{2}", objectName, behaviourDefinition.actionName, behaviourDefinition.commandName);
   auto objectDefinition = getObjectDefinition(objectName);
   objectDefinition->actionBehaviourDefinitions.push_back(behaviourDefinition);
+
+  // Ids are assigned while loading rather than while the game is running
+  SymbolTable::actionNames().intern(behaviourDefinition.actionName);
+  SymbolTable::objectNames().intern(behaviourDefinition.sourceObjectName);
+  SymbolTable::objectNames().intern(behaviourDefinition.destinationObjectName);
+
+  std::atomic_store(&objectDefinition->behaviourProgram, std::shared_ptr<BehaviourProgram>());
 }
 
 void ObjectGenerator::addInitialAction(std::string objectName, std::string actionName, uint32_t actionId, uint32_t delay, bool randomize) {
   spdlog::debug("Defining object {0} initial action {1}", objectName, actionName);
   auto objectDefinition = getObjectDefinition(objectName);
   objectDefinition->initialActionDefinitions.push_back({actionName, actionId, delay, randomize});
+  objectDefinition->initialActionDefinitions.back().actionNameId = SymbolTable::actionNames().intern(actionName);
 }
 
 std::shared_ptr<Object> ObjectGenerator::cloneInstance(std::shared_ptr<Object> toClone, std::shared_ptr<Grid> grid) {
@@ -65,7 +77,9 @@ std::shared_ptr<Object> ObjectGenerator::cloneInstance(std::shared_ptr<Object> t
                 objectDefinition->actionBehaviourDefinitions.size());
 
   // Initialize the variables for the Object
+  const auto &globalVariables = grid->getGlobalVariables();
   std::unordered_map<std::string, std::shared_ptr<int32_t>> availableVariables;
+  availableVariables.reserve(objectDefinition->variableDefinitions.size() + globalVariables.size());
   for (auto &variableDefinitions : objectDefinition->variableDefinitions) {
     // Copy the variable from the old object
     auto copiedVariableValue = *toClone->getVariableValue(variableDefinitions.first);
@@ -74,12 +88,10 @@ std::shared_ptr<Object> ObjectGenerator::cloneInstance(std::shared_ptr<Object> t
     availableVariables.insert({variableDefinitions.first, initializedVariable});
   }
 
-  auto globalVariables = grid->getGlobalVariables();
-
   // Initialize global variables
-  for (auto &globalVariable : globalVariables) {
-    auto variableName = globalVariable.first;
-    auto globalVariableInstances = globalVariable.second;
+  for (const auto &globalVariable : globalVariables) {
+    const auto &variableName = globalVariable.first;
+    const auto &globalVariableInstances = globalVariable.second;
 
     if (globalVariableInstances.size() == 1) {
       spdlog::debug("Adding reference to global variable {0} to object {1}", variableName, objectName);
@@ -94,7 +106,8 @@ std::shared_ptr<Object> ObjectGenerator::cloneInstance(std::shared_ptr<Object> t
 
   auto objectZIdx = objectDefinition->zIdx;
   auto mapCharacter = objectDefinition->mapCharacter;
-  auto initializedObject = std::make_shared<Object>(Object(objectName, mapCharacter, playerId, objectZIdx, availableVariables, shared_from_this(), grid));
+  auto initializedObject = std::make_shared<Object>(objectName, objectDefinition->objectNameId, mapCharacter, playerId, objectZIdx, std::move(availableVariables), shared_from_this(), grid);
+  initializedObject->setStateVariables(objectDefinition->variableDefinitions);
 
   if (objectName == avatarObject_) {
     initializedObject->markAsPlayerAvatar();
@@ -102,38 +115,7 @@ std::shared_ptr<Object> ObjectGenerator::cloneInstance(std::shared_ptr<Object> t
 
   initializedObject->setRenderTileId(toClone->getRenderTileId());
 
-  for (auto &actionBehaviourDefinition : objectDefinition->actionBehaviourDefinitions) {
-    switch (actionBehaviourDefinition.behaviourType) {
-      case ActionBehaviourType::SOURCE:
-
-        if (actionBehaviourDefinition.actionPreconditionsNode.IsDefined()) {
-          // Adding the acion preconditions
-          initializedObject->addPrecondition(
-              actionBehaviourDefinition.actionName,
-              actionBehaviourDefinition.behaviourIdx,
-              actionBehaviourDefinition.destinationObjectName,
-              actionBehaviourDefinition.actionPreconditionsNode);
-        }
-
-        initializedObject->addActionSrcBehaviour(
-            actionBehaviourDefinition.actionName,
-            actionBehaviourDefinition.behaviourIdx,
-            actionBehaviourDefinition.destinationObjectName,
-            actionBehaviourDefinition.commandName,
-            actionBehaviourDefinition.commandArguments,
-            actionBehaviourDefinition.conditionalCommands);
-        break;
-      case ActionBehaviourType::DESTINATION:
-        initializedObject->addActionDstBehaviour(
-            actionBehaviourDefinition.actionName,
-            actionBehaviourDefinition.behaviourIdx,
-            actionBehaviourDefinition.sourceObjectName,
-            actionBehaviourDefinition.commandName,
-            actionBehaviourDefinition.commandArguments,
-            actionBehaviourDefinition.conditionalCommands);
-        break;
-    }
-  }
+  bindBehaviourProgram(objectDefinition, initializedObject);
 
   initializedObject->setInitialActionDefinitions(objectDefinition->initialActionDefinitions);
 
@@ -161,12 +143,12 @@ std::shared_ptr<Object> ObjectGenerator::newInstance(std::string objectName, uin
     availableVariables.insert({variableDefinitions.first, initializedVariable});
   }
 
-  auto globalVariables = grid->getGlobalVariables();
+  const auto &globalVariables = grid->getGlobalVariables();
 
   // Initialize global variables
-  for (auto &globalVariable : globalVariables) {
-    auto variableName = globalVariable.first;
-    auto globalVariableInstances = globalVariable.second;
+  for (const auto &globalVariable : globalVariables) {
+    const auto &variableName = globalVariable.first;
+    const auto &globalVariableInstances = globalVariable.second;
 
     spdlog::debug("Adding reference to global variable {0} to object {1}", variableName, objectName);
     if (globalVariableInstances.size() == 1) {
@@ -180,26 +162,46 @@ std::shared_ptr<Object> ObjectGenerator::newInstance(std::string objectName, uin
 
   auto objectZIdx = objectDefinition->zIdx;
   auto mapCharacter = objectDefinition->mapCharacter;
-  auto initializedObject = std::make_shared<Object>(Object(objectName, mapCharacter, playerId, objectZIdx, availableVariables, shared_from_this(), grid));
+  auto initializedObject = std::make_shared<Object>(objectName, objectDefinition->objectNameId, mapCharacter, playerId, objectZIdx, std::move(availableVariables), shared_from_this(), grid);
+  initializedObject->setStateVariables(objectDefinition->variableDefinitions);
 
   if (isAvatar) {
     initializedObject->markAsPlayerAvatar();
   }
 
+  bindBehaviourProgram(objectDefinition, initializedObject);
+
+  initializedObject->setInitialActionDefinitions(objectDefinition->initialActionDefinitions);
+
+  return initializedObject;
+}
+
+void ObjectGenerator::bindBehaviourProgram(const std::shared_ptr<ObjectDefinition> &objectDefinition, std::shared_ptr<Object> object) {
+  const auto &objectName = objectDefinition->objectName;
+
+  // Behaviours are compiled once per object type and then shared by every instance. A published program is never
+  // changed, objects copy it before adding to it, so binding it does not need a lock
+  auto behaviourProgram = std::atomic_load(&objectDefinition->behaviourProgram);
+  if (behaviourProgram != nullptr && object->bindBehaviourProgram(behaviourProgram)) {
+    return;
+  }
+
+  spdlog::debug("Compiling {0} behaviours for object {1}", objectDefinition->actionBehaviourDefinitions.size(), objectName);
+
   for (auto &actionBehaviourDefinition : objectDefinition->actionBehaviourDefinitions) {
     switch (actionBehaviourDefinition.behaviourType) {
       case ActionBehaviourType::SOURCE:
 
         if (actionBehaviourDefinition.actionPreconditionsNode.IsDefined()) {
           // Adding the acion preconditions
-          initializedObject->addPrecondition(
+          object->addPrecondition(
               actionBehaviourDefinition.actionName,
               actionBehaviourDefinition.behaviourIdx,
               actionBehaviourDefinition.destinationObjectName,
               actionBehaviourDefinition.actionPreconditionsNode);
         }
 
-        initializedObject->addActionSrcBehaviour(
+        object->addActionSrcBehaviour(
             actionBehaviourDefinition.actionName,
             actionBehaviourDefinition.behaviourIdx,
             actionBehaviourDefinition.destinationObjectName,
@@ -208,7 +210,7 @@ std::shared_ptr<Object> ObjectGenerator::newInstance(std::string objectName, uin
             actionBehaviourDefinition.conditionalCommands);
         break;
       case ActionBehaviourType::DESTINATION:
-        initializedObject->addActionDstBehaviour(
+        object->addActionDstBehaviour(
             actionBehaviourDefinition.actionName,
             actionBehaviourDefinition.behaviourIdx,
             actionBehaviourDefinition.sourceObjectName,
@@ -219,9 +221,11 @@ std::shared_ptr<Object> ObjectGenerator::newInstance(std::string objectName, uin
     }
   }
 
-  initializedObject->setInitialActionDefinitions(objectDefinition->initialActionDefinitions);
-
-  return initializedObject;
+  // Two threads may compile the same object type at once, either program can be published
+  behaviourProgram = object->getBehaviourProgram();
+  if (behaviourProgram != nullptr) {
+    std::atomic_store(&objectDefinition->behaviourProgram, behaviourProgram);
+  }
 }
 
 void ObjectGenerator::setAvatarObject(std::string objectName) {
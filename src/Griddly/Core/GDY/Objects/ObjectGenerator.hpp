@@ -30,11 +30,16 @@ struct ActionBehaviourDefinition {
 
 struct ObjectDefinition {
   std::string objectName;
+  uint32_t objectNameId = 0;
   char mapCharacter;
   std::unordered_map<std::string, uint32_t> variableDefinitions{};
   std::vector<ActionBehaviourDefinition> actionBehaviourDefinitions{};
   std::vector<InitialActionDefinition> initialActionDefinitions{};
   uint32_t zIdx = 0;
+
+  // Compiled by the first instance and then shared by every instance. Games stepped on different threads can share
+  // the generator, so this is only read and written with std::atomic_load and std::atomic_store
+  std::shared_ptr<BehaviourProgram> behaviourProgram = nullptr;
 };
 
 class ObjectGenerator : public std::enable_shared_from_this<ObjectGenerator> {
@@ -77,5 +82,7 @@ class ObjectGenerator : public std::enable_shared_from_this<ObjectGenerator> {
   std::unordered_map<std::string, std::vector<float>> behaviourProbabilities_;
 
   std::shared_ptr<ObjectDefinition>& getObjectDefinition(std::string objectName);
+
+  void bindBehaviourProgram(const std::shared_ptr<ObjectDefinition>& objectDefinition, std::shared_ptr<Object> object);
 };
 }  // namespace griddly
\ No newline at end of file
@@ -3,11 +3,12 @@
 #include <spdlog/spdlog.h>
 
 #include "../Actions/Action.hpp"
+#include "../SymbolTable.hpp"
 #include "Object.hpp"
 
 namespace griddly {
 
-ObjectVariable::ObjectVariable(const YAML::Node& commandArguments, const std::unordered_map<std::string, std::shared_ptr<int32_t>>& availableVariables, bool allowStrings) {
+ObjectVariable::ObjectVariable(const YAML::Node& commandArguments, const std::unordered_map<std::string, uint32_t>& variableSlots, bool allowStrings) {
   auto commandArgumentValue = commandArguments.as<std::string>();
 
   auto delim = commandArgumentValue.find(".");
@@ -27,10 +28,13 @@ ObjectVariable::ObjectVariable(const YAML::Node& commandArguments, const std::un
 
     objectVariableType_ = ObjectVariableType::UNRESOLVED;
     variableName_ = commandArgumentValue.substr(delim + 1);
+    if (actionObject_ != ActionObject::META) {
+      variableNameId_ = SymbolTable::variableNames().intern(variableName_);
+    }
   } else {
-    auto variable = availableVariables.find(commandArgumentValue);
+    auto variable = variableSlots.find(commandArgumentValue);
 
-    if (variable == availableVariables.end()) {
+    if (variable == variableSlots.end()) {
       spdlog::debug("Variable string not found, trying to parse literal={0}", commandArgumentValue);
 
       try {
@@ -50,12 +54,12 @@ ObjectVariable::ObjectVariable(const YAML::Node& commandArguments, const std::un
     } else {
       spdlog::debug("Variable pointer {0} resolved.", variable->first);
       objectVariableType_ = ObjectVariableType::RESOLVED;
-      resolvedValue_ = variable->second;
+      variableSlot_ = variable->second;
     }
   }
 }
 
-int32_t ObjectVariable::resolve(std::shared_ptr<Action> action) const {
+int32_t ObjectVariable::resolve(const Object& object, const std::shared_ptr<Action>& action) const {
   int32_t resolved = 0;
   switch (objectVariableType_) {
     case ObjectVariableType::STRING: {
@@ -67,57 +71,87 @@ int32_t ObjectVariable::resolve(std::shared_ptr<Action> action) const {
       resolved = literalValue_;
       spdlog::debug("resolved literal {0}", resolved);
       break;
-    default:
-      resolved = *resolve_ptr(action);
+    case ObjectVariableType::RESOLVED:
+      resolved = *object.getVariableSlot(variableSlot_);
+      break;
+    case ObjectVariableType::UNRESOLVED:
+      if (actionObject_ == ActionObject::META) {
+        resolved = action->getMetaData(variableName_);
+      } else {
+        resolved = *resolveVariable(object, action);
+      }
       spdlog::debug("resolved pointer value {0}", resolved);
       break;
   }
 
   return resolved;
-}  // namespace griddly
+}
 
-std::string ObjectVariable::resolveString(std::shared_ptr<Action> action) const {
+std::string ObjectVariable::resolveString(const Object& object, const std::shared_ptr<Action>& action) const {
   if(objectVariableType_ == ObjectVariableType::STRING) {
     return stringValue_;
   } else {
-    return std::to_string(resolve(action));
+    return std::to_string(resolve(object, action));
   }
 }
 
-std::shared_ptr<int32_t> ObjectVariable::resolve_ptr(std::shared_ptr<Action> action) const {
+const int32_t* ObjectVariable::resolveVariable(const Object& object, const std::shared_ptr<Action>& action) const {
+  if (objectVariableType_ == ObjectVariableType::RESOLVED) {
+    return object.getVariableSlot(variableSlot_).get();
+  }
+
+  if (objectVariableType_ == ObjectVariableType::UNRESOLVED) {
+    switch (actionObject_) {
+      case ActionObject::SRC:
+        return resolveActionObjectVariable(*action->getSourceObject());
+      case ActionObject::DST:
+        return resolveActionObjectVariable(*action->getDestinationObject());
+      default:
+        break;
+    }
+  }
+
+  return nullptr;
+}
+
+bool ObjectVariable::dependsOnActionTarget() const {
+  return objectVariableType_ == ObjectVariableType::UNRESOLVED && actionObject_ != ActionObject::SRC;
+}
+
+int32_t* ObjectVariable::resolveWritableVariable(const std::shared_ptr<Object>& object, const std::shared_ptr<Action>& action, std::shared_ptr<Object>& variableObject) const {
   switch (objectVariableType_) {
     case ObjectVariableType::STRING: {
-      auto error = fmt::format("Variable is a string. Value cannot be resolved.", variableName_);
+      auto error = fmt::format("Variable {0} is a string. Value cannot be resolved.", stringValue_);
       spdlog::error(error);
       throw std::invalid_argument(error);
     }
     case ObjectVariableType::RESOLVED:
-      return resolvedValue_;
-    case ObjectVariableType::UNRESOLVED: {
-      std::shared_ptr<int32_t> ptr;
+      variableObject = object;
+      return object->getVariableSlot(variableSlot_).get();
+    case ObjectVariableType::UNRESOLVED:
       switch (actionObject_) {
-        case ActionObject::SRC: {
-          auto object = action->getSourceObject();
-          ptr = object->getVariableValue(variableName_);
-        } break;
-        case ActionObject::DST: {
-          auto object = action->getDestinationObject();
-          ptr = object->getVariableValue(variableName_);
-        } break;
-        case ActionObject::META: {
-          ptr = std::make_shared<int32_t>(action->getMetaData(variableName_));
+        case ActionObject::SRC:
+          variableObject = action->getSourceObject();
           break;
-        }
-      }
-      if (ptr == nullptr) {
-        auto error = fmt::format("Undefined variable={0}", variableName_);
-        throw std::invalid_argument(error);
+        case ActionObject::DST:
+          variableObject = action->getDestinationObject();
+          break;
+        case ActionObject::META:
+          return nullptr;
       }
-      return ptr;
-    }
+      return resolveActionObjectVariable(*variableObject);
     default:
       throw std::runtime_error("Unresolvable variable!");
   }
 }
 
+int32_t* ObjectVariable::resolveActionObjectVariable(Object& actionObject) const {
+  auto* variable = actionObject.getVariableValueById(variableNameId_, variableName_);
+  if (variable == nullptr) {
+    auto error = fmt::format("Undefined variable={0}", variableName_);
+    throw std::invalid_argument(error);
+  }
+  return variable;
+}
+
 }  // namespace griddly
\ No newline at end of file
@@ -8,6 +8,7 @@
 namespace griddly {
 
 class Action;
+class Object;
 
 enum class ObjectVariableType {
   LITERAL,
@@ -24,26 +25,38 @@ enum class ActionObject {
 
 class ObjectVariable {
  public:
-  ObjectVariable(const YAML::Node& commandArguments, const std::unordered_map<std::string, std::shared_ptr<int32_t>>& availableVariables, bool allowStrings=false);
-  int32_t resolve(std::shared_ptr<Action> action) const;
-  std::shared_ptr<int32_t> resolve_ptr(std::shared_ptr<Action> action) const;
+  ObjectVariable(const YAML::Node& commandArguments, const std::unordered_map<std::string, uint32_t>& variableSlots, bool allowStrings=false);
+  int32_t resolve(const Object& object, const std::shared_ptr<Action>& action) const;
 
-  std::string resolveString(std::shared_ptr<Action> action) const;
+  // The variable to write to and the object it is resolved from, nullptr for action meta data which is read only
+  int32_t* resolveWritableVariable(const std::shared_ptr<Object>& object, const std::shared_ptr<Action>& action, std::shared_ptr<Object>& variableObject) const;
+
+  std::string resolveString(const Object& object, const std::shared_ptr<Action>& action) const;
+
+  // The variable the value is read from, nullptr for literals and action meta data
+  const int32_t* resolveVariable(const Object& object, const std::shared_ptr<Action>& action) const;
+
+  // True if the value is read from the action's destination or meta data, rather than from the source object or a literal
+  bool dependsOnActionTarget() const;
 
  private:
+  // Looks up a src. or dst. variable in the object, throws if the object does not have it
+  int32_t* resolveActionObjectVariable(Object& actionObject) const;
+
   ObjectVariableType objectVariableType_;
 
   // Literal value
   int32_t literalValue_;
 
-  // pre-resolved value
-  std::shared_ptr<int32_t> resolvedValue_;
+  // variable slot of the object the behaviour is bound to
+  uint32_t variableSlot_;
 
   // String value
   std::string stringValue_;
 
   // value that needs to be resolved at time of action
   std::string variableName_;
+  uint32_t variableNameId_ = 0;
   ActionObject actionObject_;
 };
 }  // namespace griddly
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "SymbolTable.hpp"
+
+#include <mutex>
+
+#include "../Util/util.hpp"
+
+namespace griddly {
+
+SymbolTable& SymbolTable::objectNames() {
+  static SymbolTable objectNames({"_empty", "_boundary"});
+  return objectNames;
+}
+
+SymbolTable& SymbolTable::actionNames() {
+  static SymbolTable actionNames({});
+  return actionNames;
+}
+
+SymbolTable& SymbolTable::variableNames() {
+  static SymbolTable variableNames({});
+  return variableNames;
+}
+
+SymbolTable::SymbolTable(const std::vector<std::string>& reservedNames) {
+  for (const auto& name : reservedNames) {
+    intern(name);
+  }
+}
+
+uint32_t SymbolTable::intern(const std::string& name) {
+  uint32_t id;
+  if (find(name, id)) {
+    return id;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  auto idIt = ids_.find(name);
+  if (idIt != ids_.end()) {
+    return idIt->second;
+  }
+
+  id = static_cast<uint32_t>(names_.size());
+  names_.push_back(name);
+  ids_.insert({name, id});
+  return id;
+}
+
+bool SymbolTable::find(const std::string& name, uint32_t& id) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto idIt = ids_.find(name);
+  if (idIt == ids_.end()) {
+    return false;
+  }
+
+  id = idIt->second;
+  return true;
+}
+
+const std::string& SymbolTable::getName(uint32_t id) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  if (id >= names_.size()) {
+    throwRuntimeError(fmt::format("No name has been interned with id {0}", id));
+  }
+
+  return names_[id];
+}
+
+uint32_t SymbolTable::size() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return static_cast<uint32_t>(names_.size());
+}
+
+}  // namespace griddly
@@ -0,0 +1,45 @@
+#pragma once
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace griddly {
+
+// The default objects are interned first, so they always have these ids
+const uint32_t EMPTY_OBJECT_ID = 0;
+const uint32_t BOUNDARY_OBJECT_ID = 1;
+
+/**
+ * Maps names to small dense integer ids so runtime tables can be indexed by id rather than hashed by string.
+ * The tables are process wide, so ids are stable across every game and grid that uses the same name.
+ * Names are interned while GDY is loaded, after which lookups only take a shared lock.
+ */
+class SymbolTable {
+ public:
+  static SymbolTable& objectNames();
+  static SymbolTable& actionNames();
+  static SymbolTable& variableNames();
+
+  // Returns the id of the name, adding it to the table if it has not been seen before
+  uint32_t intern(const std::string& name);
+
+  // Returns false if the name has not been interned
+  bool find(const std::string& name, uint32_t& id) const;
+
+  const std::string& getName(uint32_t id) const;
+
+  uint32_t size() const;
+
+ private:
+  explicit SymbolTable(const std::vector<std::string>& reservedNames);
+
+  mutable std::shared_mutex mutex_;
+  std::unordered_map<std::string, uint32_t> ids_;
+
+  // A deque so references returned by getName stay valid as names are added
+  std::deque<std::string> names_;
+};
+
+}  // namespace griddly
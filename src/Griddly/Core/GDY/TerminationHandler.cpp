@@ -24,7 +24,8 @@ TerminationHandler::TerminationHandler(std::shared_ptr<Grid> grid, std::vector<s
   }
 }
 
-TerminationFunction TerminationHandler::resolveConditionArguments(const std::function<bool(int32_t, int32_t)> conditionFunction, YAML::Node &conditionArgumentsNode) const {
+TerminationFunction TerminationHandler::resolveConditionArguments(ConditionOp conditionOp, YAML::Node &conditionArgumentsNode) const {
+  auto conditionFunction = getConditionFunction(conditionOp);
   auto conditionArguments = singleOrListNodeToCommandArguments(conditionArgumentsNode);
   auto resolvedVariableSets = resolveVariables(conditionArguments);
 
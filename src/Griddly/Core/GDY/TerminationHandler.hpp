@@ -48,7 +48,7 @@ class TerminationHandler : ConditionResolver<TerminationFunction> {
  private:
   TerminationFunction instantiateTerminationCondition(TerminationState state, uint32_t playerId, int32_t reward, int32_t opposingReward, YAML::Node& conditionsNode);
 
-  TerminationFunction resolveConditionArguments(const std::function<bool(int32_t, int32_t)> conditionFunction, YAML::Node& conditionArgumentsNode) const override;
+  TerminationFunction resolveConditionArguments(ConditionOp conditionOp, YAML::Node& conditionArgumentsNode) const override;
   TerminationFunction resolveAND(const std::vector<TerminationFunction>& conditionList) const override;
   TerminationFunction resolveOR(const std::vector<TerminationFunction>& conditionList) const override;
 
@@ -1,8 +1,12 @@
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <utility>
 
+#include "ActionMask.hpp"
+#include "DelayedActionQueueItem.hpp"
 #include "GDY/Actions/Action.hpp"
+#include "GDY/SymbolTable.hpp"
 #include "GameProcess.hpp"
 #include "Players/Player.hpp"
 
@@ -49,6 +53,9 @@ void GameProcess::init(bool isCloned) {
 
   auto playerCount = gdyFactory_->getPlayerCount();
 
+  // Player ids start at 1, so reserving a slot for each of them means accumulating rewards never reallocates
+  accumulatedRewards_.resize(playerCount + 1);
+
   if (!isCloned) {
     spdlog::debug("Initializing GameProcess {0}", getProcessName());
 
@@ -62,7 +69,7 @@ void GameProcess::init(bool isCloned) {
     grid_->resetGlobalVariables(gdyFactory_->getGlobalVariableDefinitions());
 
     spdlog::debug("Resetting level generator");
-    levelGenerator_->reset(grid_);
+    resetLevel();
     spdlog::debug("Reset.");
 
   } else {
@@ -127,11 +134,8 @@ void GameProcess::reset() {
   spdlog::debug("Resetting player count.");
   grid_->setPlayerCount(gdyFactory_->getPlayerCount());
 
-  spdlog::debug("Resetting global variables.");
-  grid_->resetGlobalVariables(gdyFactory_->getGlobalVariableDefinitions());
-
   spdlog::debug("Resetting level generator.");
-  levelGenerator_->reset(grid_);
+  resetLevel();
 
   spdlog::debug("Resetting Observers.");
   resetObservers();
@@ -151,9 +155,212 @@ void GameProcess::release() {
 
   players_.clear();
 
+  levelSnapshot_ = nullptr;
+  levelSnapshotGenerator_ = nullptr;
+
   grid_->reset();
 }
 
+void GameProcess::resetLevel() {
+  if (levelSnapshot_ != nullptr && levelSnapshotGenerator_ == levelGenerator_) {
+    // The objects in the snapshot reference the global variables, so they are restored in place rather than reset
+    spdlog::debug("Restoring level from snapshot.");
+    grid_->restoreSnapshot(*levelSnapshot_);
+
+    auto randomGenerator = grid_->getRandomGenerator();
+    if (randomGenerator != nullptr) {
+      randomGenerator->getEngine().discard(levelSnapshotRandomDraws_);
+    }
+    return;
+  }
+
+  levelSnapshot_ = nullptr;
+  levelSnapshotGenerator_ = nullptr;
+  levelSnapshotRandomDraws_ = 0;
+
+  spdlog::debug("Resetting global variables.");
+  grid_->resetGlobalVariables(gdyFactory_->getGlobalVariableDefinitions());
+
+  // Shuffling the initial actions of an object draws from the random generator even when the level is deterministic
+  auto randomGenerator = grid_->getRandomGenerator();
+  std::mt19937 engineBeforeReset;
+  if (randomGenerator != nullptr) {
+    engineBeforeReset = randomGenerator->getEngine();
+  }
+
+  levelGenerator_->reset(grid_);
+
+  if (hasDeterministicInitialActions()) {
+    spdlog::debug("Level is deterministic, taking snapshot.");
+    levelSnapshot_ = grid_->takeSnapshot();
+    levelSnapshotGenerator_ = levelGenerator_;
+
+    if (randomGenerator != nullptr) {
+      levelSnapshotRandomDraws_ = countRandomDraws(engineBeforeReset, randomGenerator->getEngine());
+    }
+  }
+}
+
+uint64_t GameProcess::countRandomDraws(std::mt19937 engine, const std::mt19937& drawnEngine) {
+  for (uint64_t draws = 0; draws <= MAX_LEVEL_RANDOM_DRAWS; draws++) {
+    if (engine == drawnEngine) {
+      return draws;
+    }
+    engine();
+  }
+
+  // The generator was seeded again rather than drawn from, there is no number of draws that gets to the same state
+  spdlog::debug("Level generation did not only draw from the random generator, restoring the snapshot will not advance it.");
+  return 0;
+}
+
+bool GameProcess::hasDeterministicInitialActions() const {
+  auto objectGenerator = gdyFactory_->getObjectGenerator();
+  const auto& actionInputsDefinitions = objectGenerator->getActionInputDefinitions();
+  const auto& behaviourProbabilities = objectGenerator->getBehaviourProbabilities();
+
+  // The order that the initial actions of an object are shuffled into is not checked, the snapshot keeps the order
+  // they were performed in when the level was first generated
+  for (const auto& objectDefinitionIt : objectGenerator->getObjectDefinitions()) {
+    for (const auto& initialActionDefinition : objectDefinitionIt.second->initialActionDefinitions) {
+      const auto& actionName = initialActionDefinition.actionName;
+      if (initialActionDefinition.randomize) {
+        return false;
+      }
+
+      auto actionInputsDefinitionIt = actionInputsDefinitions.find(actionName);
+      if (actionInputsDefinitionIt != actionInputsDefinitions.end() && actionInputsDefinitionIt->second.mapToGrid) {
+        return false;
+      }
+
+      // Delayed actions are only executed after the snapshot is taken, so their probabilities are sampled every episode
+      auto behaviourProbabilitiesIt = behaviourProbabilities.find(actionName);
+      if (initialActionDefinition.delay == 0 && behaviourProbabilitiesIt != behaviourProbabilities.end()) {
+        for (auto probability : behaviourProbabilitiesIt->second) {
+          if (probability < 1.0) {
+            return false;
+          }
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+void GameProcess::copyGridState(const std::shared_ptr<Grid>& sourceGrid, const std::shared_ptr<Grid>& targetGrid) const {
+  targetGrid->setPlayerCount(sourceGrid->getPlayerCount());
+
+  auto gridHeight = sourceGrid->getHeight();
+  auto gridWidth = sourceGrid->getWidth();
+  targetGrid->resetMap(gridWidth, gridHeight);
+
+  auto objectGenerator = gdyFactory_->getObjectGenerator();
+
+  // Clone Global Variables
+  spdlog::debug("Cloning global variables...");
+  std::unordered_map<std::string, std::unordered_map<uint32_t, int32_t>> clonedGlobalVariables;
+  for (const auto& globalVariableToCopy : sourceGrid->getGlobalVariables()) {
+    auto globalVariableName = globalVariableToCopy.first;
+    auto playerVariableValues = globalVariableToCopy.second;
+
+    for (const auto& playerVariable : playerVariableValues) {
+      auto playerId = playerVariable.first;
+      auto variableValue = *playerVariable.second;
+      spdlog::debug("Cloning {0}={1} for player {2}", globalVariableName, variableValue, playerId);
+      clonedGlobalVariables[globalVariableName].insert({playerId, variableValue});
+    }
+  }
+  targetGrid->setGlobalVariables(clonedGlobalVariables);
+
+  // Initialize Object Types
+  spdlog::debug("Cloning objects types...");
+  for (const auto& objectDefinition : objectGenerator->getObjectDefinitions()) {
+    auto objectName = objectDefinition.second->objectName;
+
+    // do not initialize these objects
+    if (objectName == "_empty" || objectName == "_boundary") {
+      continue;
+    }
+    std::vector<std::string> objectVariableNames;
+    for (const auto& variableNameIt : objectDefinition.second->variableDefinitions) {
+      objectVariableNames.push_back(variableNameIt.first);
+    }
+    targetGrid->initObject(objectName, objectVariableNames);
+  }
+
+  const auto& objectsToCopy = sourceGrid->getObjects();
+
+  std::unordered_map<std::shared_ptr<Object>, std::shared_ptr<Object>> clonedObjectMapping;
+  clonedObjectMapping.reserve(objectsToCopy.size() + 2 * (players_.size() + 1));
+
+  // Adding player default objects
+  for (auto playerId = 0; playerId < players_.size() + 1; playerId++) {
+    auto defaultEmptyObject = objectGenerator->newInstance("_empty", playerId, targetGrid);
+    auto defaultBoundaryObject = objectGenerator->newInstance("_boundary", playerId, targetGrid);
+    targetGrid->addPlayerDefaultObjects(defaultEmptyObject, defaultBoundaryObject);
+
+    auto defaultEmptyObjectToCopy = sourceGrid->getPlayerDefaultEmptyObject(playerId);
+    auto defaultBoundaryObjectToCopy = sourceGrid->getPlayerDefaultBoundaryObject(playerId);
+
+    clonedObjectMapping[defaultEmptyObjectToCopy] = defaultEmptyObject;
+    clonedObjectMapping[defaultBoundaryObjectToCopy] = defaultBoundaryObject;
+  }
+
+  // Behaviour probabilities
+  targetGrid->setBehaviourProbabilities(objectGenerator->getBehaviourProbabilities());
+
+
+  // Clone Objects
+  spdlog::debug("Cloning objects...");
+  for (const auto& toCopy : objectsToCopy) {
+    auto clonedObject = objectGenerator->cloneInstance(toCopy, targetGrid);
+    targetGrid->addObject(toCopy->getLocation(), clonedObject, false, nullptr, toCopy->getObjectOrientation());
+
+    // We need to know which objects are equivalent in the grid so we can
+    // map delayed actions later
+    clonedObjectMapping[toCopy] = clonedObject;
+  }
+
+  // Copy Game Timer
+  spdlog::debug("Cloning game timer state...");
+  auto tickCountToCopy = *sourceGrid->getTickCount();
+  targetGrid->setTickCount(tickCountToCopy);
+
+  // Clone Delayed actions
+  const auto& delayedActions = sourceGrid->getDelayedActions();
+
+  spdlog::debug("Cloning delayed actions...");
+  for (const auto& delayedActionToCopy : delayedActions) {
+    auto remainingTicks = delayedActionToCopy.priority - tickCountToCopy;
+    const auto& actionToCopy = delayedActionToCopy.action;
+    auto playerId = delayedActionToCopy.playerId;
+
+    auto actionNameId = actionToCopy->getActionNameId();
+    auto vectorToDest = actionToCopy->getVectorToDest();
+    auto orientationVector = actionToCopy->getOrientationVector();
+    auto sourceObjectMapping = actionToCopy->getSourceObject();
+    auto originatingPlayerId = actionToCopy->getOriginatingPlayerId();
+    spdlog::debug("Copying action {0}", actionToCopy->getActionName());
+
+    auto clonedActionSourceObjectIt = clonedObjectMapping.find(sourceObjectMapping);
+
+    if (clonedActionSourceObjectIt != clonedObjectMapping.end()) {
+      // Clone the action
+      auto clonedAction = targetGrid->newAction(actionNameId, originatingPlayerId, remainingTicks);
+
+      // The orientation and vector to dest are already modified from the first action in respect
+      // to if this is a relative action, so relative is set to false here
+      clonedAction->init(clonedActionSourceObjectIt->second, vectorToDest, orientationVector, false);
+
+      spdlog::debug("applying cloned action {0}", clonedAction->getActionName());
+      targetGrid->performActions(playerId, {clonedAction});
+    } else {
+      spdlog::debug("Action cannot be cloned as it is invalid in original environment.");
+    }
+  }
+}
+
 bool GameProcess::isInitialized() const {
   return isInitialized_;
 }
@@ -162,6 +369,11 @@ std::string GameProcess::getProcessName() const {
   return "Unknown";
 }
 
+void GameProcess::rollback(uint32_t checkpointId) {
+  grid_->rollback(checkpointId);
+  requiresReset_ = false;
+}
+
 uint32_t GameProcess::getNumPlayers() const {
   return static_cast<uint32_t>(players_.size());
 }
@@ -175,9 +387,14 @@ std::shared_ptr<Observer> GameProcess::getObserver() {
 }
 
 int32_t GameProcess::getAccumulatedRewards(uint32_t playerId) {
-  int32_t reward = accumulatedRewards_[playerId];
-  accumulatedRewards_[playerId] = 0;
-  return reward;
+  auto& reward = accumulatedRewards_[playerId];
+  auto accumulatedReward = reward;
+  reward = 0;
+  return accumulatedReward;
+}
+
+PlayerRewards& GameProcess::getAccumulatedRewards() {
+  return accumulatedRewards_;
 }
 
 std::unordered_map<glm::ivec2, std::unordered_set<std::string>> GameProcess::getAvailableActionNames(uint32_t playerId) const {
@@ -223,15 +440,14 @@ std::vector<uint32_t> GameProcess::getAvailableActionIdsAtLocation(glm::ivec2 lo
     const auto& actionInputDefinition = actionInputDefinitions.at(actionName);
 
     auto relativeToSource = actionInputDefinition.relative;
+    auto actionNameId = SymbolTable::actionNames().intern(actionName);
 
     for (const auto& inputMapping : actionInputDefinition.inputMappings) {
       auto actionId = inputMapping.first;
-      auto mapping = inputMapping.second;
-
-      auto metaData = mapping.metaData;
+      const auto& mapping = inputMapping.second;
 
       // Create an fake action to test for availability (and not duplicate a bunch of code)
-      auto potentialAction = std::make_shared<Action>(Action(grid_, actionName, 0, 0, metaData));
+      auto potentialAction = grid_->newAction(actionNameId, 0, 0, mapping.metaData);
       potentialAction->init(srcObject, mapping.vectorToDest, mapping.orientationVector, relativeToSource);
 
       if (srcObject->isValidAction(potentialAction)) {
@@ -243,33 +459,40 @@ std::vector<uint32_t> GameProcess::getAvailableActionIdsAtLocation(glm::ivec2 lo
   return availableActionIds;
 }
 
-void GameProcess::generateStateHash(StateInfo& stateInfo) {
-  // Hash global variables
-  for (const auto& variableIt : stateInfo.globalVariables) {
-    // Ignore the internal _steps count
-    if (variableIt.first != "_steps") {
-      hash_combine(stateInfo.hash, variableIt.first);
-      for (auto playerVariableIt : variableIt.second) {
-        hash_combine(stateInfo.hash, playerVariableIt.second);
-        hash_combine(stateInfo.hash, playerVariableIt.first);
-      }
+std::vector<uint32_t> GameProcess::getActionMaskShape() const {
+  return ActionMaskLayout(gdyFactory_, grid_).getShape();
+}
+
+void GameProcess::writeActionMask(uint32_t playerId, uint8_t* mask) const {
+  ActionMaskLayout layout(gdyFactory_, grid_);
+  auto unitStride = layout.getUnitStride();
+
+  std::fill(mask, mask + layout.getUnitCount() * unitStride, 0);
+
+  PreconditionCache preconditionCache;
+  for (const auto& object : grid_->getObjects()) {
+    if (object->getPlayerId() != playerId) {
+      continue;
     }
+
+    auto* unitMask = mask + layout.getUnit(object->getLocation()) * unitStride;
+    layout.writeObjectMask(*grid_, object, unitMask, preconditionCache);
   }
+}
 
-  // Hash ordered object list
-  std::sort(stateInfo.objectInfo.begin(), stateInfo.objectInfo.end(), SortObjectInfo());
-  for (const auto& o : stateInfo.objectInfo) {
-    hash_combine(stateInfo.hash, o.name);
-    hash_combine(stateInfo.hash, o.location);
-    hash_combine(stateInfo.hash, o.orientationName);
-    hash_combine(stateInfo.hash, o.playerId);
-
-    // Hash the object variables
-    for (const auto& variableIt : o.variables) {
-      hash_combine(stateInfo.hash, variableIt.first);
-      hash_combine(stateInfo.hash, variableIt.second);
-    }
+const std::vector<uint8_t>& GameProcess::updateActionMasks() {
+  if (actionMaskTracker_ == nullptr) {
+    actionMaskTracker_ = std::make_shared<ActionMaskTracker>(gdyFactory_, grid_);
   }
+
+  actionMaskTracker_->update();
+  return actionMaskTracker_->getMasks();
+}
+
+std::vector<uint32_t> GameProcess::getActionMasksShape() const {
+  auto shape = getActionMaskShape();
+  shape.insert(shape.begin(), grid_->getPlayerCount());
+  return shape;
 }
 
 StateInfo GameProcess::getState() const {
@@ -307,7 +530,7 @@ StateInfo GameProcess::getState() const {
     stateInfo.objectInfo.push_back(objectInfo);
   }
 
-  generateStateHash(stateInfo);
+  stateInfo.hash = grid_->getStateHash();
 
   return stateInfo;
 }
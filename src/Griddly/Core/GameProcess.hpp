@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <random>
 #include <vector>
 
 #include "GDY/GDYFactory.hpp"
@@ -10,6 +11,7 @@
 
 namespace griddly {
 
+class ActionMaskTracker;
 class Player;
 
 struct ActionResult {
@@ -71,8 +73,12 @@ class GameProcess : public std::enable_shared_from_this<GameProcess> {
 
   bool isInitialized() const;
 
+  // Returns the reward accumulated by the player since it was last collected, and resets it
   virtual int32_t getAccumulatedRewards(uint32_t playerId);
 
+  // The rewards that have not been collected yet, indexed by player id
+  PlayerRewards& getAccumulatedRewards();
+
   virtual std::string getProcessName() const;
 
   std::shared_ptr<Grid> getGrid();
@@ -84,12 +90,29 @@ class GameProcess : public std::enable_shared_from_this<GameProcess> {
   virtual std::vector<uint32_t> getAvailableActionIdsAtLocation(
       glm::ivec2 location, std::string actionName) const;
 
+  // The shape of the action mask: [units, action types, action ids].
+  // If players control an avatar there is a single unit, otherwise there is a unit for every location at index x * height + y.
+  virtual std::vector<uint32_t> getActionMaskShape() const;
+
+  // Writes a 1 for every valid action of the player into a caller provided mask of getActionMaskShape().
+  // Action id 0 is marked as valid for an action type whenever any other id of that type is valid.
+  virtual void writeActionMask(uint32_t playerId, uint8_t* mask) const;
+
+  // Brings the persistent masks of every player up to date, only recomputing the units affected by changes since the last update.
+  // The masks have the shape of getActionMasksShape(), the player with id p is at index p - 1
+  virtual const std::vector<uint8_t>& updateActionMasks();
+
+  virtual std::vector<uint32_t> getActionMasksShape() const;
+
   virtual StateInfo getState() const;
 
   virtual uint32_t getNumPlayers() const;
 
   virtual void seedRandomGenerator(uint32_t seed) = 0;
 
+  // Rolls the grid back to a journal checkpoint, the game can continue even if it had terminated since
+  virtual void rollback(uint32_t checkpointId);
+
   void release();
 
   virtual ~GameProcess() = default;
@@ -99,6 +122,9 @@ class GameProcess : public std::enable_shared_from_this<GameProcess> {
       std::shared_ptr<LevelGenerator> levelGenerator);
   virtual std::shared_ptr<LevelGenerator> getLevelGenerator() const;
 
+  // Copies the objects, variables and delayed actions of one grid into another
+  void copyGridState(const std::shared_ptr<Grid>& sourceGrid, const std::shared_ptr<Grid>& targetGrid) const;
+
   std::vector<std::shared_ptr<Player>> players_;
   std::shared_ptr<Grid> grid_;
   std::shared_ptr<GDYFactory> gdyFactory_;
@@ -122,12 +148,32 @@ class GameProcess : public std::enable_shared_from_this<GameProcess> {
   bool requiresReset_ = true;
 
   // Tracks the rewards currently accumulated per player
-  std::unordered_map<uint32_t, int32_t> accumulatedRewards_;
+  PlayerRewards accumulatedRewards_;
 
  private:
-  static void generateStateHash(StateInfo& stateInfo) ;
   void resetObservers();
 
-  
+  // Resets the level and global variables from the snapshot if there is one, otherwise uses the level generator
+  void resetLevel();
+
+  // True if none of the initial actions of any object pick their direction, destination or behaviours at random
+  bool hasDeterministicInitialActions() const;
+
+  // Generating a level only draws a few values, an engine that is not reached within this many draws was seeded again
+  static constexpr uint64_t MAX_LEVEL_RANDOM_DRAWS = 1 << 20;
+
+  // The number of values drawn from engine to get it to the state of drawnEngine
+  static uint64_t countRandomDraws(std::mt19937 engine, const std::mt19937& drawnEngine);
+
+  // The level after its initial actions have run, only taken for levels that do not use any randomness
+  std::shared_ptr<GridSnapshot> levelSnapshot_;
+  std::shared_ptr<LevelGenerator> levelSnapshotGenerator_;
+
+  // The values generating the level drew from the random generator, they are discarded when the snapshot is restored
+  // so the random numbers of every episode start from the same point whether the level was generated or restored
+  uint64_t levelSnapshotRandomDraws_ = 0;
+
+  // Created by the first call to updateActionMasks, so games that never ask for masks do not track changes
+  std::shared_ptr<ActionMaskTracker> actionMaskTracker_;
 };
 }  // namespace griddly
@@ -4,12 +4,18 @@
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "DelayedActionQueueItem.hpp"
+#include "FlowField.hpp"
+#include "GDY/Objects/ObjectGenerator.hpp"
+#include "NearestObjectIndex.hpp"
+#include "PassabilityMap.hpp"
 
 namespace griddly {
 
@@ -62,21 +68,418 @@ void Grid::resetMap(uint32_t width, uint32_t height) {
 }
 
 void Grid::reset() {
-  occupiedLocations_.clear();
+  detachCopyOnWriteClones();
+  copyOnWriteSource_ = nullptr;
+  copyOnWriteObjectGenerator_ = nullptr;
+  copyOnWriteTiles_.clear();
+  copyOnWriteObjects_.clear();
+  copyOnWriteObjectsView_.clear();
+
+  tiles_.clear();
+  tiles_.resize(width_ * height_);
+  for (const auto& object : objects_) {
+    object->takePendingDelayedActions();
+  }
   objects_.clear();
+  objectsVersion_++;
   objectCounters_.clear();
   objectIds_.clear();
   objectVariableIds_.clear();
-  delayedActions_ = {};
+  delayedActions_.clear();
   defaultEmptyObject_.clear();
   defaultBoundaryObject_.clear();
 
   collisionObjectActionNames_.clear();
   collisionSourceObjectActionNames_.clear();
+  objectCollisionDetectors_.clear();
+  sourceObjectCollisionTriggers_.clear();
   collisionDetectors_.clear();
   collisionSourceObjects_.clear();
+  collisionDetectorChanges_.clear();
+  cachedCollisions_.clear();
+  flowFields_.clear();
+  passabilityMaps_.clear();
+  nearestObjectIndexes_.clear();
+
+  journal_.clear();
+  checkpoints_.clear();
 
   *gameTicks_ = 0;
+
+  objectsStateHash_ = 0;
+  resetGlobalVariablesStateHash();
+
+  actionMaskChanges_.invalidated = true;
+
+  discardLocationChanges();
+}
+
+std::shared_ptr<GridSnapshot> Grid::takeSnapshot() const {
+  auto snapshot = std::make_shared<GridSnapshot>();
+  snapshot->tiles = tiles_;
+
+  std::vector<std::shared_ptr<int32_t>> variables;
+  snapshot->objects.reserve(objects_.size());
+  snapshot->objectStates.reserve(objects_.size());
+  for (const auto& object : objects_) {
+    snapshot->objects.push_back(object);
+    snapshot->objectStates.push_back(object->getObjectState());
+    object->getOwnedVariables(variables);
+  }
+
+  // Includes _steps
+  for (const auto& globalVariable : globalVariables_) {
+    for (const auto& playerVariable : globalVariable.second) {
+      variables.push_back(playerVariable.second);
+    }
+  }
+
+  for (const auto& objectCounter : objectCounters_) {
+    for (const auto& playerCounter : objectCounter.second) {
+      variables.push_back(playerCounter.second);
+    }
+  }
+
+  snapshot->variableValues.reserve(variables.size());
+  for (const auto& variable : variables) {
+    snapshot->variableValues.emplace_back(variable, *variable);
+  }
+
+  snapshot->playerAvatars = playerAvatars_;
+  snapshot->delayedActions = delayedActions_;
+  snapshot->objectsStateHash = objectsStateHash_;
+
+  return snapshot;
+}
+
+void Grid::restoreSnapshot(const GridSnapshot& snapshot) {
+  spdlog::debug("Restoring {0} objects from snapshot", snapshot.objects.size());
+
+  detachCopyOnWriteClones();
+
+  // Objects that are not in the snapshot are dropped, the ones that are are put back with their snapshot state below
+  for (const auto& object : objects_) {
+    object->takePendingDelayedActions();
+    invalidateLocation(object->getLocation());
+    updateNearestObjectIndex(object, object->getLocation(), true);
+
+    auto objectNameId = object->getObjectNameId();
+    if (objectNameId < objectCollisionDetectors_.size()) {
+      for (const auto& collisionDetector : objectCollisionDetectors_[objectNameId]) {
+        collisionDetector->remove(object);
+      }
+    }
+  }
+
+  objects_.clear();
+  objectsVersion_++;
+  collisionSourceObjects_.clear();
+  collisionDetectorChanges_.clear();
+  cachedCollisions_.clear();
+  journal_.clear();
+  checkpoints_.clear();
+
+  tiles_ = snapshot.tiles;
+
+  // Counters of objects that were only created after the snapshot was taken are not in it
+  for (const auto& objectCounter : objectCounters_) {
+    for (const auto& playerCounter : objectCounter.second) {
+      *playerCounter.second = 0;
+    }
+  }
+
+  for (const auto& variableValue : snapshot.variableValues) {
+    *variableValue.first = variableValue.second;
+  }
+
+  objects_.reserve(snapshot.objects.size());
+  for (size_t objectIdx = 0; objectIdx < snapshot.objects.size(); objectIdx++) {
+    const auto& object = snapshot.objects[objectIdx];
+    object->setObjectState(snapshot.objectStates[objectIdx]);
+    object->setCachedStateHash(object->getStateHash());
+    objects_.insert(object);
+
+    auto location = object->getLocation();
+    invalidateLocation(location);
+    indexObject(object, location);
+  }
+
+  playerAvatars_ = snapshot.playerAvatars;
+
+  delayedActions_ = snapshot.delayedActions;
+  for (const auto& delayedAction : delayedActions_) {
+    indexDelayedAction(delayedAction);
+  }
+
+  objectsStateHash_ = snapshot.objectsStateHash;
+  resetGlobalVariablesStateHash();
+
+  // Every object may have moved, so flow fields are recomputed
+  for (auto& objectNameVersion : objectNameVersions_) {
+    objectNameVersion++;
+  }
+
+  actionMaskChanges_.invalidated = true;
+
+  discardLocationChanges();
+}
+
+std::shared_ptr<Grid> Grid::cloneCopyOnWrite(std::shared_ptr<ObjectGenerator> objectGenerator) {
+  spdlog::debug("Cloning grid copy-on-write...");
+
+  auto clonedGrid = std::make_shared<Grid>(collisionDetectorFactory_);
+  clonedGrid->playerCount_ = playerCount_;
+  clonedGrid->width_ = width_;
+  clonedGrid->height_ = height_;
+  clonedGrid->updatedLocations_.resize(playerCount_ + 1);
+
+  clonedGrid->objectIds_ = objectIds_;
+  clonedGrid->objectVariableIds_ = objectVariableIds_;
+  clonedGrid->objectVariableMap_ = objectVariableMap_;
+  clonedGrid->behaviourProbabilities_ = behaviourProbabilities_;
+
+  // Includes _steps, which has to be the tick count of the clone
+  for (const auto& globalVariable : globalVariables_) {
+    for (const auto& playerVariable : globalVariable.second) {
+      auto clonedVariable = playerVariable.second == gameTicks_ ? clonedGrid->gameTicks_ : std::make_shared<int32_t>();
+      *clonedVariable = *playerVariable.second;
+      clonedGrid->globalVariables_[globalVariable.first].insert({playerVariable.first, clonedVariable});
+    }
+  }
+  *clonedGrid->gameTicks_ = *gameTicks_;
+
+  for (const auto& objectCounter : objectCounters_) {
+    for (const auto& playerCounter : objectCounter.second) {
+      clonedGrid->objectCounters_[objectCounter.first].insert({playerCounter.first, std::make_shared<int32_t>(*playerCounter.second)});
+    }
+  }
+
+  clonedGrid->objectsStateHash_ = objectsStateHash_;
+  clonedGrid->resetGlobalVariablesStateHash();
+
+  for (const auto& defaultEmptyObject : defaultEmptyObject_) {
+    auto playerId = defaultEmptyObject.first;
+    auto clonedEmptyObject = objectGenerator->newInstance("_empty", playerId, clonedGrid);
+    auto clonedBoundaryObject = objectGenerator->newInstance("_boundary", playerId, clonedGrid);
+    clonedGrid->addPlayerDefaultObjects(clonedEmptyObject, clonedBoundaryObject);
+
+    clonedGrid->copyOnWriteObjects_.insert({defaultEmptyObject.second.get(), clonedEmptyObject});
+    clonedGrid->copyOnWriteObjects_.insert({defaultBoundaryObject_.at(playerId).get(), clonedBoundaryObject});
+  }
+
+  // Added before the clone starts sharing objects, adding a collision detector reads every object
+  for (const auto& actionTriggerDefinition : actionTriggerDefinitions_) {
+    clonedGrid->addActionTrigger(actionTriggerDefinition.first, actionTriggerDefinition.second);
+  }
+
+  clonedGrid->copyOnWriteSource_ = shared_from_this();
+  clonedGrid->copyOnWriteObjectGenerator_ = std::move(objectGenerator);
+
+  // Collision detectors have to hold every object that can collide, so those objects are copied straight away
+  if (!collisionDetectors_.empty()) {
+    std::vector<glm::ivec2> collisionLocations;
+    for (const auto& object : objects_) {
+      auto objectNameId = object->getObjectNameId();
+      if ((objectNameId < objectCollisionDetectors_.size() && !objectCollisionDetectors_[objectNameId].empty()) || collisionSourceObjects_.find(object) != collisionSourceObjects_.end()) {
+        collisionLocations.push_back(object->getLocation());
+      }
+    }
+
+    for (const auto& location : collisionLocations) {
+      clonedGrid->copyTile(location.y * width_ + location.x);
+    }
+  }
+
+  for (const auto& playerAvatar : playerAvatars_) {
+    auto clonedAvatar = clonedGrid->resolveCopiedObject(playerAvatar.second);
+    if (clonedAvatar != nullptr) {
+      clonedGrid->playerAvatars_.insert({playerAvatar.first, clonedAvatar});
+    }
+  }
+
+  // Copied into the action pool of the clone, so the clone never releases actions into the pool of this grid
+  for (const auto& delayedAction : delayedActions_) {
+    auto action = clonedGrid->copyInheritedAction(delayedAction.action);
+    if (action == nullptr) {
+      continue;
+    }
+
+    auto sourceObject = delayedAction.sourceObject == nullptr ? nullptr : action->getSourceObject();
+    DelayedActionQueueItem clonedAction{delayedAction.playerId, delayedAction.priority, action, std::move(sourceObject)};
+    clonedGrid->indexDelayedAction(clonedAction);
+    clonedGrid->delayedActions_.push(std::move(clonedAction));
+  }
+
+  if (copyOnWriteClones_.size() == copyOnWriteClones_.capacity()) {
+    copyOnWriteClones_.erase(std::remove_if(copyOnWriteClones_.begin(), copyOnWriteClones_.end(), [](const std::weak_ptr<Grid>& clone) { return clone.expired(); }), copyOnWriteClones_.end());
+  }
+  copyOnWriteClones_.push_back(clonedGrid);
+
+  return clonedGrid;
+}
+
+TileObjects& Grid::copyTile(uint32_t tileIdx) {
+  auto copiedTileIt = copyOnWriteTiles_.find(tileIdx);
+  if (copiedTileIt != copyOnWriteTiles_.end()) {
+    return copiedTileIt->second;
+  }
+
+  // Added before the objects are copied, binding their behaviours can read other tiles and search for objects
+  auto& copiedTile = copyOnWriteTiles_[tileIdx];
+  objectsVersion_++;
+  glm::ivec2 location(tileIdx % width_, tileIdx / width_);
+
+  // Action masks may have read the variables of the shared objects, they have to read the copies from now on
+  if (actionMaskTracking_) {
+    actionMaskChanges_.locations.insert(location);
+  }
+
+  for (const auto& sourceObjectIt : copyOnWriteSource_->getObjectsAt(location)) {
+    const auto& sourceObject = sourceObjectIt.second;
+    auto object = copyOnWriteObjectGenerator_->cloneInstance(sourceObject, shared_from_this());
+    object->setObjectState(sourceObject->getObjectState());
+    object->setCachedStateHash(sourceObject->getCachedStateHash());
+
+    copyOnWriteObjects_.insert({sourceObject.get(), object});
+    objects_.insert(object);
+    copiedTile.insert({sourceObjectIt.first, object});
+    indexObject(object, location);
+  }
+
+  return copiedTile;
+}
+
+std::shared_ptr<Object> Grid::resolveCopiedObject(const std::shared_ptr<Object>& object) {
+  auto copiedObjectIt = copyOnWriteObjects_.find(object.get());
+  if (copiedObjectIt != copyOnWriteObjects_.end()) {
+    return copiedObjectIt->second;
+  }
+
+  if (copyOnWriteSource_ == nullptr) {
+    return nullptr;
+  }
+
+  auto sourceObject = object;
+  if (copyOnWriteSource_->objects_.find(object) == copyOnWriteSource_->objects_.end()) {
+    sourceObject = copyOnWriteSource_->resolveCopiedObject(object);
+    if (sourceObject == nullptr) {
+      return nullptr;
+    }
+
+    copiedObjectIt = copyOnWriteObjects_.find(sourceObject.get());
+    if (copiedObjectIt != copyOnWriteObjects_.end()) {
+      return copiedObjectIt->second;
+    }
+  }
+
+  auto location = sourceObject->getLocation();
+  if (!isInBounds(location)) {
+    return nullptr;
+  }
+
+  copyTile(location.y * width_ + location.x);
+  copiedObjectIt = copyOnWriteObjects_.find(sourceObject.get());
+  return copiedObjectIt == copyOnWriteObjects_.end() ? nullptr : copiedObjectIt->second;
+}
+
+std::shared_ptr<Action> Grid::copyInheritedAction(const std::shared_ptr<Action>& action) {
+  std::shared_ptr<Object> sourceObject = nullptr;
+  if (action->hasSourceObject()) {
+    sourceObject = resolveCopiedObject(action->getSourceObject());
+    if (sourceObject == nullptr) {
+      return nullptr;
+    }
+  }
+
+  auto copiedAction = newAction(action->getActionNameId(), action->getOriginatingPlayerId(), action->getDelay(), action->getMetaData());
+  if (sourceObject == nullptr) {
+    copiedAction->init(action->getSourceLocation(), action->getDestinationLocation());
+  } else {
+    // The vectors are already relative to the source object
+    copiedAction->init(sourceObject, action->getVectorToDest(), action->getOrientationVector(), false);
+  }
+
+  return copiedAction;
+}
+
+void Grid::detachFromCopyOnWriteSource() {
+  if (copyOnWriteSource_ == nullptr) {
+    return;
+  }
+
+  spdlog::debug("Copying the remaining {0} tiles of the copy-on-write source grid", width_ * height_ - copyOnWriteTiles_.size());
+
+  auto tileCount = width_ * height_;
+  for (uint32_t tileIdx = 0; tileIdx < tileCount; tileIdx++) {
+    copyTile(tileIdx);
+  }
+
+  tiles_.resize(tileCount);
+  for (auto& copiedTile : copyOnWriteTiles_) {
+    tiles_[copiedTile.first] = std::move(copiedTile.second);
+  }
+  copyOnWriteTiles_.clear();
+  copyOnWriteObjectsView_.clear();
+
+  copyOnWriteSource_ = nullptr;
+  copyOnWriteObjectGenerator_ = nullptr;
+}
+
+void Grid::detachCopyOnWriteClones() {
+  if (copyOnWriteClones_.empty()) {
+    return;
+  }
+
+  // Swapped out first as the clones read this grid while they copy it
+  std::vector<std::weak_ptr<Grid>> copyOnWriteClones;
+  copyOnWriteClones.swap(copyOnWriteClones_);
+  for (const auto& copyOnWriteClone : copyOnWriteClones) {
+    auto clonedGrid = copyOnWriteClone.lock();
+    if (clonedGrid != nullptr) {
+      clonedGrid->detachFromCopyOnWriteSource();
+    }
+  }
+}
+
+void Grid::copyTileToCopyOnWriteClones(glm::ivec2 location) {
+  if (copyOnWriteClones_.empty() || !isInBounds(location)) {
+    return;
+  }
+
+  auto tileIdx = location.y * width_ + location.x;
+  for (const auto& copyOnWriteClone : copyOnWriteClones_) {
+    auto clonedGrid = copyOnWriteClone.lock();
+    if (clonedGrid != nullptr && clonedGrid->copyOnWriteSource_.get() == this) {
+      clonedGrid->copyTile(tileIdx);
+    }
+  }
+}
+
+uint64_t Grid::getObjectsVersion() const {
+  // Both versions only increase, so the sum changes whenever either of them does
+  return objectsVersion_ + (copyOnWriteSource_ == nullptr ? 0 : copyOnWriteSource_->getObjectsVersion());
+}
+
+void Grid::indexObject(const std::shared_ptr<Object>& object, glm::ivec2 location) {
+  updateNearestObjectIndex(object, location, false);
+
+  auto objectNameId = object->getObjectNameId();
+  if (objectNameId < objectCollisionDetectors_.size()) {
+    for (const auto& collisionDetector : objectCollisionDetectors_[objectNameId]) {
+      collisionDetector->upsert(object, location);
+    }
+  }
+
+  if (objectNameId < sourceObjectCollisionTriggers_.size() && !sourceObjectCollisionTriggers_[objectNameId].empty()) {
+    collisionSourceObjects_.insert(object);
+  }
+}
+
+void Grid::discardLocationChanges() {
+  // Skipping an index means everyone reading the log sees that changes have been discarded
+  locationChangeLog_.firstChangeIdx = getLocationChangeCount() + 1;
+  locationChangeLog_.tickStartChangeIdx = locationChangeLog_.firstChangeIdx;
+  locationChangeLog_.locations.clear();
 }
 
 void Grid::setGlobalVariables(std::unordered_map<std::string, std::unordered_map<uint32_t, int32_t>> globalVariableDefinitions) {
@@ -103,6 +506,9 @@ void Grid::setGlobalVariables(std::unordered_map<std::string, std::unordered_map
       globalVariables_[variableName].insert({playerId, std::make_shared<int32_t>(variableValue)});
     }
   }
+
+  resetGlobalVariablesStateHash();
+  actionMaskChanges_.invalidated = true;
 }
 
 void Grid::resetGlobalVariables(std::unordered_map<std::string, GlobalVariableDefinition> globalVariableDefinitions) {
@@ -119,12 +525,23 @@ void Grid::resetGlobalVariables(std::unordered_map<std::string, GlobalVariableDe
       globalVariables_[variableName].insert({0, std::make_shared<int32_t>(variableDefinition.initialValue)});
     }
   }
+
+  resetGlobalVariablesStateHash();
+  actionMaskChanges_.invalidated = true;
 }
 
 bool Grid::invalidateLocation(glm::ivec2 location) {
   for (int p = 0; p < playerCount_ + 1; p++) {
     updatedLocations_[p].insert(location);
   }
+
+  if (actionMaskTracking_) {
+    actionMaskChanges_.locations.insert(location);
+  }
+
+  if (locationChangeLog_.enabled) {
+    locationChangeLog_.locations.push_back(location);
+  }
   return true;
 }
 
@@ -132,41 +549,180 @@ void Grid::purgeUpdatedLocations(uint32_t player) {
   updatedLocations_[player].clear();
 }
 
+void Grid::enableActionMaskTracking(bool enable) {
+  actionMaskTracking_ = enable;
+  purgeActionMaskChanges();
+  actionMaskChanges_.invalidated = true;
+}
+
+void Grid::enableLocationChangeLog() {
+  locationChangeLog_.enabled = true;
+}
+
+uint64_t Grid::getLocationChangeCount() const {
+  return locationChangeLog_.firstChangeIdx + locationChangeLog_.locations.size();
+}
+
+bool Grid::getLocationChanges(uint64_t changeIdx, std::vector<glm::ivec2>& locations) const {
+  if (!locationChangeLog_.enabled || changeIdx < locationChangeLog_.firstChangeIdx) {
+    return false;
+  }
+
+  auto changesIt = locationChangeLog_.locations.begin() + static_cast<std::ptrdiff_t>(changeIdx - locationChangeLog_.firstChangeIdx);
+  locations.insert(locations.end(), changesIt, locationChangeLog_.locations.end());
+  return true;
+}
+
+const ActionMaskChanges& Grid::getActionMaskChanges() const {
+  return actionMaskChanges_;
+}
+
+void Grid::purgeActionMaskChanges() {
+  actionMaskChanges_.invalidated = false;
+  actionMaskChanges_.locations.clear();
+  actionMaskChanges_.variables.clear();
+}
+
+bool Grid::isInBounds(glm::ivec2 location) const {
+  return location.x >= 0 && location.x < width_ && location.y >= 0 && location.y < height_;
+}
+
+TileObjects& Grid::getTile(glm::ivec2 location) {
+  auto tileIdx = location.y * width_ + location.x;
+  if (copyOnWriteSource_ != nullptr) {
+    return copyTile(tileIdx);
+  }
+  return tiles_[tileIdx];
+}
+
+const TileObjects& Grid::getTile(glm::ivec2 location) const {
+  // Copying a tile from the grid this one was cloned from does not change what is on the tile
+  return const_cast<Grid*>(this)->getTile(location);
+}
+
 bool Grid::updateLocation(std::shared_ptr<Object> object, glm::ivec2 previousLocation, glm::ivec2 newLocation) {
-  if (newLocation.x < 0 || newLocation.x >= width_ || newLocation.y < 0 || newLocation.y >= height_) {
+  if (!isInBounds(newLocation)) {
     return false;
   }
 
+  copyTileToCopyOnWriteClones(previousLocation);
+  copyTileToCopyOnWriteClones(newLocation);
+
   auto objectZIdx = object->getZIdx();
-  auto newLocationObjects = occupiedLocations_[newLocation];
+  auto& newLocationObjects = getTile(newLocation);
 
   if (newLocationObjects.find(objectZIdx) != newLocationObjects.end()) {
     spdlog::debug("Cannot move object {0} to location [{1}, {2}] as it is occupied.", object->getObjectName(), newLocation.x, newLocation.y);
     return false;
   }
 
-  occupiedLocations_[previousLocation].erase(objectZIdx);
-  occupiedLocations_[newLocation][objectZIdx] = object;
+  if (isJournaling()) {
+    auto previousState = object->getObjectState();
+    previousState.location = previousLocation;
+    journal_.push_back({GridJournalEntryType::OBJECT_MOVED, object, previousState, newLocation});
+  }
+
+  if (isInBounds(previousLocation)) {
+    getTile(previousLocation).erase(objectZIdx);
+  }
+  newLocationObjects.insert({objectZIdx, object});
 
   invalidateLocation(previousLocation);
   invalidateLocation(newLocation);
 
+  // The object only updates its own location once the grid has accepted the move
+  updateCollisionDetectors(object, previousLocation, newLocation);
+  bumpObjectNameVersion(object);
+  updateNearestObjectIndex(object, newLocation, false);
+
+  return true;
+}
+
+void Grid::updateCollisionDetectors(const std::shared_ptr<Object>& object, glm::ivec2 previousLocation, glm::ivec2 location) {
   // Update spatial hashes if they exists
   if (!collisionDetectors_.empty()) {
-    auto objectName = object->getObjectName();
-
-    auto collisionDetectorActionNamesIt = collisionObjectActionNames_.find(object->getObjectName());
-    if (collisionDetectorActionNamesIt != collisionObjectActionNames_.end()) {
-      auto collisionDetectorActionNames = collisionDetectorActionNamesIt->second;
-      for (const auto& actionName : collisionDetectorActionNames) {
-        auto collisionDetector = collisionDetectors_.at(actionName);
-        spdlog::debug("Updating object {0} location in collision detector for action {1}", objectName, actionName);
-        collisionDetector->upsert(object);
+    auto objectNameId = object->getObjectNameId();
+    if (objectNameId < objectCollisionDetectors_.size()) {
+      for (const auto& collisionDetector : objectCollisionDetectors_[objectNameId]) {
+        spdlog::debug("Updating object {0} location in collision detector", object->getObjectName());
+        collisionDetector->upsert(object, location);
+
+        // The previous location as well, the object may have been cached by a source it has moved out of range of
+        recordCollisionDetectorChange(collisionDetector, previousLocation);
+        recordCollisionDetectorChange(collisionDetector, location);
       }
     }
   }
+}
 
-  return true;
+void Grid::bumpObjectNameVersion(const std::shared_ptr<Object>& object) {
+  auto objectNameId = object->getObjectNameId();
+  if (objectNameId >= objectNameVersions_.size()) {
+    objectNameVersions_.resize(objectNameId + 1, 0);
+  }
+  objectNameVersions_[objectNameId]++;
+}
+
+uint64_t Grid::getObjectNameVersion(uint32_t objectNameId) const {
+  return objectNameId < objectNameVersions_.size() ? objectNameVersions_[objectNameId] : 0;
+}
+
+void Grid::updateNearestObjectIndex(const std::shared_ptr<Object>& object, glm::ivec2 location, bool removed) {
+  auto objectNameId = object->getObjectNameId();
+  if (objectNameId >= nearestObjectIndexes_.size() || nearestObjectIndexes_[objectNameId] == nullptr) {
+    return;
+  }
+
+  if (removed) {
+    nearestObjectIndexes_[objectNameId]->remove(object);
+  } else {
+    nearestObjectIndexes_[objectNameId]->upsert(object, location);
+  }
+}
+
+std::shared_ptr<NearestObjectIndex> Grid::getNearestObjectIndex(const std::string& objectName) {
+  auto objectNameId = SymbolTable::objectNames().intern(objectName);
+  if (objectNameId >= nearestObjectIndexes_.size()) {
+    nearestObjectIndexes_.resize(objectNameId + 1);
+  }
+
+  if (nearestObjectIndexes_[objectNameId] != nullptr) {
+    return nearestObjectIndexes_[objectNameId];
+  }
+
+  spdlog::debug("Creating nearest object index for {0}", objectName);
+  auto nearestObjectIndex = std::make_shared<NearestObjectIndex>(width_, height_);
+  nearestObjectIndexes_[objectNameId] = nearestObjectIndex;
+  for (const auto& object : objects_) {
+    if (object->getObjectNameId() == objectNameId) {
+      nearestObjectIndex->upsert(object);
+    }
+  }
+
+  // The index has to hold every object with the name, the objects that are copied add themselves to it
+  if (copyOnWriteSource_ != nullptr) {
+    std::vector<std::shared_ptr<Object>> sourceObjects;
+    copyOnWriteSource_->getNearestObjectIndex(objectName)->getObjects(sourceObjects);
+    for (const auto& sourceObject : sourceObjects) {
+      resolveCopiedObject(sourceObject);
+    }
+  }
+
+  return nearestObjectIndex;
+}
+
+void Grid::recordCollisionDetectorChange(const std::shared_ptr<CollisionDetector>& collisionDetector, glm::ivec2 location) {
+  auto& detectorChanges = collisionDetectorChanges_[collisionDetector.get()];
+  detectorChanges.changeCount++;
+
+  if (!isInBounds(location)) {
+    return;
+  }
+
+  if (detectorChanges.locationChangeStamps.empty()) {
+    detectorChanges.locationChangeStamps.resize(width_ * height_, 0);
+  }
+  detectorChanges.locationChangeStamps[location.y * width_ + location.x] = detectorChanges.changeCount;
 }
 
 const std::unordered_set<glm::ivec2>& Grid::getUpdatedLocations(uint32_t playerId) const {
@@ -176,7 +732,7 @@ const std::unordered_set<glm::ivec2>& Grid::getUpdatedLocations(uint32_t playerI
   return updatedLocations_[playerId];
 }
 
-std::unordered_map<uint32_t, int32_t> Grid::executeAndRecord(uint32_t playerId, const std::shared_ptr<Action>& action) {
+PlayerRewards Grid::executeAndRecord(uint32_t playerId, const std::shared_ptr<Action>& action) {
   if (recordEvents_) {
     auto event = buildGridEvent(action, playerId, *gameTicks_);
     auto reward = executeAction(playerId, action);
@@ -186,7 +742,7 @@ std::unordered_map<uint32_t, int32_t> Grid::executeAndRecord(uint32_t playerId,
   return executeAction(playerId, action);
 }
 
-std::vector<uint32_t> Grid::filterBehaviourProbabilities(std::vector<uint32_t> actionBehaviourIdxs, std::vector<float> actionProbabilities) {
+std::vector<uint32_t> Grid::filterBehaviourProbabilities(const std::vector<uint32_t>& actionBehaviourIdxs, const std::vector<float>& actionProbabilities) {
   std::vector<uint32_t> filteredBehaviours{};
 
   spdlog::debug("Action behaviour indexes to filter: {0}, probablilities to filter with: {1}", actionBehaviourIdxs.size(), actionProbabilities.size());
@@ -208,7 +764,7 @@ std::vector<uint32_t> Grid::filterBehaviourProbabilities(std::vector<uint32_t> a
   return filteredBehaviours;
 }
 
-std::unordered_map<uint32_t, int32_t> Grid::executeAction(uint32_t playerId, std::shared_ptr<Action> action) {
+PlayerRewards Grid::executeAction(uint32_t playerId, const std::shared_ptr<Action>& action) {
   auto sourceObject = action->getSourceObject();
 
   if (objects_.find(sourceObject) == objects_.end() && action->getDelay() > 0) {
@@ -219,7 +775,7 @@ std::unordered_map<uint32_t, int32_t> Grid::executeAction(uint32_t playerId, std
   auto destinationObject = action->getDestinationObject();
 
   // Need to get this name before anything happens to the object for example if the object is removed in onActionDst.
-  auto destinationObjectName = destinationObject->getObjectName();
+  auto destinationObjectNameId = destinationObject->getObjectNameId();
 
   if (sourceObject == nullptr) {
     spdlog::debug("Cannot perform action on empty space. ({0},{1})", action->getSourceLocation()[0], action->getSourceLocation()[1]);
@@ -240,10 +796,10 @@ std::unordered_map<uint32_t, int32_t> Grid::executeAction(uint32_t playerId, std
 
   auto validBehaviourIdxs = sourceObject->getValidBehaviourIdxs(action);
 
-  auto filteredBehaviourIdxs = filterBehaviourProbabilities(validBehaviourIdxs, behaviourProbabilities_.at(action->getActionName()));
+  auto filteredBehaviourIdxs = filterBehaviourProbabilities(validBehaviourIdxs, getBehaviourProbabilities(action->getActionNameId()));
 
   if (filteredBehaviourIdxs.size() > 0) {
-    std::unordered_map<uint32_t, int32_t> rewardAccumulator;
+    PlayerRewards rewardAccumulator;
     auto dstBehaviourResult = destinationObject->onActionDst(action, validBehaviourIdxs);
     accumulateRewards(rewardAccumulator, dstBehaviourResult.rewards);
 
@@ -252,7 +808,7 @@ std::unordered_map<uint32_t, int32_t> Grid::executeAction(uint32_t playerId, std
       return rewardAccumulator;
     }
 
-    auto srcBehaviourResult = sourceObject->onActionSrc(destinationObjectName, action, validBehaviourIdxs);
+    auto srcBehaviourResult = sourceObject->onActionSrc(destinationObjectNameId, action, validBehaviourIdxs);
     accumulateRewards(rewardAccumulator, srcBehaviourResult.rewards);
     return rewardAccumulator;
   }
@@ -270,11 +826,11 @@ GridEvent Grid::buildGridEvent(const std::shared_ptr<Action>& action, uint32_t p
   event.sourceObjectName = sourceObject->getObjectName();
   event.destObjectName = destObject->getObjectName();
 
-  if (sourceObject->getObjectName() != "_empty") {
+  if (sourceObject->getObjectNameId() != EMPTY_OBJECT_ID) {
     event.sourceObjectPlayerId = sourceObject->getPlayerId();
   }
 
-  if (destObject->getObjectName() != "_empty") {
+  if (destObject->getObjectNameId() != EMPTY_OBJECT_ID) {
     event.destinationObjectPlayerId = destObject->getPlayerId();
   }
 
@@ -287,13 +843,21 @@ GridEvent Grid::buildGridEvent(const std::shared_ptr<Action>& action, uint32_t p
   return event;
 }
 
-void Grid::recordGridEvent(GridEvent event, std::unordered_map<uint32_t, int32_t> rewards) {
+void Grid::recordGridEvent(GridEvent event, PlayerRewards rewards) {
   event.rewards = std::move(rewards);
   eventHistory_.push_back(event);
 }
 
-std::unordered_map<uint32_t, int32_t> Grid::performActions(uint32_t playerId, std::vector<std::shared_ptr<Action>> actions) {
-  std::unordered_map<uint32_t, int32_t> rewardAccumulator;
+std::shared_ptr<Action> Grid::newAction(std::string actionName, uint32_t playerId, uint32_t delay, ActionMetaData metaData) {
+  return newAction(SymbolTable::actionNames().intern(actionName), playerId, delay, std::move(metaData));
+}
+
+std::shared_ptr<Action> Grid::newAction(uint32_t actionNameId, uint32_t playerId, uint32_t delay, ActionMetaData metaData) {
+  return actionPool_.newAction(shared_from_this(), actionNameId, playerId, delay, std::move(metaData));
+}
+
+PlayerRewards Grid::performActions(uint32_t playerId, std::vector<std::shared_ptr<Action>> actions) {
+  PlayerRewards rewardAccumulator;
 
   spdlog::trace("Tick {0}", *gameTicks_);
 
@@ -313,72 +877,129 @@ std::unordered_map<uint32_t, int32_t> Grid::performActions(uint32_t playerId, st
   return rewardAccumulator;
 }
 
-void Grid::delayAction(uint32_t playerId, std::shared_ptr<Action> action) {
+void Grid::delayAction(uint32_t playerId, const std::shared_ptr<Action>& action) {
   auto executionTarget = *(gameTicks_) + action->getDelay();
   spdlog::debug("Delaying action={0} to execution target time {1}", action->getDescription(), executionTarget);
-  delayedActions_.push(std::make_shared<DelayedActionQueueItem>(DelayedActionQueueItem{playerId, executionTarget, action}));
+
+  // Actions that resolve their source from a location are not tied to the object that is there now
+  std::shared_ptr<Object> sourceObject = nullptr;
+  if (action->hasSourceObject()) {
+    sourceObject = action->getSourceObject();
+    if (objects_.find(sourceObject) == objects_.end()) {
+      sourceObject = nullptr;
+    }
+  }
+
+  DelayedActionQueueItem delayedAction{playerId, executionTarget, action, std::move(sourceObject)};
+  indexDelayedAction(delayedAction);
+
+  if (isJournaling()) {
+    journal_.push_back({GridJournalEntryType::DELAYED_ACTION_PUSHED});
+    journal_.back().delayedAction = delayedAction;
+  }
+
+  delayedActions_.push(std::move(delayedAction));
 }
 
-std::unordered_map<uint32_t, int32_t> Grid::processDelayedActions() {
-  std::unordered_map<uint32_t, int32_t> delayedRewards;
+PlayerRewards Grid::processDelayedActions() {
+  PlayerRewards delayedRewards;
 
   spdlog::debug("{0} Delayed actions at game tick {1}", delayedActions_.size(), *gameTicks_);
 
-  // Perform any delayed actions
-  std::vector<std::shared_ptr<DelayedActionQueueItem>> actionsToExecute;
-  while (!delayedActions_.empty() && delayedActions_.top()->priority <= *(gameTicks_)) {
-    // Get the top element and remove it
-    actionsToExecute.push_back(delayedActions_.top());
-    delayedActions_.pop();
-  }
+  // Perform any delayed actions, the buffer is swapped out as executing actions can delay more actions
+  std::vector<DelayedActionQueueItem> actionsToExecute;
+  actionsToExecute.swap(delayedActionsToExecute_);
+  delayedActions_.popDue(*gameTicks_, actionsToExecute);
 
   for (const auto& delayedAction : actionsToExecute) {
-    auto action = delayedAction->action;
-    auto playerId = delayedAction->playerId;
+    unindexDelayedAction(delayedAction);
 
+    if (isJournaling()) {
+      journal_.push_back({GridJournalEntryType::DELAYED_ACTION_POPPED});
+      journal_.back().delayedAction = delayedAction;
+    }
+  }
+
+  for (const auto& delayedAction : actionsToExecute) {
+    const auto& action = delayedAction.action;
     spdlog::debug("Popped delayed action {0} at game tick {1}", action->getDescription(), *gameTicks_);
 
-    auto delayedActionRewards = executeAndRecord(playerId, action);
+    auto delayedActionRewards = executeAndRecord(delayedAction.playerId, action);
     accumulateRewards(delayedRewards, delayedActionRewards);
   }
 
+  // Release the actions but keep the capacity for the next tick
+  actionsToExecute.clear();
+  delayedActionsToExecute_.swap(actionsToExecute);
+
   return delayedRewards;
 }
 
-std::unordered_map<uint32_t, int32_t> Grid::processCollisions() {
-  std::unordered_map<uint32_t, int32_t> collisionRewards;
+void Grid::indexDelayedAction(const DelayedActionQueueItem& delayedAction) {
+  if (delayedAction.sourceObject != nullptr) {
+    delayedAction.sourceObject->addPendingDelayedAction(delayedAction.priority, delayedAction.action.get());
+  }
+}
+
+void Grid::unindexDelayedAction(const DelayedActionQueueItem& delayedAction) {
+  if (delayedAction.sourceObject != nullptr) {
+    delayedAction.sourceObject->removePendingDelayedAction(delayedAction.action.get());
+  }
+}
+
+void Grid::cancelDelayedActions(const std::shared_ptr<Object>& object) {
+  for (const auto& pendingDelayedAction : object->takePendingDelayedActions()) {
+    DelayedActionQueueItem cancelledAction;
+    if (!delayedActions_.remove(pendingDelayedAction.executionTick, pendingDelayedAction.action, &cancelledAction)) {
+      continue;
+    }
+
+    spdlog::debug("Cancelled delayed action {0} of removed object {1}", cancelledAction.action->getDescription(), object->getDescription());
+
+    if (isJournaling()) {
+      journal_.push_back({GridJournalEntryType::DELAYED_ACTION_CANCELLED});
+      journal_.back().delayedAction = std::move(cancelledAction);
+    }
+  }
+}
+
+PlayerRewards Grid::processCollisions() {
+  PlayerRewards collisionRewards;
 
   if (collisionDetectors_.empty()) {
     return collisionRewards;
   }
 
+  // Actions can add and remove collision sources, so the sources are copied out first
+  collisionSourcesToProcess_.assign(collisionSourceObjects_.begin(), collisionSourceObjects_.end());
+
   // Check for collisions
-  for (const auto& object : collisionSourceObjects_) {
-    const auto& objectName = object->getObjectName();
-    auto collisionActionNamesIt = collisionSourceObjectActionNames_.find(objectName);
-    if (collisionActionNamesIt != collisionSourceObjectActionNames_.end()) {
-      const auto& collisionActionNames = collisionSourceObjectActionNames_.at(objectName);
-      auto location = object->getLocation();
+  for (const auto& object : collisionSourcesToProcess_) {
+    if (collisionSourceObjects_.find(object) == collisionSourceObjects_.end()) {
+      continue;
+    }
+
+    auto objectNameId = object->getObjectNameId();
+    if (objectNameId < sourceObjectCollisionTriggers_.size()) {
+      const auto& objectName = object->getObjectName();
       auto playerId = object->getPlayerId();
 
-      for (const auto& actionName : collisionActionNames) {
-        spdlog::debug("Collision detector under action {0} for object {1} being queried", actionName, objectName);
-        auto collisionDetector = collisionDetectors_.at(actionName);
-        auto searchResults = collisionDetector->search(location);
-        auto& actionTriggerDefinition = actionTriggerDefinitions_.at(actionName);
+      const auto& collisionTriggers = sourceObjectCollisionTriggers_[objectNameId];
+      for (size_t triggerIdx = 0; triggerIdx < collisionTriggers.size(); triggerIdx++) {
+        const auto& actionName = collisionTriggers[triggerIdx].actionName;
 
-        auto objectsInCollisionRange = searchResults.objectSet;
+        // Copied as executing the actions can remove the source and its cache
+        const auto& objectsInCollisionRange = searchCollisions(object, triggerIdx, collisionTriggers[triggerIdx]);
+        collisionObjectsToProcess_.assign(objectsInCollisionRange.begin(), objectsInCollisionRange.end());
 
-        for (const auto& collisionObject : objectsInCollisionRange) {
+        for (const auto& collisionObject : collisionObjectsToProcess_) {
           if (collisionObject == object) {
-            {
-              continue;
-            }
+            continue;
           }
 
           spdlog::debug("Collision detected for action {0} {1}->{2}", actionName, collisionObject->getObjectName(), objectName);
 
-          std::shared_ptr<Action> collisionAction = std::make_shared<Action>(Action(shared_from_this(), actionName, playerId, 0));
+          auto collisionAction = newAction(collisionTriggers[triggerIdx].actionNameId, playerId);
           collisionAction->init(object, collisionObject);
 
           auto rewards = executeAndRecord(0, collisionAction);
@@ -389,13 +1010,61 @@ std::unordered_map<uint32_t, int32_t> Grid::processCollisions() {
     }
   }
 
+  collisionSourcesToProcess_.clear();
+  collisionObjectsToProcess_.clear();
+
   return collisionRewards;
 }
 
-std::unordered_map<uint32_t, int32_t> Grid::update() {
-  *(gameTicks_) += 1;
+const std::vector<std::shared_ptr<Object>>& Grid::searchCollisions(const std::shared_ptr<Object>& object, size_t triggerIdx, const CollisionTrigger& collisionTrigger) {
+  auto& objectCachedCollisions = cachedCollisions_[object.get()];
+  if (triggerIdx >= objectCachedCollisions.size()) {
+    objectCachedCollisions.resize(triggerIdx + 1);
+  }
 
-  std::unordered_map<uint32_t, int32_t> rewards;
+  auto& cachedCollisions = objectCachedCollisions[triggerIdx];
+  const auto& detectorChanges = collisionDetectorChanges_[collisionTrigger.collisionDetector.get()];
+  const auto& locationChangeStamps = detectorChanges.locationChangeStamps;
+  auto location = object->getLocation();
+
+  bool valid = cachedCollisions.valid && cachedCollisions.sourceLocation == location;
+  if (valid && cachedCollisions.changeCount != detectorChanges.changeCount && !locationChangeStamps.empty()) {
+    // Only the locations in range of the source are checked, however many changes were made elsewhere
+    auto range = static_cast<int32_t>(collisionTrigger.collisionDetector->getRange());
+    auto minX = std::max(location.x - range, 0);
+    auto maxX = std::min(location.x + range, static_cast<int32_t>(width_) - 1);
+    auto minY = std::max(location.y - range, 0);
+    auto maxY = std::min(location.y + range, static_cast<int32_t>(height_) - 1);
+    for (auto y = minY; valid && y <= maxY; y++) {
+      for (auto x = minX; valid && x <= maxX; x++) {
+        valid = locationChangeStamps[y * width_ + x] <= cachedCollisions.changeCount;
+      }
+    }
+  }
+
+  if (!valid) {
+    spdlog::debug("Collision detector under action {0} for object {1} being queried", collisionTrigger.actionName, object->getObjectName());
+    cachedCollisions.objects.clear();
+    collisionTrigger.collisionDetector->searchObjects(location, cachedCollisions.objects);
+    cachedCollisions.sourceLocation = location;
+    cachedCollisions.valid = true;
+  }
+
+  cachedCollisions.changeCount = detectorChanges.changeCount;
+  return cachedCollisions.objects;
+}
+
+PlayerRewards Grid::update() {
+  if (locationChangeLog_.enabled) {
+    auto discardedChangeCount = locationChangeLog_.tickStartChangeIdx - locationChangeLog_.firstChangeIdx;
+    locationChangeLog_.locations.erase(locationChangeLog_.locations.begin(), locationChangeLog_.locations.begin() + static_cast<std::ptrdiff_t>(discardedChangeCount));
+    locationChangeLog_.firstChangeIdx = locationChangeLog_.tickStartChangeIdx;
+    locationChangeLog_.tickStartChangeIdx = getLocationChangeCount();
+  }
+
+  writeVariable(gameTicks_.get(), *gameTicks_ + 1, nullptr);
+
+  PlayerRewards rewards;
 
   auto delayedActionRewards = processDelayedActions();
   spdlog::debug("Delayed actions processed");
@@ -409,7 +1078,7 @@ std::unordered_map<uint32_t, int32_t> Grid::update() {
   return rewards;
 }
 
-DelayedActionQueue Grid::getDelayedActions() {
+const DelayedActionQueue& Grid::getDelayedActions() const {
   return delayedActions_;
 }
 
@@ -418,24 +1087,49 @@ std::shared_ptr<int32_t> Grid::getTickCount() const {
 }
 
 void Grid::setTickCount(int32_t tickCount) {
-  *gameTicks_ = tickCount;
+  writeVariable(gameTicks_.get(), tickCount, nullptr);
 }
 
 const std::unordered_set<std::shared_ptr<Object>>& Grid::getObjects() {
-  return this->objects_;
+  if (copyOnWriteSource_ == nullptr) {
+    return this->objects_;
+  }
+
+  auto objectsVersion = getObjectsVersion();
+  if (copyOnWriteObjectsViewVersion_ != objectsVersion) {
+    copyOnWriteObjectsView_ = objects_;
+    for (const auto& sourceObject : copyOnWriteSource_->getObjects()) {
+      auto location = sourceObject->getLocation();
+      if (copyOnWriteTiles_.find(location.y * width_ + location.x) == copyOnWriteTiles_.end()) {
+        copyOnWriteObjectsView_.insert(sourceObject);
+      }
+    }
+    copyOnWriteObjectsViewVersion_ = objectsVersion;
+  }
+
+  return copyOnWriteObjectsView_;
 }
 
 const TileObjects& Grid::getObjectsAt(glm::ivec2 location) const {
-  auto i = occupiedLocations_.find(location);
-  if (i == occupiedLocations_.end()) {
+  if (!isInBounds(location)) {
     return EMPTY_OBJECTS;
   }
-  return i->second;
+
+  // Reading does not copy the tile, the grid this one was cloned from copies it in before changing it
+  if (copyOnWriteSource_ != nullptr) {
+    auto copiedTileIt = copyOnWriteTiles_.find(location.y * width_ + location.x);
+    if (copiedTileIt == copyOnWriteTiles_.end()) {
+      return copyOnWriteSource_->getObjectsAt(location);
+    }
+    return copiedTileIt->second;
+  }
+
+  return getTile(location);
 }
 
 std::shared_ptr<Object> Grid::getObject(glm::ivec2 location) const {
-  if (occupiedLocations_.count(location) > 0) {
-    const auto& objectsAtLocation = occupiedLocations_.at(location);
+  if (isInBounds(location)) {
+    const auto& objectsAtLocation = getTile(location);
     if (!objectsAtLocation.empty()) {
       // Get the highest index object
       return objectsAtLocation.rbegin()->second;
@@ -510,45 +1204,92 @@ const std::map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t
 }
 
 void Grid::setBehaviourProbabilities(const std::unordered_map<std::string, std::vector<float>>& behaviourProbabilities) {
-  behaviourProbabilities_ = behaviourProbabilities;
+  behaviourProbabilities_.clear();
+  for (const auto& behaviourProbabilitiesIt : behaviourProbabilities) {
+    auto actionNameId = SymbolTable::actionNames().intern(behaviourProbabilitiesIt.first);
+    if (actionNameId >= behaviourProbabilities_.size()) {
+      behaviourProbabilities_.resize(actionNameId + 1);
+    }
+    behaviourProbabilities_[actionNameId] = behaviourProbabilitiesIt.second;
+  }
+}
+
+const std::vector<float>& Grid::getBehaviourProbabilities(uint32_t actionNameId) const {
+  if (actionNameId >= behaviourProbabilities_.size() || behaviourProbabilities_[actionNameId].empty()) {
+    throw std::out_of_range(fmt::format("No behaviour probabilities for action {0}", SymbolTable::actionNames().getName(actionNameId)));
+  }
+
+  return behaviourProbabilities_[actionNameId];
 }
 
 void Grid::addCollisionDetector(std::unordered_set<std::string> objectNames, std::string actionName, std::shared_ptr<CollisionDetector> collisionDetector) {
+  detachFromCopyOnWriteSource();
+
+  const auto& actionCollisionDetector = collisionDetectors_.insert({actionName, collisionDetector}).first->second;
+
   for (const auto& objectName : objectNames) {
-    collisionObjectActionNames_[objectName].insert(actionName);
+    if (collisionObjectActionNames_[objectName].insert(actionName).second) {
+      auto objectNameId = SymbolTable::objectNames().intern(objectName);
+      if (objectNameId >= objectCollisionDetectors_.size()) {
+        objectCollisionDetectors_.resize(objectNameId + 1);
+      }
+      objectCollisionDetectors_[objectNameId].push_back(actionCollisionDetector);
+    }
 
     spdlog::debug("Adding collision detector with name {0} for action {1}", objectName, actionName);
   }
 
-  collisionDetectors_.insert({actionName, collisionDetector});
-
   // If we are adding an collision detector, make sure that all required objects are added to it.
   for(const auto& object : objects_) {
     const auto& objectName = object->getObjectName();
     if(objectNames.find(objectName)!=objectNames.end()) {
       collisionDetector->upsert(object);
+      recordCollisionDetectorChange(collisionDetector, object->getLocation());
     }
   }
 }
 
+std::shared_ptr<FlowField> Grid::getFlowField(const std::string& key) const {
+  auto flowFieldIt = flowFields_.find(key);
+  return flowFieldIt == flowFields_.end() ? nullptr : flowFieldIt->second;
+}
+
+void Grid::addFlowField(const std::string& key, std::shared_ptr<FlowField> flowField) {
+  flowFields_[key] = std::move(flowField);
+}
+
+std::shared_ptr<PassabilityMap> Grid::getPassabilityMap(const std::string& key) const {
+  auto passabilityMapIt = passabilityMaps_.find(key);
+  return passabilityMapIt == passabilityMaps_.end() ? nullptr : passabilityMapIt->second;
+}
+
+void Grid::addPassabilityMap(const std::string& key, std::shared_ptr<PassabilityMap> passabilityMap) {
+  passabilityMaps_[key] = std::move(passabilityMap);
+}
+
 void Grid::addActionTrigger(std::string actionName, ActionTriggerDefinition actionTriggerDefinition) {
   std::shared_ptr<CollisionDetector> collisionDetector = collisionDetectorFactory_->newCollisionDetector(width_, height_, actionTriggerDefinition);
 
   std::unordered_set<std::string> objectNames;
-  for (const auto& sourceObjectName : actionTriggerDefinition.sourceObjectNames) {
-    // TODO: I dont think we need to add source names to all object names?
-    // objectNames.push_back(sourceObjectName);
-    collisionSourceObjectActionNames_[sourceObjectName].insert(actionName);
-  }
-
   for (const auto& destinationObjectName : actionTriggerDefinition.destinationObjectNames) {
     objectNames.insert(destinationObjectName);
-    collisionObjectActionNames_[destinationObjectName].insert(actionName);
   }
 
   actionTriggerDefinitions_.insert({actionName, actionTriggerDefinition});
 
   addCollisionDetector(objectNames, actionName, collisionDetector);
+
+  for (const auto& sourceObjectName : actionTriggerDefinition.sourceObjectNames) {
+    // TODO: I dont think we need to add source names to all object names?
+    // objectNames.push_back(sourceObjectName);
+    if (collisionSourceObjectActionNames_[sourceObjectName].insert(actionName).second) {
+      auto objectNameId = SymbolTable::objectNames().intern(sourceObjectName);
+      if (objectNameId >= sourceObjectCollisionTriggers_.size()) {
+        sourceObjectCollisionTriggers_.resize(objectNameId + 1);
+      }
+      sourceObjectCollisionTriggers_[objectNameId].push_back({actionName, SymbolTable::actionNames().intern(actionName), collisionDetectors_.at(actionName)});
+    }
+  }
 }
 
 void Grid::addPlayerDefaultObjects(std::shared_ptr<Object> emptyObject, std::shared_ptr<Object> boundaryObject) {
@@ -579,6 +1320,12 @@ void Grid::addObject(glm::ivec2 location, std::shared_ptr<Object> object, bool a
     throwRuntimeError(fmt::format("Cannot add object {0} with player id {1} as the environment is only configured for {2} players.", objectName, playerId, playerCount_));
   }
 
+  if (!isInBounds(location)) {
+    throwRuntimeError(fmt::format("Cannot add object {0} to location [{1}, {2}] as it is outside the {3}x{4} grid.", objectName, location.x, location.y, width_, height_));
+  }
+
+  copyTileToCopyOnWriteClones(location);
+
   if (object->isPlayerAvatar()) {
     // If there is no playerId set on the object, we should set the playerId to 1 as 0 is reserved
     spdlog::debug("Player avatar (playerId:{3}) set as object={0} at location [{1}, {2}]", object->getObjectName(), location.x, location.y, playerId);
@@ -592,7 +1339,7 @@ void Grid::addObject(glm::ivec2 location, std::shared_ptr<Object> object, bool a
     object->init(location, orientation);
 
     auto objectZIdx = object->getZIdx();
-    auto& objectsAtLocation = occupiedLocations_[location];
+    auto& objectsAtLocation = getTile(location);
 
     auto objectAtZIt = objectsAtLocation.find(objectZIdx);
 
@@ -601,17 +1348,28 @@ void Grid::addObject(glm::ivec2 location, std::shared_ptr<Object> object, bool a
       spdlog::error("Cannot add object={0} to location: [{1},{2}], there is already an object here.", objectName, location.x, location.y);
       objects_.erase(object);
     } else {
-      auto objectCountersForPlayers = objectCounters_[objectName];
+      objectsVersion_++;
+      auto& objectCountersForPlayers = objectCounters_[objectName];
 
       // Initialize the counter if it does not exist
-      auto objectCounterForPlayerIt = objectCountersForPlayers.find(playerId);
-      if (objectCounterForPlayerIt == objectCountersForPlayers.end()) {
-        objectCounters_[objectName][playerId] = std::make_shared<int32_t>(0);
+      auto& objectCounterForPlayer = objectCountersForPlayers[playerId];
+      if (objectCounterForPlayer == nullptr) {
+        objectCounterForPlayer = std::make_shared<int32_t>(0);
       }
 
-      *objectCounters_[objectName][playerId] += 1;
+      *objectCounterForPlayer += 1;
       objectsAtLocation.insert({objectZIdx, object});
       invalidateLocation(location);
+      bumpObjectNameVersion(object);
+      updateNearestObjectIndex(object, location, false);
+
+      auto stateHash = object->getStateHash();
+      object->setCachedStateHash(stateHash);
+      objectsStateHash_ ^= stateHash;
+
+      if (isJournaling()) {
+        journal_.push_back({GridJournalEntryType::OBJECT_ADDED, object});
+      }
     }
 
     if (applyInitialActions) {
@@ -623,18 +1381,16 @@ void Grid::addObject(glm::ivec2 location, std::shared_ptr<Object> object, bool a
     }
 
     if (!collisionDetectors_.empty()) {
-      const auto& collisionDetectorActionNamesIt = collisionObjectActionNames_.find(objectName);
-      if (collisionDetectorActionNamesIt != collisionObjectActionNames_.end()) {
-        const auto& collisionDetectorActionNames = collisionObjectActionNames_.at(objectName);
-        for (const auto& actionName : collisionDetectorActionNames) {
-          auto collisionDetector = collisionDetectors_.at(actionName);
-          spdlog::debug("Adding object {0} to collision detector for action {1}", objectName, actionName);
+      auto objectNameId = object->getObjectNameId();
+      if (objectNameId < objectCollisionDetectors_.size()) {
+        for (const auto& collisionDetector : objectCollisionDetectors_[objectNameId]) {
+          spdlog::debug("Adding object {0} to collision detector", objectName);
           collisionDetector->upsert(object);
+          recordCollisionDetectorChange(collisionDetector, object->getLocation());
         }
       }
 
-      auto collisionActionNamesIt = collisionSourceObjectActionNames_.find(objectName);
-      if (collisionActionNamesIt != collisionSourceObjectActionNames_.end()) {
+      if (objectNameId < sourceObjectCollisionTriggers_.size() && !sourceObjectCollisionTriggers_[objectNameId].empty()) {
         collisionSourceObjects_.insert(object);
       }
     }
@@ -659,9 +1415,23 @@ bool Grid::removeObject(std::shared_ptr<Object> object) {
   auto objectZIdx = object->getZIdx();
   spdlog::debug("Removing object={0} with playerId={1} from environment.", object->getDescription(), playerId);
 
-  if (objects_.erase(object) > 0 && occupiedLocations_[location].erase(objectZIdx) > 0) {
+  copyTileToCopyOnWriteClones(location);
+
+  if (objects_.erase(object) > 0 && isInBounds(location) && getTile(location).erase(objectZIdx) > 0) {
+    objectsVersion_++;
     *objectCounters_[objectName][playerId] -= 1;
     invalidateLocation(location);
+    bumpObjectNameVersion(object);
+    updateNearestObjectIndex(object, location, true);
+
+    objectsStateHash_ ^= object->getCachedStateHash();
+
+    if (isJournaling()) {
+      journal_.push_back({GridJournalEntryType::OBJECT_REMOVED, object, object->getObjectState(), location});
+    }
+
+    // Cancelled straight away rather than skipped when they are due, so they do not keep the object alive
+    cancelDelayedActions(object);
 
     // if we are removing a player's avatar
     if (!playerAvatars_.empty() && playerId != 0) {
@@ -673,16 +1443,16 @@ bool Grid::removeObject(std::shared_ptr<Object> object) {
     }
 
     if (!collisionDetectors_.empty()) {
-      auto collisionDetectorActionNamesIt = collisionObjectActionNames_.find(objectName);
-      if (collisionDetectorActionNamesIt != collisionObjectActionNames_.end()) {
-        auto collisionDetectorActionNames = collisionDetectorActionNamesIt->second;
-        for (const auto& actionName : collisionDetectorActionNames) {
-          auto collisionDetector = collisionDetectors_.at(actionName);
+      auto objectNameId = object->getObjectNameId();
+      if (objectNameId < objectCollisionDetectors_.size()) {
+        for (const auto& collisionDetector : objectCollisionDetectors_[objectNameId]) {
           collisionDetector->remove(object);
+          recordCollisionDetectorChange(collisionDetector, location);
         }
       }
 
       collisionSourceObjects_.erase(object);
+      cachedCollisions_.erase(object.get());
     }
 
     return true;
@@ -712,6 +1482,185 @@ void Grid::purgeHistory() {
   eventHistory_.clear();
 }
 
+void Grid::enableJournal(bool enable) {
+  journalEnabled_ = enable;
+  if (!enable) {
+    journal_.clear();
+    checkpoints_.clear();
+  }
+}
+
+uint32_t Grid::checkpoint() {
+  if (!journalEnabled_) {
+    throwRuntimeError("Cannot create a checkpoint as the grid journal is not enabled.");
+  }
+
+  checkpoints_.push_back({journal_.size(), randomGenerator_->getEngine()});
+  return static_cast<uint32_t>(checkpoints_.size() - 1);
+}
+
+void Grid::rollback(uint32_t checkpointId) {
+  if (checkpointId >= checkpoints_.size()) {
+    throwRuntimeError(fmt::format("Cannot roll back to checkpoint {0}, there are only {1} checkpoints.", checkpointId, checkpoints_.size()));
+  }
+
+  const auto& checkpoint = checkpoints_[checkpointId];
+  spdlog::debug("Rolling back {0} journal entries to checkpoint {1}", journal_.size() - checkpoint.journalPosition, checkpointId);
+
+  // Undoing entries goes through the same methods that record them
+  journalEnabled_ = false;
+  while (journal_.size() > checkpoint.journalPosition) {
+    undoJournalEntry(journal_.back());
+    journal_.pop_back();
+  }
+  journalEnabled_ = true;
+
+  randomGenerator_->getEngine() = checkpoint.randomEngine;
+
+  // Checkpoints taken after this one are no longer reachable
+  checkpoints_.erase(checkpoints_.begin() + checkpointId + 1, checkpoints_.end());
+}
+
+bool Grid::isJournaling() const {
+  return journalEnabled_ && !checkpoints_.empty();
+}
+
+void Grid::writeVariable(int32_t* variable, int32_t value, const std::shared_ptr<Object>& object) {
+  // Clones copy the tick count and global variables when they are created, they only share object variables
+  if (object != nullptr) {
+    copyTileToCopyOnWriteClones(object->getLocation());
+  }
+
+  auto previousValue = *variable;
+
+  if (isJournaling()) {
+    journal_.push_back({GridJournalEntryType::VARIABLE_CHANGED, object});
+    auto& entry = journal_.back();
+    entry.variable = variable;
+    entry.previousValue = previousValue;
+  }
+
+  *variable = value;
+  onVariableChanged(variable, previousValue, object);
+}
+
+static uint64_t globalVariableStateHash(uint64_t key, int32_t value) {
+  return mixHash(key ^ static_cast<uint32_t>(value));
+}
+
+void Grid::onVariableChanged(const int32_t* variable, int32_t previousValue, const std::shared_ptr<Object>& object) {
+  if (actionMaskTracking_) {
+    actionMaskChanges_.variables.insert(variable);
+  }
+
+  // Objects can write global variables too, they are not part of the object's hash
+  auto keyIt = globalVariableStateHashKeys_.find(variable);
+  if (keyIt != globalVariableStateHashKeys_.end()) {
+    globalVariablesStateHash_ ^= globalVariableStateHash(keyIt->second, previousValue) ^ globalVariableStateHash(keyIt->second, *variable);
+  } else if (object != nullptr) {
+    updateStateHash(object);
+  }
+}
+
+uint64_t Grid::getStateHash() const {
+  return objectsStateHash_ ^ globalVariablesStateHash_;
+}
+
+void Grid::updateStateHash(const std::shared_ptr<Object>& object) {
+  if (objects_.find(object) == objects_.end()) {
+    return;
+  }
+
+  auto stateHash = object->getStateHash();
+  objectsStateHash_ ^= object->getCachedStateHash() ^ stateHash;
+  object->setCachedStateHash(stateHash);
+}
+
+void Grid::resetGlobalVariablesStateHash() {
+  globalVariableStateHashKeys_.clear();
+  globalVariablesStateHash_ = 0;
+  for (const auto& globalVariable : globalVariables_) {
+    // Ignore the internal _steps count
+    if (globalVariable.first == "_steps") {
+      continue;
+    }
+
+    auto variableNameHash = mixHash(std::hash<std::string>()(globalVariable.first));
+    for (const auto& playerVariable : globalVariable.second) {
+      auto key = mixHash(variableNameHash ^ playerVariable.first);
+      globalVariableStateHashKeys_[playerVariable.second.get()] = key;
+      globalVariablesStateHash_ ^= globalVariableStateHash(key, *playerVariable.second);
+    }
+  }
+}
+
+void Grid::recordObjectStateChange(const std::shared_ptr<Object>& object) {
+  copyTileToCopyOnWriteClones(object->getLocation());
+
+  if (isJournaling()) {
+    journal_.push_back({GridJournalEntryType::OBJECT_STATE_CHANGED, object, object->getObjectState()});
+  }
+}
+
+void Grid::undoJournalEntry(const GridJournalEntry& entry) {
+  switch (entry.type) {
+    case GridJournalEntryType::VARIABLE_CHANGED: {
+      if (entry.object != nullptr) {
+        copyTileToCopyOnWriteClones(entry.object->getLocation());
+      }
+      auto previousValue = *entry.variable;
+      *entry.variable = entry.previousValue;
+      onVariableChanged(entry.variable, previousValue, entry.object);
+    } break;
+    case GridJournalEntryType::OBJECT_STATE_CHANGED:
+      copyTileToCopyOnWriteClones(entry.object->getLocation());
+      entry.object->setObjectState(entry.previousState);
+      updateStateHash(entry.object);
+      invalidateLocation(entry.previousState.location);
+      break;
+    case GridJournalEntryType::OBJECT_MOVED: {
+      const auto& object = entry.object;
+      auto objectZIdx = object->getZIdx();
+      auto previousLocation = entry.previousState.location;
+      copyTileToCopyOnWriteClones(entry.location);
+      copyTileToCopyOnWriteClones(previousLocation);
+      getTile(entry.location).erase(objectZIdx);
+      if (isInBounds(previousLocation)) {
+        getTile(previousLocation).insert({objectZIdx, object});
+      }
+      object->setObjectState(entry.previousState);
+      updateStateHash(object);
+      invalidateLocation(entry.location);
+      invalidateLocation(previousLocation);
+      updateCollisionDetectors(object, entry.location, previousLocation);
+      bumpObjectNameVersion(object);
+      updateNearestObjectIndex(object, previousLocation, false);
+    } break;
+    case GridJournalEntryType::OBJECT_ADDED:
+      removeObject(entry.object);
+      break;
+    case GridJournalEntryType::OBJECT_REMOVED: {
+      addObject(entry.location, entry.object, false);
+      auto previousState = entry.previousState;
+      previousState.removed = false;
+      entry.object->setObjectState(previousState);
+      updateStateHash(entry.object);
+    } break;
+    case GridJournalEntryType::DELAYED_ACTION_PUSHED:
+      delayedActions_.remove(entry.delayedAction.priority, entry.delayedAction.action.get());
+      unindexDelayedAction(entry.delayedAction);
+      break;
+    case GridJournalEntryType::DELAYED_ACTION_POPPED:
+      indexDelayedAction(entry.delayedAction);
+      delayedActions_.restore(entry.delayedAction);
+      break;
+    case GridJournalEntryType::DELAYED_ACTION_CANCELLED:
+      indexDelayedAction(entry.delayedAction);
+      delayedActions_.push(entry.delayedAction);
+      break;
+  }
+}
+
 const std::unordered_map<std::string, std::shared_ptr<CollisionDetector>>& Grid::getCollisionDetectors() const {
   return collisionDetectors_;
 }
@@ -9,10 +9,14 @@
 #include <vector>
 
 #include "CollisionDetectorFactory.hpp"
-#include "DelayedActionQueueItem.hpp"
+#include "DelayedActionQueue.hpp"
 #include "GDY/Actions/Action.hpp"
+#include "GDY/Actions/ActionPool.hpp"
+#include "GDY/SymbolTable.hpp"
 #include "GDY/Objects/Object.hpp"
 #include "LevelGenerators/LevelGenerator.hpp"
+#include "PlayerRewards.hpp"
+#include "TileObjects.hpp"
 #include "Util/util.hpp"
 #include "Util/RandomGenerator.hpp"
 
@@ -20,10 +24,13 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/hash.hpp>
 
-#define TileObjects std::map<uint32_t, std::shared_ptr<Object>>
-
 namespace griddly {
 
+class FlowField;
+class PassabilityMap;
+class NearestObjectIndex;
+class ObjectGenerator;
+
 enum class TriggerType {
   NONE,
   RANGE_BOX_BOUNDARY,
@@ -37,12 +44,36 @@ struct ActionTriggerDefinition {
   uint32_t range = 1;
 };
 
+struct CollisionTrigger {
+  std::string actionName;
+  uint32_t actionNameId;
+  std::shared_ptr<CollisionDetector> collisionDetector;
+};
+
+// Where objects have been upserted into or removed from a collision detector
+struct CollisionDetectorChanges {
+  // The number of objects upserted or removed so far
+  uint64_t changeCount = 0;
+  // Indexed by y * width + x, the change count just after the last change at each location
+  std::vector<uint64_t> locationChangeStamps;
+};
+
+// The objects a collision source found on its last search. They are reused until the source moves or an object is
+// upserted or removed at a location in range of the source, cached objects are always in range so that covers them too
+struct CachedCollisions {
+  bool valid = false;
+  glm::ivec2 sourceLocation{};
+  // The change count of the detector when the objects were searched for
+  uint64_t changeCount = 0;
+  std::vector<std::shared_ptr<Object>> objects;
+};
+
 // Structure to hold information about the events that have happened at each time step
 struct GridEvent {
   uint32_t playerId;
   std::string actionName;
   uint32_t tick = 0;
-  std::unordered_map<uint32_t, int32_t> rewards;
+  PlayerRewards rewards;
   uint32_t delay = 0;
 
   std::string sourceObjectName;
@@ -55,6 +86,70 @@ struct GridEvent {
   glm::ivec2 destLocation;
 };
 
+enum class GridJournalEntryType {
+  VARIABLE_CHANGED,
+  OBJECT_STATE_CHANGED,
+  OBJECT_MOVED,
+  OBJECT_ADDED,
+  OBJECT_REMOVED,
+  DELAYED_ACTION_PUSHED,
+  DELAYED_ACTION_POPPED,
+  DELAYED_ACTION_CANCELLED,
+};
+
+// A single mutation of the grid, holding what is needed to undo it
+struct GridJournalEntry {
+  GridJournalEntryType type;
+  std::shared_ptr<Object> object = nullptr;
+  ObjectState previousState{};
+  // The location an object was moved to or removed from
+  glm::ivec2 location{};
+  // Object variables are kept alive by the object, global variables by the grid
+  int32_t* variable = nullptr;
+  int32_t previousValue = 0;
+  DelayedActionQueueItem delayedAction{};
+};
+
+struct GridCheckpoint {
+  size_t journalPosition;
+  std::mt19937 randomEngine;
+};
+
+// What has changed since incremental action masks were last updated
+struct ActionMaskChanges {
+  // Set when the grid has been reset, so every mask has to be recomputed
+  bool invalidated = true;
+  std::unordered_set<glm::ivec2> locations;
+  std::unordered_set<const int32_t*> variables;
+};
+
+// Every location that has changed, in order, so incremental path finders can repair their searches
+struct LocationChangeLog {
+  bool enabled = false;
+
+  // The index of the first location in the log, earlier changes have been discarded
+  uint64_t firstChangeIdx = 0;
+
+  // Changes before this index are discarded when the next tick starts
+  uint64_t tickStartChangeIdx = 0;
+
+  std::vector<glm::ivec2> locations;
+};
+
+// The state of a grid that can be restored in bulk. The objects are not copied, restoring the snapshot puts the same
+// objects back in the grid with the state and variable values they had when it was taken
+struct GridSnapshot {
+  std::vector<TileObjects> tiles;
+  std::vector<std::shared_ptr<Object>> objects;
+  // In the same order as objects
+  std::vector<ObjectState> objectStates;
+  // The object, global and object counter variables and their values
+  std::vector<std::pair<std::shared_ptr<int32_t>, int32_t>> variableValues;
+  std::unordered_map<uint32_t, std::shared_ptr<Object>> playerAvatars;
+  DelayedActionQueue delayedActions;
+  uint64_t objectsStateHash = 0;
+};
+
 struct GlobalVariableDefinition {
   int32_t initialValue = 0;
   bool perPlayer = false;
@@ -72,18 +167,23 @@ class Grid : public std::enable_shared_from_this<Grid> {
   virtual void resetGlobalVariables(std::unordered_map<std::string, GlobalVariableDefinition> globalVariableDefinitions);
   virtual void setGlobalVariables(std::unordered_map<std::string, std::unordered_map<uint32_t, int32_t>> globalVariableDefinitions);
 
-  virtual std::unordered_map<uint32_t, int32_t> performActions(uint32_t playerId, std::vector<std::shared_ptr<Action>> actions);
-  virtual std::unordered_map<uint32_t, int32_t> executeAction(uint32_t playerId, std::shared_ptr<Action> action);
-  virtual void delayAction(uint32_t playerId, std::shared_ptr<Action> action);
+  // Creates an action on this grid, reusing the memory of actions that have been released
+  std::shared_ptr<Action> newAction(std::string actionName, uint32_t playerId, uint32_t delay = 0, ActionMetaData metaData = {});
+  // Avoids interning the action name for every action
+  std::shared_ptr<Action> newAction(uint32_t actionNameId, uint32_t playerId, uint32_t delay = 0, ActionMetaData metaData = {});
+
+  virtual PlayerRewards performActions(uint32_t playerId, std::vector<std::shared_ptr<Action>> actions);
+  virtual PlayerRewards executeAction(uint32_t playerId, const std::shared_ptr<Action>& action);
+  virtual void delayAction(uint32_t playerId, const std::shared_ptr<Action>& action);
 
-  virtual std::unordered_map<uint32_t, int32_t> update();
-  virtual std::unordered_map<uint32_t, int32_t> processDelayedActions();
+  virtual PlayerRewards update();
+  virtual PlayerRewards processDelayedActions();
 
-  virtual std::unordered_map<uint32_t, int32_t> processCollisions();
+  virtual PlayerRewards processCollisions();
   virtual void addActionTrigger(std::string actionName, ActionTriggerDefinition actionTriggerDefinition);
   virtual void setBehaviourProbabilities(const std::unordered_map<std::string, std::vector<float>>& behaviourProbabilities);
 
-  virtual DelayedActionQueue getDelayedActions();
+  virtual const DelayedActionQueue& getDelayedActions() const;
 
   virtual bool updateLocation(std::shared_ptr<Object> object, glm::ivec2 previousLocation, glm::ivec2 newLocation);
 
@@ -93,6 +193,18 @@ class Grid : public std::enable_shared_from_this<Grid> {
   virtual const std::unordered_set<glm::ivec2>& getUpdatedLocations(uint32_t player) const;
   virtual void purgeUpdatedLocations(uint32_t player);
 
+  // Changed locations and variables are only recorded for action masks once tracking is enabled
+  virtual void enableActionMaskTracking(bool enable);
+  virtual const ActionMaskChanges& getActionMaskChanges() const;
+  virtual void purgeActionMaskChanges();
+
+  // Changes are kept until the end of the tick after the one they happened in
+  virtual void enableLocationChangeLog();
+  virtual uint64_t getLocationChangeCount() const;
+
+  // Appends the locations that have changed since changeIdx, returns false if some of those changes have been discarded
+  virtual bool getLocationChanges(uint64_t changeIdx, std::vector<glm::ivec2>& locations) const;
+
   virtual uint32_t getWidth() const;
   virtual uint32_t getHeight() const;
 
@@ -114,7 +226,7 @@ class Grid : public std::enable_shared_from_this<Grid> {
   virtual std::shared_ptr<Object> getPlayerDefaultBoundaryObject(uint32_t playerId) const;
 
   /**
-   * Gets all the objects at a certain location
+   * Gets all the objects at a certain location, on a copy-on-write clone these can be objects it still shares
    */
   virtual const TileObjects& getObjectsAt(glm::ivec2 location) const;
 
@@ -161,6 +273,29 @@ class Grid : public std::enable_shared_from_this<Grid> {
   virtual const std::vector<GridEvent>& getHistory() const;
   virtual void purgeHistory();
 
+  /**
+   * While the journal is enabled and a checkpoint exists, every mutation of the grid is recorded so it can be rolled back.
+   * This allows searches to step forward and back in place instead of cloning the game.
+   * The event history and updated locations are not rolled back.
+   */
+  virtual void enableJournal(bool enable);
+  virtual uint32_t checkpoint();
+  virtual void rollback(uint32_t checkpointId);
+
+  virtual void recordObjectStateChange(const std::shared_ptr<Object>& object);
+
+  // Writes a variable belonging to an object, or a global variable if the object is nullptr, so it is journaled and hashed
+  virtual void writeVariable(int32_t* variable, int32_t value, const std::shared_ptr<Object>& object);
+
+  /**
+   * A zobrist style hash of the objects and global variables in the grid, kept up to date as the grid changes.
+   * The internal _steps count is not part of the hash.
+   */
+  virtual uint64_t getStateHash() const;
+
+  // Recomputes the contribution of an object to the state hash after its state has changed
+  virtual void updateStateHash(const std::shared_ptr<Object>& object);
+
   // These are public so they can be tested
   virtual const std::unordered_map<std::string, std::shared_ptr<CollisionDetector>>& getCollisionDetectors() const;
   virtual const std::unordered_map<std::string, ActionTriggerDefinition>& getActionTriggerDefinitions() const;
@@ -169,21 +304,94 @@ class Grid : public std::enable_shared_from_this<Grid> {
 
   virtual void addCollisionDetector(std::unordered_set<std::string> objectNames, std::string actionName, std::shared_ptr<CollisionDetector> collisionDetector);
 
+  // Flow fields shared by every object that searches for the same target, nullptr if there is no field with this key
+  virtual std::shared_ptr<FlowField> getFlowField(const std::string& key) const;
+  virtual void addFlowField(const std::string& key, std::shared_ptr<FlowField> flowField);
+
+  // Passability maps shared by every path finder that avoids the same objects, nullptr if there is no map with this key
+  virtual std::shared_ptr<PassabilityMap> getPassabilityMap(const std::string& key) const;
+  virtual void addPassabilityMap(const std::string& key, std::shared_ptr<PassabilityMap> passabilityMap);
+
+  // Changes whenever an object with this name is added, removed or moved
+  virtual uint64_t getObjectNameVersion(uint32_t objectNameId) const;
+
+  // The closest objects with this name to any location, shared by every object that searches for them
+  virtual std::shared_ptr<NearestObjectIndex> getNearestObjectIndex(const std::string& objectName);
+
   virtual void reset();
 
+  /**
+   * Snapshots the objects, tiles, variables and delayed actions so they can be restored without generating the level again.
+   * The map size, object types, action triggers and global variables must not be reset before the snapshot is restored.
+   */
+  virtual std::shared_ptr<GridSnapshot> takeSnapshot() const;
+  virtual void restoreSnapshot(const GridSnapshot& snapshot);
+
+  /**
+   * Clones the grid without copying its objects up front. The clone shares the objects of this grid and copies the
+   * objects on a tile the first time it reads or changes that tile, so a clone costs about as much as the tiles it touches.
+   * Variables, object counters and delayed actions are copied straight away, objects that collision detectors track and
+   * the sources of delayed actions are too. getObjects returns the shared objects on tiles that have not been copied yet.
+   * Before this grid changes a tile that a clone still shares, the clone copies that tile. A clone and the grid it was
+   * cloned from must not be changed from different threads at the same time.
+   */
+  virtual std::shared_ptr<Grid> cloneCopyOnWrite(std::shared_ptr<ObjectGenerator> objectGenerator);
+
   virtual void seedRandomGenerator(uint32_t seed);
 
   virtual std::shared_ptr<RandomGenerator> getRandomGenerator() const;
 
  private:
   GridEvent buildGridEvent(const std::shared_ptr<Action>& action, uint32_t playerId, uint32_t tick) const;
-  void recordGridEvent(GridEvent event, std::unordered_map<uint32_t, int32_t> rewards);
+  void recordGridEvent(GridEvent event, PlayerRewards rewards);
 
   const std::vector<std::shared_ptr<CollisionDetector>> getCollisionDetectorsForObject(std::shared_ptr<Object> object) const;
 
-  std::unordered_map<uint32_t, int32_t> executeAndRecord(uint32_t playerId, const std::shared_ptr<Action>& action);
+  PlayerRewards executeAndRecord(uint32_t playerId, const std::shared_ptr<Action>& action);
+
+  std::vector<uint32_t> filterBehaviourProbabilities(const std::vector<uint32_t>& actionBehaviourIdxs, const std::vector<float>& actionProbabilities);
+  const std::vector<float>& getBehaviourProbabilities(uint32_t actionNameId) const;
+
+  void updateCollisionDetectors(const std::shared_ptr<Object>& object, glm::ivec2 previousLocation, glm::ivec2 location);
+  void bumpObjectNameVersion(const std::shared_ptr<Object>& object);
+  void updateNearestObjectIndex(const std::shared_ptr<Object>& object, glm::ivec2 location, bool removed);
+  void recordCollisionDetectorChange(const std::shared_ptr<CollisionDetector>& collisionDetector, glm::ivec2 location);
+  const std::vector<std::shared_ptr<Object>>& searchCollisions(const std::shared_ptr<Object>& object, size_t triggerIdx, const CollisionTrigger& collisionTrigger);
+
+  void indexDelayedAction(const DelayedActionQueueItem& delayedAction);
+  void unindexDelayedAction(const DelayedActionQueueItem& delayedAction);
+  void cancelDelayedActions(const std::shared_ptr<Object>& object);
 
-  std::vector<uint32_t> filterBehaviourProbabilities(std::vector<uint32_t> actionBehaviourIdxs, std::vector<float> actionProbabilities);
+  void onVariableChanged(const int32_t* variable, int32_t previousValue, const std::shared_ptr<Object>& object);
+
+  // Computes the state hash key of every global variable and rehashes them, only needed when the global variables are
+  // defined or restored in bulk. Writes through writeVariable update the hash from the keys
+  void resetGlobalVariablesStateHash();
+
+  void discardLocationChanges();
+
+  bool isJournaling() const;
+  void undoJournalEntry(const GridJournalEntry& entry);
+
+  bool isInBounds(glm::ivec2 location) const;
+  TileObjects& getTile(glm::ivec2 location);
+  const TileObjects& getTile(glm::ivec2 location) const;
+
+  // Adds an object that is already on its tile to the nearest object indexes and collision detectors
+  void indexObject(const std::shared_ptr<Object>& object, glm::ivec2 location);
+
+  TileObjects& copyTile(uint32_t tileIdx);
+  // The copy of an object of the grid this one was cloned from, or of a grid further up the chain of clones
+  std::shared_ptr<Object> resolveCopiedObject(const std::shared_ptr<Object>& object);
+  // nullptr if the source object of the action no longer exists
+  std::shared_ptr<Action> copyInheritedAction(const std::shared_ptr<Action>& action);
+  void detachFromCopyOnWriteSource();
+  // Called before the whole grid is reset or restored while clones may still be sharing its objects
+  void detachCopyOnWriteClones();
+  // Called before the objects on a tile, or their variables, change while clones may still be sharing them
+  void copyTileToCopyOnWriteClones(glm::ivec2 location);
+  // Changes whenever the objects of this grid, or of the grids it shares objects with, are added, removed or copied
+  uint64_t getObjectsVersion() const;
 
   uint32_t height_{};
   uint32_t width_{};
@@ -194,22 +402,32 @@ class Grid : public std::enable_shared_from_this<Grid> {
   // This is so we can highly optimize observers to only re-render changed grid locations
   std::vector<std::unordered_set<glm::ivec2>> updatedLocations_;
 
+  bool actionMaskTracking_ = false;
+  ActionMaskChanges actionMaskChanges_;
+
+  LocationChangeLog locationChangeLog_;
+
   std::unordered_map<std::string, uint32_t> objectIds_;
   std::unordered_map<std::string, uint32_t> objectVariableIds_;
   std::unordered_map<std::string, std::vector<std::string>> objectVariableMap_;
   std::unordered_set<std::shared_ptr<Object>> objects_;
-  std::unordered_map<glm::ivec2, TileObjects> occupiedLocations_;
+  uint64_t objectsVersion_ = 0;
+  // Dense width * height array of tiles, indexed by y * width + x
+  std::vector<TileObjects> tiles_;
   std::unordered_map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t>>> objectCounters_;
   std::unordered_map<uint32_t, std::shared_ptr<Object>> playerAvatars_;
   std::map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t>>> globalVariables_;
 
   // return reference to this if there are no object in getObjectAt
-  const std::map<uint32_t, std::shared_ptr<Object>> EMPTY_OBJECTS = {};
+  const TileObjects EMPTY_OBJECTS = {};
   const std::unordered_set<glm::ivec2> EMPTY_LOCATIONS = {};
 
-  // A priority queue of actions that are delayed in time (time is measured in game ticks)
+  // A timing wheel of actions that are delayed in time (time is measured in game ticks)
   DelayedActionQueue delayedActions_;
-  std::unordered_map<std::string, std::vector<float>> behaviourProbabilities_;
+  std::vector<DelayedActionQueueItem> delayedActionsToExecute_;
+  ActionPool actionPool_;
+  // Indexed by action name id
+  std::vector<std::vector<float>> behaviourProbabilities_;
 
   // There is at least 1 player
   uint32_t playerCount_ = 1;
@@ -217,6 +435,17 @@ class Grid : public std::enable_shared_from_this<Grid> {
   bool recordEvents_ = false;
   std::vector<GridEvent> eventHistory_;
 
+  bool journalEnabled_ = false;
+  std::vector<GridJournalEntry> journal_;
+  std::vector<GridCheckpoint> checkpoints_;
+
+  // The state hash is split so global variables can be rehashed without touching objects
+  uint64_t objectsStateHash_ = 0;
+  uint64_t globalVariablesStateHash_ = 0;
+
+  // The key of each global variable for its player, a write swaps the contribution of the old value for the new one
+  std::unordered_map<const int32_t*, uint64_t> globalVariableStateHashKeys_;
+
   // If there are collisions that need to be processed in this game environment
 
   // All objects that can collide
@@ -225,14 +454,33 @@ class Grid : public std::enable_shared_from_this<Grid> {
   // Only the source objects that can collide
   std::unordered_map<std::string, std::unordered_set<std::string>> collisionSourceObjectActionNames_;
 
+  // The two maps above indexed by object name id, so objects can be updated and collisions checked without hashing names
+  std::vector<std::vector<std::shared_ptr<CollisionDetector>>> objectCollisionDetectors_;
+  std::vector<std::vector<CollisionTrigger>> sourceObjectCollisionTriggers_;
+
   // keep a list of the objects that are named as collision sources, this makes collision processing significantly faster with large maps with many non-colliding objects
   std::unordered_set<std::shared_ptr<Object>> collisionSourceObjects_;
+  std::vector<std::shared_ptr<Object>> collisionSourcesToProcess_;
+  std::vector<std::shared_ptr<Object>> collisionObjectsToProcess_;
+
+  // Collisions are only searched for again when something that could change them has happened
+  std::unordered_map<const CollisionDetector*, CollisionDetectorChanges> collisionDetectorChanges_;
+  std::unordered_map<const Object*, std::vector<CachedCollisions>> cachedCollisions_;
 
   // Collision detectors are grouped by action name (i.e each trigger)
   std::shared_ptr<CollisionDetectorFactory> collisionDetectorFactory_;
   std::unordered_map<std::string, std::shared_ptr<CollisionDetector>> collisionDetectors_;
   std::unordered_map<std::string, ActionTriggerDefinition> actionTriggerDefinitions_;
 
+  std::unordered_map<std::string, std::shared_ptr<FlowField>> flowFields_;
+  std::unordered_map<std::string, std::shared_ptr<PassabilityMap>> passabilityMaps_;
+
+  // Indexed by object name id
+  std::vector<uint64_t> objectNameVersions_;
+
+  // Indexed by object name id, only the names something has searched for have an index
+  std::vector<std::shared_ptr<NearestObjectIndex>> nearestObjectIndexes_;
+
   // An object that is used if the source of destination location of an action is '_empty'
   // Allows a subset of actions like "spawn" to be performed in empty space.
   std::unordered_map<uint32_t, std::shared_ptr<Object>> defaultEmptyObject_;
@@ -243,6 +491,19 @@ class Grid : public std::enable_shared_from_this<Grid> {
 
   std::shared_ptr<RandomGenerator> randomGenerator_ = std::make_shared<RandomGenerator>(RandomGenerator());
 
+  // Clones that may still be sharing the objects of this grid
+  std::vector<std::weak_ptr<Grid>> copyOnWriteClones_;
+
+  // Set until this grid, if it is a copy-on-write clone, has copied every tile of the grid it was cloned from
+  std::shared_ptr<Grid> copyOnWriteSource_;
+  std::shared_ptr<ObjectGenerator> copyOnWriteObjectGenerator_;
+  // The tiles copied so far, indexed by y * width + x. tiles_ is only filled in once every tile has been copied
+  std::unordered_map<uint32_t, TileObjects> copyOnWriteTiles_;
+  // The objects of the grid this one was cloned from and their copies in this grid
+  std::unordered_map<const Object*, std::shared_ptr<Object>> copyOnWriteObjects_;
+  // objects_ plus the shared objects on tiles that have not been copied, rebuilt when getObjectsVersion changes
+  std::unordered_set<std::shared_ptr<Object>> copyOnWriteObjectsView_;
+  uint64_t copyOnWriteObjectsViewVersion_ = UINT64_MAX;
 };
 
 }  // namespace griddly
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "JumpPointPathFinder.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+#include "Grid.hpp"
+
+namespace griddly {
+
+namespace {
+// Left, up, right and down, the order of JumpPointPathFinder::actionIds_
+const std::array<glm::ivec2, 4> DIRECTIONS = {glm::ivec2(-1, 0), glm::ivec2(0, -1), glm::ivec2(1, 0), glm::ivec2(0, 1)};
+
+float manhattanDistance(glm::ivec2 a, glm::ivec2 b) {
+  return static_cast<float>(std::abs(a.x - b.x) + std::abs(a.y - b.y));
+}
+}  // namespace
+
+JumpPointPathFinder::JumpPointPathFinder(std::shared_ptr<Grid> grid, std::set<std::string> impassableObjects, const ActionInputsDefinition& actionInputs, PathFinderMode mode, std::shared_ptr<PassabilityMap> passabilityMap)
+    : PathFinder(std::move(grid), std::move(impassableObjects), mode), passabilityMap_(std::move(passabilityMap)) {
+  actionIds_.fill(std::numeric_limits<uint32_t>::max());
+  for (const auto& inputMapping : actionInputs.inputMappings) {
+    for (uint32_t d = 0; d < DIRECTIONS.size(); d++) {
+      if (inputMapping.second.vectorToDest == DIRECTIONS[d]) {
+        actionIds_[d] = std::min(actionIds_[d], inputMapping.first);
+      }
+    }
+  }
+
+  grid_->enableLocationChangeLog();
+}
+
+bool JumpPointPathFinder::supports(const ActionInputsDefinition& actionInputs) {
+  if (actionInputs.relative) {
+    return false;
+  }
+
+  std::array<bool, 4> hasDirection{};
+  for (const auto& inputMapping : actionInputs.inputMappings) {
+    const auto& vectorToDest = inputMapping.second.vectorToDest;
+    if (vectorToDest == glm::ivec2(0, 0)) {
+      continue;
+    }
+
+    auto directionIt = std::find(DIRECTIONS.begin(), DIRECTIONS.end(), vectorToDest);
+    if (directionIt == DIRECTIONS.end()) {
+      return false;
+    }
+    hasDirection[directionIt - DIRECTIONS.begin()] = true;
+  }
+
+  return std::all_of(hasDirection.begin(), hasDirection.end(), [](bool has) { return has; });
+}
+
+uint32_t JumpPointPathFinder::getExpandedCount() const {
+  return expandedCount_;
+}
+
+JumpPointPathFinder::SearchBuffers& JumpPointPathFinder::getSearchBuffers() {
+  thread_local SearchBuffers buffers;
+  return buffers;
+}
+
+bool JumpPointPathFinder::isLowerPriority(const OpenEntry& a, const OpenEntry& b) {
+  return a.scoreFromStart > b.scoreFromStart;
+}
+
+JumpPointPathFinder::Node& JumpPointPathFinder::getNode(SearchBuffers& buffers, uint32_t cellIdx) {
+  auto& node = buffers.nodes[cellIdx];
+  if (node.generation != buffers.generation) {
+    node = {std::numeric_limits<float>::max(), 0, buffers.generation, NO_DIRECTION, false};
+  }
+  return node;
+}
+
+bool JumpPointPathFinder::isPassable(int32_t x, int32_t y) const {
+  return passabilityMap_->isPassable(x, y);
+}
+
+bool JumpPointPathFinder::jumpHorizontal(glm::ivec2 location, int32_t dx, glm::ivec2& jumpPoint) const {
+  auto x = location.x;
+  auto y = location.y;
+
+  while (true) {
+    x += dx;
+    if (!isPassable(x, y)) {
+      return false;
+    }
+
+    // Stop where a tile above or below opens up, as the path could turn there
+    if ((x == goal_.x && y == goal_.y) || (isPassable(x, y - 1) && !isPassable(x - dx, y - 1)) || (isPassable(x, y + 1) && !isPassable(x - dx, y + 1))) {
+      jumpPoint = {x, y};
+      return true;
+    }
+  }
+}
+
+bool JumpPointPathFinder::jumpVertical(glm::ivec2 location, int32_t dy, glm::ivec2& jumpPoint) const {
+  auto x = location.x;
+  auto y = location.y;
+
+  while (true) {
+    y += dy;
+    if (!isPassable(x, y)) {
+      return false;
+    }
+
+    if ((x == goal_.x && y == goal_.y) || (isPassable(x - 1, y) && !isPassable(x - 1, y - dy)) || (isPassable(x + 1, y) && !isPassable(x + 1, y - dy))) {
+      jumpPoint = {x, y};
+      return true;
+    }
+
+    // Horizontal jumps do not turn on their own, so the path has to turn here if one of them leads anywhere
+    glm::ivec2 horizontalJumpPoint;
+    if (jumpHorizontal({x, y}, 1, horizontalJumpPoint) || jumpHorizontal({x, y}, -1, horizontalJumpPoint)) {
+      jumpPoint = {x, y};
+      return true;
+    }
+  }
+}
+
+bool JumpPointPathFinder::jump(glm::ivec2 location, glm::ivec2 direction, glm::ivec2& jumpPoint) const {
+  return direction.x != 0 ? jumpHorizontal(location, direction.x, jumpPoint) : jumpVertical(location, direction.y, jumpPoint);
+}
+
+SearchOutput JumpPointPathFinder::search(glm::ivec2 startLocation, glm::ivec2 endLocation, glm::ivec2 startOrientationVector, uint32_t maxDepth) {
+  passabilityMap_->update(*grid_);
+  width_ = passabilityMap_->getWidth();
+  height_ = passabilityMap_->getHeight();
+  expandedCount_ = 0;
+  goal_ = endLocation;
+
+  if (startLocation.x < 0 || startLocation.y < 0 || startLocation.x >= static_cast<int32_t>(width_) || startLocation.y >= static_cast<int32_t>(height_)) {
+    return {0};
+  }
+
+  auto& buffers = getSearchBuffers();
+  buffers.nodes.resize(std::max<size_t>(buffers.nodes.size(), width_ * height_));
+  if (++buffers.generation == 0) {
+    for (auto& node : buffers.nodes) {
+      node.generation = 0;
+    }
+    buffers.generation = 1;
+  }
+  buffers.openNodes.clear();
+
+  auto startIdx = startLocation.y * width_ + startLocation.x;
+  getNode(buffers, startIdx).scoreToGoal = 0;
+  buffers.openNodes.push_back({manhattanDistance(startLocation, endLocation), startIdx});
+
+  uint32_t steps = 0;
+  auto currentIdx = startIdx;
+
+  while (!buffers.openNodes.empty()) {
+    std::pop_heap(buffers.openNodes.begin(), buffers.openNodes.end(), isLowerPriority);
+    currentIdx = buffers.openNodes.back().cellIdx;
+    buffers.openNodes.pop_back();
+
+    auto& current = getNode(buffers, currentIdx);
+    if (current.closed) {
+      continue;
+    }
+    current.closed = true;
+    expandedCount_++;
+
+    const glm::ivec2 currentLocation(currentIdx % width_, currentIdx / width_);
+    if (currentLocation == endLocation || steps >= maxDepth) {
+      break;
+    }
+
+    for (uint8_t d = 0; d < DIRECTIONS.size(); d++) {
+      const auto& direction = DIRECTIONS[d];
+
+      // After a jump only carry on straight ahead or turn, going back the way the jump came is never shorter
+      if (current.direction != NO_DIRECTION && direction == -DIRECTIONS[current.direction]) {
+        continue;
+      }
+
+      glm::ivec2 jumpPoint;
+      if (!jump(currentLocation, direction, jumpPoint)) {
+        continue;
+      }
+
+      auto jumpPointIdx = jumpPoint.y * width_ + jumpPoint.x;
+      auto& jumpPointNode = getNode(buffers, jumpPointIdx);
+      auto jumpLength = manhattanDistance(currentLocation, jumpPoint);
+      auto scoreToGoal = current.scoreToGoal + jumpLength;
+      if (jumpPointNode.closed || scoreToGoal >= jumpPointNode.scoreToGoal) {
+        continue;
+      }
+
+      jumpPointNode.scoreToGoal = scoreToGoal;
+      jumpPointNode.direction = d;
+      jumpPointNode.firstActionId = currentIdx == startIdx ? actionIds_[d] : current.firstActionId;
+
+      // Counted in tiles like A* does, so the same max depth gives up at about the same distance
+      steps += static_cast<uint32_t>(jumpLength);
+      buffers.openNodes.push_back({scoreToGoal + manhattanDistance(jumpPoint, endLocation), jumpPointIdx});
+      std::push_heap(buffers.openNodes.begin(), buffers.openNodes.end(), isLowerPriority);
+    }
+  }
+
+  auto actionId = buffers.nodes[currentIdx].firstActionId;
+  spdlog::debug("Jump point search from [{0},{1}] to [{2},{3}]: action {4}, expanded {5} jump points", startLocation.x, startLocation.y, endLocation.x, endLocation.y, actionId, expandedCount_);
+  return {actionId};
+}
+
+}  // namespace griddly
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "GDY/Actions/Action.hpp"
+#include "PassabilityMap.hpp"
+#include "PathFinder.hpp"
+
+namespace griddly {
+
+/**
+ * Jump Point Search for actions that move one tile up, down, left or right regardless of the orientation of the object.
+ *
+ * Every move costs the same, so there are usually many equally short paths. Rather than adding every neighbouring tile
+ * to the open set, the search jumps in a straight line until it reaches a tile where the path could turn, and only those
+ * tiles are added. Passability is read from a bitmap shared with every other path finder avoiding the same objects.
+ */
+class JumpPointPathFinder : public PathFinder {
+ public:
+  JumpPointPathFinder(std::shared_ptr<Grid> grid, std::set<std::string> impassableObjects, const ActionInputsDefinition& actionInputs, PathFinderMode mode, std::shared_ptr<PassabilityMap> passabilityMap);
+
+  SearchOutput search(glm::ivec2 startLocation, glm::ivec2 endLocation, glm::ivec2 startOrientationVector, uint32_t maxDepth) override;
+
+  // The number of jump points expanded by the last search
+  uint32_t getExpandedCount() const;
+
+  // If the actions are not relative and move exactly one tile in each of the four directions
+  static bool supports(const ActionInputsDefinition& actionInputs);
+
+ private:
+  static constexpr uint8_t NO_DIRECTION = 4;
+
+  struct Node {
+    float scoreToGoal;
+
+    // The action that leads from the start towards this node, so the path never has to be walked back
+    uint32_t firstActionId;
+    uint32_t generation = 0;
+
+    // The direction of the jump that reached this node, which limits the directions it jumps in next
+    uint8_t direction;
+    bool closed;
+  };
+
+  struct OpenEntry {
+    float scoreFromStart;
+    uint32_t cellIdx;
+  };
+
+  struct SearchBuffers {
+    std::vector<Node> nodes;
+    std::vector<OpenEntry> openNodes;
+    uint32_t generation = 0;
+  };
+
+  static SearchBuffers& getSearchBuffers();
+  static Node& getNode(SearchBuffers& buffers, uint32_t cellIdx);
+  static bool isLowerPriority(const OpenEntry& a, const OpenEntry& b);
+
+  bool isPassable(int32_t x, int32_t y) const;
+
+  bool jumpHorizontal(glm::ivec2 location, int32_t dx, glm::ivec2& jumpPoint) const;
+  bool jumpVertical(glm::ivec2 location, int32_t dy, glm::ivec2& jumpPoint) const;
+  bool jump(glm::ivec2 location, glm::ivec2 direction, glm::ivec2& jumpPoint) const;
+
+  // The lowest action id moving in each of the directions left, up, right and down
+  std::array<uint32_t, 4> actionIds_{};
+
+  const std::shared_ptr<PassabilityMap> passabilityMap_;
+  uint32_t width_ = 0;
+  uint32_t height_ = 0;
+
+  glm::ivec2 goal_{};
+  uint32_t expandedCount_ = 0;
+};
+
+}  // namespace griddly
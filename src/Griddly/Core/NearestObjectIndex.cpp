@@ -0,0 +1,213 @@
+#include "NearestObjectIndex.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "GDY/Objects/Object.hpp"
+
+namespace griddly {
+
+NearestObjectIndex::NearestObjectIndex(uint32_t gridWidth, uint32_t gridHeight, uint32_t cellSize)
+    : cellSize_(std::max(cellSize, 1u)),
+      cellsX_(static_cast<int32_t>((gridWidth + cellSize_ - 1) / cellSize_)),
+      cellsY_(static_cast<int32_t>((gridHeight + cellSize_ - 1) / cellSize_)),
+      cells_(cellsX_ * cellsY_) {
+}
+
+bool NearestObjectIndex::upsert(const std::shared_ptr<Object>& object) {
+  return upsert(object, object->getLocation());
+}
+
+bool NearestObjectIndex::upsert(const std::shared_ptr<Object>& object, glm::ivec2 location) {
+  auto cellIdx = getCellIdx(location);
+  if (cellIdx == NO_CELL) {
+    remove(object);
+    return false;
+  }
+
+  auto objectCellIt = objectCells_.find(object.get());
+  if (objectCellIt == objectCells_.end()) {
+    cells_[cellIdx].push_back(object);
+    objectCells_.emplace(object.get(), cellIdx);
+    return true;
+  }
+
+  if (objectCellIt->second == cellIdx) {
+    return false;
+  }
+
+  auto& previousCell = cells_[objectCellIt->second];
+  previousCell.erase(std::find(previousCell.begin(), previousCell.end(), object));
+  cells_[cellIdx].push_back(object);
+  objectCellIt->second = cellIdx;
+  return true;
+}
+
+bool NearestObjectIndex::remove(const std::shared_ptr<Object>& object) {
+  auto objectCellIt = objectCells_.find(object.get());
+  if (objectCellIt == objectCells_.end()) {
+    return false;
+  }
+
+  auto& cell = cells_[objectCellIt->second];
+  cell.erase(std::find(cell.begin(), cell.end(), object));
+  objectCells_.erase(objectCellIt);
+  return true;
+}
+
+void NearestObjectIndex::getObjects(std::vector<std::shared_ptr<Object>>& objects) const {
+  objects.reserve(objects.size() + objectCells_.size());
+  for (const auto& cell : cells_) {
+    objects.insert(objects.end(), cell.begin(), cell.end());
+  }
+}
+
+size_t NearestObjectIndex::size() const {
+  return objectCells_.size();
+}
+
+uint32_t NearestObjectIndex::getCellIdx(glm::ivec2 location) const {
+  if (location.x < 0 || location.y < 0) {
+    return NO_CELL;
+  }
+
+  auto cellX = location.x / static_cast<int32_t>(cellSize_);
+  auto cellY = location.y / static_cast<int32_t>(cellSize_);
+  if (cellX >= cellsX_ || cellY >= cellsY_) {
+    return NO_CELL;
+  }
+
+  return cellY * cellsX_ + cellX;
+}
+
+glm::ivec2 NearestObjectIndex::getQueryCell(glm::ivec2 location) const {
+  auto cellSize = static_cast<int32_t>(cellSize_);
+  return {std::clamp(location.x / cellSize, 0, cellsX_ - 1), std::clamp(location.y / cellSize, 0, cellsY_ - 1)};
+}
+
+template <class Visitor>
+void NearestObjectIndex::visitRing(glm::ivec2 cell, int32_t ring, Visitor&& visitor) const {
+  auto visitCell = [&](int32_t cellX, int32_t cellY) {
+    if (cellX < 0 || cellY < 0 || cellX >= cellsX_ || cellY >= cellsY_) {
+      return;
+    }
+    for (const auto& object : cells_[cellY * cellsX_ + cellX]) {
+      visitor(object);
+    }
+  };
+
+  if (ring == 0) {
+    visitCell(cell.x, cell.y);
+    return;
+  }
+
+  for (auto cellX = cell.x - ring; cellX <= cell.x + ring; cellX++) {
+    visitCell(cellX, cell.y - ring);
+    visitCell(cellX, cell.y + ring);
+  }
+
+  for (auto cellY = cell.y - ring + 1; cellY < cell.y + ring; cellY++) {
+    visitCell(cell.x - ring, cellY);
+    visitCell(cell.x + ring, cellY);
+  }
+}
+
+int32_t NearestObjectIndex::getRingClearance(glm::ivec2 location, glm::ivec2 cell, int32_t ring) const {
+  auto cellSize = static_cast<int32_t>(cellSize_);
+  auto clearance = std::numeric_limits<int32_t>::max();
+
+  // Sides of the rings that are already at the edge of the grid have nothing beyond them
+  if (cell.x - ring > 0) {
+    clearance = std::min(clearance, location.x - (cell.x - ring) * cellSize + 1);
+  }
+  if (cell.x + ring < cellsX_ - 1) {
+    clearance = std::min(clearance, (cell.x + ring + 1) * cellSize - location.x);
+  }
+  if (cell.y - ring > 0) {
+    clearance = std::min(clearance, location.y - (cell.y - ring) * cellSize + 1);
+  }
+  if (cell.y + ring < cellsY_ - 1) {
+    clearance = std::min(clearance, (cell.y + ring + 1) * cellSize - location.y);
+  }
+
+  // Locations outside the grid can be outside the rings as well
+  return std::max(clearance, 0);
+}
+
+void NearestObjectIndex::searchNearest(glm::ivec2 location, uint32_t k, std::vector<std::shared_ptr<Object>>& objects) const {
+  if (k == 0 || objectCells_.empty()) {
+    return;
+  }
+
+  // A max heap of the k closest objects found so far, so the furthest one can be replaced
+  std::vector<Candidate> nearest;
+  nearest.reserve(std::min<size_t>(k, objectCells_.size()));
+  auto isCloser = [](const Candidate& a, const Candidate& b) {
+    return a.distance2 < b.distance2;
+  };
+
+  auto cell = getQueryCell(location);
+  auto maxRing = std::max(cellsX_, cellsY_);
+
+  for (int32_t ring = 0; ring < maxRing; ring++) {
+    visitRing(cell, ring, [&](const std::shared_ptr<Object>& object) {
+      auto offset = object->getLocation() - location;
+      auto distance2 = offset.x * offset.x + offset.y * offset.y;
+
+      if (nearest.size() < k) {
+        nearest.push_back({distance2, &object});
+        std::push_heap(nearest.begin(), nearest.end(), isCloser);
+      } else if (distance2 < nearest.front().distance2) {
+        std::pop_heap(nearest.begin(), nearest.end(), isCloser);
+        nearest.back() = {distance2, &object};
+        std::push_heap(nearest.begin(), nearest.end(), isCloser);
+      }
+    });
+
+    if (nearest.size() == k) {
+      auto clearance = static_cast<int64_t>(getRingClearance(location, cell, ring));
+      if (nearest.front().distance2 <= clearance * clearance) {
+        break;
+      }
+    }
+  }
+
+  std::sort_heap(nearest.begin(), nearest.end(), isCloser);
+  for (const auto& candidate : nearest) {
+    objects.push_back(*candidate.object);
+  }
+}
+
+std::shared_ptr<Object> NearestObjectIndex::searchClosest(glm::ivec2 location) const {
+  if (objectCells_.empty()) {
+    return nullptr;
+  }
+
+  const std::shared_ptr<Object>* closest = nullptr;
+  auto closestDistance2 = std::numeric_limits<int32_t>::max();
+
+  auto cell = getQueryCell(location);
+  auto maxRing = std::max(cellsX_, cellsY_);
+
+  for (int32_t ring = 0; ring < maxRing; ring++) {
+    visitRing(cell, ring, [&](const std::shared_ptr<Object>& object) {
+      auto offset = object->getLocation() - location;
+      auto distance2 = offset.x * offset.x + offset.y * offset.y;
+      if (distance2 < closestDistance2) {
+        closestDistance2 = distance2;
+        closest = &object;
+      }
+    });
+
+    if (closest != nullptr) {
+      auto clearance = static_cast<int64_t>(getRingClearance(location, cell, ring));
+      if (closestDistance2 <= clearance * clearance) {
+        break;
+      }
+    }
+  }
+
+  return closest == nullptr ? nullptr : *closest;
+}
+
+}  // namespace griddly
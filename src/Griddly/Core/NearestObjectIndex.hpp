@@ -0,0 +1,75 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace griddly {
+
+class Object;
+
+/**
+ * The objects of a single type bucketed into square cells, for finding the objects closest to a location.
+ *
+ * Queries visit rings of cells around the location, closest ring first, and stop as soon as no object in the next ring
+ * can be closer than the ones already found, so finding the closest target costs about the same on a crowded map as on
+ * an empty one. The grid keeps one index per object type and shares it between every object that searches for that type.
+ */
+class NearestObjectIndex {
+ public:
+  static constexpr uint32_t DEFAULT_CELL_SIZE = 8;
+
+  NearestObjectIndex(uint32_t gridWidth, uint32_t gridHeight, uint32_t cellSize = DEFAULT_CELL_SIZE);
+
+  virtual ~NearestObjectIndex() = default;
+
+  // Returns false if the object was already in the cell of its location
+  virtual bool upsert(const std::shared_ptr<Object>& object);
+
+  // For objects that are being moved to location but have not updated their own location yet
+  virtual bool upsert(const std::shared_ptr<Object>& object, glm::ivec2 location);
+
+  virtual bool remove(const std::shared_ptr<Object>& object);
+
+  // Appends up to k objects to objects, closest to the location first, by euclidean distance
+  virtual void searchNearest(glm::ivec2 location, uint32_t k, std::vector<std::shared_ptr<Object>>& objects) const;
+
+  // nullptr if there are no objects
+  virtual std::shared_ptr<Object> searchClosest(glm::ivec2 location) const;
+
+  // Appends every object in the index to objects, in no particular order
+  virtual void getObjects(std::vector<std::shared_ptr<Object>>& objects) const;
+
+  size_t size() const;
+
+ private:
+  static constexpr uint32_t NO_CELL = UINT32_MAX;
+
+  struct Candidate {
+    int32_t distance2;
+    const std::shared_ptr<Object>* object;
+  };
+
+  uint32_t getCellIdx(glm::ivec2 location) const;
+
+  // The cell a query starts from, locations outside the grid start from the closest cell
+  glm::ivec2 getQueryCell(glm::ivec2 location) const;
+
+  // Calls visitor with every object in the cells at the given ring around the cell
+  template <class Visitor>
+  void visitRing(glm::ivec2 cell, int32_t ring, Visitor&& visitor) const;
+
+  // The smallest distance from the location to a tile outside the rings up to and including ring
+  int32_t getRingClearance(glm::ivec2 location, glm::ivec2 cell, int32_t ring) const;
+
+  const uint32_t cellSize_;
+  const int32_t cellsX_;
+  const int32_t cellsY_;
+
+  // Indexed by cellY * cellsX + cellX
+  std::vector<std::vector<std::shared_ptr<Object>>> cells_;
+  std::unordered_map<const Object*, uint32_t> objectCells_;
+};
+
+}  // namespace griddly
@@ -1,4 +1,6 @@
 #include "EntityObserver.hpp"
+
+#include "../GDY/SymbolTable.hpp"
 namespace griddly {
 
 EntityObserver::EntityObserver(std::shared_ptr<Grid> grid) : Observer(std::move(grid)) {
@@ -10,6 +12,7 @@ void EntityObserver::init(EntityObserverConfig& config) {
 
   const auto& actionInputsDefinitions = config_.actionInputsDefinitions;
   for (const auto& actionInputDefinition : actionInputsDefinitions) {
+    actionNameIds_[actionInputDefinition.first] = SymbolTable::actionNames().intern(actionInputDefinition.first);
     if (actionInputDefinition.second.internal) {
       internalActions_.insert(actionInputDefinition.first);
     }
@@ -270,15 +273,14 @@ std::vector<uint32_t> EntityObserver::getAvailableActionIdsAtLocation(glm::ivec2
     const auto& actionInputDefinition = actionInputDefinitions.at(actionName);
 
     auto relativeToSource = actionInputDefinition.relative;
+    auto actionNameId = actionNameIds_.at(actionName);
 
     for (const auto& inputMapping : actionInputDefinition.inputMappings) {
       auto actionId = inputMapping.first;
-      auto mapping = inputMapping.second;
-
-      auto metaData = mapping.metaData;
+      const auto& mapping = inputMapping.second;
 
       // Create an fake action to test for availability (and not duplicate a bunch of code)
-      auto potentialAction = std::make_shared<Action>(Action(grid_, actionName, 0, 0, metaData));
+      auto potentialAction = grid_->newAction(actionNameId, 0, 0, mapping.metaData);
       potentialAction->init(srcObject, mapping.vectorToDest, mapping.orientationVector, relativeToSource);
 
       if (srcObject->isValidAction(potentialAction)) {
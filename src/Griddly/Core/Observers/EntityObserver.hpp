@@ -67,6 +67,9 @@ class EntityObserver : public Observer, public ObservationInterface<EntityObserv
 
   std::unordered_set<std::string> internalActions_{};
 
+  // Interned in init, so the availability checks in each observation do not intern the action names again
+  std::unordered_map<std::string, uint32_t> actionNameIds_{};
+
   std::unordered_map<std::string, EntityConfig> entityConfig_{};
 
   std::unordered_map<std::string, std::vector<std::string>> entityFeatures_;
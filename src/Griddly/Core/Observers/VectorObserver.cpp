@@ -33,7 +33,17 @@ void VectorObserver::resetShape() {
   gridBoundary_.x = grid_->getWidth();
   gridBoundary_.y = grid_->getHeight();
 
-  observationChannels_ = static_cast<uint32_t>(grid_->getObjectIds().size());
+  const auto& objectIds = grid_->getObjectIds();
+  observationChannels_ = static_cast<uint32_t>(objectIds.size());
+
+  objectChannels_.assign(SymbolTable::objectNames().size(), UINT32_MAX);
+  for (const auto& objectIdIt : objectIds) {
+    auto objectNameId = SymbolTable::objectNames().intern(objectIdIt.first);
+    if (objectNameId >= objectChannels_.size()) {
+      objectChannels_.resize(objectNameId + 1, UINT32_MAX);
+    }
+    objectChannels_[objectNameId] = objectIdIt.second;
+  }
 
   // Always in order objects, player, orientation, variables.
   if (config_.includePlayerId) {
@@ -79,9 +89,12 @@ void VectorObserver::renderLocation(glm::ivec2 objectLocation, glm::ivec2 output
   bool processTopLayer = true;
   for (auto& objectIt : grid_->getObjectsAt(objectLocation)) {
     auto object = objectIt.second;
-    auto objectName = object->getObjectName();
-    spdlog::debug("Rendering object {0}", objectName);
-    auto memPtrObject = memPtr + grid_->getObjectIds().at(objectName);
+    auto objectNameId = object->getObjectNameId();
+    spdlog::debug("Rendering object {0}", object->getObjectName());
+    if (objectNameId >= objectChannels_.size() || objectChannels_[objectNameId] == UINT32_MAX) {
+      throw std::out_of_range(fmt::format("Object {0} has no observation channel", object->getObjectName()));
+    }
+    auto memPtrObject = memPtr + objectChannels_[objectNameId];
     *memPtrObject = 1;
 
     if (processTopLayer) {
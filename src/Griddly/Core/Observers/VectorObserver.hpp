@@ -37,6 +37,9 @@ class VectorObserver : public Observer, public TensorObservationInterface, publi
   uint32_t channelsBeforeVariables_;
   uint32_t channelsBeforeGlobalVariables_;
 
+  // Grid object id of each object type, indexed by object name id
+  std::vector<uint32_t> objectChannels_;
+
   VectorObserverConfig config_;
 };
 
@@ -15,6 +15,7 @@
 namespace griddly {
 
 std::shared_ptr<vk::VulkanInstance> VulkanObserver::instance_ = nullptr;
+std::mutex VulkanObserver::instanceMutex_;
 
 VulkanObserver::VulkanObserver(std::shared_ptr<Grid> grid) : Observer(std::move(grid)) {
 }
@@ -67,13 +68,17 @@ void VulkanObserver::lazyInit() {
   auto imagePath = config_.resourceConfig.imagePath;
   auto shaderPath = config_.resourceConfig.shaderPath;
 
-  auto configuration = vk::VulkanConfiguration();
-  if (instance_ == nullptr) {
-    instance_ = std::make_shared<vk::VulkanInstance>(configuration);
-  }
+  {
+    std::lock_guard<std::mutex> instanceLock(instanceMutex_);
+
+    auto configuration = vk::VulkanConfiguration();
+    if (instance_ == nullptr) {
+      instance_ = std::make_shared<vk::VulkanInstance>(configuration);
+    }
 
-  device_ = std::make_shared<vk::VulkanDevice>(vk::VulkanDevice(instance_, config_.tileSize, shaderPath));
-  device_->initDevice(false);
+    device_ = std::make_shared<vk::VulkanDevice>(vk::VulkanDevice(instance_, config_.tileSize, shaderPath));
+    device_->initDevice(false);
+  }
 
   // This is probably far too big for most circumstances, but not sure how to work this one out in a smarter way,
   const int maxObjects = 100000;
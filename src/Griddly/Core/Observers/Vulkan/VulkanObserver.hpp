@@ -2,6 +2,7 @@
 #include <vulkan/vulkan.h>
 
 #include <memory>
+#include <mutex>
 
 #include "../../Grid.hpp"
 #include "../Observer.hpp"
@@ -70,6 +71,8 @@ class VulkanObserver : public Observer, public TensorObservationInterface, publi
 
  private:
   static std::shared_ptr<vk::VulkanInstance> instance_;
+  // Observers of games reset from different threads share the instance
+  static std::mutex instanceMutex_;
   VulkanObserverConfig config_;
 
 };
@@ -0,0 +1,130 @@
+#include "OccupancyGridCollisionDetector.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace griddly {
+
+OccupancyGridCollisionDetector::OccupancyGridCollisionDetector(uint32_t gridWidth, uint32_t gridHeight, uint32_t range, TriggerType triggerType)
+    : CollisionDetector(gridWidth, gridHeight, range), cells_(gridWidth * gridHeight), occupied_(gridWidth * gridHeight, 0), triggerType_(triggerType) {
+}
+
+bool OccupancyGridCollisionDetector::upsert(std::shared_ptr<Object> object, glm::ivec2 location) {
+  auto cellIdx = getCellIdx(location);
+  auto objectCellIt = objectCells_.find(object.get());
+
+  if (objectCellIt == objectCells_.end()) {
+    insertIntoCell(cellIdx, object);
+    objectCells_.emplace(object.get(), cellIdx);
+    return true;
+  }
+
+  if (objectCellIt->second != cellIdx) {
+    removeFromCell(objectCellIt->second, object);
+    insertIntoCell(cellIdx, object);
+    objectCellIt->second = cellIdx;
+  }
+
+  return false;
+}
+
+bool OccupancyGridCollisionDetector::remove(std::shared_ptr<Object> object) {
+  auto objectCellIt = objectCells_.find(object.get());
+
+  if (objectCellIt == objectCells_.end()) {
+    return false;
+  }
+
+  spdlog::debug("object {0} removed from occupancy grid.", object->getObjectName());
+
+  removeFromCell(objectCellIt->second, object);
+  objectCells_.erase(objectCellIt);
+  return true;
+}
+
+void OccupancyGridCollisionDetector::forEachObject(glm::ivec2 location, const CollisionVisitor& visitor) {
+  if (triggerType_ == TriggerType::NONE) {
+    throw std::invalid_argument("Misconfigured collision detector!, specify 'RANGE_BOX_BOUNDARY' or 'RANGE_BOX_AREA' in configuration");
+  }
+
+  auto range = static_cast<int32_t>(range_);
+  auto left = location.x - range;
+  auto right = location.x + range;
+  auto bottom = location.y - range;
+  auto top = location.y + range;
+
+  switch (triggerType_) {
+    case TriggerType::RANGE_BOX_AREA: {
+      for (auto y = bottom; y <= top; y++) {
+        visitRow(y, left, right, visitor);
+      }
+    } break;
+    case TriggerType::RANGE_BOX_BOUNDARY: {
+      visitRow(bottom, left, right, visitor);
+      for (auto y = bottom + 1; y < top; y++) {
+        visitRow(y, left, left, visitor);
+        visitRow(y, right, right, visitor);
+      }
+      if (top != bottom) {
+        visitRow(top, left, right, visitor);
+      }
+    } break;
+    case TriggerType::NONE:
+      break;
+  }
+}
+
+void OccupancyGridCollisionDetector::visitRow(int32_t y, int32_t left, int32_t right, const CollisionVisitor& visitor) const {
+  if (y < 0 || y >= static_cast<int32_t>(gridHeight_)) {
+    return;
+  }
+
+  auto rowLeft = std::max(0, left);
+  auto rowRight = std::min(static_cast<int32_t>(gridWidth_) - 1, right);
+  auto rowOffset = y * gridWidth_;
+  const auto* rowOccupied = occupied_.data() + rowOffset;
+
+  for (auto x = rowLeft; x <= rowRight; x++) {
+    if (rowOccupied[x] == 0) {
+      continue;
+    }
+
+    for (const auto& object : cells_[rowOffset + x]) {
+      visitor(object);
+    }
+  }
+}
+
+uint32_t OccupancyGridCollisionDetector::getCellIdx(glm::ivec2 location) const {
+  if (location.x < 0 || location.y < 0 || location.x >= static_cast<int32_t>(gridWidth_) || location.y >= static_cast<int32_t>(gridHeight_)) {
+    return NO_CELL;
+  }
+  return location.y * gridWidth_ + location.x;
+}
+
+void OccupancyGridCollisionDetector::insertIntoCell(uint32_t cellIdx, const std::shared_ptr<Object>& object) {
+  if (cellIdx == NO_CELL) {
+    return;
+  }
+
+  cells_[cellIdx].push_back(object);
+  occupied_[cellIdx] = 1;
+}
+
+void OccupancyGridCollisionDetector::removeFromCell(uint32_t cellIdx, const std::shared_ptr<Object>& object) {
+  if (cellIdx == NO_CELL) {
+    return;
+  }
+
+  auto& cell = cells_[cellIdx];
+  auto objectIt = std::find(cell.begin(), cell.end(), object);
+  if (objectIt != cell.end()) {
+    *objectIt = std::move(cell.back());
+    cell.pop_back();
+  }
+
+  occupied_[cellIdx] = cell.empty() ? 0 : 1;
+}
+
+}  // namespace griddly
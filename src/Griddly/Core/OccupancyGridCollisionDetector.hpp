@@ -0,0 +1,48 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "CollisionDetector.hpp"
+#include "Grid.hpp"
+
+namespace griddly {
+
+/**
+ * Stores the objects of every cell of the grid directly, with a byte per cell marking whether it has any objects.
+ * Searching reads the (2 * range + 1)^2 cells around the location a row at a time and only touches the objects of
+ * occupied cells, so it is cheaper than hashing for small ranges. Memory grows with the size of the grid rather than
+ * the number of objects.
+ */
+class OccupancyGridCollisionDetector : public CollisionDetector {
+ public:
+  OccupancyGridCollisionDetector(uint32_t gridWidth, uint32_t gridHeight, uint32_t range, TriggerType triggerType);
+
+  using CollisionDetector::upsert;
+
+  bool upsert(std::shared_ptr<Object> object, glm::ivec2 location) override;
+
+  bool remove(std::shared_ptr<Object> object) override;
+
+  void forEachObject(glm::ivec2 location, const CollisionVisitor& visitor) override;
+
+ private:
+  static constexpr uint32_t NO_CELL = UINT32_MAX;
+
+  uint32_t getCellIdx(glm::ivec2 location) const;
+
+  void insertIntoCell(uint32_t cellIdx, const std::shared_ptr<Object>& object);
+  void removeFromCell(uint32_t cellIdx, const std::shared_ptr<Object>& object);
+
+  void visitRow(int32_t y, int32_t left, int32_t right, const CollisionVisitor& visitor) const;
+
+  // Indexed by y * width + x
+  std::vector<std::vector<std::shared_ptr<Object>>> cells_;
+  std::vector<uint8_t> occupied_;
+
+  std::unordered_map<const Object*, uint32_t> objectCells_;
+
+  const TriggerType triggerType_;
+};
+
+}  // namespace griddly
@@ -0,0 +1,92 @@
+#include "PassabilityMap.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+#include "GDY/SymbolTable.hpp"
+#include "Grid.hpp"
+
+namespace griddly {
+
+PassabilityMap::PassabilityMap(const std::set<std::string>& impassableObjects) {
+  for (const auto& impassableObject : impassableObjects) {
+    impassableObjectNameIds_.push_back(SymbolTable::objectNames().intern(impassableObject));
+  }
+}
+
+std::string PassabilityMap::getKey(const std::set<std::string>& impassableObjects) {
+  std::string key;
+  for (const auto& impassableObject : impassableObjects) {
+    key += ":" + impassableObject;
+  }
+  return key;
+}
+
+uint32_t PassabilityMap::getWidth() const {
+  return width_;
+}
+
+uint32_t PassabilityMap::getHeight() const {
+  return height_;
+}
+
+uint32_t PassabilityMap::getBuildCount() const {
+  return buildCount_;
+}
+
+void PassabilityMap::update(const Grid& grid) {
+  changedLocations_.clear();
+  bool canUpdate = built_ && width_ == grid.getWidth() && height_ == grid.getHeight() && grid.getLocationChanges(changeIdx_, changedLocations_);
+  changeIdx_ = grid.getLocationChangeCount();
+
+  if (!canUpdate) {
+    build(grid);
+    return;
+  }
+
+  for (const auto& location : changedLocations_) {
+    setPassable(grid, location);
+  }
+}
+
+void PassabilityMap::build(const Grid& grid) {
+  width_ = grid.getWidth();
+  height_ = grid.getHeight();
+  built_ = true;
+  buildCount_++;
+
+  spdlog::debug("Building passability map for {0}x{1} grid", width_, height_);
+
+  passable_.assign((width_ * height_ + 63) / 64, 0);
+  for (uint32_t y = 0; y < height_; y++) {
+    for (uint32_t x = 0; x < width_; x++) {
+      setPassable(grid, glm::ivec2(x, y));
+    }
+  }
+}
+
+void PassabilityMap::setPassable(const Grid& grid, glm::ivec2 location) {
+  if (location.x < 0 || location.y < 0 || location.x >= static_cast<int32_t>(width_) || location.y >= static_cast<int32_t>(height_)) {
+    return;
+  }
+
+  bool passable = true;
+  for (const auto& objectIt : grid.getObjectsAt(location)) {
+    auto objectNameId = objectIt.second->getObjectNameId();
+    if (std::find(impassableObjectNameIds_.begin(), impassableObjectNameIds_.end(), objectNameId) != impassableObjectNameIds_.end()) {
+      passable = false;
+      break;
+    }
+  }
+
+  auto cellIdx = location.y * width_ + location.x;
+  auto bit = uint64_t{1} << (cellIdx & 63);
+  if (passable) {
+    passable_[cellIdx >> 6] |= bit;
+  } else {
+    passable_[cellIdx >> 6] &= ~bit;
+  }
+}
+
+}  // namespace griddly
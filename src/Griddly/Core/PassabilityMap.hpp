@@ -0,0 +1,63 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace griddly {
+
+class Grid;
+
+/**
+ * One bit per location in the grid, set if there is no impassable object at the location.
+ *
+ * A single map is shared by every path finder on the grid that avoids the same objects, so the grid is only scanned once
+ * however many objects are searching. After that the map is refreshed from the locations the grid reports as changed,
+ * and each change is only looked at by the first search after it.
+ */
+class PassabilityMap {
+ public:
+  explicit PassabilityMap(const std::set<std::string>& impassableObjects);
+
+  virtual ~PassabilityMap() = default;
+
+  // Refreshes the changed locations, or rebuilds the map if the grid has discarded some of the changes
+  virtual void update(const Grid& grid);
+
+  // Defined here, searches call it for every location they cross
+  bool isPassable(int32_t x, int32_t y) const {
+    if (x < 0 || y < 0 || x >= static_cast<int32_t>(width_) || y >= static_cast<int32_t>(height_)) {
+      return false;
+    }
+
+    auto cellIdx = static_cast<uint32_t>(y) * width_ + static_cast<uint32_t>(x);
+    return ((passable_[cellIdx >> 6] >> (cellIdx & 63)) & 1) != 0;
+  }
+
+  uint32_t getWidth() const;
+  uint32_t getHeight() const;
+
+  // The number of times the whole grid has been scanned
+  uint32_t getBuildCount() const;
+
+  static std::string getKey(const std::set<std::string>& impassableObjects);
+
+ private:
+  void build(const Grid& grid);
+  void setPassable(const Grid& grid, glm::ivec2 location);
+
+  std::vector<uint32_t> impassableObjectNameIds_;
+
+  bool built_ = false;
+  uint32_t buildCount_ = 0;
+  uint32_t width_ = 0;
+  uint32_t height_ = 0;
+  uint64_t changeIdx_ = 0;
+  std::vector<glm::ivec2> changedLocations_;
+
+  // Bit cellIdx & 63 of word cellIdx >> 6, where cellIdx is y * width + x
+  std::vector<uint64_t> passable_;
+};
+
+}  // namespace griddly
@@ -1,14 +1,23 @@
 #include "PathFinder.hpp"
 
+#include <algorithm>
 #include <utility>
 
 #include <utility>
 
+#include "GDY/SymbolTable.hpp"
 #include "Grid.hpp"
 
 namespace griddly {
 
 PathFinder::PathFinder(std::shared_ptr<Grid> grid, std::set<std::string> impassableObjects, PathFinderMode mode) : grid_(std::move(grid)), impassableObjects_(std::move(impassableObjects)), mode_(mode) {
+  for (const auto& impassableObject : impassableObjects_) {
+    impassableObjectNameIds_.push_back(SymbolTable::objectNames().intern(impassableObject));
+  }
+}
+
+bool PathFinder::isImpassable(uint32_t objectNameId) const {
+  return std::find(impassableObjectNameIds_.begin(), impassableObjectNameIds_.end(), objectNameId) != impassableObjectNameIds_.end();
 }
 
 }  // namespace griddly
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace griddly {
 
@@ -18,6 +19,12 @@ enum class PathFinderMode {
   FLEE
 };
 
+enum class PathFinderAlgorithm {
+  ASTAR,
+  FLOW_FIELD,
+  INCREMENTAL
+};
+
 class PathFinder {
  public:
   PathFinder(std::shared_ptr<Grid> grid, std::set<std::string> impassableObjects, PathFinderMode mode);
@@ -29,6 +36,11 @@ class PathFinder {
   const std::shared_ptr<Grid> grid_;
   std::set<std::string> impassableObjects_;
   const PathFinderMode mode_;
+
+  // The impassable object names interned, so checking a tile compares ids rather than strings
+  std::vector<uint32_t> impassableObjectNameIds_;
+
+  bool isImpassable(uint32_t objectNameId) const;
 };
 
 }  // namespace griddly
\ No newline at end of file
@@ -0,0 +1,170 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace griddly {
+
+/**
+ * Rewards indexed directly by player id, player 0 is the environment.
+ *
+ * Games have very few players, so the rewards for the first INLINE_PLAYERS player ids are stored in a fixed array and
+ * accumulating rewards never allocates. Players with no reward are treated as missing, so iterating, size() and
+ * comparisons behave like the std::unordered_map<uint32_t, int32_t> this replaces.
+ */
+class PlayerRewards {
+ public:
+  using value_type = std::pair<uint32_t, int32_t>;
+
+  static constexpr uint32_t INLINE_PLAYERS = 8;
+
+  // Iterates the players that have a non-zero reward
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = PlayerRewards::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = value_type;
+
+    const_iterator(const PlayerRewards& rewards, uint32_t playerId) : rewards_(&rewards), playerId_(playerId) {
+      skipZeros();
+    }
+
+    value_type operator*() const {
+      return {playerId_, rewards_->data()[playerId_]};
+    }
+
+    const_iterator& operator++() {
+      playerId_++;
+      skipZeros();
+      return *this;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return playerId_ == other.playerId_;
+    }
+
+    bool operator!=(const const_iterator& other) const {
+      return playerId_ != other.playerId_;
+    }
+
+   private:
+    void skipZeros() {
+      while (playerId_ < rewards_->slots_ && rewards_->data()[playerId_] == 0) {
+        playerId_++;
+      }
+    }
+
+    const PlayerRewards* rewards_;
+    uint32_t playerId_;
+  };
+
+  PlayerRewards() = default;
+
+  PlayerRewards(std::initializer_list<value_type> rewards) {
+    for (const auto& reward : rewards) {
+      (*this)[reward.first] += reward.second;
+    }
+  }
+
+  const_iterator begin() const {
+    return {*this, 0};
+  }
+
+  const_iterator end() const {
+    return {*this, slots_};
+  }
+
+  int32_t& operator[](uint32_t playerId) {
+    if (playerId >= slots_) {
+      resize(playerId + 1);
+    }
+    return data()[playerId];
+  }
+
+  int32_t get(uint32_t playerId) const {
+    return playerId < slots_ ? data()[playerId] : 0;
+  }
+
+  // Makes room for player ids up to playerSlots - 1 so they can be written without reallocating
+  void resize(uint32_t playerSlots) {
+    if (playerSlots <= slots_) {
+      return;
+    }
+
+    if (playerSlots > INLINE_PLAYERS) {
+      if (slots_ <= INLINE_PLAYERS) {
+        overflow_.assign(inline_.begin(), inline_.begin() + slots_);
+      }
+      overflow_.resize(playerSlots, 0);
+    }
+
+    slots_ = playerSlots;
+  }
+
+  PlayerRewards& operator+=(const PlayerRewards& other) {
+    if (other.slots_ > slots_) {
+      resize(other.slots_);
+    }
+
+    auto* rewards = data();
+    const auto* otherRewards = other.data();
+    for (uint32_t p = 0; p < other.slots_; p++) {
+      rewards[p] += otherRewards[p];
+    }
+    return *this;
+  }
+
+  // Zeroes all rewards, keeping the player slots
+  void clear() {
+    std::fill(data(), data() + slots_, 0);
+  }
+
+  // The number of players with a non-zero reward
+  size_t size() const {
+    return static_cast<size_t>(std::count_if(data(), data() + slots_, [](int32_t reward) { return reward != 0; }));
+  }
+
+  bool empty() const {
+    return std::all_of(data(), data() + slots_, [](int32_t reward) { return reward == 0; });
+  }
+
+  uint32_t getPlayerSlots() const {
+    return slots_;
+  }
+
+  // Contiguous rewards for player ids 0 to getPlayerSlots() - 1
+  int32_t* data() {
+    return slots_ > INLINE_PLAYERS ? overflow_.data() : inline_.data();
+  }
+
+  const int32_t* data() const {
+    return slots_ > INLINE_PLAYERS ? overflow_.data() : inline_.data();
+  }
+
+  bool operator==(const PlayerRewards& other) const {
+    auto slots = std::max(slots_, other.slots_);
+    for (uint32_t p = 0; p < slots; p++) {
+      if (get(p) != other.get(p)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool operator!=(const PlayerRewards& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  std::array<int32_t, INLINE_PLAYERS> inline_{};
+  std::vector<int32_t> overflow_;
+  uint32_t slots_ = 0;
+};
+
+}  // namespace griddly
@@ -1,7 +1,8 @@
 #include "SpatialHashCollisionDetector.hpp"
 
 #include <spdlog/spdlog.h>
-#include <glm/gtx/quaternion.hpp> // need this for length2 function
+
+#include <cstdlib>
 
 namespace griddly {
 
@@ -9,25 +10,29 @@ SpatialHashCollisionDetector::SpatialHashCollisionDetector(uint32_t gridWidth, u
     : CollisionDetector(gridWidth, gridHeight, range), triggerType_(triggerType), cellSize_(cellSize) {
 }
 
-bool SpatialHashCollisionDetector::upsert(std::shared_ptr<Object> object) {
-  bool isNewObject = !remove(object);
-  insert(object);
-  return isNewObject;
-}
-
-void SpatialHashCollisionDetector::insert(const std::shared_ptr<Object>& object) {
-  auto location = object->getLocation();
+bool SpatialHashCollisionDetector::upsert(std::shared_ptr<Object> object, glm::ivec2 location) {
   auto hash = calculateHash(location);
+  auto hashIt = hashes_.find(object);
 
-  spdlog::debug("object at location [{0},{1}] added to hash [{2},{3}].", location.x, location.y, hash.x, hash.y);
+  if (hashIt == hashes_.end()) {
+    spdlog::debug("object at location [{0},{1}] added to hash [{2},{3}].", location.x, location.y, hash.x, hash.y);
+    buckets_[hash].insert(object);
+    hashes_.emplace(std::move(object), hash);
+    return true;
+  }
 
-  if (buckets_.find(hash) == buckets_.end()) {
-    buckets_.insert({hash, {object}});
-  } else {
+  // Objects that move within the same cell stay in their bucket
+  if (hashIt->second != hash) {
+    spdlog::debug("object at location [{0},{1}] moved from hash [{2},{3}] to hash [{4},{5}].", location.x, location.y, hashIt->second.x, hashIt->second.y, hash.x, hash.y);
+    auto bucketIt = buckets_.find(hashIt->second);
+    if (bucketIt != buckets_.end()) {
+      bucketIt->second.erase(object);
+    }
     buckets_[hash].insert(object);
+    hashIt->second = hash;
   }
 
-  hashes_[object] = hash;
+  return false;
 }
 
 bool SpatialHashCollisionDetector::remove(std::shared_ptr<Object> object) {
@@ -45,67 +50,51 @@ bool SpatialHashCollisionDetector::remove(std::shared_ptr<Object> object) {
 
   spdlog::debug("object {0} removed from hash [{1},{2}].", object->getObjectName(), hashIt->second.x, hashIt->second.y);
 
-  hashes_.erase(object);
+  hashes_.erase(hashIt);
   return bucketIt->second.erase(object) > 0;
 }
 
-SearchResult SpatialHashCollisionDetector::search(glm::ivec2 location) {
-  auto top = std::min(gridHeight_, location.y + range_);
-  auto bottom = std::max(0, location.y - static_cast<int32_t>(range_));
+void SpatialHashCollisionDetector::forEachObject(glm::ivec2 location, const CollisionVisitor& visitor) {
+  if (triggerType_ == TriggerType::NONE) {
+    throw std::invalid_argument("Misconfigured collision detector!, specify 'RANGE_BOX_BOUNDARY' or 'RANGE_BOX_AREA' in configuration");
+  }
 
-  auto right = std::min(gridWidth_, location.x + range_);
-  auto left = std::max(0, location.x - static_cast<int32_t>(range_));
+  auto range = static_cast<int32_t>(range_);
+
+  auto top = std::min(static_cast<int32_t>(gridHeight_), location.y + range);
+  auto bottom = std::max(0, location.y - range);
+
+  auto right = std::min(static_cast<int32_t>(gridWidth_), location.x + range);
+  auto left = std::max(0, location.x - range);
 
   auto bottomLeft = calculateHash(glm::ivec2(left, bottom));
   auto topRight = calculateHash(glm::ivec2(right, top));
 
-  std::vector<glm::ivec2> hashes;
-  for (uint32_t hashy = bottomLeft.y; hashy <= topRight.y; hashy++) {
-    for (uint32_t hashx = bottomLeft.x; hashx <= topRight.x; hashx++) {
-      hashes.emplace_back(hashx, hashy);
-    }
-  }
+  for (auto hashy = bottomLeft.y; hashy <= topRight.y; hashy++) {
+    for (auto hashx = bottomLeft.x; hashx <= topRight.x; hashx++) {
+      auto bucketIt = buckets_.find({hashx, hashy});
+      if (bucketIt == buckets_.end()) {
+        continue;
+      }
 
-  std::unordered_set<std::shared_ptr<Object>> collidedObjects;
-  std::priority_queue<CollisionTarget, std::vector<CollisionTarget>, SortCollisionTargets> closestObjects;
-
-  for (const auto& hash : hashes) {
-    auto objectSet = buckets_[hash];
-
-    switch (triggerType_) {
-      case TriggerType::RANGE_BOX_BOUNDARY: {
-        for (const auto& object : objectSet) {
-          const auto& collisionLocation = object->getLocation();
-          auto distance = glm::length2(static_cast<glm::vec2>(collisionLocation-location));
-          if (std::abs(location.x - collisionLocation.x) == range_ && std::abs(location.y - collisionLocation.y) <= range_) {
-            spdlog::debug("Range collided object at ({0},{1}), source object at ({2},{3}), distance: {4}", collisionLocation.x, collisionLocation.y, location.x, location.y, distance);
-            collidedObjects.insert(object);
-            closestObjects.push({distance, object});
-          } else if (std::abs(location.y - collisionLocation.y) == range_ && std::abs(location.x - collisionLocation.x) <= range_) {
-            spdlog::debug("Range collided object at ({0},{1}), source object at ({2},{3}), distance: {4}", collisionLocation.x, collisionLocation.y, location.x, location.y, distance);
-            collidedObjects.insert(object);
-            closestObjects.push({distance, object});
-          }
+      for (const auto& object : bucketIt->second) {
+        const auto& collisionLocation = object->getLocation();
+        auto xDistance = std::abs(location.x - collisionLocation.x);
+        auto yDistance = std::abs(location.y - collisionLocation.y);
+
+        if (xDistance > range || yDistance > range) {
+          continue;
         }
-      } break;
-      case TriggerType::RANGE_BOX_AREA: {
-        for (const auto& object : objectSet) {
-          const auto& collisionLocation = object->getLocation();
-          auto distance = glm::length2(static_cast<glm::vec2>(collisionLocation-location));
-          if (std::abs(location.y - collisionLocation.y) <= range_ && std::abs(location.x - collisionLocation.x) <= range_) {
-            spdlog::debug("Area collided object at ({0},{1}), source object at ({2},{3}), distance: {4}", collisionLocation.x, collisionLocation.y, location.x, location.y, distance);
-            collidedObjects.insert(object);
-            closestObjects.push({distance, object});
-          }
+
+        if (triggerType_ == TriggerType::RANGE_BOX_BOUNDARY && xDistance != range && yDistance != range) {
+          continue;
         }
-      } break;
-      case TriggerType::NONE:
-        throw std::invalid_argument("Misconfigured collision detector!, specify 'RANGE_BOX_BOUNDARY' or 'RANGE_BOX_AREA' in configuration");
-        break;
+
+        spdlog::debug("Collided object at ({0},{1}), source object at ({2},{3})", collisionLocation.x, collisionLocation.y, location.x, location.y);
+        visitor(object);
+      }
     }
   }
-
-  return {collidedObjects, closestObjects};
 }
 
 glm::ivec2 SpatialHashCollisionDetector::calculateHash(glm::ivec2 location) const {
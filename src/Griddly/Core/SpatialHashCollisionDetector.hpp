@@ -11,17 +11,17 @@ class SpatialHashCollisionDetector : public CollisionDetector {
  public:
   SpatialHashCollisionDetector(uint32_t gridWidth, uint32_t gridHeight, uint32_t cellSize, uint32_t range, TriggerType triggerType);
 
-  bool upsert(std::shared_ptr<Object> object) override;
+  using CollisionDetector::upsert;
+
+  bool upsert(std::shared_ptr<Object> object, glm::ivec2 location) override;
 
   bool remove(std::shared_ptr<Object> object) override;
 
-  SearchResult search(glm::ivec2 location) override;
+  void forEachObject(glm::ivec2 location, const CollisionVisitor& visitor) override;
 
  private:
   glm::ivec2 calculateHash(glm::ivec2 location) const;
 
-  void insert(const std::shared_ptr<Object>& object);
-
   std::unordered_map<glm::ivec2, std::unordered_set<std::shared_ptr<Object>>> buckets_ = {};
   std::unordered_map<std::shared_ptr<Object>, glm::ivec2> hashes_ = {};
 
@@ -0,0 +1,148 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace griddly {
+
+class Object;
+
+/**
+ * The objects that occupy a single grid tile, ordered by z index.
+ *
+ * Most tiles hold one or two objects, so the first few z-slots are stored inline and only tiles with more
+ * objects than that spill over to the heap. The interface mirrors the subset of std::map<uint32_t, std::shared_ptr<Object>>
+ * that is used by the grid, observers and path finders.
+ */
+class TileObjects {
+ public:
+  using key_type = uint32_t;
+  using value_type = std::pair<uint32_t, std::shared_ptr<Object>>;
+  using const_iterator = const value_type*;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static constexpr uint32_t INLINE_SLOTS = 3;
+
+  TileObjects() = default;
+
+  TileObjects(std::initializer_list<value_type> objects) {
+    for (const auto& object : objects) {
+      insert(object);
+    }
+  }
+
+  const_iterator begin() const {
+    return data();
+  }
+
+  const_iterator end() const {
+    return data() + size_;
+  }
+
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  const_iterator find(uint32_t zIdx) const {
+    auto it = lowerBound(zIdx);
+    if (it != end() && it->first == zIdx) {
+      return it;
+    }
+    return end();
+  }
+
+  size_t count(uint32_t zIdx) const {
+    return find(zIdx) == end() ? 0 : 1;
+  }
+
+  const std::shared_ptr<Object>& at(uint32_t zIdx) const {
+    auto it = find(zIdx);
+    if (it == end()) {
+      throw std::out_of_range("No object at z index " + std::to_string(zIdx));
+    }
+    return it->second;
+  }
+
+  std::pair<const_iterator, bool> insert(value_type object) {
+    auto position = static_cast<size_t>(lowerBound(object.first) - begin());
+    if (position < size_ && data()[position].first == object.first) {
+      return {begin() + position, false};
+    }
+
+    if (size_ < INLINE_SLOTS) {
+      std::move_backward(inline_.begin() + position, inline_.begin() + size_, inline_.begin() + size_ + 1);
+      inline_[position] = std::move(object);
+    } else {
+      if (size_ == INLINE_SLOTS) {
+        overflow_.assign(std::make_move_iterator(inline_.begin()), std::make_move_iterator(inline_.end()));
+        inline_.fill({});
+      }
+      overflow_.insert(overflow_.begin() + position, std::move(object));
+    }
+
+    size_++;
+    return {begin() + position, true};
+  }
+
+  size_t erase(uint32_t zIdx) {
+    auto it = find(zIdx);
+    if (it == end()) {
+      return 0;
+    }
+
+    auto position = static_cast<size_t>(it - begin());
+    if (size_ > INLINE_SLOTS) {
+      overflow_.erase(overflow_.begin() + position);
+      if (size_ - 1 == INLINE_SLOTS) {
+        std::move(overflow_.begin(), overflow_.end(), inline_.begin());
+        overflow_.clear();
+      }
+    } else {
+      std::move(inline_.begin() + position + 1, inline_.begin() + size_, inline_.begin() + position);
+      inline_[size_ - 1] = {};
+    }
+
+    size_--;
+    return 1;
+  }
+
+  void clear() {
+    inline_.fill({});
+    overflow_.clear();
+    size_ = 0;
+  }
+
+ private:
+  const value_type* data() const {
+    return size_ > INLINE_SLOTS ? overflow_.data() : inline_.data();
+  }
+
+  const_iterator lowerBound(uint32_t zIdx) const {
+    return std::lower_bound(begin(), end(), zIdx, [](const value_type& object, uint32_t z) { return object.first < z; });
+  }
+
+  std::array<value_type, INLINE_SLOTS> inline_{};
+  std::vector<value_type> overflow_;
+  uint32_t size_ = 0;
+};
+
+}  // namespace griddly
@@ -20,8 +20,8 @@ class TurnBasedGameProcess : public GameProcess {
 
   void setTerminationHandler(std::shared_ptr<TerminationHandler> terminationHandler);
 
-  // Clone the Game Process
-  std::shared_ptr<TurnBasedGameProcess> clone();
+  // Clone the Game Process, a copy-on-write clone only copies the objects on the tiles it reads or changes
+  std::shared_ptr<TurnBasedGameProcess> clone(bool copyOnWrite = false);
 
   void seedRandomGenerator(uint32_t seed) override;
 
@@ -0,0 +1,93 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+namespace griddly {
+
+/**
+ * Bounded multi-producer multi-consumer queue in which every slot carries a sequence number (after Dmitry Vyukov's design).
+ * Producers and consumers claim slots with a single compare-and-swap, so no thread ever blocks another.
+ */
+template <class T>
+class LockFreeQueue {
+ public:
+  explicit LockFreeQueue(size_t capacity) {
+    // Capacity is rounded up to a power of two so positions can be masked rather than divided
+    size_t slotCount = 2;
+    while (slotCount < capacity) {
+      slotCount <<= 1;
+    }
+
+    mask_ = slotCount - 1;
+    slots_ = std::make_unique<Slot[]>(slotCount);
+    for (size_t i = 0; i < slotCount; i++) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  LockFreeQueue(const LockFreeQueue&) = delete;
+  LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+  // Returns false if the queue is full
+  bool tryPush(const T& value) {
+    auto position = enqueuePosition_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& slot = slots_[position & mask_];
+      auto sequence = slot.sequence.load(std::memory_order_acquire);
+      auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+      if (difference == 0) {
+        if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          slot.value = value;
+          slot.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = enqueuePosition_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Returns false if the queue is empty
+  bool tryPop(T& value) {
+    auto position = dequeuePosition_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& slot = slots_[position & mask_];
+      auto sequence = slot.sequence.load(std::memory_order_acquire);
+      auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+      if (difference == 0) {
+        if (dequeuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          value = slot.value;
+          slot.sequence.store(position + mask_ + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = dequeuePosition_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  size_t capacity() const {
+    return mask_ + 1;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_;
+
+  // Kept on separate cache lines so producers and consumers do not false share
+  alignas(64) std::atomic<size_t> enqueuePosition_{0};
+  alignas(64) std::atomic<size_t> dequeuePosition_{0};
+};
+
+}  // namespace griddly
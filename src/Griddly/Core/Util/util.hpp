@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <iterator>
 #include <sstream>
 #include <string>
@@ -8,6 +9,8 @@
 
 #include <spdlog/spdlog.h>
 
+#include "../PlayerRewards.hpp"
+
 template <typename T>
 inline void hash_combine(std::size_t& seed, const T& val) {
   seed ^= std::hash<T>()(val) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
@@ -33,10 +36,34 @@ struct VectorPriorityQueue : std::priority_queue<T, C, P> {
   using std::priority_queue<T, C, P>::priority_queue;
   typename C::iterator begin() { return std::priority_queue<T, C, P>::c.begin(); }
   typename C::iterator end() { return std::priority_queue<T, C, P>::c.end(); }
+
+  // Removes a single element, returns false if it is not in the queue
+  bool remove(const T& value) {
+    auto& container = std::priority_queue<T, C, P>::c;
+    auto it = std::find(container.begin(), container.end(), value);
+    if (it == container.end()) {
+      return false;
+    }
+    container.erase(it);
+    std::make_heap(container.begin(), container.end(), std::priority_queue<T, C, P>::comp);
+    return true;
+  }
 };
 
-inline void accumulateRewards(std::unordered_map<uint32_t, int32_t>& acc, std::unordered_map<uint32_t, int32_t>& values) {
-  for (auto valueIt : values) {
+// The splitmix64 finalizer, spreads the bits of a value so hashes can be combined with xor
+inline uint64_t mixHash(uint64_t value) {
+  value += 0x9e3779b97f4a7c15;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+  return value ^ (value >> 31);
+}
+
+inline void accumulateRewards(griddly::PlayerRewards& acc, const griddly::PlayerRewards& values) {
+  acc += values;
+}
+
+inline void accumulateRewards(griddly::PlayerRewards& acc, const std::unordered_map<uint32_t, int32_t>& values) {
+  for (const auto& valueIt : values) {
     acc[valueIt.first] += valueIt.second;
   }
 }
@@ -0,0 +1,385 @@
+#include "VectorGameProcess.hpp"
+
+#define SPDLOG_HEADER_ONLY
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+#include "GDY/Actions/Action.hpp"
+
+namespace griddly {
+
+VectorGameProcess::VectorGameProcess(uint32_t numEnvs, std::shared_ptr<GDYFactory> gdyFactory, std::string playerObserverName, uint32_t numThreads, bool pinThreads)
+    : gdyFactory_(std::move(gdyFactory)), playerObserverName_(std::move(playerObserverName)), playerCount_(gdyFactory_->getPlayerCount()), completedEnvs_(numEnvs) {
+  if (numEnvs == 0) {
+    throwRuntimeError("A vector game process needs at least one environment.");
+  }
+
+  envs_.resize(numEnvs);
+  for (auto& env : envs_) {
+    auto grid = std::make_shared<Grid>(Grid());
+    env.gameProcess = std::make_shared<TurnBasedGameProcess>(TurnBasedGameProcess("None", gdyFactory_, grid));
+
+    for (uint32_t p = 0; p < playerCount_; p++) {
+      auto playerId = p + 1;
+      auto observer = gdyFactory_->createObserver(grid, playerObserverName_, playerCount_, playerId);
+      auto tensorObserver = std::dynamic_pointer_cast<TensorObservationInterface>(observer);
+      if (tensorObserver == nullptr) {
+        throwRuntimeError(fmt::format("Observer {0} cannot be used in a vector game process as it does not produce tensor observations.", playerObserverName_));
+      }
+
+      auto player = std::make_shared<Player>(Player(playerId, fmt::format("Player {0}", playerId), observer, env.gameProcess));
+      env.gameProcess->addPlayer(player);
+      env.players.push_back(player);
+      env.observers.push_back(tensorObserver);
+      env.playerOrder.push_back(p);
+    }
+  }
+
+  rewards_.resize(numEnvs * playerCount_);
+  dones_.resize(numEnvs);
+
+  sentActions_.resize(numEnvs * playerCount_ * 4);
+  envInFlight_.resize(numEnvs);
+  envExceptions_.resize(numEnvs);
+
+#ifndef WASM
+  // Vulkan observers share a single vulkan instance, so they are only ever updated from one thread
+  auto observerType = gdyFactory_->getNamedObserverType(playerObserverName_);
+  if (numThreads > 1 && (observerType == ObserverType::SPRITE_2D || observerType == ObserverType::BLOCK_2D || observerType == ObserverType::ISOMETRIC)) {
+    spdlog::warn("Observer {0} renders with vulkan, vector game process will step games on a single thread.", playerObserverName_);
+    numThreads = 1;
+  }
+#endif
+
+  numThreads = std::min(numThreads, numEnvs);
+  if (numThreads > 1) {
+    threadPool_ = std::make_unique<WorkStealingThreadPool>(numThreads, pinThreads);
+  }
+}
+
+void VectorGameProcess::setLevel(uint32_t levelId) {
+  for (auto& env : envs_) {
+    env.gameProcess->setLevel(levelId);
+  }
+}
+
+void VectorGameProcess::init() {
+  if (isInitialized_) {
+    throw std::runtime_error("Cannot re-initialize vector game process");
+  }
+
+  externalActionNames_ = gdyFactory_->getExternalActionNames();
+  for (const auto& actionName : externalActionNames_) {
+    externalActionNameIds_.push_back(SymbolTable::actionNames().intern(actionName));
+  }
+  actionInputsDefinitions_ = gdyFactory_->getActionInputsDefinitions();
+
+  for (auto& env : envs_) {
+    env.gameProcess->init();
+  }
+
+  isInitialized_ = true;
+}
+
+void VectorGameProcess::reset() {
+  if (!isInitialized_) {
+    throw std::runtime_error("Cannot reset vector game process before initialization.");
+  }
+
+  requireNoEnvsInFlight();
+
+  forEachEnv([this](uint32_t e) { envs_[e].gameProcess->reset(); });
+
+  // Observation shapes are only known once the observers have been reset
+  observationShape_ = envs_[0].observers[0]->getShape();
+  observationStrides_ = envs_[0].observers[0]->getStrides();
+  observationSize_ = std::accumulate(observationShape_.begin(), observationShape_.end(), static_cast<size_t>(1), std::multiplies<>());
+  for (const auto& env : envs_) {
+    for (const auto& observer : env.observers) {
+      if (observer->getShape() != observationShape_) {
+        throwRuntimeError("All players in a vector game process must have the same observation shape.");
+      }
+    }
+  }
+
+  observations_.resize(envs_.size() * playerCount_ * observationSize_);
+  std::fill(rewards_.begin(), rewards_.end(), 0);
+  std::fill(dones_.begin(), dones_.end(), 0);
+
+  forEachEnv([this](uint32_t e) { observeEnv(e); });
+}
+
+void VectorGameProcess::step(const int32_t* actions, uint32_t actionSize) {
+  if (observationSize_ == 0) {
+    throw std::runtime_error("Cannot step vector game process before it has been reset.");
+  }
+
+  requireNoEnvsInFlight();
+  validateActionSize(actionSize);
+
+  auto envStride = playerCount_ * actionSize;
+  forEachEnv([this, actions, envStride, actionSize](uint32_t e) { stepEnv(e, actions + e * envStride, actionSize); });
+}
+
+void VectorGameProcess::send(const uint32_t* envIds, uint32_t count, const int32_t* actions, uint32_t actionSize) {
+  if (observationSize_ == 0) {
+    throw std::runtime_error("Cannot step vector game process before it has been reset.");
+  }
+
+  validateActionSize(actionSize);
+
+  auto numEnvs = static_cast<uint32_t>(envs_.size());
+  for (uint32_t i = 0; i < count; i++) {
+    auto envIdx = envIds[i];
+    if (envIdx >= numEnvs) {
+      auto error = fmt::format("Env {0} does not exist, there are {1} envs.", envIdx, numEnvs);
+      spdlog::error(error);
+      throw std::invalid_argument(error);
+    }
+    if (envInFlight_[envIdx]) {
+      auto error = fmt::format("Env {0} has already been sent and not received.", envIdx);
+      spdlog::error(error);
+      throw std::invalid_argument(error);
+    }
+  }
+
+  auto envStride = playerCount_ * actionSize;
+  for (uint32_t i = 0; i < count; i++) {
+    auto envIdx = envIds[i];
+    auto* envActions = &sentActions_[envIdx * playerCount_ * 4];
+    std::copy(actions + i * envStride, actions + (i + 1) * envStride, envActions);
+
+    envInFlight_[envIdx] = 1;
+    envsInFlight_++;
+
+    auto stepTask = [this, envIdx, envActions, actionSize] {
+      try {
+        stepEnv(envIdx, envActions, actionSize);
+      } catch (...) {
+        envExceptions_[envIdx] = std::current_exception();
+      }
+
+      // Every env is in the queue at most once, so it can never be full
+      completedEnvs_.tryPush(envIdx);
+
+      // Notifying under the lock stops the wake up being lost while recv is about to sleep
+      std::lock_guard<std::mutex> lock(completedEnvsMutex_);
+      envCompleted_.notify_one();
+    };
+
+    if (threadPool_ == nullptr) {
+      stepTask();
+    } else {
+      // Hinting with the env id keeps each env on the same worker unless it gets stolen
+      threadPool_->submit(envIdx, stepTask);
+    }
+  }
+}
+
+std::vector<uint32_t> VectorGameProcess::recv(uint32_t batchSize) {
+  if (batchSize > envsInFlight_) {
+    auto error = fmt::format("Cannot receive {0} envs, only {1} are in flight.", batchSize, envsInFlight_);
+    spdlog::error(error);
+    throw std::invalid_argument(error);
+  }
+
+  std::vector<uint32_t> envIds;
+  envIds.reserve(batchSize);
+
+  std::exception_ptr envException;
+  while (envIds.size() < batchSize) {
+    uint32_t envIdx;
+    if (!completedEnvs_.tryPop(envIdx)) {
+      std::unique_lock<std::mutex> lock(completedEnvsMutex_);
+      envCompleted_.wait(lock, [this, &envIdx] { return completedEnvs_.tryPop(envIdx); });
+    }
+
+    envInFlight_[envIdx] = 0;
+    envsInFlight_--;
+    envIds.push_back(envIdx);
+
+    if (envExceptions_[envIdx] != nullptr && envException == nullptr) {
+      envException = envExceptions_[envIdx];
+    }
+    envExceptions_[envIdx] = nullptr;
+  }
+
+  if (envException != nullptr) {
+    std::rethrow_exception(envException);
+  }
+
+  return envIds;
+}
+
+void VectorGameProcess::validateActionSize(uint32_t actionSize) const {
+  // Decode errors are caught here rather than part way through a batch
+  if (actionSize == 0 || actionSize > 4) {
+    auto error = fmt::format("Invalid action size, {0}", actionSize);
+    spdlog::error(error);
+    throw std::invalid_argument(error);
+  }
+}
+
+void VectorGameProcess::requireNoEnvsInFlight() const {
+  if (envsInFlight_ > 0) {
+    auto error = fmt::format("{0} envs have been sent and not received.", envsInFlight_);
+    spdlog::error(error);
+    throw std::runtime_error(error);
+  }
+}
+
+void VectorGameProcess::forEachEnv(const std::function<void(uint32_t)>& envTask) {
+  auto numEnvs = static_cast<uint32_t>(envs_.size());
+  if (threadPool_ == nullptr) {
+    for (uint32_t e = 0; e < numEnvs; e++) {
+      envTask(e);
+    }
+  } else {
+    threadPool_->parallelFor(numEnvs, envTask);
+  }
+}
+
+void VectorGameProcess::stepEnv(uint32_t envIdx, const int32_t* envActions, uint32_t actionSize) {
+  auto& env = envs_[envIdx];
+  auto& gameProcess = env.gameProcess;
+
+  // Players act in a random order and the last player to act updates the game tick, as in step_parallel
+  std::shuffle(env.playerOrder.begin(), env.playerOrder.end(), gameProcess->getGrid()->getRandomGenerator()->getEngine());
+
+  bool terminated = false;
+  for (uint32_t i = 0; i < playerCount_; i++) {
+    auto p = env.playerOrder[i];
+    auto lastPlayer = i == playerCount_ - 1;
+
+    auto action = buildAction(env, p, envActions + p * actionSize, actionSize);
+
+    std::vector<std::shared_ptr<Action>> playerActions;
+    if (action != nullptr) {
+      playerActions.push_back(action);
+    }
+
+    auto actionResult = env.players[p]->performActions(playerActions, lastPlayer);
+    if (lastPlayer) {
+      terminated = actionResult.terminated;
+    }
+  }
+
+  for (uint32_t p = 0; p < playerCount_; p++) {
+    rewards_[envIdx * playerCount_ + p] = gameProcess->getAccumulatedRewards(p + 1);
+  }
+
+  dones_[envIdx] = terminated ? 1 : 0;
+  if (terminated) {
+    gameProcess->reset();
+  }
+
+  observeEnv(envIdx);
+}
+
+void VectorGameProcess::observeEnv(uint32_t envIdx) {
+  auto& env = envs_[envIdx];
+  for (uint32_t p = 0; p < playerCount_; p++) {
+    auto& observationData = env.observers[p]->update();
+    std::memcpy(&observations_[(envIdx * playerCount_ + p) * observationSize_], &observationData, observationSize_);
+  }
+}
+
+std::shared_ptr<Action> VectorGameProcess::buildAction(const VectorEnv& env, uint32_t playerIdx, const int32_t* actionArray, uint32_t actionSize) const {
+  uint32_t actionType = 0;
+  glm::ivec2 sourceLocation{};
+  int32_t actionId;
+
+  switch (actionSize) {
+    case 1:
+      actionId = actionArray[0];
+      break;
+    case 2:
+      actionType = actionArray[0];
+      actionId = actionArray[1];
+      break;
+    case 3:
+      sourceLocation = {actionArray[0], actionArray[1]};
+      actionId = actionArray[2];
+      break;
+    case 4:
+      sourceLocation = {actionArray[0], actionArray[1]};
+      actionType = actionArray[2];
+      actionId = actionArray[3];
+      break;
+    default: {
+      auto error = fmt::format("Invalid action size, {0}", actionSize);
+      spdlog::error(error);
+      throw std::invalid_argument(error);
+    }
+  }
+
+  const auto& actionName = externalActionNames_.at(actionType);
+  const auto& actionInputsDefinition = actionInputsDefinitions_.at(actionName);
+  const auto& inputMappings = actionInputsDefinition.inputMappings;
+
+  auto inputMappingIt = inputMappings.find(actionId);
+  if (inputMappingIt == inputMappings.end()) {
+    return nullptr;
+  }
+
+  const auto& player = env.players[playerIdx];
+  const auto& mapping = inputMappingIt->second;
+  auto action = env.gameProcess->getGrid()->newAction(externalActionNameIds_[actionType], player->getId(), 0, mapping.metaData);
+
+  auto playerAvatar = player->getAvatar();
+  if (playerAvatar != nullptr) {
+    action->init(playerAvatar, mapping.vectorToDest, mapping.orientationVector, actionInputsDefinition.relative);
+  } else {
+    action->init(sourceLocation, sourceLocation + mapping.vectorToDest);
+  }
+
+  return action;
+}
+
+uint32_t VectorGameProcess::getNumEnvs() const {
+  return static_cast<uint32_t>(envs_.size());
+}
+
+uint32_t VectorGameProcess::getPlayerCount() const {
+  return playerCount_;
+}
+
+uint32_t VectorGameProcess::getNumThreads() const {
+  return threadPool_ == nullptr ? 1 : threadPool_->getNumWorkers();
+}
+
+const std::vector<uint32_t>& VectorGameProcess::getObservationShape() const {
+  return observationShape_;
+}
+
+const std::vector<uint32_t>& VectorGameProcess::getObservationStrides() const {
+  return observationStrides_;
+}
+
+std::vector<uint8_t>& VectorGameProcess::getObservations() {
+  return observations_;
+}
+
+std::vector<int32_t>& VectorGameProcess::getRewards() {
+  return rewards_;
+}
+
+std::vector<uint8_t>& VectorGameProcess::getDones() {
+  return dones_;
+}
+
+std::shared_ptr<TurnBasedGameProcess> VectorGameProcess::getGameProcess(uint32_t envIdx) const {
+  return envs_.at(envIdx).gameProcess;
+}
+
+void VectorGameProcess::release() {
+  for (auto& env : envs_) {
+    env.gameProcess->release();
+  }
+}
+
+}  // namespace griddly
@@ -0,0 +1,121 @@
+#pragma once
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "GDY/GDYFactory.hpp"
+#include "Observers/TensorObservationInterface.hpp"
+#include "Players/Player.hpp"
+#include "TurnBasedGameProcess.hpp"
+#include "Util/LockFreeQueue.hpp"
+#include "WorkStealingThreadPool.hpp"
+
+namespace griddly {
+
+struct VectorEnv {
+  std::shared_ptr<TurnBasedGameProcess> gameProcess;
+  std::vector<std::shared_ptr<Player>> players;
+  std::vector<std::shared_ptr<TensorObservationInterface>> observers;
+  std::vector<uint32_t> playerOrder;
+};
+
+/**
+ * Steps a batch of games created from the same GDY description with a single call.
+ * Observations, rewards and dones are written into contiguous buffers which are reused between steps.
+ * Games that terminate are reset straight away, so the observations of a done game are the first of its next episode.
+ * With more than one thread the games are stepped in parallel, each game only ever touching its own grid and its slice of the buffers.
+ *
+ * Games can also be stepped asynchronously with send and recv, which return games in the order they finish.
+ */
+class VectorGameProcess {
+ public:
+  VectorGameProcess(uint32_t numEnvs, std::shared_ptr<GDYFactory> gdyFactory, std::string playerObserverName, uint32_t numThreads = 1, bool pinThreads = false);
+
+  virtual ~VectorGameProcess() = default;
+
+  virtual void setLevel(uint32_t levelId);
+
+  virtual void init();
+
+  virtual void reset();
+
+  // Actions are laid out as [env][player][actionSize], with the same action formats as step_parallel
+  virtual void step(const int32_t* actions, uint32_t actionSize);
+
+  // Starts stepping the given envs and returns straight away. Actions are laid out as [envIds][player][actionSize].
+  virtual void send(const uint32_t* envIds, uint32_t count, const int32_t* actions, uint32_t actionSize);
+
+  // Blocks until batchSize of the sent envs have finished stepping and returns their ids in the order they finished.
+  // Their observations, rewards and dones can be read from the batch buffers until they are sent again.
+  virtual std::vector<uint32_t> recv(uint32_t batchSize);
+
+  uint32_t getNumEnvs() const;
+  uint32_t getPlayerCount() const;
+  uint32_t getNumThreads() const;
+
+  // The shape of a single player's observation
+  const std::vector<uint32_t>& getObservationShape() const;
+  const std::vector<uint32_t>& getObservationStrides() const;
+
+  // [env][player][observation]
+  std::vector<uint8_t>& getObservations();
+
+  // [env][player]
+  std::vector<int32_t>& getRewards();
+
+  // [env]
+  std::vector<uint8_t>& getDones();
+
+  std::shared_ptr<TurnBasedGameProcess> getGameProcess(uint32_t envIdx) const;
+
+  virtual void release();
+
+ protected:
+  void stepEnv(uint32_t envIdx, const int32_t* envActions, uint32_t actionSize);
+  void observeEnv(uint32_t envIdx);
+  void forEachEnv(const std::function<void(uint32_t)>& envTask);
+
+  std::vector<VectorEnv> envs_;
+
+ private:
+  std::shared_ptr<Action> buildAction(const VectorEnv& env, uint32_t playerIdx, const int32_t* actionArray, uint32_t actionSize) const;
+  void validateActionSize(uint32_t actionSize) const;
+  void requireNoEnvsInFlight() const;
+
+  const std::shared_ptr<GDYFactory> gdyFactory_;
+  const std::string playerObserverName_;
+  const uint32_t playerCount_;
+
+  // Cached from the GDY factory as it returns copies
+  std::vector<std::string> externalActionNames_;
+  std::vector<uint32_t> externalActionNameIds_;
+  std::unordered_map<std::string, ActionInputsDefinition> actionInputsDefinitions_;
+
+  std::vector<uint32_t> observationShape_;
+  std::vector<uint32_t> observationStrides_;
+  size_t observationSize_ = 0;
+
+  std::vector<uint8_t> observations_;
+  std::vector<int32_t> rewards_;
+  std::vector<uint8_t> dones_;
+
+  bool isInitialized_ = false;
+
+  // Async stepping. The actions of sent envs are copied so callers can reuse their buffers.
+  // Only the thread calling send and recv reads or writes the in flight flags.
+  std::vector<int32_t> sentActions_;
+  std::vector<uint8_t> envInFlight_;
+  uint32_t envsInFlight_ = 0;
+  std::vector<std::exception_ptr> envExceptions_;
+  LockFreeQueue<uint32_t> completedEnvs_;
+  // recv sleeps on this while no env has completed
+  std::mutex completedEnvsMutex_;
+  std::condition_variable envCompleted_;
+
+  // Destroyed first so no worker is still running a task when the rest of the process is torn down
+  std::unique_ptr<WorkStealingThreadPool> threadPool_;
+};
+
+}  // namespace griddly
@@ -0,0 +1,189 @@
+#include "WorkStealingThreadPool.hpp"
+
+#define SPDLOG_HEADER_ONLY
+#include <spdlog/spdlog.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace griddly {
+
+WorkStealingThreadPool::WorkStealingThreadPool(uint32_t numWorkers, bool pinWorkers) {
+  if (numWorkers == 0) {
+    throw std::invalid_argument("A thread pool needs at least one worker.");
+  }
+
+  for (uint32_t w = 0; w < numWorkers; w++) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+
+  for (uint32_t w = 0; w < numWorkers; w++) {
+    workers_.emplace_back(&WorkStealingThreadPool::workerLoop, this, w);
+    if (pinWorkers) {
+      pinWorker(w);
+    }
+  }
+
+  spdlog::debug("Started thread pool with {0} workers", numWorkers);
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    stopping_ = true;
+  }
+  tasksQueued_.notify_all();
+
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void WorkStealingThreadPool::parallelFor(uint32_t count, const std::function<void(uint32_t)>& task) {
+  if (count == 0) {
+    return;
+  }
+
+  auto numWorkers = static_cast<uint32_t>(queues_.size());
+
+  std::mutex batchMutex;
+  std::condition_variable batchFinished;
+  uint32_t pendingTasks = count;
+  std::exception_ptr taskException;
+
+  auto runTask = [&](uint32_t taskIdx) {
+    std::exception_ptr exception;
+    try {
+      task(taskIdx);
+    } catch (...) {
+      exception = std::current_exception();
+    }
+
+    // The batch state lives on the caller's stack, so it must not be touched once the lock is released on the last task
+    std::lock_guard<std::mutex> lock(batchMutex);
+    if (exception != nullptr && taskException == nullptr) {
+      taskException = exception;
+    }
+    if (--pendingTasks == 0) {
+      batchFinished.notify_all();
+    }
+  };
+
+  // Contiguous ranges keep neighbouring tasks on the same worker unless they get stolen
+  for (uint32_t w = 0; w < numWorkers; w++) {
+    auto begin = static_cast<uint32_t>(static_cast<uint64_t>(count) * w / numWorkers);
+    auto end = static_cast<uint32_t>(static_cast<uint64_t>(count) * (w + 1) / numWorkers);
+
+    std::lock_guard<std::mutex> queueLock(queues_[w]->mutex);
+    for (uint32_t t = begin; t < end; t++) {
+      queues_[w]->tasks.emplace_back([&runTask, t] { runTask(t); });
+    }
+    queuedTasks_ += end - begin;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    tasksQueued_.notify_all();
+  }
+
+  std::unique_lock<std::mutex> lock(batchMutex);
+  batchFinished.wait(lock, [&pendingTasks] { return pendingTasks == 0; });
+
+  if (taskException != nullptr) {
+    std::rethrow_exception(taskException);
+  }
+}
+
+void WorkStealingThreadPool::submit(uint32_t workerHint, std::function<void()> task) {
+  pushTask(workerHint % static_cast<uint32_t>(queues_.size()), std::move(task));
+}
+
+uint32_t WorkStealingThreadPool::getNumWorkers() const {
+  return static_cast<uint32_t>(workers_.size());
+}
+
+void WorkStealingThreadPool::pushTask(uint32_t workerIdx, std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> queueLock(queues_[workerIdx]->mutex);
+    queues_[workerIdx]->tasks.push_back(std::move(task));
+    queuedTasks_++;
+  }
+
+  // Notifying under the pool lock stops the wake up being lost while a worker is about to sleep
+  std::lock_guard<std::mutex> lock(poolMutex_);
+  tasksQueued_.notify_one();
+}
+
+void WorkStealingThreadPool::workerLoop(uint32_t workerIdx) {
+  std::function<void()> task;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(poolMutex_);
+      tasksQueued_.wait(lock, [this] { return stopping_ || queuedTasks_ > 0; });
+      if (stopping_) {
+        return;
+      }
+    }
+
+    while (popTask(workerIdx, task)) {
+      try {
+        task();
+      } catch (const std::exception& e) {
+        spdlog::error("Uncaught exception in thread pool task: {0}", e.what());
+      } catch (...) {
+        spdlog::error("Uncaught exception in thread pool task");
+      }
+      task = nullptr;
+    }
+  }
+}
+
+bool WorkStealingThreadPool::popTask(uint32_t workerIdx, std::function<void()>& task) {
+  auto numWorkers = static_cast<uint32_t>(queues_.size());
+
+  {
+    auto& ownQueue = *queues_[workerIdx];
+    std::lock_guard<std::mutex> lock(ownQueue.mutex);
+    if (!ownQueue.tasks.empty()) {
+      task = std::move(ownQueue.tasks.front());
+      ownQueue.tasks.pop_front();
+      queuedTasks_--;
+      return true;
+    }
+  }
+
+  for (uint32_t i = 1; i < numWorkers; i++) {
+    auto& victimQueue = *queues_[(workerIdx + i) % numWorkers];
+    std::lock_guard<std::mutex> lock(victimQueue.mutex);
+    if (!victimQueue.tasks.empty()) {
+      task = std::move(victimQueue.tasks.back());
+      victimQueue.tasks.pop_back();
+      queuedTasks_--;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void WorkStealingThreadPool::pinWorker(uint32_t workerIdx) {
+#ifdef __linux__
+  auto numCores = std::thread::hardware_concurrency();
+  if (numCores == 0) {
+    return;
+  }
+
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(workerIdx % numCores, &cpuSet);
+  if (pthread_setaffinity_np(workers_[workerIdx].native_handle(), sizeof(cpu_set_t), &cpuSet) != 0) {
+    spdlog::warn("Could not pin thread pool worker {0} to core {1}", workerIdx, workerIdx % numCores);
+  }
+#else
+  spdlog::debug("Pinning thread pool workers is only supported on linux");
+#endif
+}
+
+}  // namespace griddly
@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace griddly {
+
+struct WorkerQueue {
+  std::mutex mutex;
+  std::deque<std::function<void()>> tasks;
+};
+
+/**
+ * Runs independent tasks across a fixed set of worker threads.
+ * Every worker has its own queue, and workers that run out of tasks steal from the back of the others' queues.
+ * Batches are split into contiguous ranges, one per worker. Tasks write their results by index, so results do not depend on which worker ran them.
+ */
+class WorkStealingThreadPool {
+ public:
+  explicit WorkStealingThreadPool(uint32_t numWorkers, bool pinWorkers = false);
+
+  virtual ~WorkStealingThreadPool();
+
+  WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+  WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+  // Runs task(0) ... task(count - 1) and blocks until they have all finished.
+  // If any task throws, the first exception is rethrown once the batch has finished.
+  virtual void parallelFor(uint32_t count, const std::function<void(uint32_t)>& task);
+
+  // Queues a task without waiting for it. Tasks submitted with the same worker hint are started in order by that worker unless they are stolen.
+  // Submitted tasks must handle their own exceptions.
+  virtual void submit(uint32_t workerHint, std::function<void()> task);
+
+  uint32_t getNumWorkers() const;
+
+ private:
+  void workerLoop(uint32_t workerIdx);
+  bool popTask(uint32_t workerIdx, std::function<void()>& task);
+  void pushTask(uint32_t workerIdx, std::function<void()> task);
+  void pinWorker(uint32_t workerIdx);
+
+  std::vector<std::thread> workers_;
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+
+  std::mutex poolMutex_;
+  std::condition_variable tasksQueued_;
+  std::atomic<uint32_t> queuedTasks_{0};
+  bool stopping_ = false;
+};
+
+}  // namespace griddly
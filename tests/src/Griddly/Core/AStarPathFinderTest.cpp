@@ -6,6 +6,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::ReturnRef;
 
@@ -168,4 +169,37 @@ TEST(AStarPathFinderTest, searchRotationActions) {
   ASSERT_EQ(left.actionId, 1);
 }
 
+TEST(AStarPathFinderTest, searchAroundWallAfterSearchingLargerGrid) {
+  auto mockObjectPtr = std::make_shared<MockObject>();
+  auto largeMockGridPtr = std::make_shared<MockGrid>();
+  auto smallMockGridPtr = std::make_shared<MockGrid>();
+
+  const std::string objectName = "impassable_object";
+  EXPECT_CALL(*mockObjectPtr, getObjectName).WillRepeatedly(ReturnRef(objectName));
+
+  TileObjects noObjects = {};
+  TileObjects wallObjects = {{0, mockObjectPtr}};
+
+  EXPECT_CALL(*largeMockGridPtr, getObjectsAt).WillRepeatedly(ReturnRef(noObjects));
+  EXPECT_CALL(*largeMockGridPtr, getHeight).WillRepeatedly(Return(6));
+  EXPECT_CALL(*largeMockGridPtr, getWidth).WillRepeatedly(Return(6));
+
+  // A wall at x = 1 that can only be passed at the top of the grid
+  EXPECT_CALL(*smallMockGridPtr, getObjectsAt).WillRepeatedly(Invoke([&](glm::ivec2 location) -> const TileObjects& {
+    return location.x == 1 && location.y < 2 ? wallObjects : noObjects;
+  }));
+  EXPECT_CALL(*smallMockGridPtr, getHeight).WillRepeatedly(Return(3));
+  EXPECT_CALL(*smallMockGridPtr, getWidth).WillRepeatedly(Return(4));
+
+  auto largePathFinder = std::make_shared<AStarPathFinder>(
+      largeMockGridPtr, std::set<std::string>{objectName}, getUpDownLeftRightActions(), PathFinderMode::SEEK);
+  auto smallPathFinder = std::make_shared<AStarPathFinder>(
+      smallMockGridPtr, std::set<std::string>{objectName}, getUpDownLeftRightActions(), PathFinderMode::SEEK);
+
+  // Nodes visited by the first search must not leak into the second
+  ASSERT_EQ(largePathFinder->search({0, 0}, {3, 0}, {0, 0}, 100).actionId, 2);
+  ASSERT_EQ(smallPathFinder->search({0, 0}, {3, 0}, {0, 0}, 100).actionId, 1);
+  ASSERT_EQ(smallPathFinder->search({0, 2}, {3, 0}, {0, 0}, 100).actionId, 2);
+}
+
 }  // namespace griddly
\ No newline at end of file
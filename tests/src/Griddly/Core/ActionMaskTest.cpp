@@ -0,0 +1,143 @@
+#include <memory>
+
+#include "Griddly/Core/ActionMask.cpp"
+#include "Griddly/Core/GDY/Objects/Object.hpp"
+#include "Mocks/Griddly/Core/GDY/MockGDYFactory.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#define _V(X) std::make_shared<int32_t>(X)
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+using ::testing::Return;
+
+namespace griddly {
+
+std::shared_ptr<MockGDYFactory> mockActionMaskGDYFactory() {
+  auto mockGDYFactoryPtr = std::make_shared<MockGDYFactory>();
+
+  std::unordered_map<std::string, ActionInputsDefinition> actionInputsDefinitions = {
+      {"move", {{{1, {{1, 0}, {0, 0}, "Right"}}}, false, false}},
+      {"shoot", {{{1, {{1, 0}, {0, 0}, "Right"}}}, false, false}}};
+
+  EXPECT_CALL(*mockGDYFactoryPtr, getActionInputsDefinitions).WillRepeatedly(Return(actionInputsDefinitions));
+  EXPECT_CALL(*mockGDYFactoryPtr, getExternalActionNames).WillRepeatedly(Return(std::vector<std::string>{"move", "shoot"}));
+  EXPECT_CALL(*mockGDYFactoryPtr, getAvatarObject).WillRepeatedly(Return(""));
+
+  return mockGDYFactoryPtr;
+}
+
+void resetActionMaskGrid(const std::shared_ptr<Grid>& grid, uint32_t width) {
+  grid->resetMap(width, 1);
+  grid->initObject("unit", {"ammo"});
+  grid->initObject("wall", {});
+
+  auto emptyObject = std::make_shared<Object>(Object("_empty", ' ', 0, 0, {}, nullptr, grid));
+  auto boundaryObject = std::make_shared<Object>(Object("_boundary", ' ', 0, 0, {}, nullptr, grid));
+  grid->addPlayerDefaultObjects(emptyObject, boundaryObject);
+}
+
+std::shared_ptr<Grid> actionMaskGrid() {
+  auto grid = std::make_shared<Grid>();
+  grid->setPlayerCount(1);
+  resetActionMaskGrid(grid, 4);
+  return grid;
+}
+
+std::shared_ptr<Object> actionMaskUnit(const std::shared_ptr<Grid>& grid) {
+  auto unit = std::make_shared<Object>(Object("unit", 'u', 1, 0, {{"ammo", _V(1)}}, nullptr, grid));
+
+  auto shootPreconditionsNode = YAML::Load("- gt: [ammo, 0]");
+  unit->addActionSrcBehaviour("move", 0, "_empty", "nop", {}, {});
+  unit->addPrecondition("shoot", 0, "_empty", shootPreconditionsNode);
+  unit->addActionSrcBehaviour("shoot", 0, "_empty", "nop", {}, {});
+
+  return unit;
+}
+
+TEST(ActionMaskTest, updateRecomputesFullMask) {
+  auto grid = actionMaskGrid();
+  auto unit1 = actionMaskUnit(grid);
+  auto unit2 = actionMaskUnit(grid);
+  grid->addObject({0, 0}, unit1, false);
+  grid->addObject({3, 0}, unit2, false);
+
+  ActionMaskTracker tracker(mockActionMaskGDYFactory(), grid);
+  tracker.update();
+
+  ASSERT_THAT(tracker.getShape(), ElementsAre(1, 4, 2, 2));
+  ASSERT_EQ(tracker.getRecomputedUnitCount(), 2);
+
+  // The unit at the edge of the grid cannot move or shoot into the boundary
+  std::vector<uint8_t> expectedMasks(16, 0);
+  expectedMasks[0] = expectedMasks[1] = expectedMasks[2] = expectedMasks[3] = 1;
+  ASSERT_THAT(tracker.getMasks(), ElementsAreArray(expectedMasks));
+
+  tracker.update();
+  ASSERT_EQ(tracker.getRecomputedUnitCount(), 0);
+}
+
+TEST(ActionMaskTest, updateOnlyRecomputesChangedUnits) {
+  auto grid = actionMaskGrid();
+  auto unit1 = actionMaskUnit(grid);
+  auto unit2 = actionMaskUnit(grid);
+  grid->addObject({0, 0}, unit1, false);
+  grid->addObject({2, 0}, unit2, false);
+
+  ActionMaskTracker tracker(mockActionMaskGDYFactory(), grid);
+  tracker.update();
+  ASSERT_EQ(tracker.getRecomputedUnitCount(), 2);
+
+  // Only the first unit's shoot precondition reads its ammo
+  grid->writeVariable(unit1->getVariableValue("ammo").get(), 0, unit1);
+  tracker.update();
+  ASSERT_EQ(tracker.getRecomputedUnitCount(), 1);
+
+  std::vector<uint8_t> expectedMasks(16, 0);
+  expectedMasks[0] = expectedMasks[1] = 1;
+  expectedMasks[8] = expectedMasks[9] = expectedMasks[10] = expectedMasks[11] = 1;
+  ASSERT_THAT(tracker.getMasks(), ElementsAreArray(expectedMasks));
+
+  // Nothing reads the tick count
+  grid->writeVariable(grid->getTickCount().get(), 5, nullptr);
+  tracker.update();
+  ASSERT_EQ(tracker.getRecomputedUnitCount(), 0);
+
+  // A wall in front of the first unit blocks it, the wall itself does not belong to a player
+  auto wall = std::make_shared<Object>(Object("wall", 'w', 0, 0, {}, nullptr, grid));
+  grid->addObject({1, 0}, wall, false);
+  tracker.update();
+  ASSERT_EQ(tracker.getRecomputedUnitCount(), 1);
+
+  expectedMasks[0] = expectedMasks[1] = 0;
+  ASSERT_THAT(tracker.getMasks(), ElementsAreArray(expectedMasks));
+
+  // Moving the second unit clears its old unit and fills its new one
+  grid->removeObject(unit2);
+  grid->addObject({3, 0}, unit2, false);
+  tracker.update();
+  ASSERT_EQ(tracker.getRecomputedUnitCount(), 2);
+
+  expectedMasks[8] = expectedMasks[9] = expectedMasks[10] = expectedMasks[11] = 0;
+  ASSERT_THAT(tracker.getMasks(), ElementsAreArray(expectedMasks));
+}
+
+TEST(ActionMaskTest, resetRecomputesAllUnits) {
+  auto grid = actionMaskGrid();
+  auto unit1 = actionMaskUnit(grid);
+  grid->addObject({0, 0}, unit1, false);
+
+  ActionMaskTracker tracker(mockActionMaskGDYFactory(), grid);
+  tracker.update();
+
+  resetActionMaskGrid(grid, 2);
+  grid->addObject({0, 0}, actionMaskUnit(grid), false);
+  tracker.update();
+
+  ASSERT_THAT(tracker.getShape(), ElementsAre(1, 2, 2, 2));
+  ASSERT_EQ(tracker.getRecomputedUnitCount(), 1);
+  ASSERT_THAT(tracker.getMasks(), ElementsAre(1, 1, 1, 1, 0, 0, 0, 0));
+}
+
+}  // namespace griddly
@@ -0,0 +1,126 @@
+#include <memory>
+
+#include "Griddly/Core/DStarLitePathFinder.cpp"
+#include "Griddly/Core/GDY/Objects/Object.hpp"
+#include "Griddly/Core/TestUtils/common.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace griddly {
+
+std::shared_ptr<Object> dStarLiteObject(const std::shared_ptr<Grid>& grid, const std::string& objectName) {
+  return std::make_shared<Object>(Object(objectName, '?', 1, 0, {}, nullptr, grid));
+}
+
+//  y=5  . . . . . . . .
+//  y=4  . . . . . . . .
+//  y=3  . . . W . . . .
+//  y=2  . . . W . . . .
+//  y=1  . . . W . . . .
+//  y=0  . . u W . . . T
+std::shared_ptr<Grid> dStarLiteGrid() {
+  auto grid = pathFinderGrid(8, 6, {"wall", "unit"});
+
+  for (int32_t y = 0; y < 4; y++) {
+    grid->addObject({3, y}, dStarLiteObject(grid, "wall"), false);
+  }
+  return grid;
+}
+
+uint32_t freshSearchExpandedCount(const std::shared_ptr<Grid>& grid, glm::ivec2 startLocation, glm::ivec2 endLocation) {
+  DStarLitePathFinder pathFinder(grid, {"wall"}, fourDirectionMoveActions(), PathFinderMode::SEEK);
+  pathFinder.search(startLocation, endLocation, {}, 100);
+  return pathFinder.getExpandedCount();
+}
+
+TEST(DStarLitePathFinderTest, searchAroundWall) {
+  auto grid = dStarLiteGrid();
+  DStarLitePathFinder pathFinder(grid, {"wall"}, fourDirectionMoveActions(), PathFinderMode::SEEK);
+
+  ASSERT_EQ(pathFinder.search({2, 0}, {7, 0}, {}, 100).actionId, 4);
+  ASSERT_EQ(pathFinder.search({0, 4}, {7, 0}, {}, 100).actionId, 3);
+  ASSERT_EQ(pathFinder.search({4, 4}, {7, 0}, {}, 100).actionId, 2);
+
+  // Nothing to do when already at the target
+  ASSERT_EQ(pathFinder.search({7, 0}, {7, 0}, {}, 100).actionId, 0);
+}
+
+TEST(DStarLitePathFinderTest, repairSearchAfterChanges) {
+  auto grid = dStarLiteGrid();
+  DStarLitePathFinder pathFinder(grid, {"wall"}, fourDirectionMoveActions(), PathFinderMode::SEEK);
+
+  ASSERT_EQ(pathFinder.search({2, 0}, {7, 0}, {}, 100).actionId, 4);
+  auto initialExpandedCount = pathFinder.getExpandedCount();
+  ASSERT_GT(initialExpandedCount, 0);
+
+  // Moving along the path reuses the previous search
+  ASSERT_EQ(pathFinder.search({2, 1}, {7, 0}, {}, 100).actionId, 4);
+  ASSERT_LT(pathFinder.getExpandedCount(), initialExpandedCount);
+
+  // A wall away from the path barely changes the search
+  grid->addObject({6, 5}, dStarLiteObject(grid, "wall"), false);
+  ASSERT_EQ(pathFinder.search({2, 2}, {7, 0}, {}, 100).actionId, 4);
+  ASSERT_LT(pathFinder.getExpandedCount(), freshSearchExpandedCount(grid, {2, 2}, {7, 0}));
+
+  // A wall blocking the gap at y=4 moves the path onto y=5
+  grid->addObject({3, 4}, dStarLiteObject(grid, "wall"), false);
+  ASSERT_EQ(pathFinder.search({2, 4}, {7, 0}, {}, 100).actionId, 4);
+
+  ASSERT_EQ(pathFinder.search({0, 5}, {7, 1}, {}, 100).actionId, 3);
+  ASSERT_EQ(pathFinder.search({4, 5}, {7, 1}, {}, 100).actionId, 2);
+}
+
+TEST(DStarLitePathFinderTest, searchAgainAfterChangesDiscarded) {
+  auto grid = dStarLiteGrid();
+  DStarLitePathFinder pathFinder(grid, {"wall"}, fourDirectionMoveActions(), PathFinderMode::SEEK);
+
+  ASSERT_EQ(pathFinder.search({2, 0}, {7, 0}, {}, 100).actionId, 4);
+
+  grid->addObject({3, 4}, dStarLiteObject(grid, "wall"), false);
+  grid->addObject({3, 5}, dStarLiteObject(grid, "wall"), false);
+
+  // The changes are only kept until the end of the next tick, so the search starts again
+  grid->update();
+  grid->update();
+
+  ASSERT_EQ(pathFinder.search({2, 0}, {7, 0}, {}, 100).actionId, 0);
+  ASSERT_EQ(pathFinder.getExpandedCount(), freshSearchExpandedCount(grid, {2, 0}, {7, 0}));
+}
+
+TEST(DStarLitePathFinderTest, openSizeBoundedWhileRepairing) {
+  auto grid = dStarLiteGrid();
+  DStarLitePathFinder pathFinder(grid, {"wall"}, fourDirectionMoveActions(), PathFinderMode::SEEK);
+
+  ASSERT_EQ(pathFinder.search({2, 0}, {7, 0}, {}, 100).actionId, 4);
+
+  // Repairs leave stale entries behind, they are dropped before they outnumber the open locations
+  auto wall = dStarLiteObject(grid, "wall");
+  for (uint32_t i = 0; i < 50; i++) {
+    grid->addObject({3, 4}, wall, false);
+    pathFinder.search({2, 0}, {7, 0}, {}, 100);
+    grid->removeObject(wall);
+    ASSERT_EQ(pathFinder.search({2, 0}, {7, 0}, {}, 100).actionId, 4);
+    ASSERT_LE(pathFinder.getOpenSize(), 2 * 8 * 6);
+  }
+}
+
+TEST(DStarLitePathFinderTest, searchMovingTargetWithAStar) {
+  auto grid = dStarLiteGrid();
+  DStarLitePathFinder pathFinder(grid, {"wall"}, fourDirectionMoveActions(), PathFinderMode::SEEK);
+
+  ASSERT_EQ(pathFinder.search({2, 0}, {7, 0}, {}, 100).actionId, 4);
+
+  // The first move of the target is repaired
+  ASSERT_EQ(pathFinder.search({2, 1}, {7, 1}, {}, 100).actionId, 4);
+
+  // A target that keeps moving is searched with A* and the search is released
+  ASSERT_EQ(pathFinder.search({2, 2}, {7, 2}, {}, 100).actionId, 4);
+  ASSERT_EQ(pathFinder.getExpandedCount(), 0);
+  ASSERT_EQ(pathFinder.getOpenSize(), 0);
+
+  // The search starts again once the target stops
+  ASSERT_EQ(pathFinder.search({2, 3}, {7, 2}, {}, 100).actionId, 4);
+  ASSERT_EQ(pathFinder.getExpandedCount(), freshSearchExpandedCount(grid, {2, 3}, {7, 2}));
+}
+
+}  // namespace griddly
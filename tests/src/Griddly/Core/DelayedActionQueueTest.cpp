@@ -0,0 +1,99 @@
+#include "Griddly/Core/DelayedActionQueue.cpp"
+#include "Mocks/Griddly/Core/GDY/Actions/MockAction.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::UnorderedElementsAre;
+
+namespace griddly {
+
+auto DelayedActionIs(const std::shared_ptr<Action>& action) {
+  return Field(&DelayedActionQueueItem::action, action);
+}
+
+TEST(DelayedActionQueueTest, popDueInTickOrder) {
+  DelayedActionQueue queue(8);
+
+  auto action1 = std::make_shared<MockAction>();
+  auto action2 = std::make_shared<MockAction>();
+  auto action3 = std::make_shared<MockAction>();
+  auto action4 = std::make_shared<MockAction>();
+
+  queue.push({1, 3, action1});
+  queue.push({1, 2, action2});
+  queue.push({2, 3, action3});
+  queue.push({1, 5, action4});
+
+  ASSERT_EQ(queue.size(), 4);
+
+  std::vector<DelayedActionQueueItem> dueItems;
+  queue.popDue(1, dueItems);
+  ASSERT_TRUE(dueItems.empty());
+
+  queue.popDue(3, dueItems);
+  ASSERT_THAT(dueItems, ElementsAre(DelayedActionIs(action2), DelayedActionIs(action1), DelayedActionIs(action3)));
+  ASSERT_EQ(queue.size(), 1);
+
+  dueItems.clear();
+  queue.popDue(5, dueItems);
+  ASSERT_THAT(dueItems, ElementsAre(DelayedActionIs(action4)));
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(DelayedActionQueueTest, actionsFurtherThanTheWheel) {
+  DelayedActionQueue queue(4);
+
+  auto nearAction = std::make_shared<MockAction>();
+  auto farAction = std::make_shared<MockAction>();
+
+  // Both actions share a slot
+  queue.push({1, 9, farAction});
+  queue.push({1, 1, nearAction});
+
+  std::vector<DelayedActionQueueItem> dueItems;
+  queue.popDue(1, dueItems);
+  ASSERT_THAT(dueItems, ElementsAre(DelayedActionIs(nearAction)));
+
+  dueItems.clear();
+  queue.popDue(5, dueItems);
+  ASSERT_TRUE(dueItems.empty());
+
+  // Skipping more ticks than there are slots still finds the action
+  queue.popDue(20, dueItems);
+  ASSERT_THAT(dueItems, ElementsAre(DelayedActionIs(farAction)));
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(DelayedActionQueueTest, removeAndRestore) {
+  DelayedActionQueue queue(8);
+
+  auto action1 = std::make_shared<MockAction>();
+  auto action2 = std::make_shared<MockAction>();
+  auto action3 = std::make_shared<MockAction>();
+
+  queue.push({1, 2, action1});
+  queue.push({1, 2, action2});
+  queue.push({1, 4, action3});
+
+  DelayedActionQueueItem removedItem;
+  ASSERT_TRUE(queue.remove(4, action3.get(), &removedItem));
+  ASSERT_EQ(removedItem.action, action3);
+  ASSERT_FALSE(queue.remove(4, action3.get()));
+  ASSERT_THAT(queue, UnorderedElementsAre(DelayedActionIs(action1), DelayedActionIs(action2)));
+
+  std::vector<DelayedActionQueueItem> dueItems;
+  queue.popDue(2, dueItems);
+  ASSERT_TRUE(queue.empty());
+
+  // Restoring the popped actions in reverse keeps their order
+  queue.restore(dueItems[1]);
+  queue.restore(dueItems[0]);
+
+  dueItems.clear();
+  queue.popDue(2, dueItems);
+  ASSERT_THAT(dueItems, ElementsAre(DelayedActionIs(action1), DelayedActionIs(action2)));
+}
+
+}  // namespace griddly
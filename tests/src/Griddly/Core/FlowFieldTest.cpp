@@ -0,0 +1,122 @@
+#include <memory>
+
+#include "Griddly/Core/FlowField.cpp"
+#include "Griddly/Core/FlowFieldPathFinder.cpp"
+#include "Griddly/Core/GDY/Objects/Object.hpp"
+#include "Griddly/Core/TestUtils/common.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace griddly {
+
+std::shared_ptr<Object> flowFieldObject(const std::shared_ptr<Grid>& grid, const std::string& objectName, uint32_t zIdx = 0) {
+  return std::make_shared<Object>(Object(objectName, '?', 1, zIdx, {}, nullptr, grid));
+}
+
+//  y=2  . . . . .
+//  y=1  . W . . .
+//  y=0  u W . . T
+std::shared_ptr<Grid> flowFieldGrid() {
+  auto grid = pathFinderGrid(5, 3, {"target", "wall", "unit"});
+
+  grid->addObject({1, 0}, flowFieldObject(grid, "wall"), false);
+  grid->addObject({1, 1}, flowFieldObject(grid, "wall"), false);
+  grid->addObject({4, 0}, flowFieldObject(grid, "target"), false);
+  return grid;
+}
+
+std::shared_ptr<FlowField> flowField() {
+  return std::make_shared<FlowField>("target", std::set<std::string>{"wall"}, FlowFieldPathFinder::getMoveVectors(fourDirectionMoveActions()));
+}
+
+TEST(FlowFieldTest, distancesAvoidImpassableObjects) {
+  auto grid = flowFieldGrid();
+  auto field = flowField();
+  field->update(*grid);
+
+  ASSERT_EQ(field->getDistance({4, 0}), 0);
+  ASSERT_EQ(field->getDistance({2, 0}), 2);
+  ASSERT_EQ(field->getDistance({0, 0}), 8);
+  ASSERT_EQ(field->getDistance({1, 0}), FlowField::UNREACHABLE);
+  ASSERT_EQ(field->getDistance({5, 0}), FlowField::UNREACHABLE);
+  ASSERT_FALSE(field->isPassable({1, 1}));
+  ASSERT_TRUE(field->isPassable({0, 1}));
+}
+
+TEST(FlowFieldTest, pathFinderFollowsField) {
+  auto grid = flowFieldGrid();
+  auto field = flowField();
+
+  FlowFieldPathFinder seekPathFinder(grid, {"wall"}, fourDirectionMoveActions(), PathFinderMode::SEEK, field);
+  FlowFieldPathFinder fleePathFinder(grid, {"wall"}, fourDirectionMoveActions(), PathFinderMode::FLEE, field);
+
+  // Ties are broken by the lowest action id
+  ASSERT_EQ(seekPathFinder.search({0, 0}, {}, {}, 0).actionId, 4);
+  ASSERT_EQ(seekPathFinder.search({3, 1}, {}, {}, 0).actionId, 2);
+  ASSERT_EQ(seekPathFinder.search({4, 0}, {}, {}, 0).actionId, 0);
+
+  ASSERT_EQ(fleePathFinder.search({3, 0}, {}, {}, 0).actionId, 1);
+  ASSERT_EQ(fleePathFinder.search({2, 1}, {}, {}, 0).actionId, 4);
+
+  // Both path finders share the same field
+  ASSERT_EQ(field->getComputeCount(), 1);
+}
+
+TEST(FlowFieldTest, fleeAvoidsWalledOffLocations) {
+  //  y=2  W W . . .
+  //  y=1  . u . . .
+  //  y=0  W W . . T
+  auto grid = pathFinderGrid(5, 3, {"target", "wall", "unit"});
+  for (const auto& location : {glm::ivec2(0, 0), glm::ivec2(1, 0), glm::ivec2(0, 2), glm::ivec2(1, 2)}) {
+    grid->addObject(location, flowFieldObject(grid, "wall"), false);
+  }
+  grid->addObject({1, 1}, flowFieldObject(grid, "unit"), false);
+  grid->addObject({4, 0}, flowFieldObject(grid, "target"), false);
+
+  auto field = std::make_shared<FlowField>("target", std::set<std::string>{"wall", "unit"}, FlowFieldPathFinder::getMoveVectors(fourDirectionMoveActions()));
+  FlowFieldPathFinder fleePathFinder(grid, {"wall", "unit"}, fourDirectionMoveActions(), PathFinderMode::FLEE, field);
+
+  // The unit blocks the only way into the pocket on its left, so the field reaches neither of them
+  ASSERT_EQ(fleePathFinder.search({1, 1}, {}, {}, 0).actionId, 3);
+  ASSERT_EQ(field->getDistance({0, 1}), FlowField::UNREACHABLE);
+  ASSERT_EQ(field->getDistance({1, 1}), FlowField::UNREACHABLE);
+
+  // Nowhere to go from inside the pocket
+  ASSERT_EQ(fleePathFinder.search({0, 1}, {}, {}, 0).actionId, 0);
+}
+
+TEST(FlowFieldTest, recomputedOnlyWhenTargetsOrImpassablesMove) {
+  auto grid = flowFieldGrid();
+  auto field = flowField();
+
+  auto unit = flowFieldObject(grid, "unit", 1);
+  grid->addObject({0, 0}, unit, false);
+
+  field->update(*grid);
+  ASSERT_EQ(field->getComputeCount(), 1);
+
+  // Objects that are not targets or impassable do not change the field
+  *grid->getTickCount() = 1;
+  grid->removeObject(unit);
+  grid->addObject({0, 1}, unit, false);
+  field->update(*grid);
+  ASSERT_EQ(field->getComputeCount(), 1);
+
+  auto target = flowFieldObject(grid, "target");
+  grid->addObject({0, 2}, target, false);
+  field->update(*grid);
+  ASSERT_EQ(field->getComputeCount(), 2);
+  ASSERT_EQ(field->getDistance({0, 0}), 2);
+
+  // The field is computed at most once per tick
+  grid->removeObject(target);
+  field->update(*grid);
+  ASSERT_EQ(field->getComputeCount(), 2);
+
+  *grid->getTickCount() = 2;
+  field->update(*grid);
+  ASSERT_EQ(field->getComputeCount(), 3);
+  ASSERT_EQ(field->getDistance({0, 0}), 8);
+}
+
+}  // namespace griddly
@@ -0,0 +1,49 @@
+#include <memory>
+
+#include "Griddly/Core/GDY/Actions/ActionPool.cpp"
+#include "Mocks/Griddly/Core/MockGrid.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace griddly {
+
+TEST(ActionPoolTest, newAction) {
+  auto mockGridPtr = std::make_shared<MockGrid>();
+  ActionPool actionPool;
+
+  auto action = actionPool.newAction(mockGridPtr, SymbolTable::actionNames().intern("testAction"), 2, 3, {{"key", 5}});
+
+  ASSERT_EQ(action->getActionName(), "testAction");
+  ASSERT_EQ(action->getOriginatingPlayerId(), 2);
+  ASSERT_EQ(action->getDelay(), 3);
+  ASSERT_EQ(action->getMetaData("key"), 5);
+}
+
+TEST(ActionPoolTest, releasedActionsAreReused) {
+  auto mockGridPtr = std::make_shared<MockGrid>();
+  ActionPool actionPool;
+
+  auto action = actionPool.newAction(mockGridPtr, SymbolTable::actionNames().intern("testAction"), 1);
+  auto* actionAddress = action.get();
+  ASSERT_EQ(actionPool.getFreeBlockCount(), 0);
+
+  action.reset();
+  ASSERT_EQ(actionPool.getFreeBlockCount(), 1);
+
+  auto reusedAction = actionPool.newAction(mockGridPtr, SymbolTable::actionNames().intern("otherAction"), 1);
+  ASSERT_EQ(reusedAction.get(), actionAddress);
+  ASSERT_EQ(reusedAction->getActionName(), "otherAction");
+  ASSERT_EQ(actionPool.getFreeBlockCount(), 0);
+}
+
+TEST(ActionPoolTest, actionsOutliveThePool) {
+  auto mockGridPtr = std::make_shared<MockGrid>();
+  auto actionPool = std::make_shared<ActionPool>();
+
+  auto action = actionPool->newAction(mockGridPtr, SymbolTable::actionNames().intern("testAction"), 1);
+  actionPool.reset();
+
+  ASSERT_EQ(action->getActionName(), "testAction");
+}
+
+}  // namespace griddly
@@ -23,4 +23,29 @@ TEST(ActionTest, initActionLocations) {
   ASSERT_EQ(action->getVectorToDest(), glm::ivec2(3, 3));
 }
 
+TEST(ActionTest, metaData) {
+  ActionMetaData metaData{{"a", 1}, {"b", 2}};
+  metaData["a"] = 3;
+
+  ASSERT_EQ(metaData.size(), 2);
+  ASSERT_EQ(metaData.at("a"), 3);
+  ASSERT_EQ(metaData.find("c"), metaData.end());
+  ASSERT_THROW(metaData.at("c"), std::out_of_range);
+
+  // Entries past the inline capacity move to the heap and keep their order
+  for (int32_t i = 0; i < 6; i++) {
+    metaData["key" + std::to_string(i)] = i;
+  }
+
+  ASSERT_EQ(metaData.size(), 8);
+  ASSERT_EQ(metaData.at("b"), 2);
+  ASSERT_EQ(metaData.at("key5"), 5);
+  ASSERT_EQ(metaData.begin()->first, "a");
+
+  auto mockGridPtr = std::make_shared<MockGrid>();
+  auto action = std::make_shared<Action>(mockGridPtr, "testAction", 0, 0, metaData);
+  ASSERT_EQ(action->getMetaData("key3"), 3);
+  ASSERT_EQ(action->getMetaData("missing"), 0);
+}
+
 }  // namespace griddly
\ No newline at end of file
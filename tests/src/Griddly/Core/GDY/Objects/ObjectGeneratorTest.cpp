@@ -72,4 +72,44 @@ TEST(ObjectGeneratorTest, cloneInstance) {
   ASSERT_THAT(clonedObject->getAvailableActionNames(), UnorderedElementsAre("actionA"));
 
 }
-}  // namespace griddly
\ No newline at end of file
+
+TEST(ObjectGeneratorTest, newInstanceSharesBehaviourProgram) {
+  std::string objectAName = "objectA";
+  std::string objectBName = "objectB";
+  char mapCharacter = 'A';
+  uint32_t zIdx = 1;
+
+  ActionBehaviourDefinition mockBehaviourDefinition;
+
+  mockBehaviourDefinition.behaviourType = ActionBehaviourType::SOURCE;
+  mockBehaviourDefinition.sourceObjectName = objectAName;
+  mockBehaviourDefinition.destinationObjectName = objectBName;
+  mockBehaviourDefinition.actionName = "actionA";
+  mockBehaviourDefinition.commandName = "incr";
+  mockBehaviourDefinition.commandArguments = {{"0", _Y("variable1")}};
+
+  auto mockGridPtr = std::make_shared<MockGrid>();
+
+  std::map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t>>> globalVariables = {
+    {"globalVariable1", {{0, _V(1)}}},
+  };
+
+  EXPECT_CALL(*mockGridPtr, getGlobalVariables()).WillRepeatedly(ReturnRef(globalVariables));
+
+  auto objectGenerator = std::make_shared<ObjectGenerator>();
+
+  objectGenerator->defineNewObject(objectAName, mapCharacter, zIdx, {{"variable1", 5}});
+  objectGenerator->defineActionBehaviour(objectAName, mockBehaviourDefinition);
+
+  auto object1 = objectGenerator->newInstance(objectAName, 1, mockGridPtr);
+  auto object2 = objectGenerator->newInstance(objectAName, 1, mockGridPtr);
+
+  ASSERT_NE(object1->getBehaviourProgram(), nullptr);
+  ASSERT_EQ(object1->getBehaviourProgram(), object2->getBehaviourProgram());
+  ASSERT_THAT(object2->getAvailableActionNames(), UnorderedElementsAre("actionA"));
+
+  // Each instance is bound to its own variables
+  ASSERT_NE(object1->getVariableValue("variable1"), object2->getVariableValue("variable1"));
+  ASSERT_EQ(*object2->getVariableValue("variable1"), 5);
+}
+}  // namespace griddly
@@ -3,6 +3,7 @@
 
 #include "Griddly/Core/GDY/Objects/Object.hpp"
 #include "Griddly/Core/GDY/Objects/ObjectGenerator.hpp"
+#include "Griddly/Core/NearestObjectIndex.hpp"
 #include "Mocks/Griddly/Core/GDY/Actions/MockAction.hpp"
 #include "Mocks/Griddly/Core/GDY/Objects/MockObjectGenerator.hpp"
 #include "Mocks/Griddly/Core/MockGrid.hpp"
@@ -52,7 +53,7 @@ std::shared_ptr<MockAction> setupAction(std::string actionName, uint32_t origina
       .WillRepeatedly(Return(destObject->getLocation() - sourceObject->getLocation()));
 
   EXPECT_CALL(*mockActionPtr, getMetaData())
-      .WillRepeatedly(ReturnRefOfCopy(std::unordered_map<std::string, int32_t>{}));
+      .WillRepeatedly(ReturnRefOfCopy(ActionMetaData{}));
 
   EXPECT_CALL(*mockActionPtr, getMetaData(_))
       .WillRepeatedly(Return(0));
@@ -85,7 +86,7 @@ std::shared_ptr<MockAction> setupAction(std::string actionName, std::shared_ptr<
       .WillRepeatedly(Return(destObject->getLocation() - sourceObject->getLocation()));
 
   EXPECT_CALL(*mockActionPtr, getMetaData())
-      .WillRepeatedly(ReturnRefOfCopy(std::unordered_map<std::string, int32_t>{}));
+      .WillRepeatedly(ReturnRefOfCopy(ActionMetaData{}));
 
   EXPECT_CALL(*mockActionPtr, getMetaData(_))
       .WillRepeatedly(Return(0));
@@ -118,7 +119,7 @@ std::shared_ptr<MockAction> setupAction(std::string actionName, std::shared_ptr<
       .WillRepeatedly(Return(destObject->getLocation() - sourceObject->getLocation()));
 
   EXPECT_CALL(*mockActionPtr, getMetaData())
-      .WillRepeatedly(ReturnRefOfCopy(metaData));
+      .WillRepeatedly(ReturnRefOfCopy(ActionMetaData(metaData)));
 
   for (const auto& metaDataIt : metaData) {
     EXPECT_CALL(*mockActionPtr, getMetaData(metaDataIt.first))
@@ -150,7 +151,7 @@ std::shared_ptr<MockAction> setupAction(std::string actionName, std::shared_ptr<
       .WillRepeatedly(Return(destLocation - sourceObject->getLocation()));
 
   EXPECT_CALL(*mockActionPtr, getMetaData())
-      .WillRepeatedly(ReturnRefOfCopy(std::unordered_map<std::string, int32_t>{}));
+      .WillRepeatedly(ReturnRefOfCopy(ActionMetaData{}));
 
   EXPECT_CALL(*mockActionPtr, getMetaData(_))
       .WillRepeatedly(Return(0));
@@ -180,7 +181,7 @@ std::shared_ptr<MockAction> setupAction(std::string actionName, std::shared_ptr<
       .WillRepeatedly(Return(destLocation - sourceObject->getLocation()));
 
   EXPECT_CALL(*mockActionPtr, getMetaData())
-      .WillRepeatedly(ReturnRefOfCopy(std::unordered_map<std::string, int32_t>{}));
+      .WillRepeatedly(ReturnRefOfCopy(ActionMetaData{}));
 
   EXPECT_CALL(*mockActionPtr, getMetaData(_))
       .WillRepeatedly(Return(0));
@@ -246,6 +247,21 @@ TEST(ObjectTest, getVariables) {
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockGridPtr.get()));
 }
 
+TEST(ObjectTest, getVariablesById) {
+  auto object = std::make_shared<Object>(Object("object", 'o', 2, 0, {{"test_param", _V(20)}}, nullptr, std::weak_ptr<Grid>()));
+  auto testParamId = SymbolTable::variableNames().intern("test_param");
+  auto missingId = SymbolTable::variableNames().intern("does_not_exist");
+
+  // Without any behaviours there is no program to look the slot up in
+  ASSERT_EQ(object->getVariableValueById(testParamId, "test_param"), object->getVariableValue("test_param").get());
+
+  object->addActionSrcBehaviour(ACTION, 0, "dstObject", NOP, {}, {});
+
+  ASSERT_EQ(object->getVariableValueById(testParamId, "test_param"), object->getVariableValue("test_param").get());
+  ASSERT_EQ(object->getVariableValueById(SymbolTable::variableNames().intern("_playerId"), "_playerId"), object->getVariableValue("_playerId").get());
+  ASSERT_EQ(object->getVariableValueById(missingId, "does_not_exist"), nullptr);
+}
+
 TEST(ObjectTest, actionBoundToSrc) {
   auto srcObjectName = "srcObject";
   auto dstObjectName = "dstObject";
@@ -256,7 +272,7 @@ TEST(ObjectTest, actionBoundToSrc) {
 
   srcObject->addActionSrcBehaviour(ACTION, 0, dstObjectName, NOP, {}, {});
 
-  auto srcResult = srcObject->onActionSrc(dstObjectName, mockActionPtr, {0});
+  auto srcResult = srcObject->onActionSrc(SymbolTable::objectNames().intern(dstObjectName), mockActionPtr, {0});
 
   ASSERT_FALSE(srcResult.abortAction);
 
@@ -291,7 +307,7 @@ TEST(ObjectTest, actionDestinationObjectDifferentFromOriginalObject) {
 
   srcObject->addActionSrcBehaviour(ACTION, 0, dstObjectName, NOP, {}, {});
 
-  auto srcResult = srcObject->onActionSrc(dstObjectName, mockActionPtr, {0});
+  auto srcResult = srcObject->onActionSrc(SymbolTable::objectNames().intern(dstObjectName), mockActionPtr, {0});
 
   ASSERT_FALSE(srcResult.abortAction);
 
@@ -309,7 +325,7 @@ TEST(ObjectTest, srcActionNoBehaviourForDstObject) {
 
   srcObject->addActionSrcBehaviour(ACTION, 0, "not_dst_object", NOP, {}, {});
 
-  auto srcResult = srcObject->onActionSrc(dstObjectName, mockActionPtr, {0});
+  auto srcResult = srcObject->onActionSrc(SymbolTable::objectNames().intern(dstObjectName), mockActionPtr, {0});
 
   ASSERT_TRUE(srcResult.abortAction);
 
@@ -325,7 +341,7 @@ TEST(ObjectTest, srcActionNoBehaviourForAction) {
 
   auto mockActionPtr = setupAction(ACTION, srcObject, dstObject);
 
-  auto srcResult = srcObject->onActionSrc(dstObjectName, mockActionPtr, {0});
+  auto srcResult = srcObject->onActionSrc(SymbolTable::objectNames().intern(dstObjectName), mockActionPtr, {0});
 
   ASSERT_TRUE(srcResult.abortAction);
 
@@ -413,7 +429,7 @@ BehaviourResult addCommandsAndExecute(ActionBehaviourType type, std::shared_ptr<
     case ActionBehaviourType::SOURCE: {
       auto dstObjectName = dstObjectPtr == nullptr ? "_empty" : dstObjectPtr->getObjectName();
       srcObjectPtr->addActionSrcBehaviour(action->getActionName(), 0, dstObjectName, commandName, commandArgumentMap, conditionalCommands);
-      return srcObjectPtr->onActionSrc(dstObjectName, action, {0});
+      return srcObjectPtr->onActionSrc(SymbolTable::objectNames().intern(dstObjectName), action, {0});
     }
   }
 
@@ -432,10 +448,13 @@ std::shared_ptr<MockGrid> mockGrid() {
   EXPECT_CALL(*mockGridPtr, invalidateLocation)
       .WillRepeatedly(Return(true));
 
+  EXPECT_CALL(*mockGridPtr, getRandomGenerator)
+      .WillRepeatedly(Return(std::make_shared<RandomGenerator>()));
+
   return mockGridPtr;
 }
 
-void verifyCommandResult(BehaviourResult result, bool abort, std::unordered_map<uint32_t, int32_t> rewards) {
+void verifyCommandResult(BehaviourResult result, bool abort, PlayerRewards rewards) {
   ASSERT_EQ(result.abortAction, abort);
   ASSERT_EQ(result.rewards, rewards);
 }
@@ -750,11 +769,11 @@ TEST(ObjectTest, command_cascade) {
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), ActionListMatcher("action1", 1)))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 1}}));
+      .WillOnce(Return(PlayerRewards{{1, 1}}));
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), ActionListMatcher("action2", 1)))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{3, 2}}));
+      .WillOnce(Return(PlayerRewards{{3, 2}}));
 
   auto srcResult = addCommandsAndExecute(ActionBehaviourType::SOURCE, mockActionPtr1, "cascade", {{"0", _Y("_dest")}}, srcObjectPtr, dstObjectPtr);
   auto dstResult = addCommandsAndExecute(ActionBehaviourType::DESTINATION, mockActionPtr2, "cascade", {{"0", _Y("_dest")}}, srcObjectPtr, dstObjectPtr);
@@ -806,11 +825,11 @@ TEST(ObjectTest, command_mapped_to_grid) {
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonMappedToGridMatcher("mapped_to_grid", srcObjectPtr, gridDimensions)))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{2, 3}}));
+      .WillOnce(Return(PlayerRewards{{2, 3}}));
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonMappedToGridMatcher("mapped_to_grid", dstObjectPtr, gridDimensions)))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{5, 3}}));
+      .WillOnce(Return(PlayerRewards{{5, 3}}));
 
   auto srcResult = addCommandsAndExecute(ActionBehaviourType::SOURCE, mockActionPtr, "exec", {{"Action", _Y("mapped_to_grid")}}, srcObjectPtr, dstObjectPtr);
   auto dstResult = addCommandsAndExecute(ActionBehaviourType::DESTINATION, mockActionPtr, "exec", {{"Action", _Y("mapped_to_grid")}}, srcObjectPtr, dstObjectPtr);
@@ -861,11 +880,11 @@ TEST(ObjectTest, command_exec_delayed) {
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonDelayedActionVectorMatcher("exec_action", 10, srcObjectPtr, glm::ivec2(0, -1))))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{10, 3}}));
+      .WillOnce(Return(PlayerRewards{{10, 3}}));
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonDelayedActionVectorMatcher("exec_action", 10, dstObjectPtr, glm::ivec2(0, -1))))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{2, 6}}));
+      .WillOnce(Return(PlayerRewards{{2, 6}}));
 
   auto srcResult = addCommandsAndExecute(ActionBehaviourType::SOURCE, mockActionPtr, "exec", {{"Action", _Y("exec_action")}, {"Delay", _Y("10")}, {"ActionId", _Y(2)}}, srcObjectPtr, dstObjectPtr);
   auto dstResult = addCommandsAndExecute(ActionBehaviourType::DESTINATION, mockActionPtr, "exec", {{"Action", _Y("exec_action")}, {"Delay", _Y("10")}, {"ActionId", _Y(2)}}, srcObjectPtr, dstObjectPtr);
@@ -915,11 +934,11 @@ TEST(ObjectTest, command_exec) {
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonActionVectorOriginatingPlayerMatcher("exec_action", srcObjectPtr, 1, glm::ivec2{0, -1})))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{2, 3}}));
+      .WillOnce(Return(PlayerRewards{{2, 3}}));
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonActionVectorOriginatingPlayerMatcher("exec_action", dstObjectPtr, 1, glm::ivec2{0, -1})))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{10, 6}}));
+      .WillOnce(Return(PlayerRewards{{10, 6}}));
 
   auto srcResult = addCommandsAndExecute(ActionBehaviourType::SOURCE, mockActionPtr, "exec", {{"Action", _Y("exec_action")}, {"ActionId", _Y(2)}}, srcObjectPtr, dstObjectPtr);
   auto dstResult = addCommandsAndExecute(ActionBehaviourType::DESTINATION, mockActionPtr, "exec", {{"Action", _Y("exec_action")}, {"ActionId", _Y(2)}}, srcObjectPtr, dstObjectPtr);
@@ -972,11 +991,11 @@ TEST(ObjectTest, command_exec_with_action_player_id) {
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonActionVectorOriginatingPlayerMatcher("exec_action", srcObjectPtr, 5, glm::ivec2{0, -1})))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{2, 3}}));
+      .WillOnce(Return(PlayerRewards{{2, 3}}));
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonActionVectorOriginatingPlayerMatcher("exec_action", dstObjectPtr, 4, glm::ivec2{0, -1})))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{10, 6}}));
+      .WillOnce(Return(PlayerRewards{{10, 6}}));
 
   auto srcResult = addCommandsAndExecute(ActionBehaviourType::SOURCE, mockActionPtr1, "exec", {{"Action", _Y("exec_action")}, {"ActionId", _Y(2)}, {"Executor", _Y(ACTION)}}, srcObjectPtr, dstObjectPtr);
   auto dstResult = addCommandsAndExecute(ActionBehaviourType::DESTINATION, mockActionPtr2, "exec", {{"Action", _Y("exec_action")}, {"ActionId", _Y(2)}, {"Executor", _Y(ACTION)}}, srcObjectPtr, dstObjectPtr);
@@ -1030,11 +1049,11 @@ TEST(ObjectTest, command_exec_with_object_player_id) {
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonActionVectorOriginatingPlayerMatcher("exec_action", srcObjectPtr, 2, glm::ivec2{0, -1})))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{2, 3}}));
+      .WillOnce(Return(PlayerRewards{{2, 3}}));
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonActionVectorOriginatingPlayerMatcher("exec_action", dstObjectPtr, 10, glm::ivec2{0, -1})))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{10, 6}}));
+      .WillOnce(Return(PlayerRewards{{10, 6}}));
 
   auto srcResult = addCommandsAndExecute(ActionBehaviourType::SOURCE, mockActionPtr, "exec", {{"Action", _Y("exec_action")}, {"ActionId", _Y(2)}, {"Executor", _Y("object")}}, srcObjectPtr, dstObjectPtr);
   auto dstResult = addCommandsAndExecute(ActionBehaviourType::DESTINATION, mockActionPtr, "exec", {{"Action", _Y("exec_action")}, {"ActionId", _Y(2)}, {"Executor", _Y("object")}}, srcObjectPtr, dstObjectPtr);
@@ -1080,11 +1099,11 @@ TEST(ObjectTest, command_exec_randomize) {
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonActionVectorOriginatingPlayerMatcher("exec_action", srcObjectPtr, 1, glm::ivec2(-1, 0))))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 3}}));
+      .WillOnce(Return(PlayerRewards{{1, 3}}));
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonActionVectorOriginatingPlayerMatcher("exec_action", dstObjectPtr, 1, glm::ivec2(-1, 0))))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 3}}));
+      .WillOnce(Return(PlayerRewards{{1, 3}}));
 
   auto srcResult = addCommandsAndExecute(ActionBehaviourType::SOURCE, mockActionPtr, "exec", {{"Action", _Y("exec_action")}, {"Randomize", _Y(true)}}, srcObjectPtr, dstObjectPtr);
   auto dstResult = addCommandsAndExecute(ActionBehaviourType::DESTINATION, mockActionPtr, "exec", {{"Action", _Y("exec_action")}, {"Randomize", _Y(true)}}, srcObjectPtr, dstObjectPtr);
@@ -1148,11 +1167,11 @@ TEST(ObjectTest, command_exec_metadata) {
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonActionMetaDataMatcher("exec_action", srcObjectPtr, expectedSrcMetaData)))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 3}}));
+      .WillOnce(Return(PlayerRewards{{1, 3}}));
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonActionMetaDataMatcher("exec_action", dstObjectPtr, expectedDstMetaData)))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 3}}));
+      .WillOnce(Return(PlayerRewards{{1, 3}}));
 
   YAML::Node srcActionMetaData;
   srcActionMetaData["variable"] = _Y("meta.action_variable");
@@ -1208,11 +1227,11 @@ TEST(ObjectTest, command_exec_resolve_delay) {
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonDelayedActionVectorMatcher("exec_action", 10, srcObjectPtr, glm::ivec2(-1, 0))))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 3}}));
+      .WillOnce(Return(PlayerRewards{{1, 3}}));
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonDelayedActionVectorMatcher("exec_action", 20, dstObjectPtr, glm::ivec2(-1, 0))))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 3}}));
+      .WillOnce(Return(PlayerRewards{{1, 3}}));
 
   auto srcResult = addCommandsAndExecute(ActionBehaviourType::SOURCE, mockActionPtr, "exec", {{"Action", _Y("exec_action")}, {"ActionId", _Y("1")}, {"Delay", _Y("delay")}}, srcObjectPtr, dstObjectPtr);
   auto dstResult = addCommandsAndExecute(ActionBehaviourType::DESTINATION, mockActionPtr, "exec", {{"Action", _Y("exec_action")}, {"ActionId", _Y("1")}, {"Delay", _Y("delay")}}, srcObjectPtr, dstObjectPtr);
@@ -1259,11 +1278,11 @@ TEST(ObjectTest, command_exec_resolve_action_id) {
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonActionVectorOriginatingPlayerMatcher("exec_action", srcObjectPtr, 1, glm::ivec2(-1, 0))))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 3}}));
+      .WillOnce(Return(PlayerRewards{{1, 3}}));
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonActionVectorOriginatingPlayerMatcher("exec_action", dstObjectPtr, 1, glm::ivec2(1, 0))))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 3}}));
+      .WillOnce(Return(PlayerRewards{{1, 3}}));
 
   auto srcResult = addCommandsAndExecute(ActionBehaviourType::SOURCE, mockActionPtr, "exec", {{"Action", _Y("exec_action")}, {"ActionId", _Y("object_variable")}}, srcObjectPtr, dstObjectPtr);
   auto dstResult = addCommandsAndExecute(ActionBehaviourType::DESTINATION, mockActionPtr, "exec", {{"Action", _Y("exec_action")}, {"ActionId", _Y("object_variable")}}, srcObjectPtr, dstObjectPtr);
@@ -1301,8 +1320,8 @@ TEST(ObjectTest, command_exec_search) {
   EXPECT_CALL(*mockGridPtr, getWidth()).WillRepeatedly(Return(100));
 
   auto searchObjectPtr = setupObject(1, "search_object", glm::ivec2(5, 0), DiscreteOrientation(), {}, mockGridPtr, mockObjectGenerator);
-  std::map<uint32_t, std::shared_ptr<Object>> noObjects = {};
-  std::map<uint32_t, std::shared_ptr<Object>> searchObjectList = {{0, searchObjectPtr}};
+  TileObjects noObjects = {};
+  TileObjects searchObjectList = {{0, searchObjectPtr}};
 
   ON_CALL(*mockGridPtr, getObjectsAt(_)).WillByDefault(ReturnRef(noObjects));
   EXPECT_CALL(*mockGridPtr, getObjectsAt(_)).WillRepeatedly(ReturnRef(noObjects));
@@ -1319,12 +1338,10 @@ TEST(ObjectTest, command_exec_search) {
                        false,
                        false}}};
 
-  auto invokeCollisionDetector = [this, searchObjectPtr](std::unordered_set<std::string> objectNames, std::string actionName, std::shared_ptr<CollisionDetector> collisionDetector) -> void {
-    ASSERT_EQ(objectNames, std::unordered_set<std::string>({"search_object"}));
-    collisionDetector->upsert(searchObjectPtr);
-  };
+  auto searchObjectIndex = std::make_shared<NearestObjectIndex>(100, 100);
+  searchObjectIndex->upsert(searchObjectPtr);
 
-  EXPECT_CALL(*mockGridPtr, addCollisionDetector).WillOnce(Invoke(invokeCollisionDetector));
+  EXPECT_CALL(*mockGridPtr, getNearestObjectIndex(Eq("search_object"))).WillOnce(Return(searchObjectIndex));
 
   EXPECT_CALL(*mockObjectGenerator, getActionInputDefinitions())
       .Times(4)
@@ -1332,11 +1349,11 @@ TEST(ObjectTest, command_exec_search) {
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonDelayedActionVectorMatcher("exec_action", 10, srcObjectPtr, glm::ivec2(1, 0))))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 3}}));
+      .WillOnce(Return(PlayerRewards{{1, 3}}));
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(0), SingletonDelayedActionVectorMatcher("exec_action", 0, dstObjectPtr, glm::ivec2(1, 1))))
       .Times(1)
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 3}}));
+      .WillOnce(Return(PlayerRewards{{1, 3}}));
 
   YAML::Node searchNodeTargetObjectName;
   YAML::Node searchNodeTargetLocation;
@@ -1824,6 +1841,42 @@ TEST(ObjectTest, command_if_nested) {
   verifyMocks(mockActionPtr, mockGridPtr);
 }
 
+TEST(ObjectTest, command_if_nested_commands) {
+  auto ifConditions = R"(
+        Conditions:
+          eq: [1,1]
+        OnTrue:
+          - if:
+              Conditions:
+                or:
+                  - eq: [0,1]
+                  - eq: [2,1]
+              OnTrue:
+                - reward: 10
+              OnFalse:
+                - reward: 2
+                - reward: 3
+          - reward: 1
+        OnFalse:
+          - reward: 100
+        )";
+
+  auto ifNode = YAML::Load(ifConditions);
+
+  auto commandArguments = singleOrListNodeToCommandArguments(ifNode);
+
+  auto mockGridPtr = mockGrid();
+  auto objectPtr = setupObject("object", {}, mockGridPtr);
+
+  auto mockActionPtr = setupAction(ACTION, objectPtr, objectPtr);
+
+  auto srcResult = addCommandsAndExecute(ActionBehaviourType::SOURCE, mockActionPtr, "if", commandArguments, {}, objectPtr, objectPtr);
+
+  verifyCommandResult(srcResult, false, {{1, 6}});
+
+  verifyMocks(mockActionPtr, mockGridPtr);
+}
+
 TEST(ObjectTest, isValidAction) {
   auto srcObjectName = "srcObject";
   std::string dstObjectName = "dstObject";
@@ -1882,6 +1935,43 @@ TEST(ObjectTest, multipleBehaviourPreconditionsSameObject) {
   ASSERT_THAT(behaviourIdxs, UnorderedElementsAre(1));
 }
 
+TEST(ObjectTest, isValidActionSharesSourceOnlyPreconditions) {
+  auto srcObjectName = "srcObject";
+  std::string dstObjectName = "dstObject";
+  std::string actionName = ACTION;
+  std::string dstActionName = "dst_action";
+  auto srcObject = std::make_shared<Object>(Object(srcObjectName, 'S', 0, 0, {{"counter", _V(5)}}, nullptr, std::weak_ptr<Grid>()));
+  auto dstObject1 = std::make_shared<Object>(Object(dstObjectName, 'D', 0, 0, {{"counter", _V(1)}}, nullptr, std::weak_ptr<Grid>()));
+  auto dstObject2 = std::make_shared<Object>(Object(dstObjectName, 'D', 0, 0, {{"counter", _V(2)}}, nullptr, std::weak_ptr<Grid>()));
+
+  auto sourcePreconditionsNode = YAML::Load("- eq: [counter, 5]");
+  auto dstPreconditionsNode = YAML::Load("- eq: [dst.counter, 2]");
+
+  srcObject->addPrecondition(actionName, 0, dstObjectName, sourcePreconditionsNode);
+  srcObject->addActionSrcBehaviour(actionName, 0, dstObjectName, NOP, {}, {});
+  srcObject->addPrecondition(dstActionName, 0, dstObjectName, dstPreconditionsNode);
+  srcObject->addActionSrcBehaviour(dstActionName, 0, dstObjectName, NOP, {}, {});
+
+  auto mockActionPtr1 = setupAction(actionName, srcObject, dstObject1);
+  auto mockActionPtr2 = setupAction(actionName, srcObject, dstObject2);
+  auto mockDstActionPtr1 = setupAction(dstActionName, srcObject, dstObject1);
+  auto mockDstActionPtr2 = setupAction(dstActionName, srcObject, dstObject2);
+
+  PreconditionCache preconditionCache;
+  ASSERT_TRUE(srcObject->isValidAction(mockActionPtr1, preconditionCache));
+
+  // The precondition only reads the source object, so the cached result is used for the second action
+  *srcObject->getVariableValue("counter") = 4;
+  ASSERT_TRUE(srcObject->isValidAction(mockActionPtr2, preconditionCache));
+  ASSERT_FALSE(srcObject->isValidAction(mockActionPtr2));
+
+  // Preconditions that read the destination are evaluated for every action
+  ASSERT_FALSE(srcObject->isValidAction(mockDstActionPtr1, preconditionCache));
+  ASSERT_TRUE(srcObject->isValidAction(mockDstActionPtr2, preconditionCache));
+
+  ASSERT_EQ(preconditionCache.entries.size(), 2);
+}
+
 TEST(ObjectTest, isValidActionNotDefinedForAction) {
   auto srcObjectName = "srcObject";
   std::string dstObjectName = "dstObject";
@@ -1987,6 +2077,7 @@ TEST(ObjectTest, getInitialActions) {
           0,
           false,
           1.0,
+          SymbolTable::actionNames().intern("action1Name"),
       },
       {
           "action2Name",
@@ -1994,6 +2085,7 @@ TEST(ObjectTest, getInitialActions) {
           0,
           true,
           1.0,
+          SymbolTable::actionNames().intern("action2Name"),
       }};
 
   std::unordered_map<std::string, ActionInputsDefinition> mockActionInputDefinitions = {
@@ -2003,7 +2095,7 @@ TEST(ObjectTest, getInitialActions) {
        {{{2, {{2, 2}, {2, 2}, "description2"}}}}}};
 
   EXPECT_CALL(*mockObjectGenerator, getActionInputDefinitions()).WillRepeatedly(ReturnRefOfCopy(mockActionInputDefinitions));
-  EXPECT_CALL(*mockGridPtr, getRandomGenerator()).WillRepeatedly(Return(std::mt19937()));
+  EXPECT_CALL(*mockGridPtr, getRandomGenerator()).WillRepeatedly(Return(std::make_shared<RandomGenerator>()));
 
   auto object = std::make_shared<Object>(Object(objectName, 'S', 0, 0, {}, mockObjectGenerator, mockGridPtr));
 
@@ -2047,7 +2139,7 @@ TEST(ObjectTest, getInitialActionsWithOriginatingAction) {
       .WillRepeatedly(Return(glm::ivec2{1, 5}));
 
   EXPECT_CALL(*mockActionPtr, getMetaData())
-      .WillRepeatedly(ReturnRefOfCopy(std::unordered_map<std::string, int32_t>{}));
+      .WillRepeatedly(ReturnRefOfCopy(ActionMetaData{}));
 
   EXPECT_CALL(*mockActionPtr, getMetaData(_))
       .WillRepeatedly(Return(0));
@@ -2059,6 +2151,7 @@ TEST(ObjectTest, getInitialActionsWithOriginatingAction) {
           0,
           false,
           1.0,
+          SymbolTable::actionNames().intern("action1Name"),
       },
       {
           "action2Name",
@@ -2066,6 +2159,7 @@ TEST(ObjectTest, getInitialActionsWithOriginatingAction) {
           0,
           true,
           1.0,
+          SymbolTable::actionNames().intern("action2Name"),
       }};
 
   std::unordered_map<std::string, ActionInputsDefinition> mockActionInputDefinitions = {
@@ -2075,7 +2169,7 @@ TEST(ObjectTest, getInitialActionsWithOriginatingAction) {
        {{{2, {{2, 2}, {2, 2}, "description2"}}}}}};
 
   EXPECT_CALL(*mockObjectGenerator, getActionInputDefinitions()).WillRepeatedly(ReturnRefOfCopy(mockActionInputDefinitions));
-  EXPECT_CALL(*mockGridPtr, getRandomGenerator()).WillRepeatedly(Return(std::mt19937()));
+  EXPECT_CALL(*mockGridPtr, getRandomGenerator()).WillRepeatedly(Return(std::make_shared<RandomGenerator>()));
 
   auto object = std::make_shared<Object>(Object(objectName, 'S', 0, 0, {}, mockObjectGenerator, mockGridPtr));
 
@@ -0,0 +1,35 @@
+#include "Griddly/Core/GDY/SymbolTable.cpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace griddly {
+
+TEST(SymbolTableTest, defaultObjectIds) {
+  ASSERT_EQ(SymbolTable::objectNames().intern("_empty"), EMPTY_OBJECT_ID);
+  ASSERT_EQ(SymbolTable::objectNames().intern("_boundary"), BOUNDARY_OBJECT_ID);
+  ASSERT_EQ(SymbolTable::objectNames().getName(EMPTY_OBJECT_ID), "_empty");
+  ASSERT_EQ(SymbolTable::objectNames().getName(BOUNDARY_OBJECT_ID), "_boundary");
+}
+
+TEST(SymbolTableTest, intern) {
+  auto& actionNames = SymbolTable::actionNames();
+
+  auto firstId = actionNames.intern("symbolTableTestFirst");
+  auto secondId = actionNames.intern("symbolTableTestSecond");
+
+  ASSERT_NE(firstId, secondId);
+  ASSERT_EQ(actionNames.intern("symbolTableTestFirst"), firstId);
+  ASSERT_EQ(actionNames.getName(secondId), "symbolTableTestSecond");
+  ASSERT_GT(actionNames.size(), secondId);
+
+  uint32_t foundId;
+  ASSERT_TRUE(actionNames.find("symbolTableTestSecond", foundId));
+  ASSERT_EQ(foundId, secondId);
+  ASSERT_FALSE(actionNames.find("symbolTableTestMissing", foundId));
+}
+
+TEST(SymbolTableTest, getUnknownId) {
+  ASSERT_THROW(SymbolTable::actionNames().getName(UINT32_MAX), std::invalid_argument);
+}
+
+}  // namespace griddly
@@ -20,6 +20,7 @@ using ::testing::AnyNumber;
 using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
 using ::testing::Eq;
+using ::testing::Invoke;
 using ::testing::Mock;
 using ::testing::Return;
 using ::testing::ReturnRef;
@@ -306,6 +307,8 @@ TEST(GameProcessTest, reset) {
 
   EXPECT_CALL(*mockGDYFactoryPtr, getGlobalVariableDefinitions())
       .WillRepeatedly(Return(std::unordered_map<std::string, GlobalVariableDefinition>{}));
+  EXPECT_CALL(*mockGDYFactoryPtr, getObjectGenerator())
+      .WillRepeatedly(Return(std::make_shared<ObjectGenerator>()));
 
   EXPECT_CALL(*mockGDYFactoryPtr, createObserver(Eq(mockGridPtr), Eq("VECTOR"), Eq(1), Eq(0)))
       .Times(1)
@@ -340,6 +343,150 @@ TEST(GameProcessTest, reset) {
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockPlayerAvatarPtr.get()));
 }
 
+std::shared_ptr<MockGDYFactory> levelSnapshotGDYFactory(std::shared_ptr<MockLevelGenerator> mockLevelGeneratorPtr, std::shared_ptr<ObjectGenerator> objectGeneratorPtr, std::shared_ptr<Grid> gridPtr) {
+  auto mockGDYFactoryPtr = std::make_shared<MockGDYFactory>();
+  auto mockObserverPtr = std::shared_ptr<MockObserver<>>(new MockObserver<>(gridPtr));
+
+  EXPECT_CALL(*mockGDYFactoryPtr, getObjectGenerator()).WillRepeatedly(Return(objectGeneratorPtr));
+  EXPECT_CALL(*mockGDYFactoryPtr, getLevelGenerator(Eq(0)))
+      .WillRepeatedly(Return(mockLevelGeneratorPtr));
+  EXPECT_CALL(*mockGDYFactoryPtr, getGlobalVariableDefinitions())
+      .WillRepeatedly(Return(std::unordered_map<std::string, GlobalVariableDefinition>{}));
+  EXPECT_CALL(*mockGDYFactoryPtr, createObserver(Eq(gridPtr), Eq("VECTOR"), Eq(1), Eq(0)))
+      .WillOnce(Return(mockObserverPtr));
+  EXPECT_CALL(*mockGDYFactoryPtr, getPlayerCount())
+      .WillRepeatedly(Return(1));
+  EXPECT_CALL(*mockGDYFactoryPtr, createTerminationHandler)
+      .WillRepeatedly(Return(nullptr));
+
+  return mockGDYFactoryPtr;
+}
+
+TEST(GameProcessTest, resetFromLevelSnapshot) {
+  auto mockGridPtr = std::make_shared<MockGrid>();
+  auto mockLevelGeneratorPtr = std::make_shared<MockLevelGenerator>();
+  auto objectGeneratorPtr = std::make_shared<ObjectGenerator>();
+  objectGeneratorPtr->defineNewObject("object1", 'a', 0, {});
+  objectGeneratorPtr->addInitialAction("object1", "spin", 1, 0);
+
+  auto mockGDYFactoryPtr = levelSnapshotGDYFactory(mockLevelGeneratorPtr, objectGeneratorPtr, mockGridPtr);
+  auto gameProcessPtr = std::make_shared<TurnBasedGameProcess>("VECTOR", mockGDYFactoryPtr, mockGridPtr);
+  auto mockPlayerObserverPtr = std::shared_ptr<MockObserver<>>(new MockObserver<>(mockGridPtr));
+
+  auto levelSnapshot = std::make_shared<GridSnapshot>();
+
+  // The level and global variables are only generated once, after that they are restored from the snapshot
+  EXPECT_CALL(*mockLevelGeneratorPtr, reset(Eq(mockGridPtr)))
+      .Times(1);
+  EXPECT_CALL(*mockGridPtr, resetGlobalVariables(_))
+      .Times(1);
+  EXPECT_CALL(*mockGridPtr, takeSnapshot())
+      .WillOnce(Return(levelSnapshot));
+  EXPECT_CALL(*mockGridPtr, restoreSnapshot(::testing::Ref(*levelSnapshot)))
+      .Times(2);
+  EXPECT_CALL(*mockGridPtr, getPlayerAvatarObjects())
+      .WillRepeatedly(Return(std::unordered_map<uint32_t, std::shared_ptr<Object>>{}));
+
+  auto mockPlayerPtr = mockPlayer("Bob", 1, gameProcessPtr, nullptr, mockPlayerObserverPtr);
+
+  gameProcessPtr->addPlayer(mockPlayerPtr);
+
+  gameProcessPtr->init();
+  gameProcessPtr->reset();
+  gameProcessPtr->reset();
+  gameProcessPtr->reset();
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockGridPtr.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockLevelGeneratorPtr.get()));
+}
+
+TEST(GameProcessTest, resetFromLevelSnapshotAdvancesRandomGenerator) {
+  auto mockGridPtr = std::make_shared<MockGrid>();
+  auto mockLevelGeneratorPtr = std::make_shared<MockLevelGenerator>();
+  auto objectGeneratorPtr = std::make_shared<ObjectGenerator>();
+  objectGeneratorPtr->defineNewObject("object1", 'a', 0, {});
+  objectGeneratorPtr->addInitialAction("object1", "spin", 1, 0);
+
+  auto mockGDYFactoryPtr = levelSnapshotGDYFactory(mockLevelGeneratorPtr, objectGeneratorPtr, mockGridPtr);
+  auto gameProcessPtr = std::make_shared<TurnBasedGameProcess>("VECTOR", mockGDYFactoryPtr, mockGridPtr);
+  auto mockPlayerObserverPtr = std::shared_ptr<MockObserver<>>(new MockObserver<>(mockGridPtr));
+
+  auto randomGenerator = std::make_shared<RandomGenerator>();
+  auto levelSnapshot = std::make_shared<GridSnapshot>();
+
+  // Generating the level draws two values, restoring the snapshot has to draw the same number
+  EXPECT_CALL(*mockLevelGeneratorPtr, reset(Eq(mockGridPtr)))
+      .WillOnce(Invoke([randomGenerator](const std::shared_ptr<Grid>&) {
+        randomGenerator->getEngine()();
+        randomGenerator->getEngine()();
+      }));
+  EXPECT_CALL(*mockGridPtr, getRandomGenerator())
+      .WillRepeatedly(Return(randomGenerator));
+  EXPECT_CALL(*mockGridPtr, takeSnapshot())
+      .WillOnce(Return(levelSnapshot));
+  EXPECT_CALL(*mockGridPtr, restoreSnapshot(::testing::Ref(*levelSnapshot)))
+      .Times(2);
+  EXPECT_CALL(*mockGridPtr, getPlayerAvatarObjects())
+      .WillRepeatedly(Return(std::unordered_map<uint32_t, std::shared_ptr<Object>>{}));
+
+  auto mockPlayerPtr = mockPlayer("Bob", 1, gameProcessPtr, nullptr, mockPlayerObserverPtr);
+
+  gameProcessPtr->addPlayer(mockPlayerPtr);
+
+  std::mt19937 expectedEngine = randomGenerator->getEngine();
+
+  gameProcessPtr->init();
+  expectedEngine.discard(2);
+  ASSERT_EQ(randomGenerator->getEngine(), expectedEngine);
+
+  gameProcessPtr->reset();
+  expectedEngine.discard(2);
+  ASSERT_EQ(randomGenerator->getEngine(), expectedEngine);
+
+  gameProcessPtr->reset();
+  expectedEngine.discard(2);
+  ASSERT_EQ(randomGenerator->getEngine(), expectedEngine);
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockGridPtr.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockLevelGeneratorPtr.get()));
+}
+
+TEST(GameProcessTest, resetRandomizedInitialActions) {
+  auto mockGridPtr = std::make_shared<MockGrid>();
+  auto mockLevelGeneratorPtr = std::make_shared<MockLevelGenerator>();
+  auto objectGeneratorPtr = std::make_shared<ObjectGenerator>();
+  objectGeneratorPtr->defineNewObject("object1", 'a', 0, {});
+  objectGeneratorPtr->addInitialAction("object1", "spin", 1, 0);
+  objectGeneratorPtr->addInitialAction("object1", "move", 0, 0, true);
+
+  auto mockGDYFactoryPtr = levelSnapshotGDYFactory(mockLevelGeneratorPtr, objectGeneratorPtr, mockGridPtr);
+  auto gameProcessPtr = std::make_shared<TurnBasedGameProcess>("VECTOR", mockGDYFactoryPtr, mockGridPtr);
+  auto mockPlayerObserverPtr = std::shared_ptr<MockObserver<>>(new MockObserver<>(mockGridPtr));
+
+  // Randomized initial actions can put the level in a different state every time, so it is regenerated
+  EXPECT_CALL(*mockLevelGeneratorPtr, reset(Eq(mockGridPtr)))
+      .Times(2);
+  EXPECT_CALL(*mockGridPtr, resetGlobalVariables(_))
+      .Times(2);
+  EXPECT_CALL(*mockGridPtr, takeSnapshot())
+      .Times(0);
+  EXPECT_CALL(*mockGridPtr, restoreSnapshot(_))
+      .Times(0);
+  EXPECT_CALL(*mockGridPtr, getPlayerAvatarObjects())
+      .WillRepeatedly(Return(std::unordered_map<uint32_t, std::shared_ptr<Object>>{}));
+
+  auto mockPlayerPtr = mockPlayer("Bob", 1, gameProcessPtr, nullptr, mockPlayerObserverPtr);
+
+  gameProcessPtr->addPlayer(mockPlayerPtr);
+
+  gameProcessPtr->init();
+  gameProcessPtr->reset();
+  gameProcessPtr->reset();
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockGridPtr.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockLevelGeneratorPtr.get()));
+}
+
 TEST(GameProcessTest, resetNotInitialized) {
   auto mockGridPtr = std::make_shared<MockGrid>();
   auto mockGDYFactoryPtr = std::make_shared<MockGDYFactory>();
@@ -445,6 +592,8 @@ TEST(GameProcessTest, performActions) {
       .WillRepeatedly(Return(mockTerminationHandlerPtr));
   EXPECT_CALL(*mockGDYFactoryPtr, getGlobalVariableDefinitions())
       .WillRepeatedly(Return(std::unordered_map<std::string, GlobalVariableDefinition>{}));
+  EXPECT_CALL(*mockGDYFactoryPtr, getObjectGenerator())
+      .WillRepeatedly(Return(std::make_shared<ObjectGenerator>()));
   EXPECT_CALL(*mockGDYFactoryPtr, createObserver(Eq(mockGridPtr), Eq("NONE"), Eq(1), Eq(0)))
       .WillOnce(Return(mockObserverPtr));
 
@@ -462,13 +611,13 @@ TEST(GameProcessTest, performActions) {
   auto actionsList = std::vector<std::shared_ptr<Action>>{mockActionPtr};
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(playerId), Eq(actionsList)))
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 14}}));
+      .WillOnce(Return(PlayerRewards{{1, 14}}));
 
   EXPECT_CALL(*mockTerminationHandlerPtr, isTerminated())
       .WillOnce(Return(TerminationResult{false, {}}));
 
   EXPECT_CALL(*mockGridPtr, update())
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{}));
+      .WillOnce(Return(PlayerRewards{}));
 
   auto result = gameProcessPtr->performActions(playerId, actionsList);
 
@@ -520,6 +669,8 @@ TEST(GameProcessTest, performActionsMultiAgentRewards) {
       .WillRepeatedly(Return(mockTerminationHandlerPtr));
   EXPECT_CALL(*mockGDYFactoryPtr, getGlobalVariableDefinitions())
       .WillRepeatedly(Return(std::unordered_map<std::string, GlobalVariableDefinition>{}));
+  EXPECT_CALL(*mockGDYFactoryPtr, getObjectGenerator())
+      .WillRepeatedly(Return(std::make_shared<ObjectGenerator>()));
   EXPECT_CALL(*mockGDYFactoryPtr, createObserver(Eq(mockGridPtr), Eq("NONE"), Eq(3), Eq(0)))
       .WillOnce(Return(mockObserverPtr));
 
@@ -541,29 +692,29 @@ TEST(GameProcessTest, performActionsMultiAgentRewards) {
   auto actionsList = std::vector<std::shared_ptr<Action>>{mockActionPtr};
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(player1Id), Eq(actionsList)))
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 5}}));
+      .WillOnce(Return(PlayerRewards{{1, 5}}));
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(player2Id), Eq(actionsList)))
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{3, 10}, {2, -5}}));
+      .WillOnce(Return(PlayerRewards{{3, 10}, {2, -5}}));
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(player3Id), Eq(actionsList)))
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{3, 5}}));
+      .WillOnce(Return(PlayerRewards{{3, 5}}));
 
   EXPECT_CALL(*mockTerminationHandlerPtr, isTerminated())
       .WillRepeatedly(Return(TerminationResult{false, {}}));
 
   EXPECT_CALL(*mockGridPtr, update())
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 5}}));
+      .WillOnce(Return(PlayerRewards{{1, 5}}));
 
   auto result1 = gameProcessPtr->performActions(player1Id, actionsList);
 
   EXPECT_CALL(*mockGridPtr, update())
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{}));
+      .WillOnce(Return(PlayerRewards{}));
 
   auto result2 = gameProcessPtr->performActions(player2Id, actionsList);
 
   EXPECT_CALL(*mockGridPtr, update())
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{}));
+      .WillOnce(Return(PlayerRewards{}));
 
   auto result3 = gameProcessPtr->performActions(player3Id, actionsList);
 
@@ -615,6 +766,8 @@ TEST(GameProcessTest, performActionsDelayedReward) {
       .WillRepeatedly(Return(mockTerminationHandlerPtr));
   EXPECT_CALL(*mockGDYFactoryPtr, getGlobalVariableDefinitions())
       .WillRepeatedly(Return(std::unordered_map<std::string, GlobalVariableDefinition>{}));
+  EXPECT_CALL(*mockGDYFactoryPtr, getObjectGenerator())
+      .WillRepeatedly(Return(std::make_shared<ObjectGenerator>()));
   EXPECT_CALL(*mockGDYFactoryPtr, createObserver(Eq(mockGridPtr), Eq("NONE"), Eq(1), Eq(0)))
       .WillOnce(Return(mockObserverPtr));
 
@@ -632,13 +785,13 @@ TEST(GameProcessTest, performActionsDelayedReward) {
   std::vector<std::shared_ptr<Action>> actionList{mockActionPtr};
 
   EXPECT_CALL(*mockGridPtr, performActions(Eq(1), Eq(actionList)))
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 14}, {2, 3}}));
+      .WillOnce(Return(PlayerRewards{{1, 14}, {2, 3}}));
 
   EXPECT_CALL(*mockTerminationHandlerPtr, isTerminated)
       .WillOnce(Return(TerminationResult{false, {}}));
 
   EXPECT_CALL(*mockGridPtr, update())
-      .WillOnce(Return(std::unordered_map<uint32_t, int32_t>{{1, 5}, {5, 3}}));
+      .WillOnce(Return(PlayerRewards{{1, 5}, {5, 3}}));
 
   auto result = gameProcessPtr->performActions(1, actionList);
 
@@ -786,6 +939,66 @@ TEST(GameProcessTest, getAvailableIdsForActionType) {
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockGDYFactoryPtr.get()));
 }
 
+TEST(GameProcessTest, writeActionMask) {
+  auto mockGridPtr = std::make_shared<MockGrid>();
+
+  auto mockObject1 = mockObject("object", 'o', 1, 0, {0, 1}, DiscreteOrientation(), {"move", "attack"});
+  auto mockObject2 = mockObject("object", 'o', 1, 0, {2, 0}, DiscreteOrientation(), {"move", "attack"});
+  auto mockObject3 = mockObject("object", 'o', 2, 0, {1, 1}, DiscreteOrientation(), {"move", "attack"});
+
+  auto objects = std::unordered_set<std::shared_ptr<Object>>{mockObject1, mockObject2, mockObject3};
+
+  EXPECT_CALL(*mockGridPtr, getObjects()).WillRepeatedly(ReturnRef(objects));
+  EXPECT_CALL(*mockGridPtr, getWidth()).WillRepeatedly(Return(3));
+  EXPECT_CALL(*mockGridPtr, getHeight()).WillRepeatedly(Return(2));
+
+  auto mockGDYFactoryPtr = std::make_shared<MockGDYFactory>();
+
+  std::unordered_map<std::string, ActionInputsDefinition> mockActionInputsDefinitions = {
+      {"move",
+       {{{1, {{0, 1}, {0, 0}, "First Action"}},
+         {2, {{0, 2}, {0, 0}, "Second Action"}}},
+        false,
+        false}},
+      {"attack",
+       {{{1, {{1, 0}, {0, 0}, "First Action"}},
+         {2, {{2, 0}, {0, 0}, "Second Action"}},
+         {3, {{3, 0}, {0, 0}, "Third Action"}}},
+        false,
+        false}}};
+
+  EXPECT_CALL(*mockGDYFactoryPtr, getActionInputsDefinitions).WillRepeatedly(Return(mockActionInputsDefinitions));
+  EXPECT_CALL(*mockGDYFactoryPtr, getExternalActionNames).WillRepeatedly(Return(std::vector<std::string>{"move", "attack"}));
+  EXPECT_CALL(*mockGDYFactoryPtr, getAvatarObject).WillRepeatedly(Return(""));
+
+  EXPECT_CALL(*mockObject1, isValidAction(_, _)).WillRepeatedly(Return(false));
+  EXPECT_CALL(*mockObject1, isValidAction(ActionAndVectorEqMatcher("move", glm::ivec2{0, 1}), _)).WillOnce(Return(true));
+  EXPECT_CALL(*mockObject2, isValidAction(_, _)).WillRepeatedly(Return(false));
+  EXPECT_CALL(*mockObject2, isValidAction(ActionAndVectorEqMatcher("attack", glm::ivec2{3, 0}), _)).WillOnce(Return(true));
+  EXPECT_CALL(*mockObject3, isValidAction(_, _)).Times(0);
+
+  auto gameProcessPtr = std::make_shared<TurnBasedGameProcess>("NONE", mockGDYFactoryPtr, mockGridPtr);
+
+  auto maskShape = gameProcessPtr->getActionMaskShape();
+  ASSERT_THAT(maskShape, ElementsAre(6, 2, 4));
+
+  std::vector<uint8_t> mask(6 * 2 * 4, 1);
+  gameProcessPtr->writeActionMask(1, mask.data());
+
+  // Units are indexed by x * height + y
+  std::vector<uint8_t> expectedMask(6 * 2 * 4, 0);
+  expectedMask[(0 * 2 + 1) * 8 + 0] = 1;
+  expectedMask[(0 * 2 + 1) * 8 + 1] = 1;
+  expectedMask[(2 * 2 + 0) * 8 + 4] = 1;
+  expectedMask[(2 * 2 + 0) * 8 + 4 + 3] = 1;
+
+  ASSERT_THAT(mask, ElementsAreArray(expectedMask));
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObject1.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObject2.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObject3.get()));
+}
+
 TEST(GameProcessTest, getState) {
   auto mockGridPtr = std::make_shared<MockGrid>();
 
@@ -3,6 +3,7 @@
 #include <unordered_map>
 
 #include "Griddly/Core/Grid.cpp"
+#include "Griddly/Core/OccupancyGridCollisionDetector.hpp"
 #include "Griddly/Core/TestUtils/common.hpp"
 #include "Mocks/Griddly/Core/MockCollisionDetector.hpp"
 #include "Mocks/Griddly/Core/MockCollisionDetectorFactory.hpp"
@@ -10,12 +11,14 @@
 #include "gtest/gtest.h"
 
 using ::testing::_;
-using ::testing::ContainerEq;
+using ::testing::DoAll;
 using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
 using ::testing::Eq;
 using ::testing::Mock;
 using ::testing::Return;
+using ::testing::SaveArg;
+using ::testing::SetArgReferee;
 using ::testing::UnorderedElementsAre;
 
 namespace griddly {
@@ -162,6 +165,20 @@ TEST(GridTest, initializeObjectTwice) {
   ASSERT_EQ(grid->getObjects().size(), 1);
 }
 
+TEST(GridTest, addObjectOutsideGrid) {
+  auto grid = std::make_shared<Grid>();
+  grid->resetMap(5, 5);
+
+  auto mockObjectPtr = mockObject("object");
+  grid->initObject("object", {});
+
+  ASSERT_THROW(grid->addObject({5, 2}, mockObjectPtr), std::invalid_argument);
+  ASSERT_THROW(grid->addObject({-1, 2}, mockObjectPtr), std::invalid_argument);
+
+  ASSERT_EQ(grid->getObjects().size(), 0);
+  ASSERT_EQ(grid->getUpdatedLocations(1).size(), 0);
+}
+
 TEST(GridTest, removeObject) {
   auto grid = std::make_shared<Grid>();
   grid->resetMap(123, 456);
@@ -212,7 +229,7 @@ TEST(GridTest, performActionDefaultObject) {
 
   auto reward = grid->performActions(1, actions);
 
-  ASSERT_THAT(reward, ContainerEq(std::unordered_map<uint32_t, int32_t>{}));
+  ASSERT_THAT(reward, Eq(PlayerRewards{}));
 
   GridEvent gridEvent;
   gridEvent.actionName = "action";
@@ -246,7 +263,7 @@ TEST(GridTest, performActionOnEmptySpace) {
 
   auto reward = grid->performActions(1, actions);
 
-  ASSERT_THAT(reward, ContainerEq(std::unordered_map<uint32_t, int32_t>{}));
+  ASSERT_THAT(reward, Eq(PlayerRewards{}));
 
   GridEvent gridEvent;
   gridEvent.actionName = "action";
@@ -296,7 +313,7 @@ TEST(GridTest, performActionOnObjectWithNeutralPlayerId) {
 
   auto reward = grid->performActions(playerId, actions);
 
-  ASSERT_THAT(reward, ContainerEq(std::unordered_map<uint32_t, int32_t>{}));
+  ASSERT_THAT(reward, Eq(PlayerRewards{}));
 
   GridEvent gridEvent;
   gridEvent.actionName = "action";
@@ -340,7 +357,7 @@ TEST(GridTest, performActionOnObjectWithDifferentPlayerId) {
 
   auto reward = grid->performActions(playerId, actions);
 
-  ASSERT_THAT(reward, ContainerEq(std::unordered_map<uint32_t, int32_t>{}));
+  ASSERT_THAT(reward, Eq(PlayerRewards{}));
 
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockSourceObjectPtr.get()));
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockActionPtr.get()));
@@ -370,7 +387,7 @@ TEST(GridTest, performActionDestinationObjectEmpty) {
 
   auto mockActionPtr = mockAction("action", mockSourceObjectPtr, actionDestinationLocation);
 
-  EXPECT_CALL(*mockSourceObjectPtr, onActionSrc(Eq("_empty"), Eq(mockActionPtr), UnorderedElementsAre(0)))
+  EXPECT_CALL(*mockSourceObjectPtr, onActionSrc(Eq(EMPTY_OBJECT_ID), Eq(mockActionPtr), UnorderedElementsAre(0)))
       .Times(1)
       .WillOnce(Return(BehaviourResult{false, {{3, 5}}}));
 
@@ -382,7 +399,7 @@ TEST(GridTest, performActionDestinationObjectEmpty) {
 
   auto reward = grid->performActions(playerId, actions);
 
-  ASSERT_THAT(reward, ContainerEq(std::unordered_map<uint32_t, int32_t>{{3, 5}}));
+  ASSERT_THAT(reward, Eq(PlayerRewards{{3, 5}}));
 
   GridEvent gridEvent;
   gridEvent.actionName = "action";
@@ -426,7 +443,7 @@ TEST(GridTest, performActionDestinationObjectOutsideGrid) {
 
   auto mockActionPtr = mockAction("action", mockSourceObjectPtr, actionDestinationLocation, true);
 
-  EXPECT_CALL(*mockSourceObjectPtr, onActionSrc(Eq("_boundary"), Eq(mockActionPtr), UnorderedElementsAre(0)))
+  EXPECT_CALL(*mockSourceObjectPtr, onActionSrc(Eq(BOUNDARY_OBJECT_ID), Eq(mockActionPtr), UnorderedElementsAre(0)))
       .Times(1)
       .WillOnce(Return(BehaviourResult{false, {{3, 5}}}));
 
@@ -438,7 +455,7 @@ TEST(GridTest, performActionDestinationObjectOutsideGrid) {
 
   auto reward = grid->performActions(playerId, actions);
 
-  ASSERT_THAT(reward, ContainerEq(std::unordered_map<uint32_t, int32_t>{{3, 5}}));
+  ASSERT_THAT(reward, Eq(PlayerRewards{{3, 5}}));
 
   GridEvent gridEvent;
   gridEvent.actionName = "action";
@@ -503,7 +520,7 @@ TEST(GridTest, performActionCannotBePerformedOnDestinationObject) {
 
   auto reward = grid->performActions(playerId, actions);
 
-  ASSERT_THAT(reward, ContainerEq(std::unordered_map<uint32_t, int32_t>{}));
+  ASSERT_THAT(reward, Eq(PlayerRewards{}));
 
   GridEvent gridEvent;
   gridEvent.actionName = "action";
@@ -561,7 +578,7 @@ TEST(GridTest, performActionCanBePerformedOnDestinationObject) {
       .Times(1)
       .WillOnce(Return(BehaviourResult{false, {{2, 5}}}));
 
-  EXPECT_CALL(*mockSourceObjectPtr, onActionSrc(Eq("dstObject"), Eq(mockActionPtr), UnorderedElementsAre(0)))
+  EXPECT_CALL(*mockSourceObjectPtr, onActionSrc(Eq(SymbolTable::objectNames().intern("dstObject")), Eq(mockActionPtr), UnorderedElementsAre(0)))
       .Times(1)
       .WillOnce(Return(BehaviourResult{false, {{4, 5}}}));
 
@@ -569,7 +586,7 @@ TEST(GridTest, performActionCanBePerformedOnDestinationObject) {
 
   auto reward = grid->performActions(playerId, actions);
 
-  ASSERT_THAT(reward, ContainerEq(std::unordered_map<uint32_t, int32_t>{{2, 5}, {4, 5}}));
+  ASSERT_THAT(reward, Eq(PlayerRewards{{2, 5}, {4, 5}}));
 
   GridEvent gridEvent;
   gridEvent.actionName = "action";
@@ -629,7 +646,7 @@ TEST(GridTest, performActionDelayed) {
       .Times(1)
       .WillOnce(Return(BehaviourResult{false, {{playerId, 5}}}));
 
-  EXPECT_CALL(*mockSourceObjectPtr, onActionSrc(Eq("dstObject"), Eq(mockActionPtr), UnorderedElementsAre(0)))
+  EXPECT_CALL(*mockSourceObjectPtr, onActionSrc(Eq(SymbolTable::objectNames().intern("dstObject")), Eq(mockActionPtr), UnorderedElementsAre(0)))
       .Times(1)
       .WillOnce(Return(BehaviourResult{false, {{playerId, 6}}}));
 
@@ -651,7 +668,7 @@ TEST(GridTest, performActionDelayed) {
   auto delayedRewards = grid->update();
   ASSERT_EQ(delayedRewards.size(), 1);
 
-  std::unordered_map<uint32_t, int32_t> expectedRewards{{playerId, 11}};
+  PlayerRewards expectedRewards{{playerId, 11}};
   ASSERT_EQ(delayedRewards, expectedRewards);
 
   GridEvent gridEvent;
@@ -673,6 +690,52 @@ TEST(GridTest, performActionDelayed) {
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockActionPtr.get()));
 }
 
+TEST(GridTest, removeObjectCancelsDelayedActions) {
+  auto grid = std::make_shared<Grid>();
+  grid->setPlayerCount(1);
+  grid->resetMap(10, 10);
+
+  auto mockSourceObjectPtr = mockObject("srcObject", 'S', 1, 0, {0, 0});
+  auto mockDestinationObjectPtr = mockObject("dstObject", 'D', 1, 0, {0, 1});
+  grid->initObject("srcObject", {});
+  grid->initObject("dstObject", {});
+  grid->addObject({0, 0}, mockSourceObjectPtr);
+  grid->addObject({0, 1}, mockDestinationObjectPtr);
+
+  auto mockActionPtr = mockAction("action", mockSourceObjectPtr, mockDestinationObjectPtr);
+  EXPECT_CALL(*mockActionPtr, hasSourceObject()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mockActionPtr, getDelay()).WillRepeatedly(Return(10));
+  EXPECT_CALL(*mockSourceObjectPtr, getValidBehaviourIdxs).Times(0);
+
+  grid->performActions(1, {mockActionPtr});
+  ASSERT_EQ(grid->getDelayedActions().size(), 1);
+
+  // The queue no longer holds the action once its source object is removed
+  auto actionUseCount = mockActionPtr.use_count();
+  grid->removeObject(mockSourceObjectPtr);
+  ASSERT_EQ(grid->getDelayedActions().size(), 0);
+  ASSERT_EQ(mockActionPtr.use_count(), actionUseCount - 1);
+
+  // Rolling back the removal restores the action
+  grid->addObject({0, 0}, mockSourceObjectPtr);
+  grid->performActions(1, {mockActionPtr});
+  grid->enableJournal(true);
+  auto checkpoint = grid->checkpoint();
+
+  grid->removeObject(mockSourceObjectPtr);
+  ASSERT_EQ(grid->getDelayedActions().size(), 0);
+
+  grid->rollback(checkpoint);
+  ASSERT_EQ(grid->getDelayedActions().size(), 1);
+
+  grid->removeObject(mockSourceObjectPtr);
+  for (int i = 0; i < 10; i++) {
+    grid->update();
+  }
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockSourceObjectPtr.get()));
+}
+
 TEST(GridTest, objectCounters) {
   auto grid = std::make_shared<Grid>();
   grid->setPlayerCount(10);
@@ -851,9 +914,9 @@ TEST(GridTest, updateLocationWithCollisionDetection) {
 
   ASSERT_EQ(grid->getObjects().size(), 0);
 
-  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr1))).Times(1);
-  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr2))).Times(1);
-  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr3))).Times(1);
+  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr1), _)).Times(1);
+  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr2), _)).Times(1);
+  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr3), _)).Times(1);
 
   grid->addObject({1, 1}, mockObjectPtr1);
   grid->addObject({2, 2}, mockObjectPtr2);
@@ -861,9 +924,9 @@ TEST(GridTest, updateLocationWithCollisionDetection) {
 
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockCollisionDetectorPtr1.get()));
 
-  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr1))).Times(1);
-  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr2))).Times(1);
-  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr3))).Times(1);
+  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr1), Eq(glm::ivec2{11, 11}))).Times(1);
+  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr2), Eq(glm::ivec2{12, 12}))).Times(1);
+  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr3), Eq(glm::ivec2{13, 13}))).Times(1);
 
   grid->updateLocation(mockObjectPtr1, {1, 1}, {11, 11});
   grid->updateLocation(mockObjectPtr2, {2, 2}, {12, 12});
@@ -898,9 +961,9 @@ TEST(GridTest, removeObjectWithCollisionDetection) {
 
   ASSERT_EQ(grid->getObjects().size(), 0);
 
-  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr1))).Times(1);
-  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr2))).Times(1);
-  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr3))).Times(1);
+  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr1), _)).Times(1);
+  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr2), _)).Times(1);
+  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr3), _)).Times(1);
 
   grid->addObject({1, 1}, mockObjectPtr1);
   grid->addObject({2, 2}, mockObjectPtr2);
@@ -960,14 +1023,14 @@ TEST(GridTest, performActionTriggeredByCollision) {
   EXPECT_CALL(*mockObjectPtr2, onActionDst).Times(2).WillRepeatedly(Return(BehaviourResult{false, {{2, 2}}}));
   EXPECT_CALL(*mockObjectPtr3, onActionDst).Times(2).WillRepeatedly(Return(BehaviourResult{false, {{3, 3}}}));
 
-  EXPECT_CALL(*mockObjectPtr1, onActionSrc(Eq("object_2"), _, _)).Times(1).WillOnce(Return(BehaviourResult{false, {{1, 1}}}));
-  EXPECT_CALL(*mockObjectPtr1, onActionSrc(Eq("object_3"), _, _)).Times(1).WillOnce(Return(BehaviourResult{false, {{1, 1}}}));
+  EXPECT_CALL(*mockObjectPtr1, onActionSrc(Eq(SymbolTable::objectNames().intern("object_2")), _, _)).Times(1).WillOnce(Return(BehaviourResult{false, {{1, 1}}}));
+  EXPECT_CALL(*mockObjectPtr1, onActionSrc(Eq(SymbolTable::objectNames().intern("object_3")), _, _)).Times(1).WillOnce(Return(BehaviourResult{false, {{1, 1}}}));
 
-  EXPECT_CALL(*mockObjectPtr2, onActionSrc(Eq("object_1"), _, _)).Times(1).WillOnce(Return(BehaviourResult{false, {{2, 2}}}));
-  EXPECT_CALL(*mockObjectPtr2, onActionSrc(Eq("object_3"), _, _)).Times(1).WillOnce(Return(BehaviourResult{false, {{2, 2}}}));
+  EXPECT_CALL(*mockObjectPtr2, onActionSrc(Eq(SymbolTable::objectNames().intern("object_1")), _, _)).Times(1).WillOnce(Return(BehaviourResult{false, {{2, 2}}}));
+  EXPECT_CALL(*mockObjectPtr2, onActionSrc(Eq(SymbolTable::objectNames().intern("object_3")), _, _)).Times(1).WillOnce(Return(BehaviourResult{false, {{2, 2}}}));
 
-  EXPECT_CALL(*mockObjectPtr3, onActionSrc(Eq("object_2"), _, _)).Times(1).WillOnce(Return(BehaviourResult{false, {{3, 3}}}));
-  EXPECT_CALL(*mockObjectPtr3, onActionSrc(Eq("object_1"), _, _)).Times(1).WillOnce(Return(BehaviourResult{false, {{3, 3}}}));
+  EXPECT_CALL(*mockObjectPtr3, onActionSrc(Eq(SymbolTable::objectNames().intern("object_2")), _, _)).Times(1).WillOnce(Return(BehaviourResult{false, {{3, 3}}}));
+  EXPECT_CALL(*mockObjectPtr3, onActionSrc(Eq(SymbolTable::objectNames().intern("object_1")), _, _)).Times(1).WillOnce(Return(BehaviourResult{false, {{3, 3}}}));
 
   grid->initObject("object_1", {});
   grid->initObject("object_2", {});
@@ -977,14 +1040,14 @@ TEST(GridTest, performActionTriggeredByCollision) {
   grid->addObject({2, 2}, mockObjectPtr2);
   grid->addObject({3, 3}, mockObjectPtr3);
 
-  EXPECT_CALL(*mockCollisionDetectorPtr1, search(Eq(glm::ivec2{1, 1})))
-      .WillOnce(Return(SearchResult{{mockObjectPtr1, mockObjectPtr2, mockObjectPtr3}, {}}));
+  EXPECT_CALL(*mockCollisionDetectorPtr1, searchObjects(Eq(glm::ivec2{1, 1}), _))
+      .WillOnce(SetArgReferee<1>(std::vector<std::shared_ptr<Object>>{mockObjectPtr1, mockObjectPtr2, mockObjectPtr3}));
 
-  EXPECT_CALL(*mockCollisionDetectorPtr1, search(Eq(glm::ivec2{2, 2})))
-      .WillOnce(Return(SearchResult{{mockObjectPtr1, mockObjectPtr2, mockObjectPtr3}, {}}));
+  EXPECT_CALL(*mockCollisionDetectorPtr1, searchObjects(Eq(glm::ivec2{2, 2}), _))
+      .WillOnce(SetArgReferee<1>(std::vector<std::shared_ptr<Object>>{mockObjectPtr1, mockObjectPtr2, mockObjectPtr3}));
 
-  EXPECT_CALL(*mockCollisionDetectorPtr1, search(Eq(glm::ivec2{3, 3})))
-      .WillOnce(Return(SearchResult{{mockObjectPtr1, mockObjectPtr2, mockObjectPtr3}, {}}));
+  EXPECT_CALL(*mockCollisionDetectorPtr1, searchObjects(Eq(glm::ivec2{3, 3}), _))
+      .WillOnce(SetArgReferee<1>(std::vector<std::shared_ptr<Object>>{mockObjectPtr1, mockObjectPtr2, mockObjectPtr3}));
 
   auto rewards = grid->update();
 
@@ -994,6 +1057,205 @@ TEST(GridTest, performActionTriggeredByCollision) {
   ASSERT_EQ(rewards[3], 12);
 }
 
+TEST(GridTest, collisionsOnlySearchedAfterChanges) {
+  auto mockCollisionDetectorFactoryPtr = std::make_shared<MockCollisionDetectorFactory>();
+  auto mockCollisionDetectorPtr1 = std::make_shared<MockCollisionDetector>();
+
+  EXPECT_CALL(*mockCollisionDetectorFactoryPtr, newCollisionDetector)
+      .WillOnce(Return(mockCollisionDetectorPtr1));
+
+  auto grid = std::make_shared<Grid>(Grid(mockCollisionDetectorFactoryPtr));
+  grid->resetMap(123, 456);
+
+  std::string actionName1 = "collision_trigger_action";
+
+  grid->addActionTrigger(actionName1, {{"object_1"}, {"object_2"}, TriggerType::RANGE_BOX_AREA, 1});
+
+  std::unordered_map<std::string, std::vector<float>> behaviourProbabilities{
+      {actionName1, {1.0}}};
+  grid->setBehaviourProbabilities(behaviourProbabilities);
+
+  auto mockObjectPtr1 = mockObject("object_1", '?', 1, 0, {1, 1});
+  auto mockObjectPtr2 = mockObject("object_2", '?', 1, 0, {2, 2});
+  auto mockObjectPtr3 = mockObject("object_2", '?', 1, 0, {8, 8});
+
+  grid->initObject("object_1", {});
+  grid->initObject("object_2", {});
+
+  grid->addObject({1, 1}, mockObjectPtr1);
+  grid->addObject({2, 2}, mockObjectPtr2);
+  grid->addObject({8, 8}, mockObjectPtr3);
+
+  EXPECT_CALL(*mockObjectPtr1, getValidBehaviourIdxs).Times(3).WillRepeatedly(Return(std::vector<uint32_t>{0}));
+  EXPECT_CALL(*mockObjectPtr2, onActionDst).Times(3).WillRepeatedly(Return(BehaviourResult{}));
+  EXPECT_CALL(*mockObjectPtr1, onActionSrc).Times(3).WillRepeatedly(Return(BehaviourResult{}));
+
+  EXPECT_CALL(*mockCollisionDetectorPtr1, searchObjects(Eq(glm::ivec2{1, 1}), _))
+      .WillOnce(SetArgReferee<1>(std::vector<std::shared_ptr<Object>>{mockObjectPtr2}))
+      .WillOnce(Return());
+
+  grid->update();
+  grid->update();
+
+  // Objects that stay out of range do not affect the cached collisions
+  grid->updateLocation(mockObjectPtr3, {8, 8}, {9, 9});
+  grid->update();
+
+  // Removing a collided object means searching again
+  grid->removeObject(mockObjectPtr2);
+  grid->update();
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockCollisionDetectorPtr1.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectPtr1.get()));
+}
+
+std::shared_ptr<Grid> collisionCachingGrid(std::shared_ptr<MockCollisionDetector> mockCollisionDetectorPtr) {
+  auto mockCollisionDetectorFactoryPtr = std::make_shared<MockCollisionDetectorFactory>();
+
+  EXPECT_CALL(*mockCollisionDetectorFactoryPtr, newCollisionDetector)
+      .WillOnce(Return(mockCollisionDetectorPtr));
+
+  auto grid = std::make_shared<Grid>(mockCollisionDetectorFactoryPtr);
+  grid->resetMap(10, 10);
+  grid->setPlayerCount(1);
+  grid->initObject("source", {});
+  grid->initObject("target", {});
+
+  grid->addActionTrigger("collision_trigger_action", {{"source"}, {"target"}, TriggerType::RANGE_BOX_AREA, 1});
+
+  return grid;
+}
+
+std::shared_ptr<Object> collisionCachingObject(std::string objectName, std::shared_ptr<Grid> grid) {
+  return std::make_shared<Object>(objectName, 'A', 1, 0, std::unordered_map<std::string, std::shared_ptr<int32_t>>{}, nullptr, grid);
+}
+
+TEST(GridTest, collisionsSearchedAfterObjectMovesIntoRange) {
+  auto mockCollisionDetectorPtr = std::make_shared<MockCollisionDetector>();
+  auto grid = collisionCachingGrid(mockCollisionDetectorPtr);
+
+  auto source = collisionCachingObject("source", grid);
+  auto target = collisionCachingObject("target", grid);
+
+  grid->addObject({1, 1}, source, false);
+  grid->addObject({8, 8}, target, false);
+
+  EXPECT_CALL(*mockCollisionDetectorPtr, searchObjects(Eq(glm::ivec2{1, 1}), _)).Times(2);
+
+  grid->update();
+
+  ASSERT_TRUE(target->moveObject({2, 2}));
+  grid->update();
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockCollisionDetectorPtr.get()));
+}
+
+TEST(GridTest, collisionsSearchedAfterObjectMovesOutOfRange) {
+  auto mockCollisionDetectorPtr = std::make_shared<MockCollisionDetector>();
+  auto grid = collisionCachingGrid(mockCollisionDetectorPtr);
+
+  auto source = collisionCachingObject("source", grid);
+  auto target = collisionCachingObject("target", grid);
+
+  grid->addObject({1, 1}, source, false);
+  grid->addObject({2, 2}, target, false);
+
+  EXPECT_CALL(*mockCollisionDetectorPtr, searchObjects(Eq(glm::ivec2{1, 1}), _)).Times(2);
+
+  grid->update();
+
+  // The location the target leaves is in range of the source
+  ASSERT_TRUE(target->moveObject({8, 8}));
+  grid->update();
+
+  // Neither location is in range of the source
+  ASSERT_TRUE(target->moveObject({9, 9}));
+  grid->update();
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockCollisionDetectorPtr.get()));
+}
+
+TEST(GridTest, collisionsSearchedAfterObjectSpawnsInRange) {
+  auto mockCollisionDetectorPtr = std::make_shared<MockCollisionDetector>();
+  auto grid = collisionCachingGrid(mockCollisionDetectorPtr);
+
+  auto source = collisionCachingObject("source", grid);
+  auto target = collisionCachingObject("target", grid);
+
+  grid->addObject({1, 1}, source, false);
+
+  EXPECT_CALL(*mockCollisionDetectorPtr, searchObjects(Eq(glm::ivec2{1, 1}), _)).Times(2);
+
+  grid->update();
+
+  grid->addObject({2, 2}, target, false);
+  grid->update();
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockCollisionDetectorPtr.get()));
+}
+
+TEST(GridTest, collisionsSearchedAfterRemovalRolledBack) {
+  auto mockCollisionDetectorPtr = std::make_shared<MockCollisionDetector>();
+  auto grid = collisionCachingGrid(mockCollisionDetectorPtr);
+
+  auto source = collisionCachingObject("source", grid);
+  auto target = collisionCachingObject("target", grid);
+
+  grid->addObject({1, 1}, source, false);
+  grid->addObject({2, 2}, target, false);
+
+  // Removing the target and rolling it back both change a location in range of the source
+  EXPECT_CALL(*mockCollisionDetectorPtr, searchObjects(Eq(glm::ivec2{1, 1}), _)).Times(2);
+
+  grid->update();
+
+  grid->enableJournal(true);
+  auto checkpoint = grid->checkpoint();
+  grid->removeObject(target);
+  grid->rollback(checkpoint);
+
+  ASSERT_EQ(grid->getObject({2, 2}), target);
+  grid->update();
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockCollisionDetectorPtr.get()));
+}
+
+TEST(GridTest, moveObjectIntoOccupancyGridCollisionRange) {
+  auto mockCollisionDetectorFactoryPtr = std::make_shared<MockCollisionDetectorFactory>();
+  auto collisionDetector = std::make_shared<OccupancyGridCollisionDetector>(10, 10, 1, TriggerType::RANGE_BOX_AREA);
+
+  EXPECT_CALL(*mockCollisionDetectorFactoryPtr, newCollisionDetector)
+      .WillOnce(Return(collisionDetector));
+
+  auto grid = std::make_shared<Grid>(mockCollisionDetectorFactoryPtr);
+  grid->resetMap(10, 10);
+  grid->setPlayerCount(1);
+  grid->initObject("source", {});
+  grid->initObject("target", {});
+
+  grid->addActionTrigger("collision_trigger_action", {{"source"}, {"target"}, TriggerType::RANGE_BOX_AREA, 1});
+
+  auto source = std::make_shared<Object>("source", 'S', 1, 0, std::unordered_map<std::string, std::shared_ptr<int32_t>>{}, nullptr, grid);
+  auto target = std::make_shared<Object>("target", 'T', 1, 0, std::unordered_map<std::string, std::shared_ptr<int32_t>>{}, nullptr, grid);
+
+  grid->addObject({5, 5}, source, false);
+  grid->addObject({2, 2}, target, false);
+
+  std::vector<std::shared_ptr<Object>> objects;
+  collisionDetector->searchObjects({5, 5}, objects);
+  ASSERT_TRUE(objects.empty());
+
+  // The detector has to see the location the object is moving to, not the one it is leaving
+  ASSERT_TRUE(target->moveObject({4, 4}));
+  collisionDetector->searchObjects({5, 5}, objects);
+  ASSERT_THAT(objects, ElementsAre(target));
+
+  objects.clear();
+  ASSERT_TRUE(target->moveObject({3, 3}));
+  collisionDetector->searchObjects({5, 5}, objects);
+  ASSERT_TRUE(objects.empty());
+}
+
 TEST(GridTest, addCollisionDetectorAfterObjects) {
   auto mockCollisionDetectorFactoryPtr = std::make_shared<MockCollisionDetectorFactory>();
   auto mockCollisionDetectorPtr1 = std::make_shared<MockCollisionDetector>();
@@ -1013,9 +1275,9 @@ TEST(GridTest, addCollisionDetectorAfterObjects) {
   grid->addObject({2, 2}, mockObjectPtr2);
   grid->addObject({3, 3}, mockObjectPtr3);
 
-  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr1))).Times(1);
-  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr2))).Times(1);
-  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr3))).Times(1);
+  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr1), _)).Times(1);
+  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr2), _)).Times(1);
+  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert(Eq(mockObjectPtr3), _)).Times(1);
 
   grid->addCollisionDetector({"object_1", "object_2", "object_3"}, "test_action", mockCollisionDetectorPtr1);
 }
@@ -1070,4 +1332,357 @@ TEST(GridTest, randomNumberGenerator) {
   ASSERT_EQ(randomResult122, randomResult121);
 }
 
+TEST(GridTest, journalRollback) {
+  auto grid = std::make_shared<Grid>();
+  grid->resetMap(10, 10);
+  grid->setPlayerCount(1);
+  grid->initObject("object", {});
+
+  auto object1 = std::make_shared<Object>("object", 'A', 1, 0, std::unordered_map<std::string, std::shared_ptr<int32_t>>{}, nullptr, grid);
+  auto object2 = std::make_shared<Object>("object", 'A', 1, 0, std::unordered_map<std::string, std::shared_ptr<int32_t>>{}, nullptr, grid);
+
+  grid->addObject({1, 1}, object1, false);
+
+  grid->enableJournal(true);
+  auto checkpoint = grid->checkpoint();
+
+  ASSERT_TRUE(grid->updateLocation(object1, {1, 1}, {2, 2}));
+  grid->addObject({3, 3}, object2, false);
+  grid->removeObject(object2);
+  grid->delayAction(1, std::make_shared<Action>(Action(grid, "action", 1, 5)));
+  grid->update();
+
+  ASSERT_EQ(grid->getObject({2, 2}), object1);
+  ASSERT_EQ(grid->getDelayedActions().size(), 1);
+  ASSERT_EQ(*grid->getTickCount(), 1);
+
+  grid->rollback(checkpoint);
+
+  ASSERT_EQ(grid->getObject({1, 1}), object1);
+  ASSERT_EQ(object1->getLocation(), glm::ivec2(1, 1));
+  ASSERT_EQ(grid->getObject({2, 2}), nullptr);
+  ASSERT_EQ(grid->getObject({3, 3}), nullptr);
+  ASSERT_THAT(grid->getObjects(), UnorderedElementsAre(object1));
+  ASSERT_EQ(*grid->getObjectCounter("object").at(1), 1);
+  ASSERT_EQ(grid->getDelayedActions().size(), 0);
+  ASSERT_EQ(*grid->getTickCount(), 0);
+
+  // Rolling back a removal restores the object
+  grid->removeObject(object1);
+  ASSERT_EQ(grid->getObject({1, 1}), nullptr);
+
+  grid->rollback(checkpoint);
+
+  ASSERT_EQ(grid->getObject({1, 1}), object1);
+  ASSERT_EQ(*grid->getObjectCounter("object").at(1), 1);
+}
+
+TEST(GridTest, restoreSnapshot) {
+  auto grid = std::make_shared<Grid>();
+  grid->resetMap(10, 10);
+  grid->setPlayerCount(1);
+  grid->initObject("object", {"health"});
+
+  auto newObject = [&grid]() {
+    auto object = std::make_shared<Object>("object", 'A', 1, 0, std::unordered_map<std::string, std::shared_ptr<int32_t>>{{"health", std::make_shared<int32_t>(5)}}, nullptr, grid);
+    object->setStateVariables({{"health", 5}});
+    return object;
+  };
+
+  auto object1 = newObject();
+  auto object2 = newObject();
+  auto object3 = newObject();
+
+  grid->addObject({1, 1}, object1, false);
+  grid->addObject({2, 2}, object2, false);
+  grid->delayAction(1, std::make_shared<Action>(Action(grid, "action", 1, 5)));
+
+  auto stateHash = grid->getStateHash();
+  auto snapshot = grid->takeSnapshot();
+
+  ASSERT_TRUE(grid->updateLocation(object1, {1, 1}, {3, 3}));
+  object1->init({3, 3});
+  grid->writeVariable(object1->getVariableValue("health").get(), 1, object1);
+  grid->removeObject(object2);
+  grid->addObject({4, 4}, object3, false);
+  grid->update();
+  grid->update();
+
+  grid->restoreSnapshot(*snapshot);
+
+  ASSERT_EQ(grid->getObject({1, 1}), object1);
+  ASSERT_EQ(object1->getLocation(), glm::ivec2(1, 1));
+  ASSERT_EQ(*object1->getVariableValue("health"), 5);
+  ASSERT_EQ(grid->getObject({2, 2}), object2);
+  ASSERT_FALSE(object2->isRemoved());
+  ASSERT_EQ(grid->getObject({3, 3}), nullptr);
+  ASSERT_EQ(grid->getObject({4, 4}), nullptr);
+  ASSERT_THAT(grid->getObjects(), UnorderedElementsAre(object1, object2));
+  ASSERT_EQ(*grid->getObjectCounter("object").at(1), 2);
+  ASSERT_EQ(grid->getDelayedActions().size(), 1);
+  ASSERT_EQ(*grid->getTickCount(), 0);
+  ASSERT_EQ(grid->getStateHash(), stateHash);
+}
+
+TEST(GridTest, cloneCopyOnWrite) {
+  auto objectGenerator = std::make_shared<ObjectGenerator>();
+  objectGenerator->defineNewObject("object", 'A', 0, {{"health", 5}});
+
+  auto grid = std::make_shared<Grid>();
+  grid->setPlayerCount(1);
+  grid->resetMap(10, 10);
+  grid->initObject("object", {"health"});
+  grid->addPlayerDefaultObjects(objectGenerator->newInstance("_empty", 1, grid), objectGenerator->newInstance("_boundary", 1, grid));
+
+  auto object1 = objectGenerator->newInstance("object", 1, grid);
+  auto object2 = objectGenerator->newInstance("object", 1, grid);
+  grid->addObject({1, 1}, object1, false);
+  grid->addObject({5, 5}, object2, false);
+
+  auto action = grid->newAction("action", 1, 5);
+  action->init({1, 1}, {2, 2});
+  grid->delayAction(1, action);
+
+  auto stateHash = grid->getStateHash();
+  auto clonedGrid = grid->cloneCopyOnWrite(objectGenerator);
+
+  ASSERT_EQ(clonedGrid->getStateHash(), stateHash);
+  ASSERT_EQ(*clonedGrid->getObjectCounter("object").at(1), 2);
+  ASSERT_EQ(clonedGrid->getDelayedActions().size(), 1);
+
+  auto clonedObject1 = clonedGrid->getObject({1, 1});
+  ASSERT_NE(clonedObject1, nullptr);
+  ASSERT_NE(clonedObject1, object1);
+  ASSERT_EQ(clonedObject1->getObjectName(), "object");
+  ASSERT_EQ(clonedObject1->getLocation(), glm::ivec2(1, 1));
+
+  // Changing the clone does not change the grid it was cloned from
+  clonedGrid->writeVariable(clonedObject1->getVariableValue("health").get(), 1, clonedObject1);
+  ASSERT_TRUE(clonedGrid->removeObject(clonedObject1));
+  ASSERT_EQ(*object1->getVariableValue("health"), 5);
+  ASSERT_EQ(grid->getObject({1, 1}), object1);
+  ASSERT_EQ(*grid->getObjectCounter("object").at(1), 2);
+  ASSERT_EQ(grid->getStateHash(), stateHash);
+
+  // Changing the grid it was cloned from copies the changed tile into the clone first
+  grid->writeVariable(object2->getVariableValue("health").get(), 2, object2);
+  auto clonedObject2 = clonedGrid->getObject({5, 5});
+  ASSERT_NE(clonedObject2, nullptr);
+  ASSERT_NE(clonedObject2, object2);
+  ASSERT_EQ(*clonedObject2->getVariableValue("health"), 5);
+  ASSERT_THAT(clonedGrid->getObjects(), UnorderedElementsAre(clonedObject2));
+  ASSERT_EQ(*clonedGrid->getObjectCounter("object").at(1), 1);
+  ASSERT_EQ(clonedGrid->getDelayedActions().size(), 1);
+}
+
+TEST(GridTest, cloneCopyOnWriteCopiesOnlyChangedTiles) {
+  auto objectGenerator = std::make_shared<ObjectGenerator>();
+  objectGenerator->defineNewObject("object", 'A', 0, {{"health", 5}});
+
+  auto grid = std::make_shared<Grid>();
+  grid->setPlayerCount(1);
+  grid->resetMap(10, 10);
+  grid->initObject("object", {"health"});
+  grid->addPlayerDefaultObjects(objectGenerator->newInstance("_empty", 1, grid), objectGenerator->newInstance("_boundary", 1, grid));
+
+  auto object1 = objectGenerator->newInstance("object", 1, grid);
+  auto object2 = objectGenerator->newInstance("object", 1, grid);
+  auto object3 = objectGenerator->newInstance("object", 1, grid);
+  grid->addObject({1, 1}, object1, false);
+  grid->addObject({5, 5}, object2, false);
+  grid->addObject({8, 8}, object3, false);
+
+  auto action = grid->newAction("action", 1, 5);
+  action->init(object2, {1, 0}, {1, 0}, false);
+  grid->delayAction(1, action);
+
+  auto clonedGrid = grid->cloneCopyOnWrite(objectGenerator);
+
+  // The delayed action is copied into the clone with a copy of its source object
+  ASSERT_EQ(clonedGrid->getDelayedActions().size(), 1);
+  auto clonedAction = clonedGrid->getDelayedActions().begin()->action;
+  ASSERT_NE(clonedAction, action);
+  auto clonedObject2 = clonedAction->getSourceObject();
+  ASSERT_NE(clonedObject2, object2);
+  ASSERT_EQ(clonedGrid->getObject({5, 5}), clonedObject2);
+  ASSERT_EQ(grid->getDelayedActions().begin()->action, action);
+
+  // Observing the clone reads the objects it still shares without copying them
+  ASSERT_THAT(clonedGrid->getObjects(), UnorderedElementsAre(object1, clonedObject2, object3));
+  ASSERT_THAT(grid->getObjects(), UnorderedElementsAre(object1, object2, object3));
+  ASSERT_EQ(clonedGrid->getObjectsAt({8, 8}).begin()->second, object3);
+
+  // Changing the grid it was cloned from only copies the changed tile
+  grid->writeVariable(object1->getVariableValue("health").get(), 2, object1);
+  auto clonedObject1 = clonedGrid->getObject({1, 1});
+  ASSERT_NE(clonedObject1, object1);
+  ASSERT_EQ(*clonedObject1->getVariableValue("health"), 5);
+  ASSERT_THAT(clonedGrid->getObjects(), UnorderedElementsAre(clonedObject1, clonedObject2, object3));
+
+  // Moving an object copies the tiles on both sides of the move
+  ASSERT_TRUE(grid->updateLocation(object3, {8, 8}, {8, 9}));
+  auto clonedObject3 = clonedGrid->getObject({8, 8});
+  ASSERT_NE(clonedObject3, nullptr);
+  ASSERT_NE(clonedObject3, object3);
+  ASSERT_EQ(clonedGrid->getObject({8, 9}), nullptr);
+  ASSERT_THAT(clonedGrid->getObjects(), UnorderedElementsAre(clonedObject1, clonedObject2, clonedObject3));
+}
+
+TEST(GridTest, cloneCopyOnWriteCopiesCollisionObjects) {
+  auto mockCollisionDetectorFactoryPtr = std::make_shared<MockCollisionDetectorFactory>();
+  auto mockCollisionDetectorPtr1 = std::make_shared<MockCollisionDetector>();
+  auto mockCollisionDetectorPtr2 = std::make_shared<MockCollisionDetector>();
+
+  EXPECT_CALL(*mockCollisionDetectorFactoryPtr, newCollisionDetector)
+      .WillOnce(Return(mockCollisionDetectorPtr1))
+      .WillOnce(Return(mockCollisionDetectorPtr2));
+
+  auto objectGenerator = std::make_shared<ObjectGenerator>();
+  objectGenerator->defineNewObject("object_1", 'A', 0, {});
+  objectGenerator->defineNewObject("object_2", 'B', 0, {});
+
+  auto grid = std::make_shared<Grid>(mockCollisionDetectorFactoryPtr);
+  grid->setPlayerCount(1);
+  grid->resetMap(10, 10);
+  grid->addActionTrigger("collision_trigger_action", {{"object_1"}, {"object_1"}, TriggerType::RANGE_BOX_AREA, 1});
+  grid->initObject("object_1", {});
+  grid->initObject("object_2", {});
+  grid->addPlayerDefaultObjects(objectGenerator->newInstance("_empty", 1, grid), objectGenerator->newInstance("_boundary", 1, grid));
+
+  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert).WillRepeatedly(Return(true));
+
+  auto object1 = objectGenerator->newInstance("object_1", 1, grid);
+  auto object2 = objectGenerator->newInstance("object_2", 1, grid);
+  grid->addObject({1, 1}, object1, false);
+  grid->addObject({5, 5}, object2, false);
+
+  // Only the objects that can collide are copied when the clone is made
+  std::shared_ptr<Object> clonedObject1;
+  EXPECT_CALL(*mockCollisionDetectorPtr2, upsert(_, Eq(glm::ivec2{1, 1})))
+      .WillOnce(DoAll(SaveArg<0>(&clonedObject1), Return(true)));
+
+  auto clonedGrid = grid->cloneCopyOnWrite(objectGenerator);
+
+  ASSERT_NE(clonedObject1, nullptr);
+  ASSERT_NE(clonedObject1, object1);
+  ASSERT_EQ(clonedGrid->getObject({1, 1}), clonedObject1);
+  ASSERT_EQ(clonedGrid->getObjectsAt({5, 5}).begin()->second, object2);
+  ASSERT_THAT(clonedGrid->getObjects(), UnorderedElementsAre(clonedObject1, object2));
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockCollisionDetectorPtr2.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockCollisionDetectorFactoryPtr.get()));
+}
+
+TEST(GridTest, journalRollbackRandomState) {
+  auto grid = std::make_shared<Grid>();
+  grid->resetMap(10, 10);
+
+  ASSERT_THROW(grid->checkpoint(), std::invalid_argument);
+
+  grid->enableJournal(true);
+  grid->seedRandomGenerator(100);
+
+  auto checkpoint = grid->checkpoint();
+  auto sample1 = grid->getRandomGenerator()->sampleInt(0, 1000);
+
+  grid->rollback(checkpoint);
+  auto sample2 = grid->getRandomGenerator()->sampleInt(0, 1000);
+
+  ASSERT_EQ(sample1, sample2);
+  ASSERT_THROW(grid->rollback(checkpoint + 1), std::invalid_argument);
+}
+
+TEST(GridTest, stateHash) {
+  auto grid1 = std::make_shared<Grid>();
+  auto grid2 = std::make_shared<Grid>();
+  grid1->resetMap(10, 10);
+  grid2->resetMap(10, 10);
+
+  auto emptyHash = grid1->getStateHash();
+  ASSERT_EQ(grid2->getStateHash(), emptyHash);
+
+  auto newObject = [](const std::shared_ptr<Grid>& grid) {
+    auto object = std::make_shared<Object>("object", 'A', 1, 0, std::unordered_map<std::string, std::shared_ptr<int32_t>>{{"health", std::make_shared<int32_t>(5)}}, nullptr, grid);
+    object->setStateVariables({{"health", 5}});
+    return object;
+  };
+
+  auto object11 = newObject(grid1);
+  auto object12 = newObject(grid1);
+  auto object21 = newObject(grid2);
+  auto object22 = newObject(grid2);
+
+  // The same state reached in a different order has the same hash
+  grid1->addObject({1, 1}, object11, false);
+  grid1->addObject({2, 2}, object12, false);
+  grid2->addObject({2, 2}, object22, false);
+  grid2->addObject({1, 1}, object21, false);
+
+  auto stateHash = grid1->getStateHash();
+  ASSERT_NE(stateHash, emptyHash);
+  ASSERT_EQ(grid2->getStateHash(), stateHash);
+
+  // Variable writes change the hash and writing the value back restores it
+  auto health = object11->getVariableValue("health");
+  grid1->writeVariable(health.get(), 4, object11);
+  ASSERT_NE(grid1->getStateHash(), stateHash);
+  grid1->writeVariable(health.get(), 5, object11);
+  ASSERT_EQ(grid1->getStateHash(), stateHash);
+
+  // Rolling back restores the hash
+  grid1->enableJournal(true);
+  auto checkpoint = grid1->checkpoint();
+  grid1->removeObject(object12);
+  grid1->writeVariable(health.get(), 1, object11);
+  grid1->update();
+  ASSERT_NE(grid1->getStateHash(), stateHash);
+
+  grid1->rollback(checkpoint);
+  ASSERT_EQ(grid1->getStateHash(), stateHash);
+
+  grid1->removeObject(object11);
+  grid1->removeObject(object12);
+  ASSERT_EQ(grid1->getStateHash(), emptyHash);
+}
+
+TEST(GridTest, stateHashGlobalVariables) {
+  auto grid1 = std::make_shared<Grid>();
+  auto grid2 = std::make_shared<Grid>();
+  grid1->setPlayerCount(2);
+  grid2->setPlayerCount(2);
+  grid1->resetMap(10, 10);
+  grid2->resetMap(10, 10);
+  grid1->resetGlobalVariables({{"score", {0, true}}, {"lives", {3, false}}});
+  grid2->resetGlobalVariables({{"score", {0, true}}, {"lives", {3, false}}});
+
+  auto initialHash = grid1->getStateHash();
+  ASSERT_EQ(grid2->getStateHash(), initialHash);
+
+  // The same value hashes differently for each player
+  const auto& score = grid1->getGlobalVariables().at("score");
+  grid1->writeVariable(score.at(1).get(), 5, nullptr);
+  auto player1Hash = grid1->getStateHash();
+  ASSERT_NE(player1Hash, initialHash);
+
+  grid1->writeVariable(score.at(1).get(), 0, nullptr);
+  ASSERT_EQ(grid1->getStateHash(), initialHash);
+  grid1->writeVariable(score.at(2).get(), 5, nullptr);
+  ASSERT_NE(grid1->getStateHash(), initialHash);
+  ASSERT_NE(grid1->getStateHash(), player1Hash);
+
+  // Updating the hash on every write gives the same hash as hashing the values from scratch
+  grid2->setGlobalVariables({{"score", {{0, 0}, {1, 0}, {2, 5}}}, {"lives", {{0, 3}}}});
+  ASSERT_EQ(grid2->getStateHash(), grid1->getStateHash());
+
+  auto stateHash = grid1->getStateHash();
+  grid1->enableJournal(true);
+  auto checkpoint = grid1->checkpoint();
+  grid1->writeVariable(grid1->getGlobalVariables().at("lives").at(0).get(), 2, nullptr);
+  grid1->update();
+  ASSERT_NE(grid1->getStateHash(), stateHash);
+
+  grid1->rollback(checkpoint);
+  ASSERT_EQ(grid1->getStateHash(), stateHash);
+}
+
 }  // namespace griddly
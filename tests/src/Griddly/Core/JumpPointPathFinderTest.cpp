@@ -0,0 +1,166 @@
+#include <memory>
+#include <queue>
+#include <random>
+
+#include "Griddly/Core/GDY/Objects/Object.hpp"
+#include "Griddly/Core/JumpPointPathFinder.cpp"
+#include "Griddly/Core/PassabilityMap.cpp"
+#include "Griddly/Core/TestUtils/common.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace griddly {
+
+std::shared_ptr<Object> addJumpPointWall(const std::shared_ptr<Grid>& grid, glm::ivec2 location) {
+  auto wall = std::make_shared<Object>(Object("wall", 'W', 0, 0, {}, nullptr, grid));
+  grid->addObject(location, wall, false);
+  return wall;
+}
+
+std::shared_ptr<PassabilityMap> wallPassabilityMap() {
+  return std::make_shared<PassabilityMap>(std::set<std::string>{"wall"});
+}
+
+bool isJumpPointWall(const std::shared_ptr<Grid>& grid, glm::ivec2 location) {
+  return location.x < 0 || location.y < 0 || location.x >= static_cast<int32_t>(grid->getWidth()) || location.y >= static_cast<int32_t>(grid->getHeight()) || grid->getObject(location) != nullptr;
+}
+
+// Breadth first distance, or -1 if the end cannot be reached
+int32_t jumpPointBreadthFirstDistance(const std::shared_ptr<Grid>& grid, glm::ivec2 start, glm::ivec2 end) {
+  std::vector<int32_t> distances(grid->getWidth() * grid->getHeight(), -1);
+  std::queue<glm::ivec2> frontier;
+  distances[start.y * grid->getWidth() + start.x] = 0;
+  frontier.push(start);
+
+  while (!frontier.empty()) {
+    auto location = frontier.front();
+    frontier.pop();
+    if (location == end) {
+      return distances[location.y * grid->getWidth() + location.x];
+    }
+
+    for (const auto& direction : {glm::ivec2(-1, 0), glm::ivec2(0, -1), glm::ivec2(1, 0), glm::ivec2(0, 1)}) {
+      auto next = location + direction;
+      if (!isJumpPointWall(grid, next) && distances[next.y * grid->getWidth() + next.x] == -1) {
+        distances[next.y * grid->getWidth() + next.x] = distances[location.y * grid->getWidth() + location.x] + 1;
+        frontier.push(next);
+      }
+    }
+  }
+  return -1;
+}
+
+TEST(JumpPointPathFinderTest, supports) {
+  ASSERT_TRUE(JumpPointPathFinder::supports(fourDirectionMoveActions()));
+
+  auto relative = fourDirectionMoveActions();
+  relative.relative = true;
+  ASSERT_FALSE(JumpPointPathFinder::supports(relative));
+
+  auto diagonal = fourDirectionMoveActions();
+  diagonal.inputMappings[5] = {{1, 1}};
+  ASSERT_FALSE(JumpPointPathFinder::supports(diagonal));
+
+  auto missingDirection = fourDirectionMoveActions();
+  missingDirection.inputMappings.erase(4);
+  ASSERT_FALSE(JumpPointPathFinder::supports(missingDirection));
+
+  auto noop = fourDirectionMoveActions();
+  noop.inputMappings[5] = {{0, 0}};
+  ASSERT_TRUE(JumpPointPathFinder::supports(noop));
+}
+
+TEST(JumpPointPathFinderTest, searchCorridor) {
+  //  y=0  . . . . . . . . . . . . . . . . . . . .
+  //  y=1  W W W W W W W W W W W W W W W W W W W .
+  //  y=2  T . . . . . . . . . . . . . . . . . . .
+  auto grid = pathFinderGrid(20, 3, {"wall"});
+  for (int32_t x = 0; x < 19; x++) {
+    addJumpPointWall(grid, {x, 1});
+  }
+
+  JumpPointPathFinder pathFinder(grid, {"wall"}, fourDirectionMoveActions(), PathFinderMode::SEEK, wallPassabilityMap());
+
+  ASSERT_EQ(pathFinder.search({0, 0}, {0, 2}, {}, 100).actionId, 3);
+
+  // The start, the end of each corridor and the target
+  ASSERT_EQ(pathFinder.getExpandedCount(), 4);
+
+  ASSERT_EQ(pathFinder.search({19, 1}, {0, 2}, {}, 100).actionId, 4);
+  ASSERT_EQ(pathFinder.search({0, 2}, {0, 2}, {}, 100).actionId, 0);
+}
+
+TEST(JumpPointPathFinderTest, passabilityFollowsGridChanges) {
+  auto grid = pathFinderGrid(5, 3, {"wall"});
+  JumpPointPathFinder pathFinder(grid, {"wall"}, fourDirectionMoveActions(), PathFinderMode::SEEK, wallPassabilityMap());
+
+  ASSERT_EQ(pathFinder.search({0, 1}, {4, 1}, {}, 100).actionId, 3);
+
+  addJumpPointWall(grid, {1, 1});
+  auto wall = addJumpPointWall(grid, {1, 2});
+  ASSERT_EQ(pathFinder.search({0, 1}, {4, 1}, {}, 100).actionId, 2);
+
+  addJumpPointWall(grid, {1, 0});
+  grid->removeObject(wall);
+  ASSERT_EQ(pathFinder.search({0, 1}, {4, 1}, {}, 100).actionId, 4);
+}
+
+TEST(JumpPointPathFinderTest, sharePassabilityMap) {
+  auto grid = pathFinderGrid(5, 3, {"wall"});
+  auto passabilityMap = wallPassabilityMap();
+  JumpPointPathFinder pathFinder1(grid, {"wall"}, fourDirectionMoveActions(), PathFinderMode::SEEK, passabilityMap);
+  JumpPointPathFinder pathFinder2(grid, {"wall"}, fourDirectionMoveActions(), PathFinderMode::SEEK, passabilityMap);
+
+  ASSERT_EQ(pathFinder1.search({0, 1}, {4, 1}, {}, 100).actionId, 3);
+  ASSERT_EQ(pathFinder2.search({1, 1}, {4, 1}, {}, 100).actionId, 3);
+
+  // Changes are picked up by whichever path finder searches first, the grid is only scanned once
+  addJumpPointWall(grid, {1, 0});
+  addJumpPointWall(grid, {1, 1});
+  ASSERT_EQ(pathFinder2.search({0, 1}, {4, 1}, {}, 100).actionId, 4);
+  ASSERT_EQ(pathFinder1.search({0, 0}, {4, 1}, {}, 100).actionId, 4);
+  ASSERT_EQ(passabilityMap->getBuildCount(), 1);
+}
+
+TEST(JumpPointPathFinderTest, followsShortestPaths) {
+  std::mt19937 random(1234);
+  uint32_t reachableMapCount = 0;
+
+  for (uint32_t mapIdx = 0; mapIdx < 20; mapIdx++) {
+    auto grid = pathFinderGrid(16, 12, {"wall"});
+    std::bernoulli_distribution isWall(0.3);
+    for (int32_t y = 0; y < 12; y++) {
+      for (int32_t x = 0; x < 16; x++) {
+        if ((x != 0 || y != 0) && (x != 15 || y != 11) && isWall(random)) {
+          addJumpPointWall(grid, {x, y});
+        }
+      }
+    }
+
+    auto distance = jumpPointBreadthFirstDistance(grid, {0, 0}, {15, 11});
+    if (distance == -1) {
+      continue;
+    }
+    reachableMapCount++;
+
+    // Every step has to be on a shortest path for the walk to take exactly the shortest distance
+    JumpPointPathFinder pathFinder(grid, {"wall"}, fourDirectionMoveActions(), PathFinderMode::SEEK, wallPassabilityMap());
+    const std::unordered_map<uint32_t, glm::ivec2> moves = {{1, {-1, 0}}, {2, {0, -1}}, {3, {1, 0}}, {4, {0, 1}}};
+
+    glm::ivec2 location(0, 0);
+    int32_t steps = 0;
+    while (location != glm::ivec2(15, 11) && steps <= distance) {
+      auto actionId = pathFinder.search(location, {15, 11}, {}, 1000).actionId;
+      ASSERT_NE(actionId, 0);
+      location += moves.at(actionId);
+      ASSERT_FALSE(isJumpPointWall(grid, location));
+      steps++;
+    }
+
+    ASSERT_EQ(steps, distance);
+  }
+
+  ASSERT_GT(reachableMapCount, 0);
+}
+
+}  // namespace griddly
@@ -0,0 +1,143 @@
+#include <random>
+
+#include "Griddly/Core/Grid.hpp"
+#include "Griddly/Core/NearestObjectIndex.cpp"
+#include "Griddly/Core/TestUtils/common.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::ReturnRefOfCopy;
+
+namespace griddly {
+
+std::vector<std::shared_ptr<Object>> searchNearestObjects(const NearestObjectIndex& index, glm::ivec2 location, uint32_t k) {
+  std::vector<std::shared_ptr<Object>> objects;
+  index.searchNearest(location, k, objects);
+  return objects;
+}
+
+int32_t nearestObjectDistance2(const std::shared_ptr<Object>& object, glm::ivec2 location) {
+  auto offset = object->getLocation() - location;
+  return offset.x * offset.x + offset.y * offset.y;
+}
+
+TEST(NearestObjectIndexTest, upsertAndRemove) {
+  NearestObjectIndex index(20, 20, 4);
+  auto mockObjectPtr = mockObject("object", '?', 1, 0, {1, 1});
+
+  ASSERT_FALSE(index.remove(mockObjectPtr));
+  ASSERT_TRUE(index.upsert(mockObjectPtr));
+  ASSERT_FALSE(index.upsert(mockObjectPtr));
+  ASSERT_EQ(index.searchClosest({19, 19}), mockObjectPtr);
+
+  // Moving within a cell does not change the index
+  EXPECT_CALL(*mockObjectPtr, getLocation()).WillRepeatedly(ReturnRefOfCopy(glm::ivec2(2, 2)));
+  ASSERT_FALSE(index.upsert(mockObjectPtr));
+
+  EXPECT_CALL(*mockObjectPtr, getLocation()).WillRepeatedly(ReturnRefOfCopy(glm::ivec2(18, 2)));
+  ASSERT_TRUE(index.upsert(mockObjectPtr));
+  ASSERT_EQ(index.size(), 1);
+  ASSERT_EQ(index.searchClosest({0, 0}), mockObjectPtr);
+
+  // Objects outside the grid cannot be found
+  EXPECT_CALL(*mockObjectPtr, getLocation()).WillRepeatedly(ReturnRefOfCopy(glm::ivec2(-1, 2)));
+  ASSERT_FALSE(index.upsert(mockObjectPtr));
+  ASSERT_EQ(index.size(), 0);
+  ASSERT_EQ(index.searchClosest({0, 0}), nullptr);
+
+  EXPECT_CALL(*mockObjectPtr, getLocation()).WillRepeatedly(ReturnRefOfCopy(glm::ivec2(5, 5)));
+  ASSERT_TRUE(index.upsert(mockObjectPtr));
+  ASSERT_TRUE(index.remove(mockObjectPtr));
+  ASSERT_THAT(searchNearestObjects(index, {5, 5}, 3), IsEmpty());
+}
+
+TEST(NearestObjectIndexTest, searchNearest) {
+  NearestObjectIndex index(20, 20, 4);
+  auto mockObjectPtr1 = mockObject("object", '?', 1, 0, {19, 19});
+  auto mockObjectPtr2 = mockObject("object", '?', 1, 0, {3, 3});
+  auto mockObjectPtr3 = mockObject("object", '?', 1, 0, {9, 8});
+  auto mockObjectPtr4 = mockObject("object", '?', 1, 0, {8, 0});
+
+  index.upsert(mockObjectPtr1);
+  index.upsert(mockObjectPtr2);
+  index.upsert(mockObjectPtr3);
+  index.upsert(mockObjectPtr4);
+
+  ASSERT_THAT(searchNearestObjects(index, {8, 8}, 2), ElementsAre(mockObjectPtr3, mockObjectPtr2));
+  ASSERT_THAT(searchNearestObjects(index, {8, 8}, 10), ElementsAre(mockObjectPtr3, mockObjectPtr2, mockObjectPtr4, mockObjectPtr1));
+  ASSERT_THAT(searchNearestObjects(index, {8, 8}, 0), IsEmpty());
+  ASSERT_EQ(index.searchClosest({17, 16}), mockObjectPtr1);
+  ASSERT_EQ(index.searchClosest({30, -5}), mockObjectPtr4);
+}
+
+TEST(NearestObjectIndexTest, searchMatchesExhaustiveSearch) {
+  std::mt19937 random(4321);
+  std::uniform_int_distribution<int32_t> randomX(0, 49);
+  std::uniform_int_distribution<int32_t> randomY(0, 39);
+
+  NearestObjectIndex index(50, 40, 4);
+  std::vector<std::shared_ptr<Object>> objects;
+  for (uint32_t i = 0; i < 60; i++) {
+    auto mockObjectPtr = mockObject("object", '?', 1, 0, {randomX(random), randomY(random)});
+    index.upsert(mockObjectPtr);
+    objects.push_back(mockObjectPtr);
+  }
+
+  std::uniform_int_distribution<int32_t> randomQuery(-10, 60);
+  for (uint32_t q = 0; q < 200; q++) {
+    glm::ivec2 location(randomQuery(random), randomQuery(random));
+
+    std::vector<int32_t> expectedDistances;
+    for (const auto& object : objects) {
+      expectedDistances.push_back(nearestObjectDistance2(object, location));
+    }
+    std::sort(expectedDistances.begin(), expectedDistances.end());
+    expectedDistances.resize(5);
+
+    std::vector<int32_t> distances;
+    for (const auto& object : searchNearestObjects(index, location, 5)) {
+      distances.push_back(nearestObjectDistance2(object, location));
+    }
+
+    ASSERT_EQ(distances, expectedDistances);
+    ASSERT_EQ(nearestObjectDistance2(index.searchClosest(location), location), expectedDistances[0]);
+  }
+}
+
+TEST(NearestObjectIndexTest, gridKeepsIndexUpToDate) {
+  auto grid = std::make_shared<Grid>();
+  grid->setPlayerCount(1);
+  grid->resetMap(10, 10);
+  grid->initObject("target", {});
+
+  auto emptyObject = std::make_shared<Object>(Object("_empty", ' ', 0, 0, {}, nullptr, grid));
+  auto boundaryObject = std::make_shared<Object>(Object("_boundary", ' ', 0, 0, {}, nullptr, grid));
+  grid->addPlayerDefaultObjects(emptyObject, boundaryObject);
+
+  auto target1 = std::make_shared<Object>(Object("target", 't', 1, 0, {}, nullptr, grid));
+  auto target2 = std::make_shared<Object>(Object("target", 't', 1, 0, {}, nullptr, grid));
+  grid->addObject({1, 1}, target1, false);
+
+  // Targets already on the grid are added when the index is created
+  auto index = grid->getNearestObjectIndex("target");
+  ASSERT_EQ(index->size(), 1);
+  ASSERT_EQ(grid->getNearestObjectIndex("target"), index);
+
+  grid->addObject({8, 8}, target2, false);
+  ASSERT_EQ(index->size(), 2);
+  ASSERT_EQ(index->searchClosest({9, 9}), target2);
+
+  // Objects only update their own location after the grid has moved them
+  grid->updateLocation(target2, {8, 8}, {0, 9});
+  target2->init({0, 9});
+  ASSERT_EQ(index->searchClosest({0, 7}), target2);
+  ASSERT_EQ(index->searchClosest({9, 0}), target1);
+
+  grid->removeObject(target1);
+  ASSERT_EQ(index->size(), 1);
+  ASSERT_EQ(index->searchClosest({9, 0}), target2);
+}
+
+}  // namespace griddly
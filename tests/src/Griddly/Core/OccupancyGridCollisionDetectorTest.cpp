@@ -0,0 +1,77 @@
+#include "Griddly/Core/OccupancyGridCollisionDetector.cpp"
+#include "Griddly/Core/TestUtils/common.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::ReturnRefOfCopy;
+using ::testing::UnorderedElementsAre;
+
+namespace griddly {
+
+std::vector<std::shared_ptr<Object>> searchOccupancyGrid(CollisionDetector& collisionDetector, glm::ivec2 location) {
+  std::vector<std::shared_ptr<Object>> objects;
+  collisionDetector.searchObjects(location, objects);
+  return objects;
+}
+
+TEST(OccupancyGridCollisionDetectorTest, test_upsert_and_remove_object) {
+  OccupancyGridCollisionDetector collisionDetector(10, 10, 1, TriggerType::RANGE_BOX_AREA);
+
+  auto mockObjectPtr = mockObject("object", '?', 1, 0, {0, 0});
+
+  ASSERT_FALSE(collisionDetector.remove(mockObjectPtr));
+  ASSERT_TRUE(collisionDetector.upsert(mockObjectPtr));
+  ASSERT_THAT(searchOccupancyGrid(collisionDetector, {1, 1}), ElementsAre(mockObjectPtr));
+
+  EXPECT_CALL(*mockObjectPtr, getLocation()).WillRepeatedly(ReturnRefOfCopy(glm::ivec2(5, 5)));
+  ASSERT_FALSE(collisionDetector.upsert(mockObjectPtr));
+  ASSERT_THAT(searchOccupancyGrid(collisionDetector, {1, 1}), IsEmpty());
+  ASSERT_THAT(searchOccupancyGrid(collisionDetector, {4, 6}), ElementsAre(mockObjectPtr));
+
+  ASSERT_TRUE(collisionDetector.remove(mockObjectPtr));
+  ASSERT_THAT(searchOccupancyGrid(collisionDetector, {4, 6}), IsEmpty());
+}
+
+TEST(OccupancyGridCollisionDetectorTest, test_search_area) {
+  OccupancyGridCollisionDetector collisionDetector(10, 10, 2, TriggerType::RANGE_BOX_AREA);
+
+  auto mockObjectPtr1 = mockObject("object1", '?', 1, 0, {1, 1});
+  auto mockObjectPtr2 = mockObject("object2", '?', 1, 0, {3, 1});
+  auto mockObjectPtr3 = mockObject("object3", '?', 1, 0, {0, 4});
+  auto mockObjectPtr4 = mockObject("object4", '?', 1, 0, {4, 4});
+
+  ASSERT_TRUE(collisionDetector.upsert(mockObjectPtr1));
+  ASSERT_TRUE(collisionDetector.upsert(mockObjectPtr2));
+  ASSERT_TRUE(collisionDetector.upsert(mockObjectPtr3));
+  ASSERT_TRUE(collisionDetector.upsert(mockObjectPtr4));
+
+  ASSERT_THAT(searchOccupancyGrid(collisionDetector, {0, 0}), UnorderedElementsAre(mockObjectPtr1));
+  ASSERT_THAT(searchOccupancyGrid(collisionDetector, {2, 2}), UnorderedElementsAre(mockObjectPtr1, mockObjectPtr2, mockObjectPtr3, mockObjectPtr4));
+  ASSERT_THAT(searchOccupancyGrid(collisionDetector, {9, 9}), IsEmpty());
+  ASSERT_EQ(collisionDetector.searchClosest({3, 3}), mockObjectPtr4);
+}
+
+TEST(OccupancyGridCollisionDetectorTest, test_search_boundary) {
+  OccupancyGridCollisionDetector collisionDetector(10, 10, 2, TriggerType::RANGE_BOX_BOUNDARY);
+
+  auto mockObjectPtr1 = mockObject("object1", '?', 1, 0, {1, 1});
+  auto mockObjectPtr2 = mockObject("object2", '?', 1, 0, {3, 1});
+  auto mockObjectPtr3 = mockObject("object3", '?', 1, 0, {1, 3});
+  auto mockObjectPtr4 = mockObject("object4", '?', 1, 0, {3, 3});
+  auto mockObjectPtr5 = mockObject("object5", '?', 1, 0, {0, 0});
+  auto mockObjectPtr6 = mockObject("object6", '?', 1, 0, {4, 0});
+  auto mockObjectPtr7 = mockObject("object7", '?', 1, 0, {0, 4});
+  auto mockObjectPtr8 = mockObject("object8", '?', 1, 0, {4, 4});
+
+  for (const auto& mockObjectPtr : {mockObjectPtr1, mockObjectPtr2, mockObjectPtr3, mockObjectPtr4, mockObjectPtr5, mockObjectPtr6, mockObjectPtr7, mockObjectPtr8}) {
+    ASSERT_TRUE(collisionDetector.upsert(mockObjectPtr));
+  }
+
+  ASSERT_THAT(searchOccupancyGrid(collisionDetector, {3, 3}), UnorderedElementsAre(mockObjectPtr1, mockObjectPtr2, mockObjectPtr3));
+  ASSERT_THAT(searchOccupancyGrid(collisionDetector, {2, 2}), UnorderedElementsAre(mockObjectPtr5, mockObjectPtr6, mockObjectPtr7, mockObjectPtr8));
+  ASSERT_THAT(searchOccupancyGrid(collisionDetector, {1, 1}), UnorderedElementsAre(mockObjectPtr2, mockObjectPtr3, mockObjectPtr4));
+}
+
+}  // namespace griddly
@@ -0,0 +1,51 @@
+#include "Griddly/Core/PlayerRewards.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+namespace griddly {
+
+TEST(PlayerRewardsTest, accumulate) {
+  PlayerRewards rewards{{1, 3}, {3, -2}};
+  rewards += PlayerRewards{{1, 2}, {2, 4}};
+  rewards[0] += 1;
+
+  ASSERT_EQ(rewards.get(0), 1);
+  ASSERT_EQ(rewards.get(1), 5);
+  ASSERT_EQ(rewards.get(2), 4);
+  ASSERT_EQ(rewards.get(3), -2);
+  ASSERT_EQ(rewards.get(10), 0);
+  ASSERT_EQ(rewards.getPlayerSlots(), 4);
+}
+
+TEST(PlayerRewardsTest, ignoresZeroRewards) {
+  PlayerRewards rewards{{1, 0}, {3, 7}};
+
+  ASSERT_EQ(rewards.size(), 1);
+  ASSERT_THAT(rewards, ElementsAre(Pair(3, 7)));
+  ASSERT_EQ(rewards, (PlayerRewards{{3, 7}}));
+
+  rewards.clear();
+  ASSERT_TRUE(rewards.empty());
+  ASSERT_EQ(rewards, PlayerRewards{});
+  ASSERT_EQ(rewards.getPlayerSlots(), 4);
+}
+
+TEST(PlayerRewardsTest, overflow) {
+  PlayerRewards rewards{{2, 1}};
+  auto* inlineData = rewards.data();
+
+  rewards.resize(PlayerRewards::INLINE_PLAYERS);
+  ASSERT_EQ(rewards.data(), inlineData);
+
+  rewards[PlayerRewards::INLINE_PLAYERS + 2] = 5;
+
+  ASSERT_EQ(rewards.getPlayerSlots(), PlayerRewards::INLINE_PLAYERS + 3);
+  ASSERT_EQ(rewards.get(2), 1);
+  ASSERT_EQ(rewards.get(PlayerRewards::INLINE_PLAYERS + 2), 5);
+  ASSERT_THAT(rewards, ElementsAre(Pair(2, 1), Pair(PlayerRewards::INLINE_PLAYERS + 2, 5)));
+}
+
+}  // namespace griddly
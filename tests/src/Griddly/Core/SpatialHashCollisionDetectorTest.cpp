@@ -257,4 +257,29 @@ TEST(SpatialHashCollisionDetectorTest, test_search_range_larger_than_cell_size)
   ASSERT_THAT(closestObject3, AnyOf(Eq(mockObjectPtr2), Eq(mockObjectPtr3)));
 }
 
+TEST(SpatialHashCollisionDetectorTest, test_search_objects_and_closest) {
+  auto collisionDetector = std::shared_ptr<CollisionDetector>(new SpatialHashCollisionDetector(10, 10, 2, 2, TriggerType::RANGE_BOX_AREA));
+
+  auto mockObjectPtr1 = mockObject("object1", {1, 1});
+  auto mockObjectPtr2 = mockObject("object2", {4, 4});
+
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr1));
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr2));
+
+  std::vector<std::shared_ptr<Object>> objects;
+  collisionDetector->searchObjects({3, 3}, objects);
+  ASSERT_THAT(objects, UnorderedElementsAre(mockObjectPtr1, mockObjectPtr2));
+  ASSERT_EQ(collisionDetector->searchClosest({3, 3}), mockObjectPtr2);
+
+  // Moving to another cell takes the object out of range
+  EXPECT_CALL(*mockObjectPtr2, getLocation()).WillRepeatedly(ReturnRefOfCopy(glm::ivec2(9, 9)));
+  ASSERT_FALSE(collisionDetector->upsert(mockObjectPtr2));
+
+  objects.clear();
+  collisionDetector->searchObjects({3, 3}, objects);
+  ASSERT_THAT(objects, ElementsAre(mockObjectPtr1));
+  ASSERT_EQ(collisionDetector->searchClosest({9, 8}), mockObjectPtr2);
+  ASSERT_EQ(collisionDetector->searchClosest({6, 0}), nullptr);
+}
+
 }  // namespace griddly
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <memory>
 #include <unordered_map>
 
+#include "Griddly/Core/Grid.hpp"
 #include "Mocks/Griddly/Core/GDY/Actions/MockAction.hpp"
 #include "Mocks/Griddly/Core/GDY/Objects/MockObject.hpp"
 #include "gmock/gmock.h"
@@ -89,6 +90,31 @@ std::shared_ptr<MockAction> static mockAction(std::string actionName, std::share
   return mockActionPtr;
 }
 
+ActionInputsDefinition static fourDirectionMoveActions() {
+  ActionInputsDefinition definition;
+  definition.inputMappings = {
+      {1, {{-1, 0}}}, {2, {{0, -1}}}, {3, {{1, 0}}}, {4, {{0, 1}}}};
+  definition.relative = false;
+  definition.internal = false;
+  definition.mapToGrid = false;
+
+  return definition;
+}
+
+std::shared_ptr<Grid> static pathFinderGrid(uint32_t width, uint32_t height, const std::vector<std::string>& objectNames) {
+  auto grid = std::make_shared<Grid>();
+  grid->setPlayerCount(1);
+  grid->resetMap(width, height);
+  for (const auto& objectName : objectNames) {
+    grid->initObject(objectName, {});
+  }
+
+  auto emptyObject = std::make_shared<Object>(Object("_empty", ' ', 0, 0, {}, nullptr, grid));
+  auto boundaryObject = std::make_shared<Object>(Object("_boundary", ' ', 0, 0, {}, nullptr, grid));
+  grid->addPlayerDefaultObjects(emptyObject, boundaryObject);
+  return grid;
+}
+
 bool static commandArgumentsEqual(CommandArguments a, CommandArguments b) {
   for (auto& it : a) {
     auto key = it.first;
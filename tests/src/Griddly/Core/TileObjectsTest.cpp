@@ -0,0 +1,73 @@
+#include "Griddly/Core/TileObjects.hpp"
+#include "Griddly/Core/TestUtils/common.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace griddly {
+
+TEST(TileObjectsTest, insertOrderedByZIdx) {
+  auto object0 = mockObject("object0");
+  auto object1 = mockObject("object1");
+  auto object2 = mockObject("object2");
+
+  TileObjects tileObjects;
+
+  ASSERT_TRUE(tileObjects.insert({2, object2}).second);
+  ASSERT_TRUE(tileObjects.insert({0, object0}).second);
+  ASSERT_TRUE(tileObjects.insert({1, object1}).second);
+  ASSERT_FALSE(tileObjects.insert({1, object0}).second);
+
+  ASSERT_EQ(tileObjects.size(), 3);
+  ASSERT_EQ(tileObjects.at(1), object1);
+  ASSERT_EQ(tileObjects.rbegin()->second, object2);
+
+  std::vector<uint32_t> zIdxs;
+  for (const auto& objectIt : tileObjects) {
+    zIdxs.push_back(objectIt.first);
+  }
+  ASSERT_THAT(zIdxs, ElementsAre(0, 1, 2));
+}
+
+TEST(TileObjectsTest, eraseAndFind) {
+  auto object0 = mockObject("object0");
+  auto object1 = mockObject("object1");
+
+  TileObjects tileObjects = {{0, object0}, {1, object1}};
+
+  ASSERT_EQ(tileObjects.erase(3), 0);
+  ASSERT_EQ(tileObjects.erase(0), 1);
+
+  ASSERT_EQ(tileObjects.size(), 1);
+  ASSERT_EQ(tileObjects.find(0), tileObjects.end());
+  ASSERT_EQ(tileObjects.count(1), 1);
+  ASSERT_THROW(tileObjects.at(0), std::out_of_range);
+}
+
+TEST(TileObjectsTest, spillsOverInlineSlots) {
+  TileObjects tileObjects;
+  std::vector<std::shared_ptr<MockObject>> objects;
+
+  uint32_t numObjects = TileObjects::INLINE_SLOTS + 2;
+  for (uint32_t z = numObjects; z > 0; z--) {
+    auto object = mockObject("object" + std::to_string(z));
+    objects.push_back(object);
+    tileObjects.insert({z, object});
+  }
+
+  ASSERT_EQ(tileObjects.size(), numObjects);
+  ASSERT_EQ(tileObjects.begin()->first, 1);
+  ASSERT_EQ(tileObjects.rbegin()->first, numObjects);
+
+  auto copiedTileObjects = tileObjects;
+
+  for (uint32_t z = numObjects; z > 1; z--) {
+    ASSERT_EQ(tileObjects.erase(z), 1);
+  }
+
+  ASSERT_EQ(tileObjects.size(), 1);
+  ASSERT_EQ(tileObjects.at(1), objects.back());
+  ASSERT_EQ(copiedTileObjects.size(), numObjects);
+  ASSERT_EQ(copiedTileObjects.at(numObjects), objects.front());
+}
+
+}  // namespace griddly
@@ -0,0 +1,76 @@
+#include <thread>
+#include <vector>
+
+#include "Griddly/Core/Util/LockFreeQueue.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace griddly {
+
+TEST(LockFreeQueueTest, pushPopInOrder) {
+  LockFreeQueue<uint32_t> queue(3);
+
+  ASSERT_EQ(queue.capacity(), 4);
+
+  uint32_t value;
+  ASSERT_FALSE(queue.tryPop(value));
+
+  for (uint32_t i = 0; i < 4; i++) {
+    ASSERT_TRUE(queue.tryPush(i));
+  }
+  ASSERT_FALSE(queue.tryPush(4));
+
+  for (uint32_t i = 0; i < 4; i++) {
+    ASSERT_TRUE(queue.tryPop(value));
+    ASSERT_EQ(value, i);
+  }
+  ASSERT_FALSE(queue.tryPop(value));
+
+  // Positions wrap around the slots
+  ASSERT_TRUE(queue.tryPush(10));
+  ASSERT_TRUE(queue.tryPop(value));
+  ASSERT_EQ(value, 10);
+}
+
+TEST(LockFreeQueueTest, concurrentProducers) {
+  LockFreeQueue<uint32_t> queue(64);
+
+  const uint32_t numProducers = 4;
+  const uint32_t valuesPerProducer = 10000;
+
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < numProducers; p++) {
+    producers.emplace_back([&queue, p] {
+      for (uint32_t i = 0; i < valuesPerProducer; i++) {
+        while (!queue.tryPush(p * valuesPerProducer + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<uint32_t> received(numProducers * valuesPerProducer);
+  std::vector<uint32_t> lastFromProducer(numProducers, 0);
+  for (uint32_t r = 0; r < numProducers * valuesPerProducer; r++) {
+    uint32_t value;
+    while (!queue.tryPop(value)) {
+      std::this_thread::yield();
+    }
+    received[value]++;
+
+    // Each producer's values arrive in the order they were pushed
+    auto producer = value / valuesPerProducer;
+    ASSERT_GE(value, lastFromProducer[producer]);
+    lastFromProducer[producer] = value;
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  for (auto count : received) {
+    ASSERT_EQ(count, 1);
+  }
+}
+
+}  // namespace griddly
@@ -0,0 +1,218 @@
+#include <memory>
+#include <random>
+#include <sstream>
+
+#include "Griddly/Core/VectorGameProcess.cpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using ::testing::ElementsAre;
+using ::testing::UnorderedElementsAre;
+
+namespace griddly {
+
+std::shared_ptr<GDYFactory> vectorTestGDYFactory() {
+  auto gdyString = R"(
+Version: "0.1"
+Environment:
+  Name: VectorTest
+  Player:
+    AvatarObject: avatar
+  Termination:
+    Win:
+      - eq: [goal:count, 0]
+  Levels:
+    - |
+      wwwww
+      wA.gw
+      wwwww
+
+Actions:
+  - Name: move
+    Behaviours:
+      - Src:
+          Object: avatar
+          Commands:
+            - mov: _dest
+        Dst:
+          Object: _empty
+      - Src:
+          Object: avatar
+          Commands:
+            - reward: 1
+        Dst:
+          Object: goal
+          Commands:
+            - remove: true
+
+Objects:
+  - Name: avatar
+    MapCharacter: A
+
+  - Name: goal
+    MapCharacter: g
+
+  - Name: wall
+    MapCharacter: w
+)";
+
+  auto gdyFactory = std::make_shared<GDYFactory>(GDYFactory(std::make_shared<ObjectGenerator>(ObjectGenerator()), std::make_shared<TerminationGenerator>(TerminationGenerator()), {}));
+  std::istringstream gdyStream(gdyString);
+  gdyFactory->parseFromStream(gdyStream);
+  return gdyFactory;
+}
+
+std::vector<uint8_t> envObservation(std::shared_ptr<VectorGameProcess> vectorGameProcess, uint32_t envIdx) {
+  auto& observations = vectorGameProcess->getObservations();
+  auto observationSize = observations.size() / vectorGameProcess->getNumEnvs();
+  return {observations.begin() + envIdx * observationSize, observations.begin() + (envIdx + 1) * observationSize};
+}
+
+TEST(VectorGameProcessTest, reset) {
+  auto vectorGameProcess = std::make_shared<VectorGameProcess>(3, vectorTestGDYFactory(), "Vector");
+
+  vectorGameProcess->init();
+  vectorGameProcess->reset();
+
+  ASSERT_EQ(vectorGameProcess->getNumEnvs(), 3);
+  ASSERT_EQ(vectorGameProcess->getPlayerCount(), 1);
+  ASSERT_THAT(vectorGameProcess->getObservationShape(), ElementsAre(3, 5, 3));
+  ASSERT_EQ(vectorGameProcess->getObservations().size(), 3 * 3 * 5 * 3);
+  ASSERT_THAT(vectorGameProcess->getRewards(), ElementsAre(0, 0, 0));
+  ASSERT_THAT(vectorGameProcess->getDones(), ElementsAre(0, 0, 0));
+
+  ASSERT_EQ(envObservation(vectorGameProcess, 0), envObservation(vectorGameProcess, 1));
+  ASSERT_EQ(envObservation(vectorGameProcess, 0), envObservation(vectorGameProcess, 2));
+}
+
+TEST(VectorGameProcessTest, stepAutoReset) {
+  auto vectorGameProcess = std::make_shared<VectorGameProcess>(2, vectorTestGDYFactory(), "Vector");
+
+  vectorGameProcess->init();
+  vectorGameProcess->reset();
+
+  auto initialObservation = envObservation(vectorGameProcess, 0);
+
+  // Env 0 moves right, env 1 does nothing
+  std::vector<int32_t> actions = {3, 0};
+
+  vectorGameProcess->step(actions.data(), 1);
+
+  ASSERT_THAT(vectorGameProcess->getRewards(), ElementsAre(0, 0));
+  ASSERT_THAT(vectorGameProcess->getDones(), ElementsAre(0, 0));
+  ASSERT_NE(envObservation(vectorGameProcess, 0), initialObservation);
+  ASSERT_EQ(envObservation(vectorGameProcess, 1), initialObservation);
+  ASSERT_EQ(*vectorGameProcess->getGameProcess(0)->getGrid()->getTickCount(), 1);
+
+  vectorGameProcess->step(actions.data(), 1);
+
+  ASSERT_THAT(vectorGameProcess->getRewards(), ElementsAre(1, 0));
+  ASSERT_THAT(vectorGameProcess->getDones(), ElementsAre(1, 0));
+
+  // The finished env has been reset, so it observes the start of its next episode
+  ASSERT_EQ(envObservation(vectorGameProcess, 0), initialObservation);
+  ASSERT_EQ(*vectorGameProcess->getGameProcess(0)->getGrid()->getTickCount(), 0);
+  ASSERT_EQ(*vectorGameProcess->getGameProcess(1)->getGrid()->getTickCount(), 2);
+}
+
+TEST(VectorGameProcessTest, stepInvalidActionSize) {
+  auto vectorGameProcess = std::make_shared<VectorGameProcess>(1, vectorTestGDYFactory(), "Vector");
+
+  vectorGameProcess->init();
+  vectorGameProcess->reset();
+
+  std::vector<int32_t> actions = {0, 0, 0, 0, 0};
+  ASSERT_THROW(vectorGameProcess->step(actions.data(), 5), std::invalid_argument);
+}
+
+TEST(VectorGameProcessTest, stepBeforeReset) {
+  auto vectorGameProcess = std::make_shared<VectorGameProcess>(1, vectorTestGDYFactory(), "Vector");
+
+  vectorGameProcess->init();
+
+  std::vector<int32_t> actions = {0};
+  ASSERT_THROW(vectorGameProcess->step(actions.data(), 1), std::runtime_error);
+}
+
+TEST(VectorGameProcessTest, stepParallelMatchesSerial) {
+  auto gdyFactory = vectorTestGDYFactory();
+  auto serialGameProcess = std::make_shared<VectorGameProcess>(16, gdyFactory, "Vector");
+  auto parallelGameProcess = std::make_shared<VectorGameProcess>(16, gdyFactory, "Vector", 4);
+
+  ASSERT_EQ(serialGameProcess->getNumThreads(), 1);
+  ASSERT_EQ(parallelGameProcess->getNumThreads(), 4);
+
+  serialGameProcess->init();
+  serialGameProcess->reset();
+  parallelGameProcess->init();
+  parallelGameProcess->reset();
+
+  std::mt19937 actionGenerator(123);
+  std::uniform_int_distribution<int32_t> actionDistribution(0, 4);
+  std::vector<int32_t> actions(16);
+  for (uint32_t s = 0; s < 20; s++) {
+    for (auto& action : actions) {
+      action = actionDistribution(actionGenerator);
+    }
+
+    serialGameProcess->step(actions.data(), 1);
+    parallelGameProcess->step(actions.data(), 1);
+
+    ASSERT_EQ(serialGameProcess->getObservations(), parallelGameProcess->getObservations());
+    ASSERT_EQ(serialGameProcess->getRewards(), parallelGameProcess->getRewards());
+    ASSERT_EQ(serialGameProcess->getDones(), parallelGameProcess->getDones());
+  }
+}
+
+TEST(VectorGameProcessTest, sendRecv) {
+  auto vectorGameProcess = std::make_shared<VectorGameProcess>(4, vectorTestGDYFactory(), "Vector", 2);
+
+  vectorGameProcess->init();
+  vectorGameProcess->reset();
+
+  auto initialObservation = envObservation(vectorGameProcess, 0);
+
+  // Envs 1 and 3 move right
+  std::vector<uint32_t> envIds = {1, 3};
+  std::vector<int32_t> actions = {3, 3};
+  vectorGameProcess->send(envIds.data(), 2, actions.data(), 1);
+
+  ASSERT_THROW(vectorGameProcess->send(envIds.data(), 1, actions.data(), 1), std::invalid_argument);
+  ASSERT_THROW(vectorGameProcess->step(actions.data(), 1), std::runtime_error);
+  ASSERT_THROW(vectorGameProcess->recv(3), std::invalid_argument);
+
+  auto firstEnv = vectorGameProcess->recv(1);
+  auto secondEnv = vectorGameProcess->recv(1);
+  ASSERT_THAT((std::vector<uint32_t>{firstEnv[0], secondEnv[0]}), UnorderedElementsAre(1, 3));
+
+  ASSERT_EQ(envObservation(vectorGameProcess, 0), initialObservation);
+  ASSERT_NE(envObservation(vectorGameProcess, 1), initialObservation);
+  ASSERT_EQ(envObservation(vectorGameProcess, 2), initialObservation);
+  ASSERT_NE(envObservation(vectorGameProcess, 3), initialObservation);
+
+  // The second move picks up the goal, the env is reset and reports that it is done
+  vectorGameProcess->send(envIds.data(), 2, actions.data(), 1);
+  ASSERT_THAT(vectorGameProcess->recv(2), UnorderedElementsAre(1, 3));
+
+  ASSERT_THAT(vectorGameProcess->getRewards(), ElementsAre(0, 1, 0, 1));
+  ASSERT_THAT(vectorGameProcess->getDones(), ElementsAre(0, 1, 0, 1));
+  ASSERT_EQ(envObservation(vectorGameProcess, 1), initialObservation);
+  ASSERT_EQ(envObservation(vectorGameProcess, 3), initialObservation);
+
+  // Synchronous steps can be used again once everything has been received
+  std::vector<int32_t> stepActions = {0, 0, 0, 0};
+  vectorGameProcess->step(stepActions.data(), 1);
+}
+
+TEST(VectorGameProcessTest, sendInvalidEnv) {
+  auto vectorGameProcess = std::make_shared<VectorGameProcess>(2, vectorTestGDYFactory(), "Vector");
+
+  vectorGameProcess->init();
+  vectorGameProcess->reset();
+
+  std::vector<uint32_t> envIds = {2};
+  std::vector<int32_t> actions = {3};
+  ASSERT_THROW(vectorGameProcess->send(envIds.data(), 1, actions.data(), 1), std::invalid_argument);
+}
+
+}  // namespace griddly
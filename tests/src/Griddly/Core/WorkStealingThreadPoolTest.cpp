@@ -0,0 +1,87 @@
+#include <atomic>
+#include <vector>
+
+#include "Griddly/Core/WorkStealingThreadPool.cpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace griddly {
+
+TEST(WorkStealingThreadPoolTest, parallelForRunsEachTaskOnce) {
+  WorkStealingThreadPool threadPool(4);
+
+  ASSERT_EQ(threadPool.getNumWorkers(), 4);
+
+  for (uint32_t count : {1, 3, 4, 100}) {
+    std::vector<std::atomic<uint32_t>> taskRuns(count);
+    threadPool.parallelFor(count, [&taskRuns](uint32_t taskIdx) { taskRuns[taskIdx]++; });
+
+    for (uint32_t t = 0; t < count; t++) {
+      ASSERT_EQ(taskRuns[t], 1);
+    }
+  }
+}
+
+TEST(WorkStealingThreadPoolTest, parallelForStealsFromBusyWorkers) {
+  WorkStealingThreadPool threadPool(2);
+
+  // The first worker's range starts with a task that blocks until every other task has run, so they can only finish if they are stolen
+  std::atomic<uint32_t> finishedTasks{0};
+  threadPool.parallelFor(8, [&finishedTasks](uint32_t taskIdx) {
+    if (taskIdx == 0) {
+      while (finishedTasks < 7) {
+        std::this_thread::yield();
+      }
+    }
+    finishedTasks++;
+  });
+
+  ASSERT_EQ(finishedTasks, 8);
+}
+
+TEST(WorkStealingThreadPoolTest, parallelForRethrowsTaskException) {
+  WorkStealingThreadPool threadPool(3);
+
+  std::atomic<uint32_t> finishedTasks{0};
+  auto task = [&finishedTasks](uint32_t taskIdx) {
+    if (taskIdx == 5) {
+      throw std::invalid_argument("task failed");
+    }
+    finishedTasks++;
+  };
+
+  ASSERT_THROW(threadPool.parallelFor(10, task), std::invalid_argument);
+  ASSERT_EQ(finishedTasks, 9);
+
+  // The pool can still be used after a task has failed
+  finishedTasks = 0;
+  threadPool.parallelFor(10, [&finishedTasks](uint32_t) { finishedTasks++; });
+  ASSERT_EQ(finishedTasks, 10);
+}
+
+TEST(WorkStealingThreadPoolTest, submit) {
+  WorkStealingThreadPool threadPool(3);
+
+  std::mutex finishedMutex;
+  std::condition_variable allFinished;
+  uint32_t finishedTasks = 0;
+
+  for (uint32_t t = 0; t < 50; t++) {
+    threadPool.submit(t, [&] {
+      std::lock_guard<std::mutex> lock(finishedMutex);
+      finishedTasks++;
+      allFinished.notify_all();
+    });
+  }
+
+  // Submitted tasks do not block batches
+  std::atomic<uint32_t> batchTasks{0};
+  threadPool.parallelFor(10, [&batchTasks](uint32_t) { batchTasks++; });
+  ASSERT_EQ(batchTasks, 10);
+
+  std::unique_lock<std::mutex> lock(finishedMutex);
+  allFinished.wait(lock, [&finishedTasks] { return finishedTasks == 50; });
+  ASSERT_EQ(finishedTasks, 50);
+}
+
+}  // namespace griddly
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Griddly/Core/GDY/Actions/Action.hpp"
+#include "Griddly/Core/GDY/SymbolTable.hpp"
 #include "gmock/gmock.h"
 
 namespace griddly {
@@ -8,7 +9,9 @@ namespace griddly {
 class MockAction : public Action {
  public:
   MockAction()
-      : Action(std::shared_ptr<Grid>(), "mockAction", 0, {}) {}
+      : Action(std::shared_ptr<Grid>(), "mockAction", 0, {}) {
+    ON_CALL(*this, getActionNameId).WillByDefault([this] { return SymbolTable::actionNames().intern(getActionName()); });
+  }
       
       
   MOCK_METHOD(void, init, (std::shared_ptr<Object> sourceObject, std::shared_ptr<Object> destinationObject), ());
@@ -16,6 +19,7 @@ class MockAction : public Action {
   MOCK_METHOD(void, init, (std::shared_ptr<Object> sourceObject, glm::ivec2 vectorToDest, glm::ivec2 orientationVector, bool relativeToSource), ());
 
   MOCK_METHOD(std::shared_ptr<Object>, getSourceObject, (), (const));
+  MOCK_METHOD(bool, hasSourceObject, (), (const));
   MOCK_METHOD(std::shared_ptr<Object>, getDestinationObject, (), (const));
 
   MOCK_METHOD(glm::ivec2, getSourceLocation, (), (const));
@@ -25,10 +29,11 @@ class MockAction : public Action {
   MOCK_METHOD(glm::ivec2, getOrientationVector, (), (const));
 
   MOCK_METHOD(const std::string&, getActionName, (), (const));
+  MOCK_METHOD(uint32_t, getActionNameId, (), (const));
   MOCK_METHOD(std::string, getDescription, (), (const));
   MOCK_METHOD(uint32_t, getDelay, (), (const));
-  MOCK_METHOD(int32_t, getMetaData, (std::string variableName), (const));
-  MOCK_METHOD((const std::unordered_map<std::string, int32_t>&), getMetaData, (), (const));
+  MOCK_METHOD(int32_t, getMetaData, (const std::string& variableName), (const));
+  MOCK_METHOD(const ActionMetaData&, getMetaData, (), (const));
 
   MOCK_METHOD(uint32_t, getOriginatingPlayerId, (), (const));
 };
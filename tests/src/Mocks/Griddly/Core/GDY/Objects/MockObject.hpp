@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Griddly/Core/GDY/Objects/Object.hpp"
+#include "Griddly/Core/GDY/SymbolTable.hpp"
 #include "gmock/gmock.h"
 
 namespace griddly {
@@ -9,6 +10,7 @@ class MockObject : public Object {
  public:
   MockObject()
       : Object("mockObject", 'o', 0, 0, {}, nullptr, std::weak_ptr<Grid>()) {
+    ON_CALL(*this, getObjectNameId).WillByDefault([this] { return SymbolTable::objectNames().intern(getObjectName()); });
   }
 
 
@@ -18,6 +20,7 @@ class MockObject : public Object {
   MOCK_METHOD(int32_t, getZIdx, (), (const));
   MOCK_METHOD(const glm::ivec2&, getLocation, (), (const));
   MOCK_METHOD(const std::string&, getObjectName, (), (const));
+  MOCK_METHOD(uint32_t, getObjectNameId, (), (const));
   MOCK_METHOD(char, getMapCharacter, (), (const));
   MOCK_METHOD(const std::string&, getObjectRenderTileName, (), (const));
   MOCK_METHOD(uint32_t, getPlayerId, (), (const));
@@ -31,11 +34,12 @@ class MockObject : public Object {
 
   MOCK_METHOD(std::vector<std::shared_ptr<Action>>, getInitialActions, (std::shared_ptr<Action> originatingAction), ());
 
-  MOCK_METHOD(bool, isValidAction, (std::shared_ptr<Action> action), (const));
-  MOCK_METHOD(std::vector<uint32_t>, getValidBehaviourIdxs, (std::shared_ptr<Action> action), (const));
+  MOCK_METHOD(bool, isValidAction, (const std::shared_ptr<Action>& action), (const));
+  MOCK_METHOD(bool, isValidAction, (const std::shared_ptr<Action>& action, PreconditionCache& preconditionCache), (const));
+  MOCK_METHOD(std::vector<uint32_t>, getValidBehaviourIdxs, (const std::shared_ptr<Action>& action), (const));
 
-  MOCK_METHOD(BehaviourResult, onActionSrc, (std::string destinationObjectName, std::shared_ptr<Action> action, std::vector<uint32_t> behaviourIdxs), (override));
-  MOCK_METHOD(BehaviourResult, onActionDst, (std::shared_ptr<Action> action, std::vector<uint32_t> behaviourIdxs), (override));
+  MOCK_METHOD(BehaviourResult, onActionSrc, (uint32_t destinationObjectNameId, const std::shared_ptr<Action>& action, const std::vector<uint32_t>& behaviourIdxs), (override));
+  MOCK_METHOD(BehaviourResult, onActionDst, (const std::shared_ptr<Action>& action, const std::vector<uint32_t>& behaviourIdxs), (override));
 
   MOCK_METHOD(std::unordered_set<std::string>, getAvailableActionNames, (), (const));
   MOCK_METHOD((std::unordered_map<std::string, std::shared_ptr<int32_t>>), getAvailableVariables, (), (const));
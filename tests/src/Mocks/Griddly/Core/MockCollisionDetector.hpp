@@ -7,8 +7,12 @@ class MockCollisionDetector : public CollisionDetector {
   MockCollisionDetector() : CollisionDetector(10, 10, 1) {}
   ~MockCollisionDetector() override = default;
 
-  MOCK_METHOD(bool, upsert, (std::shared_ptr<Object> object), ());
+  using CollisionDetector::upsert;
+
+  MOCK_METHOD(bool, upsert, (std::shared_ptr<Object> object, glm::ivec2 location), ());
   MOCK_METHOD(bool, remove, (std::shared_ptr<Object> object), ());
-  MOCK_METHOD(SearchResult, search, (glm::ivec2 location), ());
+  MOCK_METHOD(void, forEachObject, (glm::ivec2 location, const CollisionVisitor& visitor), ());
+  MOCK_METHOD(void, searchObjects, (glm::ivec2 location, std::vector<std::shared_ptr<Object>>& objects), ());
+  MOCK_METHOD(std::shared_ptr<Object>, searchClosest, (glm::ivec2 location), ());
 };
 }  // namespace griddly
\ No newline at end of file
@@ -11,7 +11,7 @@ class MockGrid : public Grid {
   MOCK_METHOD(void, resetMap, (uint32_t width, uint32_t height), ());
   MOCK_METHOD(void, setGlobalVariables, ((std::unordered_map<std::string, std::unordered_map<uint32_t, int32_t>>)), ());
   MOCK_METHOD(void, resetGlobalVariables, ((std::unordered_map<std::string, GlobalVariableDefinition>)), ());
-  MOCK_METHOD((std::unordered_map<uint32_t, int32_t>), update, (), ());
+  MOCK_METHOD(PlayerRewards, update, (), ());
 
   MOCK_METHOD((const std::unordered_set<glm::ivec2>&), getUpdatedLocations, (uint32_t playerId), (const));
   MOCK_METHOD(void, purgeUpdatedLocations, (uint32_t playerId), ());
@@ -22,7 +22,7 @@ class MockGrid : public Grid {
   MOCK_METHOD(bool, invalidateLocation, (glm::ivec2 location));
 
   MOCK_METHOD(bool, updateLocation, (std::shared_ptr<Object> object, glm::ivec2 previousLocation, glm::ivec2 newLocation), ());
-  MOCK_METHOD((std::unordered_map<uint32_t, int32_t>), performActions, (uint32_t playerId, std::vector<std::shared_ptr<Action>> actions), ());
+  MOCK_METHOD(PlayerRewards, performActions, (uint32_t playerId, std::vector<std::shared_ptr<Action>> actions), ());
 
   MOCK_METHOD(void, initObject, (std::string, std::vector<std::string>), ());
   MOCK_METHOD(void, addObject, (glm::ivec2 location, std::shared_ptr<Object> object, bool applyInitialActions, std::shared_ptr<Action> originatingAction, DiscreteOrientation orientation), ());
@@ -49,9 +49,14 @@ class MockGrid : public Grid {
   MOCK_METHOD(uint32_t, getPlayerCount, (), (const));
 
   MOCK_METHOD(void, addCollisionDetector, (std::unordered_set<std::string> objectNames, std::string actionName, std::shared_ptr<CollisionDetector> collisionDetector), ());
+  MOCK_METHOD(std::shared_ptr<NearestObjectIndex>, getNearestObjectIndex, (const std::string& objectName), ());
 
   MOCK_METHOD(std::shared_ptr<int32_t>, getTickCount, (), (const));
 
-  MOCK_METHOD(std::mt19937, getRandomGenerator, (), ());
+  MOCK_METHOD(std::shared_ptr<GridSnapshot>, takeSnapshot, (), (const));
+  MOCK_METHOD(void, restoreSnapshot, (const GridSnapshot& snapshot), ());
+  MOCK_METHOD(std::shared_ptr<Grid>, cloneCopyOnWrite, (std::shared_ptr<ObjectGenerator> objectGenerator), ());
+
+  MOCK_METHOD(std::shared_ptr<RandomGenerator>, getRandomGenerator, (), (const));
 };
 }  // namespace griddly
\ No newline at end of file